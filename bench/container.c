@@ -0,0 +1,152 @@
+/*
+ * Measures random access to the splines of a container. Each query opens a
+ * view of a random spline (zero-copy) and evaluates it at a random knot. For
+ * comparison, the same is done by copying the spline out of the container
+ * (ts_container_load) and by loading it from a JSON file (ts_bspline_load),
+ * which is what applications storing one file per spline would do.
+ *
+ * Usage: tinyspline_bench_container [num_splines]
+ */
+#include "tinyspline.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+
+#define NUM_QUERIES 1000000
+#define NUM_JSON_QUERIES 10000
+#define FILE_CONTAINER "tinyspline_bench_container.tsbc"
+#define FILE_JSON "tinyspline_bench_container.json"
+
+static unsigned long lcg_state = 42;
+
+static tsReal next_random(void)
+{
+	lcg_state = lcg_state * 1103515245UL + 12345UL;
+	return (tsReal) ((lcg_state >> 8) & 0xFFFFFF) / (tsReal) 0xFFFFFF;
+}
+
+static size_t next_index(size_t num)
+{
+	size_t idx = (size_t) (next_random() * (tsReal) num);
+	return idx < num ? idx : num - 1;
+}
+
+static double ns_per_op(clock_t start, clock_t end, size_t ops)
+{
+	return (double) (end - start) / CLOCKS_PER_SEC * 1e9 / (double) ops;
+}
+
+int main(int argc, char **argv)
+{
+	tsContainerWriter writer = ts_container_writer_init();
+	tsContainer container = ts_container_init();
+	tsEvalContext ctx = ts_eval_context_init();
+	tsBSpline spline = ts_bspline_init();
+	tsBSplineView view;
+	tsReal *ctrlp = NULL, point[3], min, max;
+	size_t num_splines = 100000, i, j;
+	clock_t start;
+	double t_write, t_open, t_view, t_load, t_json;
+	tsStatus status;
+
+	if (argc > 1)
+		num_splines = (size_t) strtoul(argv[1], NULL, 10);
+	if (num_splines == 0)
+		return EXIT_FAILURE;
+
+	TS_TRY(try, status.code, &status)
+		/* Write splines with 8 to 39 control points. */
+		start = clock();
+		TS_CALL(try, status.code, ts_container_writer_open(
+		        FILE_CONTAINER, 0, &writer, &status))
+		for (i = 0; i < num_splines; i++) {
+			TS_CALL(try, status.code, ts_bspline_new(
+			        8 + i % 32, 3, 3, TS_CLAMPED, &spline,
+			        &status))
+			TS_CALL(try, status.code, ts_bspline_control_points(
+			        &spline, &ctrlp, &status))
+			for (j = 0; j < (8 + i % 32) * 3; j++)
+				ctrlp[j] = next_random();
+			TS_CALL(try, status.code,
+			        ts_bspline_set_control_points(
+			        &spline, ctrlp, &status))
+			TS_CALL(try, status.code, ts_container_writer_append(
+			        &writer, &spline, &status))
+			if (i == 0) {
+				TS_CALL(try, status.code, ts_bspline_save(
+				        &spline, FILE_JSON, &status))
+			}
+			ts_bspline_free(&spline);
+			free(ctrlp);
+			ctrlp = NULL;
+		}
+		TS_CALL(try, status.code, ts_container_writer_close(
+		        &writer, &status))
+		t_write = ns_per_op(start, clock(), num_splines);
+
+		start = clock();
+		TS_CALL(try, status.code, ts_container_open(
+		        FILE_CONTAINER, &container, &status))
+		t_open = ns_per_op(start, clock(), 1) / 1e3;
+
+		/* Zero-copy access. */
+		start = clock();
+		for (i = 0; i < NUM_QUERIES; i++) {
+			TS_CALL(try, status.code, ts_container_view(
+			        &container, next_index(num_splines), &view,
+			        &status))
+			ts_bspline_view_domain(&view, &min, &max);
+			TS_CALL(try, status.code, ts_eval_context_view_eval(
+			        &ctx, &view, min + (max - min) * next_random(),
+			        point, &status))
+		}
+		t_view = ns_per_op(start, clock(), NUM_QUERIES);
+
+		/* Copy (and validate) the spline. */
+		start = clock();
+		for (i = 0; i < NUM_QUERIES; i++) {
+			TS_CALL(try, status.code, ts_container_load(
+			        &container, next_index(num_splines), &spline,
+			        &status))
+			ts_bspline_domain(&spline, &min, &max);
+			TS_CALL(try, status.code, ts_eval_context_eval(
+			        &ctx, &spline, min + (max - min) * next_random(),
+			        point, &status))
+			ts_bspline_free(&spline);
+		}
+		t_load = ns_per_op(start, clock(), NUM_QUERIES);
+
+		/* One JSON file per spline. */
+		start = clock();
+		for (i = 0; i < NUM_JSON_QUERIES; i++) {
+			TS_CALL(try, status.code, ts_bspline_load(
+			        FILE_JSON, &spline, &status))
+			ts_bspline_domain(&spline, &min, &max);
+			TS_CALL(try, status.code, ts_eval_context_eval(
+			        &ctx, &spline, min + (max - min) * next_random(),
+			        point, &status))
+			ts_bspline_free(&spline);
+		}
+		t_json = ns_per_op(start, clock(), NUM_JSON_QUERIES);
+
+		printf("splines:                  %lu\n",
+		       (unsigned long) num_splines);
+		printf("write [ns/spline]:        %.1f\n", t_write);
+		printf("open [us]:                %.1f\n", t_open);
+		printf("view + eval [ns/query]:   %.1f\n", t_view);
+		printf("load + eval [ns/query]:   %.1f\n", t_load);
+		printf("json file + eval [ns/q.]: %.1f\n", t_json);
+	TS_CATCH(status.code)
+		fprintf(stderr, "%s\n", status.message);
+	TS_FINALLY
+		ts_container_writer_close(&writer, NULL);
+		ts_container_close(&container);
+		ts_eval_context_free(&ctx);
+		ts_bspline_free(&spline);
+		free(ctrlp);
+		remove(FILE_CONTAINER);
+		remove(FILE_JSON);
+	TS_END_TRY
+	return status.code ? EXIT_FAILURE : EXIT_SUCCESS;
+}
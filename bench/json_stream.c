@@ -0,0 +1,206 @@
+/*
+ * Measures batch serialization of many splines into a single JSON file, both
+ * as array and as newline-delimited JSON. The newline-delimited file is also
+ * read in (sequential) byte ranges to show how evenly the work is distributed
+ * when the ranges are processed by multiple threads. For comparison, a spline
+ * is loaded from a file of its own (ts_bspline_load), which is what
+ * applications storing one file per spline would do.
+ *
+ * Usage: tinyspline_bench_json_stream [num_splines] [num_ranges]
+ */
+#include "tinyspline.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+
+/* Multiple of 32 to have the same mix of splines as the stream. */
+#define NUM_FILES 2048
+#define FILE_STREAM "tinyspline_bench_json_stream.json"
+#define FILE_SINGLE "tinyspline_bench_json_stream_%lu.json"
+
+static unsigned long lcg_state = 42;
+
+static tsReal next_random(void)
+{
+	lcg_state = lcg_state * 1103515245UL + 12345UL;
+	return (tsReal) ((lcg_state >> 8) & 0xFFFFFF) / (tsReal) 0xFFFFFF;
+}
+
+static double seconds(clock_t start, clock_t end)
+{
+	return (double) (end - start) / CLOCKS_PER_SEC;
+}
+
+static size_t file_size(const char *path)
+{
+	FILE *file = fopen(path, "rb");
+	long size;
+	if (!file) return 0;
+	fseek(file, 0, SEEK_END);
+	size = ftell(file);
+	fclose(file);
+	return size < 0 ? 0 : (size_t) size;
+}
+
+/* Reads all splines of `stream' and returns their number. */
+static tsError read_stream(tsJsonStream *stream,
+                           size_t *num,
+                           tsStatus *status)
+{
+	tsBSpline spline = ts_bspline_init();
+	int done = 0;
+	tsError err;
+	*num = 0;
+	for (;;) {
+		TS_CALL_ROE(err, ts_json_stream_next(stream, &spline, &done,
+		            status))
+		if (done) break;
+		ts_bspline_free(&spline);
+		(*num)++;
+	}
+	TS_RETURN_SUCCESS(status)
+}
+
+int main(int argc, char **argv)
+{
+	tsJsonStreamWriter writer = ts_json_stream_writer_init();
+	tsJsonStream stream = ts_json_stream_init();
+	tsBSpline *splines = NULL;
+	tsBSpline spline = ts_bspline_init();
+	tsReal *ctrlp = NULL;
+	size_t num_splines = 100000, num_ranges = 4, num, total, size;
+	size_t created = 0, num_files = 0, i, j;
+	char path[64];
+	tsJsonFormat formats[2] = { TS_JSON_ARRAY, TS_JSON_LINES };
+	const char *names[2] = { "array", "lines" };
+	clock_t start;
+	double t_write, t_read, t_range, t_max;
+	int f;
+	tsStatus status;
+
+	if (argc > 1)
+		num_splines = (size_t) strtoul(argv[1], NULL, 10);
+	if (argc > 2)
+		num_ranges = (size_t) strtoul(argv[2], NULL, 10);
+	if (num_splines == 0 || num_ranges == 0)
+		return EXIT_FAILURE;
+
+	TS_TRY(try, status.code, &status)
+		/* Splines with 8 to 39 control points. */
+		splines = (tsBSpline *) malloc(num_splines * sizeof(tsBSpline));
+		if (!splines) {
+			TS_THROW_0(try, status.code, &status, TS_MALLOC,
+			           "out of memory")
+		}
+		for (; created < num_splines; created++) {
+			TS_CALL(try, status.code, ts_bspline_new(
+			        8 + created % 32, 3, 3, TS_CLAMPED,
+			        splines + created, &status))
+			TS_CALL(try, status.code, ts_bspline_control_points(
+			        splines + created, &ctrlp, &status))
+			for (j = 0; j < (8 + created % 32) * 3; j++)
+				ctrlp[j] = next_random();
+			TS_CALL(try, status.code,
+			        ts_bspline_set_control_points(
+			        splines + created, ctrlp, &status))
+			free(ctrlp);
+			ctrlp = NULL;
+		}
+
+		printf("splines: %lu\n\n", (unsigned long) num_splines);
+		printf("format      size [MB]   write [MB/s]    read [MB/s]\n");
+		for (f = 0; f < 2; f++) {
+			start = clock();
+			TS_CALL(try, status.code, ts_bspline_save_all(
+			        splines, num_splines, FILE_STREAM, formats[f],
+			        &status))
+			t_write = seconds(start, clock());
+			size = file_size(FILE_STREAM);
+
+			start = clock();
+			TS_CALL(try, status.code, ts_json_stream_open(
+			        FILE_STREAM, &stream, &status))
+			TS_CALL(try, status.code, read_stream(
+			        &stream, &num, &status))
+			ts_json_stream_close(&stream);
+			t_read = seconds(start, clock());
+			if (num != num_splines) {
+				TS_THROW_0(try, status.code, &status,
+				           TS_PARSE_ERROR,
+				           "unexpected number of splines")
+			}
+			printf("%-6s %14.1f %14.1f %14.1f\n", names[f],
+			       (double) size / 1e6,
+			       (double) size / 1e6 / t_write,
+			       (double) size / 1e6 / t_read);
+		}
+
+		/* The last file is newline-delimited. */
+		total = 0;
+		t_max = t_read = 0;
+		for (i = 0; i < num_ranges; i++) {
+			start = clock();
+			TS_CALL(try, status.code, ts_json_stream_open_range(
+			        FILE_STREAM, size * i / num_ranges,
+			        size * (i + 1) / num_ranges, &stream,
+			        &status))
+			TS_CALL(try, status.code, read_stream(
+			        &stream, &num, &status))
+			ts_json_stream_close(&stream);
+			t_range = seconds(start, clock());
+			t_read += t_range;
+			t_max = t_range > t_max ? t_range : t_max;
+			total += num;
+		}
+		if (total != num_splines) {
+			TS_THROW_0(try, status.code, &status, TS_PARSE_ERROR,
+			           "ranges are not disjoint")
+		}
+		printf("\nranges: %lu, slowest range: %.0f%% of total, "
+		       "speedup bound: %.1fx\n", (unsigned long) num_ranges,
+		       t_max / t_read * 100.0, t_read / t_max);
+
+		/* One file per spline. */
+		for (; num_files < NUM_FILES; num_files++) {
+			sprintf(path, FILE_SINGLE, (unsigned long) num_files);
+			TS_CALL(try, status.code, ts_bspline_save(
+			        splines + num_files % num_splines, path,
+			        &status))
+		}
+		start = clock();
+		for (i = 0; i < NUM_FILES; i++) {
+			sprintf(path, FILE_SINGLE, (unsigned long) i);
+			TS_CALL(try, status.code, ts_bspline_load(
+			        path, &spline, &status))
+			ts_bspline_free(&spline);
+		}
+		t_read = seconds(start, clock()) / (double) NUM_FILES;
+		start = clock();
+		TS_CALL(try, status.code, ts_json_stream_open(
+		        FILE_STREAM, &stream, &status))
+		TS_CALL(try, status.code, read_stream(&stream, &num, &status))
+		ts_json_stream_close(&stream);
+		t_range = seconds(start, clock()) / (double) num;
+		printf("\nload, one file per spline [us/spline]: %.1f\n",
+		       t_read * 1e6);
+		printf("load, one stream [us/spline]:         %.1f\n",
+		       t_range * 1e6);
+	TS_CATCH(status.code)
+		fprintf(stderr, "%s\n", status.message);
+	TS_FINALLY
+		ts_json_stream_writer_close(&writer, NULL);
+		ts_json_stream_close(&stream);
+		ts_bspline_free(&spline);
+		for (i = 0; i < created; i++)
+			ts_bspline_free(splines + i);
+		free(splines);
+		free(ctrlp);
+		remove(FILE_STREAM);
+		for (i = 0; i < num_files; i++) {
+			sprintf(path, FILE_SINGLE, (unsigned long) i);
+			remove(path);
+		}
+	TS_END_TRY
+	return status.code ? EXIT_FAILURE : EXIT_SUCCESS;
+}
@@ -0,0 +1,144 @@
+/*
+ * Measures how evaluation and chord length computation scale with the number
+ * of knots of a spline. Evaluating a spline at an arbitrary knot requires a
+ * binary search (O(log n)), evaluating a sorted sequence of knots reuses the
+ * span of the previous evaluation (O(1) per knot), and computing the chord
+ * lengths of n knots is O(n).
+ *
+ * Usage: tinyspline_bench_large_spline [max_num_control_points]
+ *
+ * By default, splines with 1e3 to 1e7 control points are measured (1e3 to 1e6
+ * with single precision, which cannot keep the knots of larger splines
+ * apart; see TS_MAX_NUM_KNOTS).
+ */
+#include "tinyspline.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+
+#define NUM_QUERIES 1000000
+
+static unsigned long lcg_state = 42;
+
+static tsReal next_random(void)
+{
+	lcg_state = lcg_state * 1103515245UL + 12345UL;
+	return (tsReal) ((lcg_state >> 8) & 0xFFFFFF) / (tsReal) 0xFFFFFF;
+}
+
+static double ns_per_op(clock_t start, clock_t end, size_t ops)
+{
+	return (double) (end - start) / CLOCKS_PER_SEC * 1e9 / (double) ops;
+}
+
+static int run(size_t num_ctrlp)
+{
+	tsBSpline spline = ts_bspline_init();
+	tsDeBoorNet net = ts_deboornet_init();
+	tsEvalContext ctx = ts_eval_context_init();
+	tsReal *ctrlp = NULL, *knots = NULL, *lengths = NULL;
+	tsReal min, max, point[2];
+	size_t i;
+	clock_t start;
+	double t_eval, t_ctx_random, t_ctx_seq, t_chord;
+	tsStatus status;
+
+	TS_TRY(try, status.code, &status)
+		TS_CALL(try, status.code, ts_bspline_new(
+		        num_ctrlp, 2, 3, TS_CLAMPED, &spline, &status))
+		TS_CALL(try, status.code, ts_bspline_control_points(
+		        &spline, &ctrlp, &status))
+		for (i = 0; i < num_ctrlp; i++) {
+			ctrlp[i * 2]     = (tsReal) i;
+			ctrlp[i * 2 + 1] = next_random();
+		}
+		TS_CALL(try, status.code, ts_bspline_set_control_points(
+		        &spline, ctrlp, &status))
+		ts_bspline_domain(&spline, &min, &max);
+
+		knots = (tsReal *) malloc(NUM_QUERIES * sizeof(tsReal));
+		lengths = (tsReal *) malloc(num_ctrlp * sizeof(tsReal));
+		if (!knots || !lengths) {
+			TS_THROW_0(try, status.code, &status, TS_MALLOC,
+			           "out of memory")
+		}
+
+		/* ts_bspline_eval: random knots, new net per call. */
+		for (i = 0; i < NUM_QUERIES; i++)
+			knots[i] = min + (max - min) * next_random();
+		start = clock();
+		for (i = 0; i < NUM_QUERIES; i++) {
+			TS_CALL(try, status.code, ts_bspline_eval(
+			        &spline, knots[i], &net, &status))
+			ts_deboornet_free(&net);
+		}
+		t_eval = ns_per_op(start, clock(), NUM_QUERIES);
+
+		/* ts_eval_context_eval: random knots. */
+		start = clock();
+		for (i = 0; i < NUM_QUERIES; i++) {
+			TS_CALL(try, status.code, ts_eval_context_eval(
+			        &ctx, &spline, knots[i], point, &status))
+		}
+		t_ctx_random = ns_per_op(start, clock(), NUM_QUERIES);
+
+		/* ts_eval_context_eval: sorted knots. */
+		for (i = 0; i < NUM_QUERIES; i++) {
+			knots[i] = min + (max - min) *
+			           ((tsReal) i / (NUM_QUERIES - 1));
+		}
+		start = clock();
+		for (i = 0; i < NUM_QUERIES; i++) {
+			TS_CALL(try, status.code, ts_eval_context_eval(
+			        &ctx, &spline, knots[i], point, &status))
+		}
+		t_ctx_seq = ns_per_op(start, clock(), NUM_QUERIES);
+
+		/* ts_bspline_chord_lengths: one knot per control point. */
+		free(knots);
+		knots = (tsReal *) malloc(num_ctrlp * sizeof(tsReal));
+		if (!knots) {
+			TS_THROW_0(try, status.code, &status, TS_MALLOC,
+			           "out of memory")
+		}
+		ts_bspline_uniform_knot_seq(&spline, num_ctrlp, knots);
+		start = clock();
+		TS_CALL(try, status.code, ts_bspline_chord_lengths(
+		        &spline, knots, num_ctrlp, lengths, &status))
+		t_chord = ns_per_op(start, clock(), num_ctrlp);
+
+		printf("%12lu %12lu %14.1f %14.1f %14.1f %14.1f\n",
+		       (unsigned long) num_ctrlp,
+		       (unsigned long) ts_bspline_num_knots(&spline),
+		       t_eval, t_ctx_random, t_ctx_seq, t_chord);
+	TS_CATCH(status.code)
+		fprintf(stderr, "%s\n", status.message);
+	TS_FINALLY
+		ts_bspline_free(&spline);
+		ts_deboornet_free(&net);
+		ts_eval_context_free(&ctx);
+		free(ctrlp);
+		free(knots);
+		free(lengths);
+	TS_END_TRY
+	return status.code;
+}
+
+int main(int argc, char **argv)
+{
+	size_t max_num_ctrlp = sizeof(tsReal) == sizeof(float)
+		? 1000000 : 10000000;
+	size_t n;
+	if (argc > 1)
+		max_num_ctrlp = (size_t) strtoul(argv[1], NULL, 10);
+
+	printf("%12s %12s %14s %14s %14s %14s\n",
+	       "ctrlp", "knots", "eval [ns]", "ctx rand [ns]",
+	       "ctx seq [ns]", "chord [ns/kn]");
+	for (n = 1000; n <= max_num_ctrlp; n *= 10) {
+		if (run(n))
+			return EXIT_FAILURE;
+	}
+	return EXIT_SUCCESS;
+}
@@ -0,0 +1,80 @@
+/*
+ * Samples many small curves per frame, as an interactive editor would, and
+ * compares BSpline.sample (which copies the points into a new JavaScript
+ * array) with EvalBuffer.sample (which returns a typed array view into wasm
+ * memory). Runs headless in Node. Configure with -DTINYSPLINE_WASM_SIMD=ON to
+ * measure the WebAssembly SIMD build.
+ *
+ * Usage: node sample.js path/to/tinyspline.js [num_curves] [num_samples]
+ *                                             [num_frames]
+ */
+'use strict';
+
+const path = require('path');
+
+if (process.argv.length < 3) {
+	console.error('usage: node sample.js path/to/tinyspline.js ' +
+	              '[num_curves] [num_samples] [num_frames]');
+	process.exit(1);
+}
+const ts = require(path.resolve(process.argv[2]));
+const numCurves = parseInt(process.argv[3] || '2000', 10);
+const numSamples = parseInt(process.argv[4] || '64', 10);
+const numFrames = parseInt(process.argv[5] || '60', 10);
+
+let lcgState = 42;
+function nextRandom() {
+	lcgState = (Math.imul(lcgState, 1103515245) + 12345) >>> 0;
+	return ((lcgState >>> 8) & 0xFFFFFF) / 0xFFFFFF;
+}
+
+/* Runs `frame' `numFrames' times and returns the mean ms per frame. */
+function measure(frame) {
+	frame(); /* warm up */
+	const start = process.hrtime.bigint();
+	for (let f = 0; f < numFrames; f++)
+		frame();
+	return Number(process.hrtime.bigint() - start) / 1e6 / numFrames;
+}
+
+function run() {
+	const splines = [];
+	for (let i = 0; i < numCurves; i++) {
+		const spline = new ts.BSpline(8, 2, 3);
+		const ctrlp = [];
+		for (let j = 0; j < 16; j++)
+			ctrlp.push(nextRandom() * 800);
+		spline.controlPoints = ctrlp;
+		splines.push(spline);
+	}
+	const buffer = new ts.EvalBuffer();
+
+	/* Consume the points so that nothing is optimized away. */
+	let sum = 0;
+	const tArray = measure(() => {
+		for (const spline of splines) {
+			const points = spline.sample(numSamples);
+			sum += points[points.length - 1];
+		}
+	});
+	const tView = measure(() => {
+		for (const spline of splines) {
+			const points = buffer.sample(spline, numSamples);
+			sum += points[points.length - 1];
+		}
+	});
+
+	console.log(`curves: ${numCurves}, samples: ${numSamples}, ` +
+	            `frames: ${numFrames}`);
+	console.log(`sample (array) [ms/frame]:      ${tArray.toFixed(2)}`);
+	console.log(`EvalBuffer (view) [ms/frame]:   ${tView.toFixed(2)}`);
+	console.log(`speedup: ${(tArray / tView).toFixed(1)}x (checksum ` +
+	            `${sum.toFixed(0)})`);
+
+	buffer.delete();
+	for (const spline of splines)
+		spline.delete();
+}
+
+if (ts.calledRun) run();
+else ts.onRuntimeInitialized = run;
@@ -0,0 +1,121 @@
+/*
+ * Compares the size of quantized splines (8, 16, and 32 bits) with the size
+ * of the binary format and reports the maximum error introduced by
+ * quantization. Also measures the throughput of encoding and of decoding
+ * (into a new spline and into a reused buffer). Throughput is given in MB of
+ * (unquantized) control points and knots per second. Note that large splines
+ * cannot be quantized with 8 bits because their knots are merged.
+ *
+ * Usage: tinyspline_bench_quantized [num_control_points]
+ */
+#include "tinyspline.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+
+static unsigned long lcg_state = 42;
+
+static tsReal next_random(void)
+{
+	lcg_state = lcg_state * 1103515245UL + 12345UL;
+	return (tsReal) ((lcg_state >> 8) & 0xFFFFFF) / (tsReal) 0xFFFFFF;
+}
+
+static double mb_per_s(clock_t start, clock_t end, size_t bytes)
+{
+	double secs = (double) (end - start) / CLOCKS_PER_SEC;
+	if (secs <= 0.0) secs = 1.0 / CLOCKS_PER_SEC;
+	return (double) bytes / (1024.0 * 1024.0) / secs;
+}
+
+int main(int argc, char **argv)
+{
+	tsBSpline spline = ts_bspline_init();
+	tsBSpline parsed = ts_bspline_init();
+	tsBSplineView view;
+	tsReal *ctrlp = NULL, *buffer = NULL, max_error;
+	unsigned char *data = NULL;
+	size_t num_ctrlp = 10000, payload, size, size_binary, len, i;
+	const size_t bits[3] = { 8, 16, 32 };
+	clock_t start;
+	double t_to, t_from, t_dequantize;
+	tsStatus status;
+
+	if (argc > 1)
+		num_ctrlp = (size_t) strtoul(argv[1], NULL, 10);
+	if (num_ctrlp < 4)
+		return EXIT_FAILURE;
+
+	TS_TRY(try, status.code, &status)
+		TS_CALL(try, status.code, ts_bspline_new(
+		        num_ctrlp, 3, 3, TS_CLAMPED, &spline, &status))
+		TS_CALL(try, status.code, ts_bspline_control_points(
+		        &spline, &ctrlp, &status))
+		for (i = 0; i < num_ctrlp * 3; i++)
+			ctrlp[i] = next_random() * 1000;
+		TS_CALL(try, status.code, ts_bspline_set_control_points(
+		        &spline, ctrlp, &status))
+		payload = ts_bspline_sof_control_points(&spline) +
+		          ts_bspline_sof_knots(&spline);
+		/* Binary format with double precision. */
+		size_binary = TS_BINARY_HEADER_SIZE + 8 *
+			(ts_bspline_len_control_points(&spline) +
+			 ts_bspline_num_knots(&spline));
+
+		printf("ctrlp: %lu, binary (double) [B]: %lu\n\n",
+		       (unsigned long) num_ctrlp,
+		       (unsigned long) size_binary);
+		printf("%4s %12s %7s %12s %9s %9s %11s\n", "bits", "size [B]",
+		       "ratio", "max error", "to", "from", "dequantize");
+		for (i = 0; i < 3; i++) {
+			start = clock();
+			status.code = ts_bspline_to_quantized(&spline, bits[i],
+				&data, &size, &max_error, &status);
+			t_to = mb_per_s(start, clock(), payload);
+			/* Too many knots for the number of bits. */
+			if (status.code == TS_MULTIPLICITY) {
+				printf("%4lu %s\n", (unsigned long) bits[i],
+				       status.message);
+				continue;
+			}
+			TS_CALL(try, status.code, status.code)
+			start = clock();
+			TS_CALL(try, status.code, ts_bspline_from_binary(
+			        data, size, &parsed, &status))
+			t_from = mb_per_s(start, clock(), payload);
+			ts_bspline_free(&parsed);
+			TS_CALL(try, status.code, ts_bspline_dequantized_len(
+			        data, size, &len, &status))
+			buffer = (tsReal *) malloc(len * sizeof(tsReal));
+			if (!buffer) {
+				TS_THROW_0(try, status.code, &status,
+				           TS_MALLOC, "out of memory")
+			}
+			start = clock();
+			TS_CALL(try, status.code, ts_bspline_dequantize(
+			        data, size, buffer, len, &view, &status))
+			t_dequantize = mb_per_s(start, clock(), payload);
+
+			printf("%4lu %12lu %6.2fx %12.3g %9.1f %9.1f %11.1f\n",
+			       (unsigned long) bits[i], (unsigned long) size,
+			       (double) size_binary / (double) size,
+			       (double) max_error, t_to, t_from,
+			       t_dequantize);
+			free(data);
+			data = NULL;
+			free(buffer);
+			buffer = NULL;
+		}
+		printf("\n%45s\n", "[MB/s]");
+	TS_CATCH(status.code)
+		fprintf(stderr, "%s\n", status.message);
+	TS_FINALLY
+		ts_bspline_free(&spline);
+		ts_bspline_free(&parsed);
+		free(ctrlp);
+		free(data);
+		free(buffer);
+	TS_END_TRY
+	return status.code ? EXIT_FAILURE : EXIT_SUCCESS;
+}
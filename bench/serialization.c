@@ -0,0 +1,134 @@
+/*
+ * Compares the throughput of the JSON and the binary serialization format.
+ * Each format is measured in memory (to/parse) and through the file system
+ * (save/load). Throughput is given in MB of control points and knots per
+ * second so that both formats are comparable.
+ *
+ * Usage: tinyspline_bench_serialization [max_num_control_points]
+ */
+#include "tinyspline.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#define FILE_JSON "tinyspline_bench_serialization.json"
+#define FILE_BINARY "tinyspline_bench_serialization.bin"
+
+static unsigned long lcg_state = 42;
+
+static tsReal next_random(void)
+{
+	lcg_state = lcg_state * 1103515245UL + 12345UL;
+	return (tsReal) ((lcg_state >> 8) & 0xFFFFFF) / (tsReal) 0xFFFFFF;
+}
+
+static double mb_per_s(clock_t start, clock_t end, size_t bytes)
+{
+	double secs = (double) (end - start) / CLOCKS_PER_SEC;
+	if (secs <= 0.0) secs = 1.0 / CLOCKS_PER_SEC;
+	return (double) bytes / (1024.0 * 1024.0) / secs;
+}
+
+static int run(size_t num_ctrlp)
+{
+	tsBSpline spline = ts_bspline_init();
+	tsBSpline parsed = ts_bspline_init();
+	tsReal *ctrlp = NULL;
+	char *json = NULL;
+	unsigned char *binary = NULL;
+	size_t i, payload, size_binary;
+	clock_t start;
+	double t_to_json, t_parse_json, t_save_json, t_load_json;
+	double t_to_bin, t_from_bin, t_save_bin, t_load_bin;
+	tsStatus status;
+
+	TS_TRY(try, status.code, &status)
+		TS_CALL(try, status.code, ts_bspline_new(
+		        num_ctrlp, 3, 3, TS_CLAMPED, &spline, &status))
+		TS_CALL(try, status.code, ts_bspline_control_points(
+		        &spline, &ctrlp, &status))
+		for (i = 0; i < num_ctrlp * 3; i++)
+			ctrlp[i] = next_random() * 1000;
+		TS_CALL(try, status.code, ts_bspline_set_control_points(
+		        &spline, ctrlp, &status))
+		payload = ts_bspline_sof_control_points(&spline) +
+		          ts_bspline_sof_knots(&spline);
+
+		start = clock();
+		TS_CALL(try, status.code, ts_bspline_to_json(
+		        &spline, &json, &status))
+		t_to_json = mb_per_s(start, clock(), payload);
+		start = clock();
+		TS_CALL(try, status.code, ts_bspline_parse_json(
+		        json, &parsed, &status))
+		t_parse_json = mb_per_s(start, clock(), payload);
+		ts_bspline_free(&parsed);
+		start = clock();
+		TS_CALL(try, status.code, ts_bspline_save(
+		        &spline, FILE_JSON, &status))
+		t_save_json = mb_per_s(start, clock(), payload);
+		start = clock();
+		TS_CALL(try, status.code, ts_bspline_load(
+		        FILE_JSON, &parsed, &status))
+		t_load_json = mb_per_s(start, clock(), payload);
+		ts_bspline_free(&parsed);
+
+		start = clock();
+		TS_CALL(try, status.code, ts_bspline_to_binary(
+		        &spline, &binary, &size_binary, &status))
+		t_to_bin = mb_per_s(start, clock(), payload);
+		start = clock();
+		TS_CALL(try, status.code, ts_bspline_from_binary(
+		        binary, size_binary, &parsed, &status))
+		t_from_bin = mb_per_s(start, clock(), payload);
+		ts_bspline_free(&parsed);
+		start = clock();
+		TS_CALL(try, status.code, ts_bspline_save_binary(
+		        &spline, FILE_BINARY, &status))
+		t_save_bin = mb_per_s(start, clock(), payload);
+		start = clock();
+		TS_CALL(try, status.code, ts_bspline_load_binary(
+		        FILE_BINARY, &parsed, &status))
+		t_load_bin = mb_per_s(start, clock(), payload);
+
+		printf("%10lu %10lu %10lu %9.1f %9.1f %9.1f %9.1f "
+		       "%9.1f %9.1f %9.1f %9.1f\n",
+		       (unsigned long) num_ctrlp,
+		       (unsigned long) strlen(json),
+		       (unsigned long) size_binary,
+		       t_to_json, t_parse_json, t_save_json, t_load_json,
+		       t_to_bin, t_from_bin, t_save_bin, t_load_bin);
+	TS_CATCH(status.code)
+		fprintf(stderr, "%s\n", status.message);
+	TS_FINALLY
+		ts_bspline_free(&spline);
+		ts_bspline_free(&parsed);
+		free(ctrlp);
+		free(json);
+		free(binary);
+		remove(FILE_JSON);
+		remove(FILE_BINARY);
+	TS_END_TRY
+	return status.code;
+}
+
+int main(int argc, char **argv)
+{
+	size_t max_num_ctrlp = 1000000, n;
+	if (argc > 1)
+		max_num_ctrlp = (size_t) strtoul(argv[1], NULL, 10);
+
+	printf("%10s %10s %10s %9s %9s %9s %9s %9s %9s %9s %9s\n",
+	       "ctrlp", "json [B]", "bin [B]",
+	       "to json", "parse", "save", "load",
+	       "to bin", "from bin", "save bin", "load bin");
+	printf("%32s %39s %39s\n", "",
+	       "JSON [MB/s]", "binary [MB/s]");
+	for (n = 1000; n <= max_num_ctrlp; n *= 10) {
+		if (run(n))
+			return EXIT_FAILURE;
+	}
+	return EXIT_SUCCESS;
+}
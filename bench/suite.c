@@ -0,0 +1,498 @@
+/*
+ * Measures the hot functions of the library across degrees, dimensions and
+ * numbers of control points and prints the results as JSON, so that they can
+ * be stored and compared between revisions. Each benchmark is repeated
+ * (doubling the number of iterations) until it has run for at least
+ * `min_time' seconds. Functions whose work depends on the number of processed
+ * items (knots, points, etc.) additionally report their throughput in
+ * items/s. JSON is serialized and parsed in memory (ts_bspline_to_json and
+ * ts_bspline_parse_json) in order to not measure the file system.
+ *
+ * Usage: tinyspline_bench [min_time] [filter] > results.json
+ *
+ * If `filter' is given, only benchmarks whose name contains `filter' are run.
+ */
+#include "tinyspline.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#define NUM_KNOTS 1000
+#define NUM_RANDOM 1024
+
+static unsigned long lcg_state = 42;
+
+static tsReal next_random(void)
+{
+	lcg_state = lcg_state * 1103515245UL + 12345UL;
+	return (tsReal) ((lcg_state >> 8) & 0xFFFFFF) / (tsReal) 0xFFFFFF;
+}
+
+struct fixture {
+	size_t deg, dim, num;
+	tsBSpline spline;  /* control points sorted at component 0 */
+	tsBSpline other;   /* lower degree, fewer control points */
+	tsReal *knots;     /* NUM_KNOTS sorted knots */
+	tsReal *random;    /* NUM_RANDOM random knots */
+	tsReal *points;    /* `num' points to interpolate */
+	tsReal *lengths;   /* NUM_KNOTS chord lengths */
+	tsFrame *frames;   /* NUM_KNOTS frames */
+	char *json;
+	tsReal middle;     /* near the center of the domain */
+	size_t next;       /* next index in `random' */
+};
+
+/* Runs the measured function once and stores the number of items processed
+ * in `items'. */
+typedef tsError (*bench_fn)(struct fixture *,
+                            size_t *,
+                            tsStatus *);
+
+static tsError bench_eval(struct fixture *f, size_t *items, tsStatus *status)
+{
+	tsDeBoorNet net = ts_deboornet_init();
+	tsError err;
+	f->next = (f->next + 1) % NUM_RANDOM;
+	err = ts_bspline_eval(&f->spline, f->random[f->next], &net, status);
+	ts_deboornet_free(&net);
+	*items = 1;
+	return err;
+}
+
+static tsError bench_eval_all(struct fixture *f,
+                              size_t *items,
+                              tsStatus *status)
+{
+	tsReal *points = NULL;
+	tsError err;
+	err = ts_bspline_eval_all(&f->spline, f->knots, NUM_KNOTS, &points,
+	                          status);
+	free(points);
+	*items = NUM_KNOTS;
+	return err;
+}
+
+static tsError bench_sample(struct fixture *f,
+                            size_t *items,
+                            tsStatus *status)
+{
+	tsReal *points = NULL;
+	tsError err;
+	err = ts_bspline_sample(&f->spline, NUM_KNOTS, &points, items,
+	                        status);
+	free(points);
+	return err;
+}
+
+static tsError bench_bisect(struct fixture *f,
+                            size_t *items,
+                            tsStatus *status)
+{
+	tsDeBoorNet net = ts_deboornet_init();
+	tsError err;
+	err = ts_bspline_bisect(&f->spline, (tsReal) f->num / 2,
+	                        (tsReal) 0.0, 0, 0, 1, 50, &net, status);
+	ts_deboornet_free(&net);
+	*items = 1;
+	return err;
+}
+
+static tsError bench_chord_lengths(struct fixture *f,
+                                   size_t *items,
+                                   tsStatus *status)
+{
+	*items = NUM_KNOTS;
+	return ts_bspline_chord_lengths(&f->spline, f->knots, NUM_KNOTS,
+	                                f->lengths, status);
+}
+
+static tsError bench_compute_rmf(struct fixture *f,
+                                 size_t *items,
+                                 tsStatus *status)
+{
+	*items = NUM_KNOTS;
+	return ts_bspline_compute_rmf(&f->spline, f->knots, NUM_KNOTS, 0,
+	                              f->frames, status);
+}
+
+static tsError bench_insert_knot(struct fixture *f,
+                                 size_t *items,
+                                 tsStatus *status)
+{
+	tsBSpline result = ts_bspline_init();
+	size_t k;
+	tsError err;
+	err = ts_bspline_insert_knot(&f->spline, f->middle, 1, &result, &k,
+	                             status);
+	ts_bspline_free(&result);
+	*items = 1;
+	return err;
+}
+
+static tsError bench_to_beziers(struct fixture *f,
+                                size_t *items,
+                                tsStatus *status)
+{
+	tsBSpline beziers = ts_bspline_init();
+	tsError err;
+	err = ts_bspline_to_beziers(&f->spline, &beziers, status);
+	ts_bspline_free(&beziers);
+	*items = f->num;
+	return err;
+}
+
+static tsError bench_elevate_degree(struct fixture *f,
+                                    size_t *items,
+                                    tsStatus *status)
+{
+	tsBSpline elevated = ts_bspline_init();
+	tsError err;
+	err = ts_bspline_elevate_degree(&f->spline, 1, TS_POINT_EPSILON,
+	                                &elevated, status);
+	ts_bspline_free(&elevated);
+	*items = f->num;
+	return err;
+}
+
+static tsError bench_elevate_degree_direct(struct fixture *f,
+                                           size_t *items,
+                                           tsStatus *status)
+{
+	tsBSpline elevated = ts_bspline_init();
+	tsError err;
+	err = ts_bspline_elevate_degree_direct(&f->spline, 1, &elevated,
+	                                       status);
+	ts_bspline_free(&elevated);
+	*items = f->num;
+	return err;
+}
+
+static tsError bench_reduce_degree(struct fixture *f,
+                                   size_t *items,
+                                   tsStatus *status)
+{
+	tsBSpline reduced = ts_bspline_init();
+	tsError err;
+	/* A tolerance large enough for random control points. */
+	err = ts_bspline_reduce_degree(&f->spline, 1, (tsReal) 1e4, &reduced,
+	                               NULL, status);
+	ts_bspline_free(&reduced);
+	*items = f->num;
+	return err;
+}
+
+static tsError bench_align(struct fixture *f,
+                           size_t *items,
+                           tsStatus *status)
+{
+	tsBSpline s1 = ts_bspline_init(), s2 = ts_bspline_init();
+	tsError err;
+	err = ts_bspline_align(&f->spline, &f->other, TS_POINT_EPSILON,
+	                       &s1, &s2, status);
+	ts_bspline_free(&s1);
+	ts_bspline_free(&s2);
+	*items = f->num;
+	return err;
+}
+
+static tsError bench_morph(struct fixture *f,
+                           size_t *items,
+                           tsStatus *status)
+{
+	tsBSpline out = ts_bspline_init();
+	tsError err;
+	err = ts_bspline_morph(&f->spline, &f->other, (tsReal) 0.5,
+	                       TS_POINT_EPSILON, &out, status);
+	ts_bspline_free(&out);
+	*items = f->num;
+	return err;
+}
+
+static tsError bench_cubic_natural(struct fixture *f,
+                                   size_t *items,
+                                   tsStatus *status)
+{
+	tsBSpline spline = ts_bspline_init();
+	tsError err;
+	err = ts_bspline_interpolate_cubic_natural(f->points, f->num, f->dim,
+	                                           &spline, status);
+	ts_bspline_free(&spline);
+	*items = f->num;
+	return err;
+}
+
+static tsError bench_catmull_rom(struct fixture *f,
+                                 size_t *items,
+                                 tsStatus *status)
+{
+	tsBSpline spline = ts_bspline_init();
+	tsError err;
+	err = ts_bspline_interpolate_catmull_rom(f->points, f->num, f->dim,
+	                                         (tsReal) 0.5, NULL, NULL,
+	                                         TS_POINT_EPSILON, &spline,
+	                                         status);
+	ts_bspline_free(&spline);
+	*items = f->num;
+	return err;
+}
+
+static tsError bench_to_json(struct fixture *f,
+                             size_t *items,
+                             tsStatus *status)
+{
+	char *json = NULL;
+	tsError err;
+	err = ts_bspline_to_json(&f->spline, &json, status);
+	free(json);
+	*items = f->num;
+	return err;
+}
+
+static tsError bench_parse_json(struct fixture *f,
+                                size_t *items,
+                                tsStatus *status)
+{
+	tsBSpline spline = ts_bspline_init();
+	tsError err;
+	err = ts_bspline_parse_json(f->json, &spline, status);
+	ts_bspline_free(&spline);
+	*items = f->num;
+	return err;
+}
+
+struct benchmark {
+	const char *name;
+	bench_fn fn;
+	/* The interpolation functions always create cubic splines, so
+	 * varying the degree does not make sense. */
+	int cubic_only;
+	/* ts_bspline_align inserts knots with a linear search whose step
+	 * size is based on TS_KNOT_EPSILON, which fails if too many knots
+	 * are missing. 0 means no limit. */
+	size_t max_num;
+};
+
+static const struct benchmark BENCHMARKS[] = {
+	{ "eval",                      bench_eval,                   0,   0 },
+	{ "eval_all",                  bench_eval_all,               0,   0 },
+	{ "sample",                    bench_sample,                 0,   0 },
+	{ "bisect",                    bench_bisect,                 0,   0 },
+	{ "chord_lengths",             bench_chord_lengths,          0,   0 },
+	{ "compute_rmf",               bench_compute_rmf,            0,   0 },
+	{ "insert_knot",               bench_insert_knot,            0,   0 },
+	{ "to_beziers",                bench_to_beziers,             0,   0 },
+	{ "elevate_degree",            bench_elevate_degree,         0,   0 },
+	{ "elevate_degree_direct",     bench_elevate_degree_direct,  0,   0 },
+	{ "reduce_degree",             bench_reduce_degree,          0,   0 },
+	{ "align",                     bench_align,                  0, 256 },
+	{ "morph",                     bench_morph,                  0, 256 },
+	{ "interpolate_cubic_natural", bench_cubic_natural,          1,   0 },
+	{ "interpolate_catmull_rom",   bench_catmull_rom,            1,   0 },
+	{ "to_json",                   bench_to_json,                0,   0 },
+	{ "parse_json",                bench_parse_json,             0,   0 }
+};
+
+#define NUM_ELEMS(array) (sizeof(array) / sizeof(array[0]))
+#define NUM_BENCHMARKS NUM_ELEMS(BENCHMARKS)
+
+static const size_t DEGREES[] = { 1, 3, 5 };
+static const size_t DIMENSIONS[] = { 2, 3 };
+static const size_t SIZES[] = { 16, 256, 4096 };
+
+static void fixture_free(struct fixture *f)
+{
+	ts_bspline_free(&f->spline);
+	ts_bspline_free(&f->other);
+	free(f->knots);
+	free(f->random);
+	free(f->points);
+	free(f->lengths);
+	free(f->frames);
+	free(f->json);
+}
+
+static tsError new_random_spline(size_t num,
+                                 size_t dim,
+                                 size_t deg,
+                                 tsBSpline *spline,
+                                 tsStatus *status)
+{
+	tsReal *ctrlp = NULL;
+	size_t i, j;
+	tsError err;
+	TS_TRY(try, err, status)
+		TS_CALL(try, err, ts_bspline_new(num, dim, deg, TS_CLAMPED,
+		        spline, status))
+		TS_CALL(try, err, ts_bspline_control_points(
+		        spline, &ctrlp, status))
+		for (i = 0; i < num; i++) {
+			/* Sorted for ts_bspline_bisect. */
+			ctrlp[i * dim] = (tsReal) i;
+			for (j = 1; j < dim; j++)
+				ctrlp[i * dim + j] = next_random() * 100;
+		}
+		TS_CALL(try, err, ts_bspline_set_control_points(
+		        spline, ctrlp, status))
+	TS_FINALLY
+		free(ctrlp);
+	TS_END_TRY_RETURN(err)
+}
+
+static tsError fixture_new(size_t deg,
+                           size_t dim,
+                           size_t num,
+                           struct fixture *f,
+                           tsStatus *status)
+{
+	tsReal min, max;
+	size_t i;
+	tsError err;
+
+	memset(f, 0, sizeof(struct fixture));
+	f->spline = ts_bspline_init();
+	f->other = ts_bspline_init();
+	f->deg = deg;
+	f->dim = dim;
+	f->num = num;
+	TS_TRY(try, err, status)
+		TS_CALL(try, err, new_random_spline(
+		        num, dim, deg, &f->spline, status))
+		TS_CALL(try, err, new_random_spline(
+		        num / 2 + deg, dim, deg > 1 ? deg - 1 : deg,
+		        &f->other, status))
+		f->knots = (tsReal *) malloc(NUM_KNOTS * sizeof(tsReal));
+		f->random = (tsReal *) malloc(NUM_RANDOM * sizeof(tsReal));
+		f->points = (tsReal *) malloc(num * dim * sizeof(tsReal));
+		f->lengths = (tsReal *) malloc(NUM_KNOTS * sizeof(tsReal));
+		f->frames = (tsFrame *) malloc(NUM_KNOTS * sizeof(tsFrame));
+		if (!f->knots || !f->random || !f->points || !f->lengths ||
+		    !f->frames) {
+			TS_THROW_0(try, err, status, TS_MALLOC,
+			           "out of memory")
+		}
+		ts_bspline_domain(&f->spline, &min, &max);
+		ts_bspline_uniform_knot_seq(&f->spline, NUM_KNOTS, f->knots);
+		for (i = 0; i < NUM_RANDOM; i++)
+			f->random[i] = min + (max - min) * next_random();
+		for (i = 0; i < num * dim; i++)
+			f->points[i] = next_random() * 100;
+		/* A third of a knot span away from the center, which never
+		 * coincides with an existing knot. */
+		f->middle = (min + max) / 2 + (max - min) / (3 * (num - deg));
+		TS_CALL(try, err, ts_bspline_to_json(
+		        &f->spline, &f->json, status))
+	TS_CATCH(err)
+		fixture_free(f);
+	TS_END_TRY_RETURN(err)
+}
+
+/* Runs `bench' on `f' for at least `min_time' seconds and prints the result
+ * as JSON object. */
+static tsError run(const struct benchmark *bench,
+                   struct fixture *f,
+                   double min_time,
+                   int first,
+                   tsStatus *status)
+{
+	unsigned long iterations = 1, i;
+	size_t items = 0, total;
+	clock_t start;
+	double elapsed;
+	tsError err;
+
+	for (;;) {
+		total = 0;
+		start = clock();
+		for (i = 0; i < iterations; i++) {
+			TS_CALL_ROE(err, bench->fn(f, &items, status))
+			total += items;
+		}
+		elapsed = (double) (clock() - start) / CLOCKS_PER_SEC;
+		if (elapsed >= min_time)
+			break;
+		iterations *= 2;
+	}
+	printf("%s    {\"name\": \"%s\", \"degree\": %lu, \"dimension\": %lu, "
+	       "\"num_control_points\": %lu, \"iterations\": %lu, "
+	       "\"ns_per_op\": %.1f, \"items_per_op\": %lu, "
+	       "\"items_per_second\": %.6g}",
+	       first ? "" : ",\n",
+	       bench->name,
+	       (unsigned long) f->deg,
+	       (unsigned long) f->dim,
+	       (unsigned long) f->num,
+	       iterations,
+	       elapsed * 1e9 / (double) iterations,
+	       (unsigned long) items,
+	       (double) total / elapsed);
+	fflush(stdout);
+	TS_RETURN_SUCCESS(status)
+}
+
+/* Runs all benchmarks matching `filter' with one configuration. */
+static tsError run_all(size_t deg,
+                       size_t dim,
+                       size_t num,
+                       const char *filter,
+                       double min_time,
+                       int *first,
+                       tsStatus *status)
+{
+	struct fixture f;
+	size_t b;
+	tsError err;
+
+	TS_CALL_ROE(err, fixture_new(deg, dim, num, &f, status))
+	TS_TRY(try, err, status)
+		for (b = 0; b < NUM_BENCHMARKS; b++) {
+			if (filter && !strstr(BENCHMARKS[b].name, filter))
+				continue;
+			if (BENCHMARKS[b].cubic_only && deg != 3)
+				continue;
+			if (BENCHMARKS[b].max_num &&
+			    num > BENCHMARKS[b].max_num)
+				continue;
+			TS_CALL(try, err, run(BENCHMARKS + b, &f, min_time,
+			        *first, status))
+			*first = 0;
+		}
+	TS_FINALLY
+		fixture_free(&f);
+	TS_END_TRY_RETURN(err)
+}
+
+int main(int argc, char **argv)
+{
+	double min_time = 0.02;
+	const char *filter = NULL;
+	size_t deg, dim, num;
+	int first = 1;
+	tsStatus status;
+
+	if (argc > 1)
+		min_time = strtod(argv[1], NULL);
+	if (argc > 2)
+		filter = argv[2];
+	if (min_time <= 0)
+		return EXIT_FAILURE;
+
+	printf("{\n  \"min_time\": %g,\n  \"real\": \"%s\",\n"
+	       "  \"results\": [\n", min_time,
+	       sizeof(tsReal) == sizeof(float) ? "float" : "double");
+	for (num = 0; num < NUM_ELEMS(SIZES); num++) {
+		for (dim = 0; dim < NUM_ELEMS(DIMENSIONS); dim++) {
+			for (deg = 0; deg < NUM_ELEMS(DEGREES); deg++) {
+				if (!run_all(DEGREES[deg], DIMENSIONS[dim],
+				             SIZES[num], filter, min_time,
+				             &first, &status))
+					continue;
+				fprintf(stderr, "%s\n", status.message);
+				return EXIT_FAILURE;
+			}
+		}
+	}
+	printf("\n  ]\n}\n");
+	return EXIT_SUCCESS;
+}
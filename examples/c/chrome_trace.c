@@ -0,0 +1,116 @@
+/*
+ * Writes the trace events of some long-running operations in the Chrome
+ * trace-event format. Open the resulting file with chrome://tracing or
+ * https://ui.perfetto.dev to see which phases of an operation take how long.
+ * Requires TinySpline to be built with TINYSPLINE_ENABLE_TRACING.
+ *
+ * Usage: chrome_trace_c [file] [num_points]
+ */
+#include "tinyspline.h"
+#include <stdlib.h>
+#include <stdio.h>
+#include <time.h>
+
+/* ------------------------------------------------------------------------- */
+/* The adapter. Timestamps are processor time in microseconds (the only clock
+ * available in C89). All events are assigned to the same thread. Applications
+ * calling TinySpline from multiple threads need to protect `file' with a
+ * mutex and pass the id of the calling thread. */
+typedef struct
+{
+	FILE *file;
+	int num_events;
+} ChromeTrace;
+
+static void chrome_trace_event(const char *name, char phase, void *user_data)
+{
+	ChromeTrace *trace = (ChromeTrace *) user_data;
+	fprintf(trace->file, "%s\n{\"name\":\"%s\",\"ph\":\"%c\","
+	        "\"ts\":%.0f,\"pid\":1,\"tid\":1}",
+	        trace->num_events ? "," : "", name, phase,
+	        (double) clock() * 1e6 / CLOCKS_PER_SEC);
+	trace->num_events++;
+}
+
+static void chrome_trace_begin(const char *name, void *user_data)
+{
+	chrome_trace_event(name, 'B', user_data);
+}
+
+static void chrome_trace_end(const char *name, void *user_data)
+{
+	chrome_trace_event(name, 'E', user_data);
+}
+
+/* ------------------------------------------------------------------------- */
+int main(int argc, char **argv)
+{
+	const char *path = argc > 1 ? argv[1] : "trace.json";
+	size_t num_points = argc > 2 ? (size_t) strtoul(argv[2], NULL, 10)
+	                             : 200;
+	ChromeTrace trace;
+	tsTracer tracer;
+	tsStatus status;
+	tsBSpline spline, linear, morphed;
+	tsReal *points = NULL;
+	size_t i;
+
+	if (!ts_tracing_enabled()) {
+		fprintf(stderr, "TinySpline has been built without "
+		        "TINYSPLINE_ENABLE_TRACING\n");
+		return EXIT_FAILURE;
+	}
+	if (num_points < 2)
+		return EXIT_FAILURE;
+	trace.file = fopen(path, "w");
+	if (!trace.file) {
+		fprintf(stderr, "cannot open %s\n", path);
+		return EXIT_FAILURE;
+	}
+	trace.num_events = 0;
+	fputs("{\"traceEvents\":[", trace.file);
+	tracer.begin = chrome_trace_begin;
+	tracer.end = chrome_trace_end;
+	tracer.user_data = &trace;
+	ts_set_tracer(&tracer);
+
+	spline = ts_bspline_init();
+	linear = ts_bspline_init();
+	morphed = ts_bspline_init();
+	TS_TRY(try, status.code, &status)
+		points = (tsReal *) malloc(num_points * 2 * sizeof(tsReal));
+		if (!points) {
+			TS_THROW_0(try, status.code, &status, TS_MALLOC,
+			           "out of memory")
+		}
+		for (i = 0; i < num_points; i++) {
+			points[i * 2] = (tsReal) i;
+			points[i * 2 + 1] = (tsReal) (i % 7);
+		}
+		TS_CALL(try, status.code, ts_bspline_interpolate_cubic_natural(
+		        points, num_points, 2, &spline, &status))
+		TS_CALL(try, status.code, ts_bspline_new(
+		        num_points / 4 + 2, 2, 1, TS_CLAMPED, &linear,
+		        &status))
+		/* Aligns `linear' and `spline' first. */
+		TS_CALL(try, status.code, ts_bspline_morph(
+		        &linear, &spline, (tsReal) 0.5, TS_POINT_EPSILON,
+		        &morphed, &status))
+	TS_CATCH(status.code)
+		fprintf(stderr, "%s\n", status.message);
+	TS_FINALLY
+		ts_set_tracer(NULL);
+		fputs("\n]}\n", trace.file);
+		fclose(trace.file);
+		ts_bspline_free(&spline);
+		ts_bspline_free(&linear);
+		ts_bspline_free(&morphed);
+		free(points);
+	TS_END_TRY
+
+	if (status.code == TS_SUCCESS) {
+		printf("wrote %d events to %s\n", trace.num_events, path);
+		return EXIT_SUCCESS;
+	}
+	return EXIT_FAILURE;
+}
@@ -196,20 +196,42 @@
 
 // Ignore C elements and unsupported C++ features.
 %rename("$ignore", regexmatch$name="ts_") "";
+%ignore tsAllocator;
+%ignore tsArena;
 %ignore tsBSpline;
 %ignore tsBSplineType;
+%ignore tsBSplineView;
+%ignore tsBSplineSet;
+%ignore tsEvalContext;
+%ignore tsContainer;
+%ignore tsContainerWriter;
+%ignore tsJsonFormat;
+%ignore tsJsonStream;
+%ignore tsJsonStreamWriter;
 %ignore tsDeBoorNet;
 %ignore tsError;
 %ignore tsFrame;
+%ignore tsMorphism;
 %ignore tsStatus;
 %ignore tinyspline::BSpline::BSpline(BSpline &&);
 %ignore tinyspline::BSpline::operator=;
+%ignore tinyspline::BSpline::fromBinary;
+%ignore tinyspline::BSpline::toBinary;
+%ignore tinyspline::BSpline::toQuantized;
+%ignore tinyspline::BSplineView;
+%ignore tinyspline::Evaluator;
+%ignore tinyspline::Container;
+%ignore tinyspline::ContainerWriter;
+%ignore tinyspline::JsonStream;
+%ignore tinyspline::JsonStreamWriter;
 %ignore tinyspline::ChordLengths::ChordLengths(ChordLengths &&);
 %ignore tinyspline::ChordLengths::operator=;
 %ignore tinyspline::DeBoorNet::DeBoorNet(DeBoorNet &&);
 %ignore tinyspline::DeBoorNet::operator=;
 %ignore tinyspline::Domain::operator=;
 %ignore tinyspline::Frame::operator=;
+%ignore tinyspline::Morphism::Morphism(Morphism &&);
+%ignore tinyspline::Morphism::operator=;
 %ignore tinyspline::FrameSeq::FrameSeq(FrameSeq &&);
 %ignore tinyspline::FrameSeq::operator=;
 %ignore tinyspline::Vec2::operator=;
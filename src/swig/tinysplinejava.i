@@ -454,4 +454,188 @@
 	delete $1;
 }
 
+// Bulk transfer of real values without boxing. Arrays are copied with a
+// single (critical) copy. Direct buffers are read and written in place.
+%{
+	#include <climits>
+	#include <cstring>
+	#include <memory>
+
+	// Real values copied from/to a Java array.
+	struct ts_java_reals {
+		std::vector<tinyspline::real> values;
+	};
+
+	// Memory of a direct buffer (capacity in number of reals).
+	struct ts_java_buffer {
+		tinyspline::real *data;
+		size_t size;
+	};
+
+	static jdoubleArray ts_java_new_array(JNIEnv *jenv,
+	                                      const double *values,
+	                                      jsize size)
+	{
+		jdoubleArray array = jenv->NewDoubleArray(size);
+		if (array) jenv->SetDoubleArrayRegion(array, 0, size, values);
+		return array;
+	}
+
+	static jfloatArray ts_java_new_array(JNIEnv *jenv,
+	                                     const float *values,
+	                                     jsize size)
+	{
+		jfloatArray array = jenv->NewFloatArray(size);
+		if (array) jenv->SetFloatArrayRegion(array, 0, size, values);
+		return array;
+	}
+
+	// Evaluates `spline' at `num' knots and writes the results to `out'.
+	static void ts_java_eval_into(const tinyspline::BSpline &spline,
+	                              const tinyspline::real *knots,
+	                              size_t num,
+	                              ts_java_buffer *out)
+	{
+		const size_t dim = spline.dimension();
+		if (num > out->size / dim)
+			throw std::out_of_range("buffer is too small");
+		tinyspline::Evaluator evaluator(spline.degree(), dim);
+		for (size_t i = 0; i < num; i++) {
+			std::memcpy(out->data + i * dim,
+			            evaluator.eval(spline, knots[i]),
+			            dim * sizeof(tinyspline::real));
+		}
+	}
+%}
+
+#ifdef TINYSPLINE_FLOAT_PRECISION
+	%typemap(jni) ts_java_reals * "jfloatArray"
+	%typemap(jtype) ts_java_reals * "float[]"
+	%typemap(jstype) ts_java_reals * "float[]"
+	%typemap(jstype) ts_java_buffer * "java.nio.FloatBuffer"
+	%typemap(jtype) ts_java_buffer * "java.nio.FloatBuffer"
+#else
+	%typemap(jni) ts_java_reals * "jdoubleArray"
+	%typemap(jtype) ts_java_reals * "double[]"
+	%typemap(jstype) ts_java_reals * "double[]"
+	%typemap(jstype) ts_java_buffer * "java.nio.DoubleBuffer"
+	%typemap(jtype) ts_java_buffer * "java.nio.DoubleBuffer"
+#endif
+%typemap(jni) ts_java_buffer * "jobject"
+
+%typemap(javaout) ts_java_reals * {
+	return $jnicall;
+}
+%typemap(javain) ts_java_reals * "$javainput"
+%typemap(javain, pre="    if (!$javainput.isDirect())\n"
+                     "      throw new IllegalArgumentException(\"buffer is not direct\");\n"
+                     "    if ($javainput.order() != java.nio.ByteOrder.nativeOrder())\n"
+                     "      throw new IllegalArgumentException(\"buffer is not in native byte order\");")
+	ts_java_buffer * "$javainput"
+
+// Map ts_java_reals to a new array.
+%typemap(out) ts_java_reals * {
+	if ($1->values.size() > (size_t) INT_MAX) {
+		delete $1;
+		SWIG_JavaThrowException(jenv, SWIG_JavaIndexOutOfBoundsException,
+		                        "too many values for an array");
+		return $null;
+	}
+	$result = ts_java_new_array(jenv, $1->values.data(),
+	                            (jsize) $1->values.size());
+	delete $1;
+}
+
+// Map array to ts_java_reals.
+%typemap(in) ts_java_reals * {
+	if (!$input) {
+		SWIG_JavaThrowException(jenv, SWIG_JavaNullPointerException,
+		                        "array is null");
+		return $null;
+	}
+	$1 = new ts_java_reals();
+	$1->values.resize((size_t) jenv->GetArrayLength($input));
+	if (!$1->values.empty()) {
+		void *elements = jenv->GetPrimitiveArrayCritical($input, NULL);
+		if (!elements) {
+			delete $1;
+			return $null; // OutOfMemoryError is pending
+		}
+		std::memcpy($1->values.data(), elements,
+		            $1->values.size() * sizeof(tinyspline::real));
+		jenv->ReleasePrimitiveArrayCritical($input, elements, JNI_ABORT);
+	}
+}
+%typemap(freearg) ts_java_reals * {
+	delete $1;
+}
+
+// Map direct buffer to ts_java_buffer (checked in Java, see javain).
+%typemap(in) ts_java_buffer * (ts_java_buffer temp) {
+	temp.data = (tinyspline::real *) jenv->GetDirectBufferAddress($input);
+	if (!temp.data) {
+		SWIG_JavaThrowException(jenv, SWIG_JavaIllegalArgumentException,
+		                        "buffer is not direct");
+		return $null;
+	}
+	temp.size = (size_t) jenv->GetDirectBufferCapacity($input);
+	$1 = &temp;
+}
+
+%extend tinyspline::BSpline {
+	// Like evalAll(List), but without boxing.
+	ts_java_reals *evalAll(ts_java_reals *knots) const {
+		std::unique_ptr<std::vector<tinyspline::real>> points(
+			$self->evalAll(&knots->values));
+		ts_java_reals *result = new ts_java_reals();
+		result->values.swap(*points);
+		return result;
+	}
+
+	// Evaluates this spline at all knots of the direct buffer knots (the
+	// whole capacity, regardless of the position) and writes the results
+	// to the direct buffer points. Both buffers must be in native byte
+	// order. No memory is allocated on the Java heap.
+	void evalAll(ts_java_buffer *knots, ts_java_buffer *points) const {
+		ts_java_eval_into(*$self, knots->data, knots->size, points);
+	}
+
+	// Like sample(long), but without boxing.
+	ts_java_reals *sampleArray(size_t num = 0) const {
+		std::unique_ptr<std::vector<tinyspline::real>> points(
+			$self->sample(num));
+		ts_java_reals *result = new ts_java_reals();
+		result->values.swap(*points);
+		return result;
+	}
+
+	// Like sample(long), but writes the samples to the direct buffer
+	// points (native byte order).
+	void sample(size_t num, ts_java_buffer *points) const {
+		std::unique_ptr<std::vector<tinyspline::real>> knots(
+			$self->uniformKnotSeq(num == 0 ? 100 : num));
+		ts_java_eval_into(*$self, knots->data(), knots->size(), points);
+	}
+
+	ts_java_reals *controlPointsArray() const {
+		ts_java_reals *result = new ts_java_reals();
+		result->values = $self->controlPoints();
+		return result;
+	}
+
+	void setControlPoints(ts_java_reals *ctrlp) {
+		$self->setControlPoints(ctrlp->values);
+	}
+
+	ts_java_reals *knotsArray() const {
+		ts_java_reals *result = new ts_java_reals();
+		result->values = $self->knots();
+		return result;
+	}
+
+	void setKnots(ts_java_reals *knots) {
+		$self->setKnots(knots->values);
+	}
+}
+
 %include "tinyspline.i"
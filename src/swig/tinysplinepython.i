@@ -13,31 +13,174 @@
 %rename (__repr__) tinyspline::Vec3::toString;
 %rename (__repr__) tinyspline::Vec4::toString;
 
-// Map std::vector<tinyspline::real> to Python list.
-%typemap(out) std::vector<tinyspline::real> * (int size, PyObject *data) {
-	size = $1->size();
-	$result = PyList_New(size);
-	for (int i = 0; i < size; i++) {
-		data = PyFloat_FromDouble((*$1)[i]);
-		PyList_SetItem($result, i, data);
+%{
+	#include <memory>
+
+	// Python format character of tinyspline::real (see buffer protocol).
+	static const char *ts_py_real_format()
+	{
+		return sizeof(tinyspline::real) == sizeof(float) ? "f" : "d";
+	}
+
+	// Returns whether `format' describes a native tinyspline::real.
+	static bool ts_py_is_real_format(const char *format)
+	{
+		const unsigned int one = 1;
+		const bool little = *((const unsigned char *) &one) == 1;
+		if (!format) return false;
+		if (*format == '@' || *format == '=' || (little && *format == '<'))
+			format++;
+		return format[0] == ts_py_real_format()[0] && !format[1];
+	}
+
+	// Creates a list of Python floats from `values'.
+	static PyObject *ts_py_real_list(const std::vector<tinyspline::real> &values)
+	{
+		PyObject *list = PyList_New((Py_ssize_t) values.size());
+		if (!list) return NULL;
+		for (size_t i = 0; i < values.size(); i++) {
+			PyObject *value = PyFloat_FromDouble(values[i]);
+			if (!value) {
+				Py_DECREF(list);
+				return NULL;
+			}
+			PyList_SET_ITEM(list, (Py_ssize_t) i, value);
+		}
+		return list;
+	}
+
+	// Real values that are returned as memoryview (see the *Buffer
+	// accessors below).
+	struct ts_py_reals {
+		std::vector<tinyspline::real> values;
+	};
+
+	// Creates a flat, writable memoryview of `values'. The values are
+	// copied with a single memcpy into a bytearray owned by the view. This
+	// avoids creating one Python float per value and allows libraries such
+	// as NumPy to use the data without copying (e.g., numpy.asarray).
+	static PyObject *ts_py_real_buffer(const std::vector<tinyspline::real> &values)
+	{
+#if PY_VERSION_HEX >= 0x03030000
+		PyObject *bytes, *view, *cast;
+		bytes = PyByteArray_FromStringAndSize(
+			(const char *) values.data(),
+			(Py_ssize_t) (values.size() * sizeof(tinyspline::real)));
+		if (!bytes) return NULL;
+		view = PyMemoryView_FromObject(bytes);
+		Py_DECREF(bytes);
+		if (!view) return NULL;
+		cast = PyObject_CallMethod(view, (char *) "cast", (char *) "s",
+			ts_py_real_format());
+		Py_DECREF(view);
+		return cast;
+#else
+		return ts_py_real_list(values);
+#endif
+	}
+
+	// Fills `values' with the content of `obj'. Objects exposing
+	// tinyspline::real through the buffer protocol (e.g., NumPy arrays of
+	// matching dtype, array.array, or the memoryviews returned by this
+	// module) are copied in bulk. Any other sequence is converted element
+	// by element.
+	static bool ts_py_to_reals(PyObject *obj,
+	                           std::vector<tinyspline::real> &values)
+	{
+		Py_buffer buffer;
+		PyObject *seq;
+		Py_ssize_t size, i;
+		if (PyObject_CheckBuffer(obj) && PyObject_GetBuffer(obj, &buffer,
+				PyBUF_C_CONTIGUOUS | PyBUF_FORMAT) == 0) {
+			if (buffer.itemsize == sizeof(tinyspline::real) &&
+			    ts_py_is_real_format(buffer.format)) {
+				const tinyspline::real *data =
+					(const tinyspline::real *) buffer.buf;
+				values.assign(data, data +
+					buffer.len / buffer.itemsize);
+				PyBuffer_Release(&buffer);
+				return true;
+			}
+			PyBuffer_Release(&buffer);
+		}
+		PyErr_Clear();
+		seq = PySequence_Fast(obj, "expected a sequence of numbers");
+		if (!seq) return false;
+		size = PySequence_Fast_GET_SIZE(seq);
+		values.resize((size_t) size);
+		for (i = 0; i < size; i++) {
+			values[i] = (tinyspline::real) PyFloat_AsDouble(
+				PySequence_Fast_GET_ITEM(seq, i));
+			if (PyErr_Occurred()) {
+				Py_DECREF(seq);
+				return false;
+			}
+		}
+		Py_DECREF(seq);
+		return true;
 	}
+%}
+
+// Map std::vector<tinyspline::real> to Python list.
+%typemap(out) std::vector<tinyspline::real> * {
+	$result = ts_py_real_list(*$1);
+	if (!$result) SWIG_fail;
 }
 %typemap(newfree) std::vector<tinyspline::real> * {
 	delete $1;
 }
 
-// Map Python list to std::vector<tinyspline::real>.
-%typemap(in) std::vector<tinyspline::real> * (int size, PyObject *data) %{
-	size = PyList_Size($input);
+// Map Python sequence or buffer to std::vector<tinyspline::real>.
+%typemap(in) std::vector<tinyspline::real> * %{
 	$1 = new std::vector<tinyspline::real>();
-	$1->reserve(size);
-	for (int i = 0; i < size; i++) {
-		data = PyList_GetItem($input, i);
-		$1->push_back(PyFloat_AsDouble(data));
-	}
+	if (!ts_py_to_reals($input, *$1)) SWIG_fail;
 %}
 %typemap(freearg) std::vector<tinyspline::real> * {
 	delete $1;
 }
+%typemap(typecheck, precedence=SWIG_TYPECHECK_DOUBLE_ARRAY)
+	std::vector<tinyspline::real> * {
+	$1 = PySequence_Check($input) || PyObject_CheckBuffer($input);
+}
+
+// Map ts_py_reals to a memoryview (list in Python < 3.3).
+%typemap(out) ts_py_reals * {
+	$result = ts_py_real_buffer($1->values);
+	delete $1;
+	if (!$result) SWIG_fail;
+}
+
+// Like evalAll, sample, controlPoints, and knots, but the values are returned
+// as memoryview rather than list. Thus, NumPy and the like can use them
+// without creating one Python float per value (e.g., numpy.asarray).
+%extend tinyspline::BSpline {
+	ts_py_reals *evalAllBuffer(std::vector<tinyspline::real> *knots) const {
+		std::unique_ptr<std::vector<tinyspline::real>> points(
+			$self->evalAll(knots));
+		ts_py_reals *result = new ts_py_reals();
+		result->values.swap(*points);
+		return result;
+	}
+
+	ts_py_reals *sampleBuffer(size_t num = 0) const {
+		std::unique_ptr<std::vector<tinyspline::real>> points(
+			$self->sample(num));
+		ts_py_reals *result = new ts_py_reals();
+		result->values.swap(*points);
+		return result;
+	}
+
+	ts_py_reals *controlPointsBuffer() const {
+		ts_py_reals *result = new ts_py_reals();
+		result->values = $self->controlPoints();
+		return result;
+	}
+
+	ts_py_reals *knotsBuffer() const {
+		ts_py_reals *result = new ts_py_reals();
+		result->values = $self->knots();
+		return result;
+	}
+}
 
 %include "tinyspline.i"
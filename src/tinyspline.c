@@ -1,12 +1,31 @@
 #define TINYSPLINE_EXPORT
 #include "tinyspline.h"
-#include "parson.h" /* serialization */
 
 #include <stdlib.h> /* malloc, free */
 #include <math.h>   /* fabs, sqrt, acos */
 #include <string.h> /* memcpy, memmove */
 #include <stdio.h>  /* FILE, fopen */
 #include <stdarg.h> /* varargs */
+#include <float.h>  /* DBL_MAX, DBL_MANT_DIG */
+#include <limits.h> /* ULONG_MAX */
+
+/* Memory mapping of spline containers. */
+#if defined(_WIN32)
+#define TS_INT_MMAP_WIN32
+#ifndef WIN32_LEAN_AND_MEAN
+#define WIN32_LEAN_AND_MEAN
+#endif
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#elif defined(__unix__) || defined(__APPLE__)
+#define TS_INT_MMAP_POSIX
+#include <fcntl.h>    /* open */
+#include <sys/mman.h> /* mmap, munmap */
+#include <sys/stat.h> /* fstat */
+#include <unistd.h>   /* close */
+#endif
 
 /* Suppress some useless MSVC warnings. */
 #ifdef _MSC_VER
@@ -27,6 +46,534 @@
 	if ((in) != (out))                     \
 		ts_int_bspline_init(out);
 
+/* Machine epsilon of tsReal. */
+#ifdef TINYSPLINE_FLOAT_PRECISION
+#define TS_INT_REAL_EPSILON FLT_EPSILON
+#else
+#define TS_INT_REAL_EPSILON DBL_EPSILON
+#endif
+
+/* Newly created splines with more than TS_MAX_NUM_KNOTS knots receive a
+ * domain in which distinct knots are at least this factor times
+ * TS_KNOT_EPSILON apart. The margin absorbs the rounding errors of the knot
+ * values, which grow with the magnitude of the domain. */
+#define TS_INT_KNOT_SPACING_FACTOR 2
+
+/* Thread-local storage (if supported by the compiler). Otherwise, variables
+ * declared with TS_THREAD_LOCAL are shared by all threads and accesses are
+ * not synchronized. The documentation of ::ts_set_thread_allocator and of
+ * the statistics in tinyspline.h describes the consequences. */
+#if defined(_MSC_VER)
+#define TS_THREAD_LOCAL __declspec(thread)
+#elif defined(__GNUC__) || defined(__clang__)
+#define TS_THREAD_LOCAL __thread
+#else
+#define TS_THREAD_LOCAL
+#endif
+
+
+
+/*! @name Statistics
+ *
+ * The counters are updated with the macros of this section, which expand to
+ * nothing if TINYSPLINE_ENABLE_STATS is not defined.
+ *
+ * @{
+ */
+#ifdef TINYSPLINE_ENABLE_STATS
+/* Maximum number of functions with counters, including "other". Should be
+ * greater than the number of instrumented functions. If not, the events of
+ * the functions that do not fit are attributed to "other", for which the
+ * last slot is reserved. */
+#define TS_INT_STATS_MAX 128
+
+static TS_THREAD_LOCAL tsStats ts_int_stats[TS_INT_STATS_MAX];
+static TS_THREAD_LOCAL size_t ts_int_stats_num = 0;
+/* The outermost instrumented function that is running. */
+static TS_THREAD_LOCAL const char *ts_int_stats_scope = NULL;
+
+tsStats *
+ts_int_stats_current(void)
+{
+	const char *function = ts_int_stats_scope ?
+		ts_int_stats_scope : "other";
+	tsStats *stats;
+	size_t i;
+	for (i = 0; i < ts_int_stats_num; i++) {
+		if (strcmp(ts_int_stats[i].function, function) == 0)
+			return ts_int_stats + i;
+	}
+	if (ts_int_stats_num >= TS_INT_STATS_MAX - 1 &&
+	    strcmp(function, "other") != 0) {
+		/* Only "other" may take the last slot. */
+		for (i = 0; i < ts_int_stats_num; i++) {
+			if (strcmp(ts_int_stats[i].function, "other") == 0)
+				return ts_int_stats + i;
+		}
+		function = "other";
+	}
+	stats = ts_int_stats + ts_int_stats_num++;
+	memset(stats, 0, sizeof(tsStats));
+	stats->function = function;
+	return stats;
+}
+
+const char *
+ts_int_stats_enter(const char *function)
+{
+	const char *prev = ts_int_stats_scope;
+	if (!prev) {
+		ts_int_stats_scope = function;
+		ts_int_stats_current()->num_calls++;
+	}
+	return prev;
+}
+
+void
+ts_int_stats_leave(const char *prev)
+{
+	ts_int_stats_scope = prev;
+}
+
+void
+ts_int_stats_alloc(size_t size)
+{
+	tsStats *stats = ts_int_stats_current();
+	stats->num_allocs++;
+	stats->num_bytes += size;
+}
+
+/* Attributes all events that occur until the matching TS_INT_STATS_LEAVE to
+ * `function' (unless another instrumented function is already running).
+ * Declares a variable and, thus, must be placed at the beginning of a
+ * block. */
+#define TS_INT_STATS_ENTER(function) \
+	const char *ts_int_stats_prev = ts_int_stats_enter(function);
+#define TS_INT_STATS_LEAVE ts_int_stats_leave(ts_int_stats_prev);
+#define TS_INT_STATS_ALLOC(size) ts_int_stats_alloc(size);
+#define TS_INT_STATS_ADD(counter, num) \
+	ts_int_stats_current()->counter += (num);
+#else
+#define TS_INT_STATS_ENTER(function)
+#define TS_INT_STATS_LEAVE
+#define TS_INT_STATS_ALLOC(size)
+#define TS_INT_STATS_ADD(counter, num)
+#endif
+
+int
+ts_stats_enabled(void)
+{
+#ifdef TINYSPLINE_ENABLE_STATS
+	return 1;
+#else
+	return 0;
+#endif
+}
+
+size_t
+ts_stats_get(tsStats *stats,
+             size_t num)
+{
+#ifdef TINYSPLINE_ENABLE_STATS
+	num = num < ts_int_stats_num ? num : ts_int_stats_num;
+	if (num > 0)
+		memcpy(stats, ts_int_stats, num * sizeof(tsStats));
+	return ts_int_stats_num;
+#else
+	(void) stats;
+	(void) num;
+	return 0;
+#endif
+}
+
+void
+ts_stats_reset(void)
+{
+#ifdef TINYSPLINE_ENABLE_STATS
+	ts_int_stats_num = 0;
+#endif
+}
+/*! @} */
+
+
+
+/*! @name Tracing
+ *
+ * The tracer is called with the macros of this section, which expand to
+ * nothing if TINYSPLINE_ENABLE_TRACING is not defined.
+ *
+ * @{
+ */
+#ifdef TINYSPLINE_ENABLE_TRACING
+static const tsTracer *ts_int_tracer = NULL;
+
+void
+ts_int_trace_begin(const char *name)
+{
+	const tsTracer *tracer = ts_int_tracer;
+	if (tracer)
+		tracer->begin(name, tracer->user_data);
+}
+
+void
+ts_int_trace_end(const char *name)
+{
+	const tsTracer *tracer = ts_int_tracer;
+	if (tracer)
+		tracer->end(name, tracer->user_data);
+}
+
+#define TS_INT_TRACE_BEGIN(name) ts_int_trace_begin(name);
+#define TS_INT_TRACE_END(name) ts_int_trace_end(name);
+#else
+#define TS_INT_TRACE_BEGIN(name)
+#define TS_INT_TRACE_END(name)
+#endif
+
+/* Like TS_CALL, but traces `call' as phase `name'. The phase ends before
+ * jumping to the error handler so that begin and end are always balanced. */
+#define TS_INT_TRACE_CALL(label, error, name, call)  \
+		TS_INT_TRACE_BEGIN(name)             \
+		(error) = (call);                    \
+		TS_INT_TRACE_END(name)               \
+		if ((error)) goto __ ## label ## __;
+
+/* Returns the result of `call' and instruments it as API function
+ * `function' (statistics and tracing). */
+#if defined(TINYSPLINE_ENABLE_STATS) || defined(TINYSPLINE_ENABLE_TRACING)
+#define TS_INT_API_SCOPE(function, call)        \
+{                                               \
+	TS_INT_STATS_ENTER(#function)           \
+	tsError ts_int_api_err;                 \
+	TS_INT_TRACE_BEGIN(#function)           \
+	ts_int_api_err = (call);                \
+	TS_INT_TRACE_END(#function)             \
+	TS_INT_STATS_LEAVE                      \
+	return ts_int_api_err;                  \
+}
+#else
+#define TS_INT_API_SCOPE(function, call) return (call);
+#endif
+
+int
+ts_tracing_enabled(void)
+{
+#ifdef TINYSPLINE_ENABLE_TRACING
+	return 1;
+#else
+	return 0;
+#endif
+}
+
+const tsTracer *
+ts_set_tracer(const tsTracer *tracer)
+{
+#ifdef TINYSPLINE_ENABLE_TRACING
+	const tsTracer *prev = ts_int_tracer;
+	ts_int_tracer = tracer;
+	return prev;
+#else
+	(void) tracer;
+	return NULL;
+#endif
+}
+/*! @} */
+
+
+
+/*! @name Memory Management
+ *
+ * All memory that is not passed to the caller is allocated with
+ * ::ts_int_malloc and released with ::ts_int_free.
+ *
+ * @{
+ */
+/**
+ * Precedes each block allocated with ::ts_int_malloc. The union ensures that
+ * the memory following the header is suitably aligned.
+ */
+union tsAllocHeader
+{
+	struct {
+		const tsAllocator *allocator; /**< Allocator of the block. */
+		size_t size; /**< Size of the block including the header. */
+	} info;
+	tsReal align_real;
+	double align_double;
+	long align_long;
+	void *align_ptr;
+};
+
+/**
+ * Precedes each block of a ::tsArena that did not fit into its memory block.
+ */
+union tsArenaOverflow
+{
+	struct {
+		union tsArenaOverflow *prev; /**< Previous overflow block. */
+		union tsArenaOverflow *next; /**< Next overflow block. */
+	} link;
+	union tsAllocHeader align_header;
+};
+
+void *
+ts_int_default_allocate(size_t size,
+                        void *user_data)
+{
+	(void) user_data;
+	return malloc(size);
+}
+
+void *
+ts_int_default_reallocate(void *ptr,
+                          size_t old_size,
+                          size_t size,
+                          void *user_data)
+{
+	(void) old_size;
+	(void) user_data;
+	return realloc(ptr, size);
+}
+
+void
+ts_int_default_deallocate(void *ptr,
+                          size_t size,
+                          void *user_data)
+{
+	(void) size;
+	(void) user_data;
+	free(ptr);
+}
+
+static const tsAllocator ts_int_default_allocator = {
+	ts_int_default_allocate,
+	ts_int_default_reallocate,
+	ts_int_default_deallocate,
+	NULL
+};
+static const tsAllocator *ts_int_global_allocator = NULL;
+static TS_THREAD_LOCAL const tsAllocator *ts_int_thread_allocator = NULL;
+
+const tsAllocator *
+ts_set_allocator(const tsAllocator *allocator)
+{
+	const tsAllocator *prev = ts_int_global_allocator;
+	ts_int_global_allocator = allocator;
+	return prev;
+}
+
+const tsAllocator *
+ts_set_thread_allocator(const tsAllocator *allocator)
+{
+	const tsAllocator *prev = ts_int_thread_allocator;
+	ts_int_thread_allocator = allocator;
+	return prev;
+}
+
+const tsAllocator *
+ts_active_allocator(void)
+{
+	if (ts_int_thread_allocator)
+		return ts_int_thread_allocator;
+	if (ts_int_global_allocator)
+		return ts_int_global_allocator;
+	return &ts_int_default_allocator;
+}
+
+void *
+ts_int_malloc(size_t size)
+{
+	const tsAllocator *allocator = ts_active_allocator();
+	const size_t total = sizeof(union tsAllocHeader) + size;
+	union tsAllocHeader *header;
+
+	TS_INT_STATS_ALLOC(size)
+	header = (union tsAllocHeader *) allocator->allocate(
+		total, allocator->user_data);
+	if (!header) return NULL;
+	header->info.allocator = allocator;
+	header->info.size = total;
+	return header + 1;
+}
+
+void *
+ts_int_realloc(void *ptr,
+               size_t size)
+{
+	const tsAllocator *allocator;
+	const size_t total = sizeof(union tsAllocHeader) + size;
+	union tsAllocHeader *header, *resized;
+	size_t old_size;
+
+	if (!ptr) return ts_int_malloc(size);
+	TS_INT_STATS_ALLOC(size)
+	header = ((union tsAllocHeader *) ptr) - 1;
+	allocator = header->info.allocator;
+	old_size = header->info.size;
+	if (allocator->reallocate) {
+		resized = (union tsAllocHeader *) allocator->reallocate(
+			header, old_size, total, allocator->user_data);
+		if (!resized) return NULL;
+	} else {
+		resized = (union tsAllocHeader *) allocator->allocate(
+			total, allocator->user_data);
+		if (!resized) return NULL;
+		memcpy(resized, header, old_size < total ? old_size : total);
+		allocator->deallocate(header, old_size, allocator->user_data);
+	}
+	resized->info.size = total;
+	return resized + 1;
+}
+
+void
+ts_int_free(void *ptr)
+{
+	const tsAllocator *allocator;
+	union tsAllocHeader *header;
+
+	if (!ptr) return;
+	header = ((union tsAllocHeader *) ptr) - 1;
+	allocator = header->info.allocator;
+	allocator->deallocate(header, header->info.size, allocator->user_data);
+}
+
+int
+ts_int_arena_owns(const tsArena *arena,
+                  const void *ptr)
+{
+	const unsigned char *block = (const unsigned char *) ptr;
+	return arena->memory != NULL &&
+	       block >= arena->memory &&
+	       block < arena->memory + arena->size;
+}
+
+void *
+ts_int_arena_allocate(size_t size,
+                      void *user_data)
+{
+	tsArena *arena = (tsArena *) user_data;
+	const size_t align = sizeof(union tsAllocHeader);
+	const size_t offset = (arena->used + align - 1) / align * align;
+	union tsArenaOverflow *node;
+
+	if (offset <= arena->size && size <= arena->size - offset) {
+		arena->used = offset + size;
+		if (arena->used > arena->peak)
+			arena->peak = arena->used;
+		return arena->memory + offset;
+	}
+
+	/* Memory block is exhausted. */
+	node = (union tsArenaOverflow *) malloc(
+		sizeof(union tsArenaOverflow) + size);
+	if (!node) return NULL;
+	node->link.prev = NULL;
+	node->link.next = (union tsArenaOverflow *) arena->overflows;
+	if (node->link.next)
+		node->link.next->link.prev = node;
+	arena->overflows = node;
+	arena->num_overflows++;
+	return node + 1;
+}
+
+void
+ts_int_arena_deallocate(void *ptr,
+                        size_t size,
+                        void *user_data)
+{
+	tsArena *arena = (tsArena *) user_data;
+	unsigned char *block = (unsigned char *) ptr;
+	union tsArenaOverflow *node;
+
+	if (ts_int_arena_owns(arena, ptr)) {
+		/* Roll back the most recent allocation. */
+		if (block + size == arena->memory + arena->used)
+			arena->used = (size_t) (block - arena->memory);
+		return;
+	}
+	node = ((union tsArenaOverflow *) ptr) - 1;
+	if (node->link.prev)
+		node->link.prev->link.next = node->link.next;
+	else
+		arena->overflows = node->link.next;
+	if (node->link.next)
+		node->link.next->link.prev = node->link.prev;
+	free(node);
+}
+
+void *
+ts_int_arena_reallocate(void *ptr,
+                        size_t old_size,
+                        size_t size,
+                        void *user_data)
+{
+	tsArena *arena = (tsArena *) user_data;
+	unsigned char *block = (unsigned char *) ptr;
+	size_t offset;
+	void *resized;
+
+	if (ts_int_arena_owns(arena, ptr)) {
+		offset = (size_t) (block - arena->memory);
+		/* Resize the most recent allocation in place. */
+		if (block + old_size == arena->memory + arena->used &&
+		    size <= arena->size - offset) {
+			arena->used = offset + size;
+			if (arena->used > arena->peak)
+				arena->peak = arena->used;
+			return ptr;
+		}
+		if (size <= old_size)
+			return ptr;
+	}
+	resized = ts_int_arena_allocate(size, user_data);
+	if (!resized) return NULL;
+	memcpy(resized, ptr, old_size < size ? old_size : size);
+	ts_int_arena_deallocate(ptr, old_size, user_data);
+	return resized;
+}
+
+void
+ts_arena_init(tsArena *arena,
+              void *memory,
+              size_t size)
+{
+	const size_t align = sizeof(union tsAllocHeader);
+	size_t skip = 0;
+
+	/* Align the beginning of the memory block. */
+	if (memory && (size_t) memory % align)
+		skip = align - (size_t) memory % align;
+	if (skip > size)
+		skip = size;
+	arena->memory = memory ? (unsigned char *) memory + skip : NULL;
+	arena->size = size - skip;
+	arena->used = 0;
+	arena->peak = 0;
+	arena->num_overflows = 0;
+	arena->overflows = NULL;
+	arena->allocator.allocate = ts_int_arena_allocate;
+	arena->allocator.reallocate = ts_int_arena_reallocate;
+	arena->allocator.deallocate = ts_int_arena_deallocate;
+	arena->allocator.user_data = arena;
+}
+
+void
+ts_arena_reset(tsArena *arena)
+{
+	union tsArenaOverflow *node, *next;
+	node = (union tsArenaOverflow *) arena->overflows;
+	while (node) {
+		next = node->link.next;
+		free(node);
+		node = next;
+	}
+	arena->used = 0;
+	arena->peak = 0;
+	arena->num_overflows = 0;
+	arena->overflows = NULL;
+}
+/*! @} */
+
 
 
 /*! @name Internal Structs and Functions
@@ -130,9 +677,9 @@ ts_int_deboornet_init(tsDeBoorNet *net)
 size_t
 ts_int_deboornet_sof_state(const tsDeBoorNet *net)
 {
+	/* The result is part of `points'. */
 	return sizeof(struct tsDeBoorNetImpl) +
-	       ts_deboornet_sof_points(net) +
-	       ts_deboornet_sof_result(net);
+	       ts_deboornet_sof_points(net);
 }
 
 tsReal *
@@ -210,6 +757,7 @@ ts_bspline_control_points(const tsBSpline *spline,
                           tsStatus *status)
 {
 	const size_t size = ts_bspline_sof_control_points(spline);
+	TS_INT_STATS_ALLOC(size)
 	*ctrlp = (tsReal*) malloc(size);
 	if (!*ctrlp) TS_RETURN_0(status, TS_MALLOC, "out of memory")
 	memcpy(*ctrlp, ts_int_bspline_access_ctrlp(spline), size);
@@ -284,6 +832,7 @@ ts_bspline_knots(const tsBSpline *spline,
                  tsStatus *status)
 {
 	const size_t size = ts_bspline_sof_knots(spline);
+	TS_INT_STATS_ALLOC(size)
 	*knots = (tsReal*) malloc(size);
 	if (!*knots) TS_RETURN_0(status, TS_MALLOC, "out of memory")
 	memcpy(*knots, ts_int_bspline_access_knots(spline), size);
@@ -299,20 +848,21 @@ ts_bspline_knot_at(const tsBSpline *spline,
 	return ts_int_bspline_access_knot_at(spline, index, knot, status);
 }
 
+/* Checks that `knots' (with stride `ks') are non-decreasing and that no knot
+ * has a multiplicity greater than `order'. */
 tsError
-ts_bspline_set_knots(tsBSpline *spline,
-                     const tsReal *knots,
-                     tsStatus *status)
+ts_int_check_knots(const tsReal *knots,
+                   size_t ks,
+                   size_t num_knots,
+                   size_t order,
+                   tsStatus *status)
 {
-	const size_t size = ts_bspline_sof_knots(spline);
-	const size_t num_knots = ts_bspline_num_knots(spline);
-	const size_t order = ts_bspline_order(spline);
 	size_t idx, mult;
 	tsReal lst_knot, knot;
 	lst_knot = knots[0];
 	mult = 1;
 	for (idx = 1; idx < num_knots; idx++) {
-		knot = knots[idx];
+		knot = knots[idx * ks];
 		if (ts_knots_equal(lst_knot, knot)) {
 			mult++;
 		} else if (lst_knot > knot) {
@@ -330,6 +880,19 @@ ts_bspline_set_knots(tsBSpline *spline,
 		}
 		lst_knot = knot;
 	}
+	TS_RETURN_SUCCESS(status)
+}
+
+tsError
+ts_bspline_set_knots(tsBSpline *spline,
+                     const tsReal *knots,
+                     tsStatus *status)
+{
+	const size_t size = ts_bspline_sof_knots(spline);
+	tsError err;
+	TS_CALL_ROE(err, ts_int_check_knots(
+	            knots, 1, ts_bspline_num_knots(spline),
+	            ts_bspline_order(spline), status))
 	memmove(ts_int_bspline_access_knots(spline), knots, size);
 	TS_RETURN_SUCCESS(status)
 }
@@ -405,6 +968,34 @@ ts_bspline_init(void)
 	return spline;
 }
 
+/* Returns the number of default domains that are required to store
+ * `n_knots' distinct knots (see ::TS_INT_KNOT_SPACING_FACTOR). */
+size_t
+ts_int_bspline_num_domains(size_t n_knots)
+{
+	const double width = TS_DOMAIN_DEFAULT_MAX - TS_DOMAIN_DEFAULT_MIN;
+	if (n_knots <= TS_MAX_NUM_KNOTS)
+		return 1;
+	return (size_t) ceil(TS_INT_KNOT_SPACING_FACTOR * TS_KNOT_EPSILON *
+	                     (double) (n_knots - 1) / width);
+}
+
+/* Returns 1 if the knots generated for a spline with `n_knots' knots stay
+ * distinct despite rounding to tsReal, 0 otherwise. Knot `i' is off by at most
+ * half an ulp of the end of the domain, i.e., adjacent knots are off by at
+ * most `max * TS_INT_REAL_EPSILON'. This error must be less than the margin
+ * of (TS_INT_KNOT_SPACING_FACTOR - 1) * TS_KNOT_EPSILON, which is the case
+ * if `n_knots * TS_INT_REAL_EPSILON' is less than `(F - 1) / F' (with `F'
+ * being the spacing factor). Half of this bound is used for safety. */
+int
+ts_int_bspline_knots_representable(size_t n_knots)
+{
+	const double f = TS_INT_KNOT_SPACING_FACTOR;
+	if (n_knots <= TS_MAX_NUM_KNOTS)
+		return 1;
+	return (double) n_knots * TS_INT_REAL_EPSILON < (f - 1) / f / 2;
+}
+
 tsError
 ts_int_bspline_generate_knots(const tsBSpline *spline,
                               tsBSplineType type,
@@ -413,7 +1004,16 @@ ts_int_bspline_generate_knots(const tsBSpline *spline,
 	const size_t n_knots = ts_bspline_num_knots(spline);
 	const size_t deg = ts_bspline_degree(spline);
 	const size_t order = ts_bspline_order(spline);
-	tsReal fac; /**< Factor used to calculate the knot values. */
+	/* Number of default domains required to keep distinct knots at least
+	   TS_INT_KNOT_SPACING_FACTOR * TS_KNOT_EPSILON apart. */
+	const size_t n_domains = ts_int_bspline_num_domains(n_knots);
+	const double min = TS_DOMAIN_DEFAULT_MIN;
+	const double max = TS_DOMAIN_DEFAULT_MIN +
+		(TS_DOMAIN_DEFAULT_MAX - TS_DOMAIN_DEFAULT_MIN) *
+		(double) n_domains;
+	/* Computed in double precision such that each knot is rounded to
+	   tsReal only once. */
+	double fac; /**< Factor used to calculate the knot values. */
 	size_t i; /**< Used in for loops. */
 	tsReal *knots; /**< Pointer to the knots of \p _result_. */
 
@@ -427,30 +1027,27 @@ ts_int_bspline_generate_knots(const tsBSpline *spline,
 	knots = ts_int_bspline_access_knots(spline);
 
 	if (type == TS_OPENED) {
-		knots[0] = TS_DOMAIN_DEFAULT_MIN; /* n_knots >= 2 */
-		fac = (TS_DOMAIN_DEFAULT_MAX - TS_DOMAIN_DEFAULT_MIN)
-		      / (n_knots - 1); /* n_knots >= 2 */
+		knots[0] = (tsReal) min; /* n_knots >= 2 */
+		fac = (max - min) / (double) (n_knots - 1); /* n_knots >= 2 */
 		for (i = 1; i < n_knots-1; i++)
-			knots[i] = TS_DOMAIN_DEFAULT_MIN + i*fac;
-		knots[i] = TS_DOMAIN_DEFAULT_MAX; /* n_knots >= 2 */
+			knots[i] = (tsReal) (min + (double) i * fac);
+		knots[i] = (tsReal) max; /* n_knots >= 2 */
 	} else if (type == TS_CLAMPED) {
 		/* n_knots >= 2*order == 2*(deg+1) == 2*deg + 2 > 2*deg - 1 */
-		fac = (TS_DOMAIN_DEFAULT_MAX - TS_DOMAIN_DEFAULT_MIN)
-		      / (n_knots - 2*deg - 1);
-		ts_arr_fill(knots, order, TS_DOMAIN_DEFAULT_MIN);
+		fac = (max - min) / (double) (n_knots - 2*deg - 1);
+		ts_arr_fill(knots, order, (tsReal) min);
 		for (i = order ;i < n_knots-order; i++)
-			knots[i] = TS_DOMAIN_DEFAULT_MIN + (i-deg)*fac;
-		ts_arr_fill(knots + i, order, TS_DOMAIN_DEFAULT_MAX);
+			knots[i] = (tsReal) (min + (double) (i-deg) * fac);
+		ts_arr_fill(knots + i, order, (tsReal) max);
 	} else if (type == TS_BEZIERS) {
 		/* n_knots >= 2*order implies n_knots/order >= 2 */
-		fac = (TS_DOMAIN_DEFAULT_MAX - TS_DOMAIN_DEFAULT_MIN)
-		      / (n_knots/order - 1);
-		ts_arr_fill(knots, order, TS_DOMAIN_DEFAULT_MIN);
+		fac = (max - min) / (double) (n_knots/order - 1);
+		ts_arr_fill(knots, order, (tsReal) min);
 		for (i = order; i < n_knots-order; i += order)
 			ts_arr_fill(knots + i,
 			            order,
-			            TS_DOMAIN_DEFAULT_MIN + (i/order)*fac);
-		ts_arr_fill(knots + i, order, TS_DOMAIN_DEFAULT_MAX);
+			            (tsReal) (min + (double) (i/order) * fac));
+		ts_arr_fill(knots + i, order, (tsReal) max);
 	}
 	TS_RETURN_SUCCESS(status)
 }
@@ -472,6 +1069,8 @@ ts_bspline_new(size_t num_control_points,
 	const size_t sof_ctrlp_vec = len_ctrlp * sof_real;
 	const size_t sof_knots_vec = num_knots * sof_real;
 	const size_t sof_spline = sof_impl + sof_ctrlp_vec + sof_knots_vec;
+	/* Maximum number of reals that can be addressed by `sof_spline'. */
+	const size_t max_len = ((size_t) -1 - sof_impl) / sof_real;
 	tsError err;
 
 	ts_int_bspline_init(spline);
@@ -479,10 +1078,14 @@ ts_bspline_new(size_t num_control_points,
 	if (dimension < 1) {
 		TS_RETURN_0(status, TS_DIM_ZERO, "unsupported dimension: 0")
 	}
-	if (num_knots > TS_MAX_NUM_KNOTS) {
+	/* Check for overflows in the size calculations above. */
+	if (num_knots < num_control_points ||
+	    len_ctrlp / dimension != num_control_points ||
+	    num_knots > max_len || len_ctrlp > max_len - num_knots) {
 		TS_RETURN_2(status, TS_NUM_KNOTS,
-		            "unsupported number of knots: %lu > %i",
-		            (unsigned long) num_knots, TS_MAX_NUM_KNOTS)
+		            "unsupported number of knots: %lu (dimension %lu)",
+		            (unsigned long) num_knots,
+		            (unsigned long) dimension)
 	}
 	if (degree >= num_control_points) {
 		TS_RETURN_2(status, TS_DEG_GE_NCTRLP,
@@ -490,8 +1093,13 @@ ts_bspline_new(size_t num_control_points,
 		            (unsigned long) degree,
 		            (unsigned long) num_control_points)
 	}
+	if (!ts_int_bspline_knots_representable(num_knots)) {
+		TS_RETURN_1(status, TS_NUM_KNOTS,
+		            "num(knots) (%lu) exceeds the precision of tsReal",
+		            (unsigned long) num_knots)
+	}
 
-	spline->pImpl = (struct tsBSplineImpl *) malloc(sof_spline);
+	spline->pImpl = (struct tsBSplineImpl *) ts_int_malloc(sof_spline);
 	if (!spline->pImpl) TS_RETURN_0(status, TS_MALLOC, "out of memory")
 
 	spline->pImpl->deg = degree;
@@ -549,7 +1157,7 @@ ts_bspline_copy(const tsBSpline *src,
 	if (src == dest) TS_RETURN_SUCCESS(status)
 	ts_int_bspline_init(dest);
 	size = ts_int_bspline_sof_state(src);
-	dest->pImpl = (struct tsBSplineImpl *) malloc(size);
+	dest->pImpl = (struct tsBSplineImpl *) ts_int_malloc(size);
 	if (!dest->pImpl) TS_RETURN_0(status, TS_MALLOC, "out of memory")
 	memcpy(dest->pImpl, src->pImpl, size);
 	TS_RETURN_SUCCESS(status)
@@ -567,13 +1175,113 @@ ts_bspline_move(tsBSpline *src,
 void
 ts_bspline_free(tsBSpline *spline)
 {
-	if (spline->pImpl) free(spline->pImpl);
+	if (spline->pImpl) ts_int_free(spline->pImpl);
 	ts_int_bspline_init(spline);
 }
 /*! @} */
 
 
 
+/*! @name B-Spline Views
+ *
+ * @{
+ */
+tsError
+ts_bspline_view_init(size_t num_control_points,
+                     size_t dimension,
+                     size_t degree,
+                     const tsReal *control_points,
+                     size_t control_point_stride,
+                     const tsReal *knots,
+                     size_t knot_stride,
+                     tsBSplineView *view,
+                     tsStatus *status)
+{
+	if (dimension == 0)
+		TS_RETURN_0(status, TS_DIM_ZERO, "unsupported dimension: 0")
+	if (control_point_stride == 0)
+		control_point_stride = dimension;
+	if (control_point_stride < dimension) {
+		TS_RETURN_2(status, TS_LCTRLP_DIM_MISMATCH,
+		            "stride (%lu) < dimension (%lu)",
+		            (unsigned long) control_point_stride,
+		            (unsigned long) dimension)
+	}
+	if (degree >= num_control_points) {
+		TS_RETURN_2(status, TS_DEG_GE_NCTRLP,
+		            "degree (%lu) >= num(control_points) (%lu)",
+		            (unsigned long) degree,
+		            (unsigned long) num_control_points)
+	}
+	view->degree = degree;
+	view->dimension = dimension;
+	view->num_control_points = num_control_points;
+	view->control_points = control_points;
+	view->control_point_stride = control_point_stride;
+	view->knots = knots;
+	view->knot_stride = knot_stride == 0 ? 1 : knot_stride;
+	TS_RETURN_SUCCESS(status)
+}
+
+void
+ts_bspline_as_view(const tsBSpline *spline,
+                   tsBSplineView *view)
+{
+	view->degree = ts_bspline_degree(spline);
+	view->dimension = ts_bspline_dimension(spline);
+	view->num_control_points = ts_bspline_num_control_points(spline);
+	view->control_points = ts_int_bspline_access_ctrlp(spline);
+	view->control_point_stride = view->dimension;
+	view->knots = ts_int_bspline_access_knots(spline);
+	view->knot_stride = 1;
+}
+
+tsError
+ts_bspline_view_to_bspline(const tsBSplineView *view,
+                           tsBSpline *spline,
+                           tsStatus *status)
+{
+	const size_t dim = view->dimension;
+	const size_t sof_ctrlp = dim * sizeof(tsReal);
+	size_t i, num_knots;
+	tsReal *ctrlp, *knots;
+	tsError err;
+
+	TS_CALL_ROE(err, ts_bspline_new(
+	            view->num_control_points, dim, view->degree,
+	            TS_OPENED, spline, status))
+	ctrlp = ts_int_bspline_access_ctrlp(spline);
+	knots = ts_int_bspline_access_knots(spline);
+	num_knots = ts_bspline_num_knots(spline);
+	for (i = 0; i < view->num_control_points; i++) {
+		memcpy(ctrlp + i * dim,
+		       view->control_points + i * view->control_point_stride,
+		       sof_ctrlp);
+	}
+	for (i = 0; i < num_knots; i++)
+		knots[i] = view->knots[i * view->knot_stride];
+	TS_TRY(try, err, status)
+		/* Validates the knots. */
+		TS_CALL(try, err, ts_bspline_set_knots(
+		        spline, knots, status))
+	TS_CATCH(err)
+		ts_bspline_free(spline);
+	TS_END_TRY_RETURN(err)
+}
+
+void
+ts_bspline_view_domain(const tsBSplineView *view,
+                       tsReal *min,
+                       tsReal *max)
+{
+	const size_t num_knots = view->num_control_points + view->degree + 1;
+	*min = view->knots[view->degree * view->knot_stride];
+	*max = view->knots[(num_knots - view->degree - 1) * view->knot_stride];
+}
+/*! @} */
+
+
+
 /*! @name De Boor Net Data
  *
  * @{
@@ -639,6 +1347,7 @@ ts_deboornet_points(const tsDeBoorNet *net,
                     tsStatus *status)
 {
 	const size_t size = ts_deboornet_sof_points(net);
+	TS_INT_STATS_ALLOC(size)
 	*points = (tsReal*) malloc(size);
 	if (!*points) TS_RETURN_0(status, TS_MALLOC, "out of memory")
 	memcpy(*points, ts_int_deboornet_access_points(net), size);
@@ -676,6 +1385,7 @@ ts_deboornet_result(const tsDeBoorNet *net,
                     tsStatus *status)
 {
 	const size_t size = ts_deboornet_sof_result(net);
+	TS_INT_STATS_ALLOC(size)
 	*result = (tsReal*) malloc(size);
 	if (!*result) TS_RETURN_0(status, TS_MALLOC, "out of memory")
 	memcpy(*result, ts_int_deboornet_access_result(net), size);
@@ -698,13 +1408,12 @@ ts_deboornet_init(void)
 }
 
 tsError
-ts_int_deboornet_new(const tsBSpline *spline,
-                     tsDeBoorNet *net,
-                     tsStatus *status)
+ts_int_deboornet_new_sized(size_t deg,
+                           size_t dim,
+                           tsDeBoorNet *net,
+                           tsStatus *status)
 {
-	const size_t dim = ts_bspline_dimension(spline);
-	const size_t deg = ts_bspline_degree(spline);
-	const size_t order = ts_bspline_order(spline);
+	const size_t order = deg + 1;
 	const size_t num_points = (size_t)(order * (order+1) * 0.5f);
 	/* Handle `order == 1' which generates too few points. */
 	const size_t fixed_num_points = num_points < 2 ? 2 : num_points;
@@ -714,7 +1423,7 @@ ts_int_deboornet_new(const tsBSpline *spline,
 	const size_t sof_points_vec = fixed_num_points * dim * sof_real;
 	const size_t sof_net = sof_impl + sof_points_vec;
 
-	net->pImpl = (struct tsDeBoorNetImpl *) malloc(sof_net);
+	net->pImpl = (struct tsDeBoorNetImpl *) ts_int_malloc(sof_net);
 	if (!net->pImpl) TS_RETURN_0(status, TS_MALLOC, "out of memory")
 
 	net->pImpl->u = 0.f;
@@ -726,10 +1435,29 @@ ts_int_deboornet_new(const tsBSpline *spline,
 	TS_RETURN_SUCCESS(status)
 }
 
+tsError
+ts_int_view_deboornet_new(const tsBSplineView *view,
+                          tsDeBoorNet *net,
+                          tsStatus *status)
+{
+	return ts_int_deboornet_new_sized(view->degree, view->dimension,
+	                                  net, status);
+}
+
+tsError
+ts_int_deboornet_new(const tsBSpline *spline,
+                     tsDeBoorNet *net,
+                     tsStatus *status)
+{
+	tsBSplineView view;
+	ts_bspline_as_view(spline, &view);
+	return ts_int_view_deboornet_new(&view, net, status);
+}
+
 void
 ts_deboornet_free(tsDeBoorNet *net)
 {
-	if (net->pImpl) free(net->pImpl);
+	if (net->pImpl) ts_int_free(net->pImpl);
 	ts_int_deboornet_init(net);
 }
 
@@ -742,7 +1470,7 @@ ts_deboornet_copy(const tsDeBoorNet *src,
 	if (src == dest) TS_RETURN_SUCCESS(status)
 	ts_int_deboornet_init(dest);
 	size = ts_int_deboornet_sof_state(src);
-	dest->pImpl = (struct tsDeBoorNetImpl *) malloc(size);
+	dest->pImpl = (struct tsDeBoorNetImpl *) ts_int_malloc(size);
 	if (!dest->pImpl) TS_RETURN_0(status, TS_MALLOC, "out of memory")
 	memcpy(dest->pImpl, src->pImpl, size);
 	TS_RETURN_SUCCESS(status)
@@ -808,7 +1536,7 @@ ts_int_thomas_algorithm(const tsReal *a,
 		            "num(points) (%lu) <= 1",
 		            (unsigned long) num)
 	}
-	cc = (tsReal *) malloc(num * sizeof(tsReal));
+	cc = (tsReal *) ts_int_malloc(num * sizeof(tsReal));
 	if (!cc) TS_RETURN_0(status, TS_MALLOC, "out of memory")
 
 	TS_TRY(try, err, status)
@@ -857,7 +1585,7 @@ ts_int_thomas_algorithm(const tsReal *a,
 			}
 		}
 	TS_FINALLY
-		free(cc);
+		ts_int_free(cc);
 	TS_END_TRY_RETURN(err)
 }
 
@@ -900,7 +1628,7 @@ ts_int_relaxed_uniform_cubic_bspline(const tsReal *points,
 		        TS_BEZIERS, spline, status))
 		ctrlp = ts_int_bspline_access_ctrlp(spline);
 
-		s = (tsReal*) malloc(n * sof_ctrlp);
+		s = (tsReal*) ts_int_malloc(n * sof_ctrlp);
 		if (!s) {
 			TS_THROW_0(try, err, status, TS_MALLOC,
 			           "out of memory")
@@ -938,16 +1666,16 @@ ts_int_relaxed_uniform_cubic_bspline(const tsReal *points,
 		ts_bspline_free(spline);
 	TS_FINALLY
 		if (s)
-			free(s);
+			ts_int_free(s);
 	TS_END_TRY_RETURN(err)
 }
 
 tsError
-ts_bspline_interpolate_cubic_natural(const tsReal *points,
-                                     size_t num_points,
-                                     size_t dimension,
-                                     tsBSpline *spline,
-                                     tsStatus *status)
+ts_int_bspline_interpolate_cubic_natural(const tsReal *points,
+                                         size_t num_points,
+                                         size_t dimension,
+                                         tsBSpline *spline,
+                                         tsStatus *status)
 {
 	const size_t sof_ctrlp = dimension * sizeof(tsReal);
 	const size_t len_points = num_points * dimension;
@@ -972,7 +1700,7 @@ ts_bspline_interpolate_cubic_natural(const tsReal *points,
 	/* `num_points` >= 3 */
 	buffer = NULL;
 	TS_TRY(try, err, status)
-		buffer = (tsReal *) malloc(
+		buffer = (tsReal *) ts_int_malloc(
 			/* `a', `b', `c' (note that `c' is equal to `a') */
 			2 * num_int_points * sizeof(tsReal) +
 			/* At first: `d' Afterwards: The result of the thomas
@@ -1015,7 +1743,9 @@ ts_bspline_interpolate_cubic_natural(const tsReal *points,
 			for (i = 0; i < dimension; i++)
 				d[i] *= (tsReal) 0.25f;
 		} else {
-			TS_CALL(try, err, ts_int_thomas_algorithm(
+			TS_INT_TRACE_CALL(try, err,
+			        "ts_bspline_interpolate_cubic_natural/solve",
+			        ts_int_thomas_algorithm(
 			        a, b, c, num_int_points, dimension, d,
 			        status))
 		}
@@ -1023,25 +1753,40 @@ ts_bspline_interpolate_cubic_natural(const tsReal *points,
 		memcpy(d + num_int_points * dimension,
 		       points + (num_points-1) * dimension,
 		       sof_ctrlp);
-		TS_CALL(try, err, ts_int_relaxed_uniform_cubic_bspline(
+		TS_INT_TRACE_CALL(try, err,
+		        "ts_bspline_interpolate_cubic_natural/build",
+		        ts_int_relaxed_uniform_cubic_bspline(
 		        d - dimension, num_points, dimension, spline, status))
 	TS_CATCH(err)
 		ts_bspline_free(spline);
 	TS_FINALLY
-		if (buffer) free(buffer);
+		if (buffer) ts_int_free(buffer);
 	TS_END_TRY_RETURN(err)
 }
 
 tsError
-ts_bspline_interpolate_catmull_rom(const tsReal *points,
-                                   size_t num_points,
-                                   size_t dimension,
-                                   tsReal alpha,
-                                   const tsReal *first,
-                                   const tsReal *last,
-                                   tsReal epsilon,
-                                   tsBSpline *spline,
-                                   tsStatus *status)
+ts_bspline_interpolate_cubic_natural(const tsReal *points,
+                                     size_t num_points,
+                                     size_t dimension,
+                                     tsBSpline *spline,
+                                     tsStatus *status)
+{
+	TS_INT_API_SCOPE(ts_bspline_interpolate_cubic_natural,
+		ts_int_bspline_interpolate_cubic_natural(points, num_points,
+		                                         dimension, spline,
+		                                         status))
+}
+
+tsError
+ts_int_bspline_interpolate_catmull_rom(const tsReal *points,
+                                       size_t num_points,
+                                       size_t dimension,
+                                       tsReal alpha,
+                                       const tsReal *first,
+                                       const tsReal *last,
+                                       tsReal epsilon,
+                                       tsBSpline *spline,
+                                       tsStatus *status)
 {
 	const size_t sof_real = sizeof(tsReal);
 	const size_t sof_ctrlp = dimension * sof_real;
@@ -1067,7 +1812,7 @@ ts_bspline_interpolate_catmull_rom(const tsReal *points,
 	if (alpha > (tsReal) 1.0) alpha = (tsReal) 1.0;
 
 	/* Copy `points` to `cr_ctrlp`. Add space for `first` and `last`. */
-	cr_ctrlp = (tsReal *) malloc((num_points + 2) * sof_ctrlp);
+	cr_ctrlp = (tsReal *) ts_int_malloc((num_points + 2) * sof_ctrlp);
 	if (!cr_ctrlp)
 		TS_RETURN_0(status, TS_MALLOC, "out of memory")
 	memcpy(cr_ctrlp + dimension, points, num_points * sof_ctrlp);
@@ -1092,7 +1837,7 @@ ts_bspline_interpolate_catmull_rom(const tsReal *points,
 
 	/* Check if there are still enough points for interpolation. */
 	if (num_points == 1) { /* `num_points` can't be 0 */
-		free(cr_ctrlp); /* The point is copied from `points`. */
+		ts_int_free(cr_ctrlp); /* The point is copied from `points`. */
 		TS_CALL_ROE(err, ts_int_cubic_point(
 		            points, dimension, spline, status))
 		TS_RETURN_SUCCESS(status)
@@ -1128,7 +1873,7 @@ ts_bspline_interpolate_catmull_rom(const tsReal *points,
 		        TS_BEZIERS, spline, status))
 		bs_ctrlp = ts_int_bspline_access_ctrlp(spline);
 	TS_CATCH(err)
-		free(cr_ctrlp);
+		ts_int_free(cr_ctrlp);
 	TS_END_TRY_ROE(err)
 	for (i = 0; i < ts_bspline_num_control_points(spline) / 4; i++) {
 		p0 = cr_ctrlp + ((i+0) * dimension);
@@ -1157,9 +1902,27 @@ ts_bspline_interpolate_catmull_rom(const tsReal *points,
 			bs_ctrlp[((i*4 + 3) * dimension) + d] = p2[d];
 		}
 	}
-	free(cr_ctrlp);
+	ts_int_free(cr_ctrlp);
 	TS_RETURN_SUCCESS(status)
 }
+
+tsError
+ts_bspline_interpolate_catmull_rom(const tsReal *points,
+                                   size_t num_points,
+                                   size_t dimension,
+                                   tsReal alpha,
+                                   const tsReal *first,
+                                   const tsReal *last,
+                                   tsReal epsilon,
+                                   tsBSpline *spline,
+                                   tsStatus *status)
+{
+	TS_INT_API_SCOPE(ts_bspline_interpolate_catmull_rom,
+		ts_int_bspline_interpolate_catmull_rom(points, num_points,
+		                                       dimension, alpha, first,
+		                                       last, epsilon, spline,
+		                                       status))
+}
 /*! @} */
 
 
@@ -1168,20 +1931,50 @@ ts_bspline_interpolate_catmull_rom(const tsReal *points,
  *
  * @{
  */
+/* Interpolates `origin[i]' and `target[i]' with respect to `t'. */
+tsReal
+ts_int_lerp(const tsReal *origin,
+            const tsReal *target,
+            tsReal t,
+            size_t i)
+{
+	return t * target[i] + ((tsReal) 1.0 - t) * origin[i];
+}
+
+/* Returns knot `i' of `knots' or, if `target' is not NULL, the knot that
+ * results from interpolating `knots[i]' and `target[i]' with respect to `t'
+ * (see ::ts_morphism_eval). */
+tsReal
+ts_int_knot_at(const tsReal *knots,
+               const tsReal *target,
+               tsReal t,
+               size_t i)
+{
+	return target ? ts_int_lerp(knots, target, t, i) : knots[i];
+}
+
+/* Finds the span of `knot' in the knot vector `knots' (stride `ks') of a
+ * spline of degree `deg' with `num_knots' knots. If `target' is not NULL, the
+ * knot vector is interpolated on the fly (see ::ts_int_knot_at), which allows
+ * to search the knot vector of a morphed spline without creating it. */
 tsError
-ts_int_bspline_find_knot(const tsBSpline *spline,
-                         tsReal *knot, /* in: knot; out: actual knot */
-                         size_t *idx,  /* out: index of `knot' */
-                         size_t *mult, /* out: multiplicity of `knot' */
-                         tsStatus *status)
+ts_int_find_knot(const tsReal *knots,
+                 const tsReal *target,
+                 tsReal t,
+                 size_t ks,
+                 size_t deg,
+                 size_t num_knots,
+                 tsReal *knot, /* in: knot; out: actual knot */
+                 size_t *idx,  /* in: hint; out: index of `knot' */
+                 size_t *mult, /* out: multiplicity of `knot' */
+                 tsStatus *status)
 {
-	const size_t deg = ts_bspline_degree(spline);
-	const size_t num_knots = ts_bspline_num_knots(spline);
-	const tsReal *knots = ts_int_bspline_access_knots(spline);
-	tsReal min, max;
+	const tsReal min = ts_int_knot_at(knots, target, t, deg * ks);
+	const tsReal max = ts_int_knot_at(knots, target, t,
+	                                  (num_knots - deg - 1) * ks);
 	size_t low, high;
 
-	ts_bspline_domain(spline, &min, &max);
+	TS_INT_STATS_ADD(num_knot_searches, 1)
 	if (*knot < min) {
 		/* Avoid infinite loop (issue #222) */
 		if (ts_knots_equal(*knot, min)) *knot = min;
@@ -1198,14 +1991,32 @@ ts_int_bspline_find_knot(const tsBSpline *spline,
 	}
 
 	/* Based on 'The NURBS Book' (Les Piegl and Wayne Tiller). */
-	if (ts_knots_equal(*knot, knots[num_knots - 1])) {
+	if (ts_knots_equal(*knot, ts_int_knot_at(knots, target, t,
+	                                         (num_knots - 1) * ks))) {
 		*idx = num_knots - 1;
+	} else if (*idx + 1 < num_knots &&
+	           ts_int_knot_at(knots, target, t, *idx * ks) <= *knot &&
+	           *knot < ts_int_knot_at(knots, target, t,
+	                                  (*idx + 1) * ks)) {
+		/* The hint is the span of `knot'. As spans are half-open
+		   intervals, the span of a knot is unique. Thus, the hint
+		   yields the same index as the binary search below. */
+	} else if (*idx + 2 < num_knots &&
+	           ts_int_knot_at(knots, target, t,
+	                          (*idx + 1) * ks) <= *knot &&
+	           *knot < ts_int_knot_at(knots, target, t,
+	                                  (*idx + 2) * ks)) {
+		/* Coherent queries often move to the next span. */
+		(*idx)++;
 	} else {
 		low = 0;
 		high = num_knots - 1;
 		*idx = (low+high) / 2;
-		while (*knot < knots[*idx] || *knot >= knots[*idx + 1]) {
-			if (*knot < knots[*idx])
+		while (*knot < ts_int_knot_at(knots, target, t, *idx * ks) ||
+		       *knot >= ts_int_knot_at(knots, target, t,
+		                               (*idx + 1) * ks)) {
+			if (*knot < ts_int_knot_at(knots, target, t,
+			                           *idx * ks))
 				high = *idx;
 			else
 				low = *idx;
@@ -1215,15 +2026,17 @@ ts_int_bspline_find_knot(const tsBSpline *spline,
 
 	/* Handle floating point errors. */
 	while (*idx < num_knots - 1 && /* there is a next knot */
-	       ts_knots_equal(*knot, knots[*idx + 1])) {
+	       ts_knots_equal(*knot, ts_int_knot_at(knots, target, t,
+	                                            (*idx + 1) * ks))) {
 		(*idx)++;
 	}
-	if (ts_knots_equal(*knot, knots[*idx]))
-		*knot = knots[*idx]; /* set actual knot */
+	if (ts_knots_equal(*knot, ts_int_knot_at(knots, target, t, *idx * ks)))
+		*knot = ts_int_knot_at(knots, target, t, *idx * ks);
 
 	/* Calculate knot's multiplicity. */
 	for (*mult = deg + 1; *mult > 0 ; (*mult)--) {
-		if (ts_knots_equal(*knot, knots[*idx - (*mult-1)]))
+		if (ts_knots_equal(*knot, ts_int_knot_at(knots, target, t,
+		                   (*idx - (*mult-1)) * ks)))
 			break;
 	}
 
@@ -1231,19 +2044,34 @@ ts_int_bspline_find_knot(const tsBSpline *spline,
 }
 
 tsError
-ts_int_bspline_eval_woa(const tsBSpline *spline,
-                        tsReal u,
-                        tsDeBoorNet *net,
-                        tsStatus *status)
+ts_int_view_find_knot(const tsBSplineView *view,
+                      tsReal *knot, /* in: knot; out: actual knot */
+                      size_t *idx,  /* in: hint; out: index of `knot' */
+                      size_t *mult, /* out: multiplicity of `knot' */
+                      tsStatus *status)
 {
-	const size_t deg = ts_bspline_degree(spline);
-	const size_t order = ts_bspline_order(spline);
-	const size_t dim = ts_bspline_dimension(spline);
-	const size_t num_knots = ts_bspline_num_knots(spline);
+	return ts_int_find_knot(view->knots, NULL, (tsReal) 0.0,
+	                        view->knot_stride, view->degree,
+	                        view->num_control_points + view->degree + 1,
+	                        knot, idx, mult, status);
+}
+
+tsError
+ts_int_view_eval_woa(const tsBSplineView *view,
+                     tsReal u,
+                     tsDeBoorNet *net,
+                     tsStatus *status)
+{
+	const size_t deg = view->degree;
+	const size_t order = deg + 1;
+	const size_t dim = view->dimension;
+	const size_t num_knots = view->num_control_points + order;
 	const size_t sof_ctrlp = dim * sizeof(tsReal);
+	const size_t cs = view->control_point_stride;
+	const size_t ks = view->knot_stride;
 
-	const tsReal *ctrlp = ts_int_bspline_access_ctrlp(spline);
-	const tsReal *knots = ts_int_bspline_access_knots(spline);
+	const tsReal *ctrlp = view->control_points;
+	const tsReal *knots = view->knots;
 	tsReal *points = NULL;  /**< Pointer to the points of \p net. */
 
 	size_t k;        /**< Index of \p u. */
@@ -1264,16 +2092,19 @@ ts_int_bspline_eval_woa(const tsBSpline *spline,
 
 	tsError err;
 
+	TS_INT_STATS_ADD(num_evals, 1)
 	points = ts_int_deboornet_access_points(net);
 
 	/* 1. Find index k such that u is in between [u_k, u_k+1).
 	 * 2. Setup already known values.
 	 * 3. Decide by multiplicity of u how to calculate point P(u). */
 
-	/* 1. */
-	k = s = 0;
-	TS_CALL_ROE(err, ts_int_bspline_find_knot(
-	            spline, &u, &k, &s, status))
+	/* 1. The span of the previous evaluation (if any) serves as a
+	 * hint. */
+	k = net->pImpl->k;
+	s = 0;
+	TS_CALL_ROE(err, ts_int_view_find_knot(
+	            view, &u, &k, &s, status))
 
 	/* 2. */
 	net->pImpl->u = u;
@@ -1291,13 +2122,14 @@ ts_int_bspline_eval_woa(const tsBSpline *spline,
 		/* only one of the two control points exists */
 		if (k == deg || /* only the first */
 		    k == num_knots - 1) { /* only the last */
-			from = k == deg ? 0 : (k-s) * dim;
+			from = k == deg ? 0 : (k-s) * cs;
 			net->pImpl->n_points = 1;
 			memcpy(points, ctrlp + from, sof_ctrlp);
 		} else {
-			from = (k-s) * dim;
+			from = (k-s) * cs;
 			net->pImpl->n_points = 2;
-			memcpy(points, ctrlp + from, 2 * sof_ctrlp);
+			memcpy(points, ctrlp + from, sof_ctrlp);
+			memcpy(points + dim, ctrlp + from + cs, sof_ctrlp);
 		}
 	} else { /* by 3a) s <= deg (order = deg+1) */
 		fst = k-deg; /* by 1. k >= deg */
@@ -1307,7 +2139,15 @@ ts_int_bspline_eval_woa(const tsBSpline *spline,
 		net->pImpl->n_points = (size_t)(N * (N+1) * 0.5f);
 
 		/* copy initial values to output */
-		memcpy(points, ctrlp + fst*dim, N * sof_ctrlp);
+		if (cs == dim) {
+			memcpy(points, ctrlp + fst*dim, N * sof_ctrlp);
+		} else {
+			for (i = 0; i < N; i++) {
+				memcpy(points + i*dim,
+				       ctrlp + (fst+i) * cs,
+				       sof_ctrlp);
+			}
+		}
 
 		lidx = 0;
 		ridx = dim;
@@ -1316,16 +2156,22 @@ ts_int_bspline_eval_woa(const tsBSpline *spline,
 		for (;r <= ts_deboornet_num_insertions(net); r++) {
 			i = fst + r;
 			for (; i <= lst; i++) {
-				ui = knots[i];
+				ui = knots[i * ks];
 				a = (ts_deboornet_knot(net) - ui) /
-					(knots[i+deg-r+1] - ui);
+					(knots[(i+deg-r+1) * ks] - ui);
 				a_hat = 1.f-a;
 
+				/* Indexed by `d' only, so that compilers can
+				   vectorize this loop (e.g., with SSE2 or
+				   WebAssembly SIMD). */
 				for (d = 0; d < dim; d++) {
-					points[tidx++] =
-						a_hat * points[lidx++] +
-						a     * points[ridx++];
+					points[tidx + d] =
+						a_hat * points[lidx + d] +
+						a     * points[ridx + d];
 				}
+				tidx += dim;
+				lidx += dim;
+				ridx += dim;
 			}
 			lidx += dim;
 			ridx += dim;
@@ -1335,31 +2181,64 @@ ts_int_bspline_eval_woa(const tsBSpline *spline,
 }
 
 tsError
-ts_bspline_eval(const tsBSpline *spline,
-                tsReal knot,
-                tsDeBoorNet *net,
-                tsStatus *status)
+ts_int_bspline_eval_woa(const tsBSpline *spline,
+                        tsReal u,
+                        tsDeBoorNet *net,
+                        tsStatus *status)
+{
+	tsBSplineView view;
+	ts_bspline_as_view(spline, &view);
+	return ts_int_view_eval_woa(&view, u, net, status);
+}
+
+tsError
+ts_int_bspline_view_eval(const tsBSplineView *view,
+                         tsReal knot,
+                         tsDeBoorNet *net,
+                         tsStatus *status)
 {
 	tsError err;
 	ts_int_deboornet_init(net);
 	TS_TRY(try, err, status)
-		TS_CALL(try, err, ts_int_deboornet_new(
-		        spline, net, status))
-		TS_CALL(try, err, ts_int_bspline_eval_woa(
-		        spline, knot, net, status))
+		TS_CALL(try, err, ts_int_view_deboornet_new(
+		        view, net, status))
+		TS_CALL(try, err, ts_int_view_eval_woa(
+		        view, knot, net, status))
 	TS_CATCH(err)
 		ts_deboornet_free(net);
 	TS_END_TRY_RETURN(err)
 }
 
 tsError
-ts_bspline_eval_all(const tsBSpline *spline,
-                    const tsReal *knots,
-                    size_t num,
-                    tsReal **points,
-                    tsStatus *status)
+ts_bspline_view_eval(const tsBSplineView *view,
+                     tsReal knot,
+                     tsDeBoorNet *net,
+                     tsStatus *status)
 {
-	const size_t dim = ts_bspline_dimension(spline);
+	TS_INT_API_SCOPE(ts_bspline_view_eval,
+		ts_int_bspline_view_eval(view, knot, net, status))
+}
+
+tsError
+ts_bspline_eval(const tsBSpline *spline,
+                tsReal knot,
+                tsDeBoorNet *net,
+                tsStatus *status)
+{
+	tsBSplineView view;
+	ts_bspline_as_view(spline, &view);
+	TS_INT_API_SCOPE(ts_bspline_eval,
+		ts_int_bspline_view_eval(&view, knot, net, status))
+}
+
+tsError
+ts_int_bspline_view_eval_all(const tsBSplineView *view,
+                             const tsReal *knots,
+                             size_t num,
+                             tsReal **points,
+                             tsStatus *status)
+{
+	const size_t dim = view->dimension;
 	const size_t sof_point = dim * sizeof(tsReal);
 	const size_t sof_points = num * sof_point;
 	tsDeBoorNet net = ts_deboornet_init();
@@ -1367,16 +2246,17 @@ ts_bspline_eval_all(const tsBSpline *spline,
 	size_t i;
 	tsError err;
 	TS_TRY(try, err, status)
+		TS_INT_STATS_ALLOC(sof_points)
 		*points = (tsReal *) malloc(sof_points);
 		if (!*points) {
 			TS_THROW_0(try, err, status, TS_MALLOC,
 			           "out of memory")
 		}
-		TS_CALL(try, err, ts_int_deboornet_new(
-		        spline,&net, status))
+		TS_CALL(try, err, ts_int_view_deboornet_new(
+		        view, &net, status))
 		for (i = 0; i < num; i++) {
-			TS_CALL(try, err, ts_int_bspline_eval_woa(
-			        spline, knots[i], &net, status))
+			TS_CALL(try, err, ts_int_view_eval_woa(
+			        view, knots[i], &net, status))
 			result = ts_int_deboornet_access_result(&net);
 			memcpy((*points) + i * dim, result, sof_point);
 		}
@@ -1390,44 +2270,329 @@ ts_bspline_eval_all(const tsBSpline *spline,
 }
 
 tsError
-ts_bspline_sample(const tsBSpline *spline,
-                  size_t num,
-                  tsReal **points,
-                  size_t *actual_num,
-                  tsStatus *status)
+ts_bspline_view_eval_all(const tsBSplineView *view,
+                         const tsReal *knots,
+                         size_t num,
+                         tsReal **points,
+                         tsStatus *status)
+{
+	TS_INT_API_SCOPE(ts_bspline_view_eval_all,
+		ts_int_bspline_view_eval_all(view, knots, num, points, status))
+}
+
+tsError
+ts_bspline_eval_all(const tsBSpline *spline,
+                    const tsReal *knots,
+                    size_t num,
+                    tsReal **points,
+                    tsStatus *status)
+{
+	tsBSplineView view;
+	ts_bspline_as_view(spline, &view);
+	TS_INT_API_SCOPE(ts_bspline_eval_all,
+		ts_int_bspline_view_eval_all(&view, knots, num, points, status))
+}
+
+void
+ts_int_uniform_knot_seq(tsReal min,
+                        tsReal max,
+                        size_t num,
+                        tsReal *knots)
+{
+	size_t i;
+	if (num == 0) return;
+	for (i = 0; i < num; i++) {
+		knots[i] = max - min;
+		knots[i] *= (tsReal) i / (num - 1);
+		knots[i] += min;
+	}
+	/* Set `knots[0]` after `knots[num - 1]` to ensure
+	   that `knots[0] = min` if `num` is `1'. */
+	knots[num - 1] = max;
+	knots[0] = min;
+}
+
+tsError
+ts_int_bspline_view_sample(const tsBSplineView *view,
+                           size_t num,
+                           tsReal **points,
+                           size_t *actual_num,
+                           tsStatus *status)
 {
 	tsError err;
-	tsReal *knots;
+	tsReal *knots, min, max;
 
 	num = num == 0 ? 100 : num;
 	*actual_num = num;
-	knots = (tsReal *) malloc(num * sizeof(tsReal));
+	knots = (tsReal *) ts_int_malloc(num * sizeof(tsReal));
 	if (!knots) {
 		*points = NULL;
 		TS_RETURN_0(status, TS_MALLOC, "out of memory")
 	}
-	ts_bspline_uniform_knot_seq(spline, num, knots);
+	ts_bspline_view_domain(view, &min, &max);
+	ts_int_uniform_knot_seq(min, max, num, knots);
 	TS_TRY(try, err, status)
-		TS_CALL(try, err, ts_bspline_eval_all(
-		        spline, knots, num, points, status))
+		TS_CALL(try, err, ts_int_bspline_view_eval_all(
+		        view, knots, num, points, status))
 	TS_FINALLY
-		free(knots);
+		ts_int_free(knots);
 	TS_END_TRY_RETURN(err)
 }
 
 tsError
-ts_bspline_bisect(const tsBSpline *spline,
-                  tsReal value,
-                  tsReal epsilon,
-                  int persnickety,
-                  size_t index,
-                  int ascending,
-                  size_t max_iter,
-                  tsDeBoorNet *net,
+ts_bspline_view_sample(const tsBSplineView *view,
+                       size_t num,
+                       tsReal **points,
+                       size_t *actual_num,
+                       tsStatus *status)
+{
+	TS_INT_API_SCOPE(ts_bspline_view_sample,
+		ts_int_bspline_view_sample(view, num, points, actual_num,
+		                           status))
+}
+
+tsError
+ts_bspline_sample(const tsBSpline *spline,
+                  size_t num,
+                  tsReal **points,
+                  size_t *actual_num,
                   tsStatus *status)
 {
+	tsBSplineView view;
+	ts_bspline_as_view(spline, &view);
+	TS_INT_API_SCOPE(ts_bspline_sample,
+		ts_int_bspline_view_sample(&view, num, points, actual_num,
+		                           status))
+}
+
+/**
+ * The maximum subdivision depth of a Bezier curve in ::ts_bspline_tessellate.
+ */
+#define TS_INT_TESSELLATE_MAX_DEPTH 24
+
+/**
+ * Stores the state of ::ts_bspline_tessellate.
+ */
+struct tsTessellation
+{
+	size_t order; /**< Order of the Bezier curves. */
+	size_t dim; /**< Dimensionality of the points. */
+	tsReal tol2; /**< Squared tolerance. */
+	tsReal *work; /**< Subdivision buffer (left and right per depth). */
+	tsReal **points; /**< Output buffer. */
+	size_t *capacity; /**< Capacity of `points'. */
+	size_t *num_points; /**< Number of points in `points'. */
+	tsGrowFunc grow; /**< Used to grow `points'. */
+	void *user_data; /**< Passed to `grow'. */
+};
+
+void *
+ts_int_default_grow(void *buffer,
+                    size_t size,
+                    void *user_data)
+{
+	(void) user_data;
+	return realloc(buffer, size);
+}
+
+tsReal
+ts_int_segment_distance_sq(const tsReal *point,
+                           const tsReal *first,
+                           const tsReal *last,
+                           size_t dim)
+{
+	tsReal len_sq = (tsReal) 0.0; /**< Squared length of the segment. */
+	tsReal proj = (tsReal) 0.0; /**< Projection of point onto segment. */
+	tsReal dist_sq = (tsReal) 0.0;
+	tsReal t, d;
+	size_t i;
+
+	for (i = 0; i < dim; i++) {
+		d = last[i] - first[i];
+		len_sq += d * d;
+		proj += (point[i] - first[i]) * d;
+	}
+	t = len_sq > (tsReal) 0.0 ? proj / len_sq : (tsReal) 0.0;
+	if (t < (tsReal) 0.0) t = (tsReal) 0.0;
+	else if (t > (tsReal) 1.0) t = (tsReal) 1.0;
+	for (i = 0; i < dim; i++) {
+		d = point[i] - (first[i] + t * (last[i] - first[i]));
+		dist_sq += d * d;
+	}
+	return dist_sq;
+}
+
+tsError
+ts_int_tessellation_emit(struct tsTessellation *tess,
+                         const tsReal *point,
+                         tsStatus *status)
+{
+	const size_t sof_point = tess->dim * sizeof(tsReal);
+	size_t capacity;
+	void *grown;
+
+	if (*tess->num_points >= *tess->capacity) {
+		capacity = *tess->capacity < 16 ? 32 : *tess->capacity * 2;
+		TS_INT_STATS_ALLOC(capacity * sof_point)
+		grown = tess->grow(*tess->points,
+		                   capacity * sof_point,
+		                   tess->user_data);
+		if (!grown) {
+			TS_RETURN_0(status, TS_MALLOC, "out of memory")
+		}
+		*tess->points = (tsReal *) grown;
+		*tess->capacity = capacity;
+	}
+	memcpy(*tess->points + *tess->num_points * tess->dim,
+	       point, sof_point);
+	(*tess->num_points)++;
+	TS_RETURN_SUCCESS(status)
+}
+
+tsError
+ts_int_tessellate_bezier(struct tsTessellation *tess,
+                         const tsReal *ctrlp,
+                         size_t depth,
+                         tsStatus *status)
+{
+	const size_t order = tess->order;
+	const size_t dim = tess->dim;
+	const size_t sof_point = dim * sizeof(tsReal);
+	const tsReal *last = ctrlp + (order - 1) * dim;
+	tsReal *left, *right; /**< Subdivided control points. */
+	int flat = 1;
+	size_t i, j, d;
 	tsError err;
+
+	for (i = 1; flat && i + 1 < order; i++) {
+		if (ts_int_segment_distance_sq(ctrlp + i * dim, ctrlp, last,
+		                               dim) > tess->tol2)
+			flat = 0;
+	}
+	if (flat || depth >= TS_INT_TESSELLATE_MAX_DEPTH) {
+		TS_CALL_ROE(err, ts_int_tessellation_emit(
+		            tess, last, status))
+		TS_RETURN_SUCCESS(status)
+	}
+
+	/* Subdivide at 0.5 (de Casteljau). `right' serves as triangle buffer
+	 * whose i-th last value is final after the i-th iteration. */
+	left = tess->work + depth * 2 * order * dim;
+	right = left + order * dim;
+	memcpy(right, ctrlp, order * sof_point);
+	memcpy(left, ctrlp, sof_point);
+	for (i = 1; i < order; i++) {
+		for (j = 0; j < order - i; j++) {
+			for (d = 0; d < dim; d++) {
+				right[j*dim + d] = (tsReal) 0.5 *
+					(right[j*dim + d] +
+					 right[(j+1)*dim + d]);
+			}
+		}
+		memcpy(left + i * dim, right, sof_point);
+	}
+	TS_CALL_ROE(err, ts_int_tessellate_bezier(
+	            tess, left, depth + 1, status))
+	TS_CALL_ROE(err, ts_int_tessellate_bezier(
+	            tess, right, depth + 1, status))
+	TS_RETURN_SUCCESS(status)
+}
+
+tsError
+ts_int_bspline_tessellate(const tsBSpline *spline,
+                          tsReal tolerance,
+                          tsReal **points,
+                          size_t *capacity,
+                          size_t *num_points,
+                          tsGrowFunc grow,
+                          void *user_data,
+                          tsStatus *status)
+{
+	const size_t order = ts_bspline_order(spline);
 	const size_t dim = ts_bspline_dimension(spline);
+	tsBSpline beziers = ts_bspline_init();
+	struct tsTessellation tess;
+	const tsReal *ctrlp, *prev;
+	size_t num_beziers, i;
+	tsError err;
+
+	if (tolerance < TS_POINT_EPSILON)
+		tolerance = TS_POINT_EPSILON;
+	if (!*points)
+		*capacity = 0;
+	*num_points = 0;
+
+	tess.order = order;
+	tess.dim = dim;
+	tess.tol2 = tolerance * tolerance;
+	tess.work = NULL;
+	tess.points = points;
+	tess.capacity = capacity;
+	tess.num_points = num_points;
+	tess.grow = grow ? grow : ts_int_default_grow;
+	tess.user_data = user_data;
+
+	TS_TRY(try, err, status)
+		TS_CALL(try, err, ts_bspline_to_beziers(
+		        spline, &beziers, status))
+		tess.work = (tsReal *) ts_int_malloc(
+			TS_INT_TESSELLATE_MAX_DEPTH * 2 * order * dim *
+			sizeof(tsReal));
+		if (!tess.work) {
+			TS_THROW_0(try, err, status, TS_MALLOC,
+			           "out of memory")
+		}
+		ctrlp = ts_int_bspline_access_ctrlp(&beziers);
+		num_beziers = ts_bspline_num_control_points(&beziers) / order;
+		for (i = 0; i < num_beziers; i++) {
+			/* Emit the first point of a Bezier curve only if the
+			 * spline is discontinuous at this point. */
+			prev = *num_points == 0 ? NULL :
+				*points + (*num_points - 1) * dim;
+			if (!prev || ts_distance(prev, ctrlp, dim) >
+			             TS_POINT_EPSILON) {
+				TS_CALL(try, err, ts_int_tessellation_emit(
+				        &tess, ctrlp, status))
+			}
+			TS_CALL(try, err, ts_int_tessellate_bezier(
+			        &tess, ctrlp, 0, status))
+			ctrlp += order * dim;
+		}
+	TS_FINALLY
+		ts_bspline_free(&beziers);
+		if (tess.work)
+			ts_int_free(tess.work);
+	TS_END_TRY_RETURN(err)
+}
+
+tsError
+ts_bspline_tessellate(const tsBSpline *spline,
+                      tsReal tolerance,
+                      tsReal **points,
+                      size_t *capacity,
+                      size_t *num_points,
+                      tsGrowFunc grow,
+                      void *user_data,
+                      tsStatus *status)
+{
+	TS_INT_API_SCOPE(ts_bspline_tessellate,
+		ts_int_bspline_tessellate(spline, tolerance, points, capacity,
+		                          num_points, grow, user_data, status))
+}
+
+tsError
+ts_int_bspline_view_bisect(const tsBSplineView *view,
+                           tsReal value,
+                           tsReal epsilon,
+                           int persnickety,
+                           size_t index,
+                           int ascending,
+                           size_t max_iter,
+                           tsDeBoorNet *net,
+                           tsStatus *status)
+{
+	tsError err;
+	const size_t dim = view->dimension;
 	const tsReal eps = (tsReal) fabs(epsilon);
 	size_t i = 0;
 	tsReal dist = 0;
@@ -1445,14 +2610,14 @@ ts_bspline_bisect(const tsBSpline *spline,
 	if(max_iter == 0)
 		TS_RETURN_0(status, TS_NO_RESULT, "0 iterations")
 
-	ts_bspline_domain(spline, &min, &max);
+	ts_bspline_view_domain(view, &min, &max);
 	TS_TRY(try, err, status)
-		TS_CALL(try, err, ts_int_deboornet_new(
-		        spline, net, status))
+		TS_CALL(try, err, ts_int_view_deboornet_new(
+		        view, net, status))
 		do {
 			mid = (tsReal) ((min + max) / 2.0);
-			TS_CALL(try, err, ts_int_bspline_eval_woa(
-			        spline, mid, net, status))
+			TS_CALL(try, err, ts_int_view_eval_woa(
+			        view, mid, net, status))
 			P = ts_int_deboornet_access_result(net);
 			dist = ts_distance(&P[index], &value, 1);
 			if (dist <= eps)
@@ -1479,6 +2644,42 @@ ts_bspline_bisect(const tsBSpline *spline,
 	TS_END_TRY_RETURN(err)
 }
 
+tsError
+ts_bspline_view_bisect(const tsBSplineView *view,
+                       tsReal value,
+                       tsReal epsilon,
+                       int persnickety,
+                       size_t index,
+                       int ascending,
+                       size_t max_iter,
+                       tsDeBoorNet *net,
+                       tsStatus *status)
+{
+	TS_INT_API_SCOPE(ts_bspline_view_bisect,
+		ts_int_bspline_view_bisect(view, value, epsilon, persnickety,
+		                           index, ascending, max_iter, net,
+		                           status))
+}
+
+tsError
+ts_bspline_bisect(const tsBSpline *spline,
+                  tsReal value,
+                  tsReal epsilon,
+                  int persnickety,
+                  size_t index,
+                  int ascending,
+                  size_t max_iter,
+                  tsDeBoorNet *net,
+                  tsStatus *status)
+{
+	tsBSplineView view;
+	ts_bspline_as_view(spline, &view);
+	TS_INT_API_SCOPE(ts_bspline_bisect,
+		ts_int_bspline_view_bisect(&view, value, epsilon, persnickety,
+		                           index, ascending, max_iter, net,
+		                           status))
+}
+
 void ts_bspline_domain(const tsBSpline *spline,
                        tsReal *min,
                        tsReal *max)
@@ -1534,12 +2735,12 @@ ts_bspline_is_closed(const tsBSpline *spline,
 }
 
 tsError
-ts_bspline_compute_rmf(const tsBSpline *spline,
-                       const tsReal *knots,
-                       size_t num,
-                       int has_first_normal,
-                       tsFrame *frames,
-                       tsStatus *status)
+ts_int_bspline_compute_rmf(const tsBSpline *spline,
+                           const tsReal *knots,
+                           size_t num,
+                           int has_first_normal,
+                           tsFrame *frames,
+                           tsStatus *status)
 {
 	tsError err;
 	size_t i;
@@ -1686,17 +2887,30 @@ ts_bspline_compute_rmf(const tsBSpline *spline,
 	TS_END_TRY_RETURN(err)
 }
 
+tsError
+ts_bspline_compute_rmf(const tsBSpline *spline,
+                       const tsReal *knots,
+                       size_t num,
+                       int has_first_normal,
+                       tsFrame *frames,
+                       tsStatus *status)
+{
+	TS_INT_API_SCOPE(ts_bspline_compute_rmf,
+		ts_int_bspline_compute_rmf(spline, knots, num, has_first_normal,
+		                           frames, status))
+}
+
 
 tsError
-ts_bspline_chord_lengths(const tsBSpline *spline,
-                         const tsReal *knots,
-                         size_t num,
-                         tsReal *lengths,
-                         tsStatus *status)
+ts_int_bspline_view_chord_lengths(const tsBSplineView *view,
+                                  const tsReal *knots,
+                                  size_t num,
+                                  tsReal *lengths,
+                                  tsStatus *status)
 {
 	tsError err;
 	tsReal dist, lst_knot, cur_knot;
-	size_t i, dim = ts_bspline_dimension(spline);
+	size_t i, dim = view->dimension;
 	tsDeBoorNet lst = ts_deboornet_init();
 	tsDeBoorNet cur = ts_deboornet_init();
 	tsDeBoorNet tmp = ts_deboornet_init();
@@ -1704,19 +2918,19 @@ ts_bspline_chord_lengths(const tsBSpline *spline,
 	if (num == 0) TS_RETURN_SUCCESS(status);
 
 	TS_TRY(try, err, status)
-		TS_CALL(try, err, ts_int_deboornet_new(
-		        spline, &lst, status))
-		TS_CALL(try, err, ts_int_deboornet_new(
-		        spline, &cur, status))
+		TS_CALL(try, err, ts_int_view_deboornet_new(
+		        view, &lst, status))
+		TS_CALL(try, err, ts_int_view_deboornet_new(
+		        view, &cur, status))
 
 		/* num >= 1 */
-		TS_CALL(try, err, ts_int_bspline_eval_woa(
-		        spline, knots[0], &lst, status));
+		TS_CALL(try, err, ts_int_view_eval_woa(
+		        view, knots[0], &lst, status));
 		lengths[0] = (tsReal) 0.0;
 
 		for (i = 1; i < num; i++) {
-			TS_CALL(try, err, ts_int_bspline_eval_woa(
-			        spline, knots[i], &cur, status));
+			TS_CALL(try, err, ts_int_view_eval_woa(
+			        view, knots[i], &cur, status));
 			lst_knot = ts_deboornet_knot(&lst);
 			cur_knot = ts_deboornet_knot(&cur);
 			if (cur_knot < lst_knot) {
@@ -1738,6 +2952,32 @@ ts_bspline_chord_lengths(const tsBSpline *spline,
 	TS_END_TRY_RETURN(err)
 }
 
+tsError
+ts_bspline_view_chord_lengths(const tsBSplineView *view,
+                              const tsReal *knots,
+                              size_t num,
+                              tsReal *lengths,
+                              tsStatus *status)
+{
+	TS_INT_API_SCOPE(ts_bspline_view_chord_lengths,
+		ts_int_bspline_view_chord_lengths(view, knots, num, lengths,
+		                                  status))
+}
+
+tsError
+ts_bspline_chord_lengths(const tsBSpline *spline,
+                         const tsReal *knots,
+                         size_t num,
+                         tsReal *lengths,
+                         tsStatus *status)
+{
+	tsBSplineView view;
+	ts_bspline_as_view(spline, &view);
+	TS_INT_API_SCOPE(ts_bspline_chord_lengths,
+		ts_int_bspline_view_chord_lengths(&view, knots, num, lengths,
+		                                  status))
+}
+
 
 tsError
 ts_bspline_sub_spline(const tsBSpline *spline,
@@ -1783,7 +3023,7 @@ ts_bspline_sub_spline(const tsBSpline *spline,
 	 * spline. */
 	reverse = knot0 > knot1;
 	if (reverse) { /* swap `knot0` and `knot1` */
-		tmp = (tsReal *) malloc(dim * sizeof(tsReal));
+		tmp = (tsReal *) ts_int_malloc(dim * sizeof(tsReal));
 		if (!tmp) TS_RETURN_0(status, TS_MALLOC, "out of memory");
 		*tmp = knot0; /* `tmp` can  hold at least one value */
 		knot0 = knot1;
@@ -1840,7 +3080,7 @@ ts_bspline_sub_spline(const tsBSpline *spline,
 			worker.pImpl->n_knots = nk;
 			worker.pImpl->n_ctrlp = nc;
 			i = ts_int_bspline_sof_state(&worker);
-			worker.pImpl = realloc(worker.pImpl, i);
+			worker.pImpl = ts_int_realloc(worker.pImpl, i);
 			if (worker.pImpl == NULL) { /* unlikely to fail */
 				TS_THROW_0(try, err, status, TS_MALLOC,
 				           "out of memory")
@@ -1868,7 +3108,7 @@ ts_bspline_sub_spline(const tsBSpline *spline,
 	TS_CATCH(err)
 		ts_bspline_free(&worker);
 	TS_FINALLY
-		if (tmp) free(tmp);
+		if (tmp) ts_int_free(tmp);
 	TS_END_TRY_RETURN(err)
 }
 
@@ -1877,19 +3117,9 @@ ts_bspline_uniform_knot_seq(const tsBSpline *spline,
                             size_t num,
                             tsReal *knots)
 {
-	size_t i;
 	tsReal min, max;
-	if (num == 0) return;
 	ts_bspline_domain(spline, &min, &max);
-	for (i = 0; i < num; i++) {
-		knots[i] = max - min;
-		knots[i] *= (tsReal) i / (num - 1);
-		knots[i] += min;
-	}
-	/* Set `knots[0]` after `knots[num - 1]` to ensure
-	   that `knots[0] = min` if `num` is `1'. */
-	knots[num - 1] = max;
-	knots[0] = min;
+	ts_int_uniform_knot_seq(min, max, num, knots);
 }
 
 tsError
@@ -1905,7 +3135,7 @@ ts_bspline_equidistant_knot_seq(const tsBSpline *spline,
 	if (num == 0) TS_RETURN_SUCCESS(status);
 	if (num_samples == 0) num_samples = 200;
 
-	samples = (tsReal *) malloc(2 * num_samples * sizeof(tsReal));
+	samples = (tsReal *) ts_int_malloc(2 * num_samples * sizeof(tsReal));
 	if (!samples) TS_RETURN_0(status, TS_MALLOC, "out of memory");
 	ts_bspline_uniform_knot_seq(spline, num_samples, samples);
 	lengths = samples + num_samples;
@@ -1915,1228 +3145,6029 @@ ts_bspline_equidistant_knot_seq(const tsBSpline *spline,
 		TS_CALL(try, err, ts_chord_lengths_equidistant_knot_seq(
 		        samples, lengths, num_samples, num, knots, status))
 	TS_FINALLY
-		free(samples); /* cannot be NULL */
+		ts_int_free(samples); /* cannot be NULL */
 		/* free(lengths); NO! */
 	TS_END_TRY_RETURN(err)
 }
 /*! @} */
 
 
-
-/*! @name Transformation Functions
+/*! @name Evaluation Context
  *
  * @{
  */
-tsError
-ts_int_bspline_resize(const tsBSpline *spline,
-                      int n,
-                      int back,
-                      tsBSpline *resized,
-                      tsStatus *status)
+struct tsEvalContextImpl
 {
-	const size_t deg = ts_bspline_degree(spline);
-	const size_t dim = ts_bspline_dimension(spline);
-	const size_t sof_real = sizeof(tsReal);
-
-	const size_t num_ctrlp = ts_bspline_num_control_points(spline);
-	const size_t num_knots = ts_bspline_num_knots(spline);
-	const size_t nnum_ctrlp = num_ctrlp + n; /**< New length of ctrlp. */
-	const size_t nnum_knots = num_knots + n; /**< New length of knots. */
-	const size_t min_num_ctrlp_vec = n < 0 ? nnum_ctrlp : num_ctrlp;
-	const size_t min_num_knots_vec = n < 0 ? nnum_knots : num_knots;
-
-	const size_t sof_min_num_ctrlp = min_num_ctrlp_vec * dim * sof_real;
-	const size_t sof_min_num_knots = min_num_knots_vec * sof_real;
+	size_t max_deg; /**< Maximum degree supported by `net'. */
+	size_t max_dim; /**< Maximum dimensionality supported by `net'. */
+	tsDeBoorNet net; /**< Reused net. Its span serves as hint. */
+};
 
-	tsBSpline tmp; /**< Temporarily stores the result. */
-	const tsReal* from_ctrlp = ts_int_bspline_access_ctrlp(spline);
-	const tsReal* from_knots = ts_int_bspline_access_knots(spline);
-	tsReal* to_ctrlp = NULL; /**< Pointer to the control points of tmp. */
-	tsReal* to_knots = NULL; /**< Pointer to the knots of tmp. */
+tsEvalContext
+ts_eval_context_init(void)
+{
+	tsEvalContext ctx;
+	ctx.pImpl = NULL;
+	return ctx;
+}
 
+tsError
+ts_eval_context_new(size_t max_degree,
+                    size_t max_dimension,
+                    tsEvalContext *ctx,
+                    tsStatus *status)
+{
+	const size_t sof_impl = sizeof(struct tsEvalContextImpl);
 	tsError err;
 
-	if (n == 0) return ts_bspline_copy(spline, resized, status);
-
-	INIT_OUT_BSPLINE(spline, resized)
-	TS_CALL_ROE(err, ts_bspline_new(
-	            nnum_ctrlp, dim, deg, TS_OPENED,
-	            &tmp, status))
-	to_ctrlp = ts_int_bspline_access_ctrlp(&tmp);
-	to_knots = ts_int_bspline_access_knots(&tmp);
+	ctx->pImpl = NULL;
+	if (max_dimension < 1)
+		TS_RETURN_0(status, TS_DIM_ZERO, "unsupported dimension: 0")
+	ctx->pImpl = (struct tsEvalContextImpl *) ts_int_malloc(sof_impl);
+	if (!ctx->pImpl) TS_RETURN_0(status, TS_MALLOC, "out of memory")
+	ctx->pImpl->max_deg = max_degree;
+	ctx->pImpl->max_dim = max_dimension;
+	TS_TRY(try, err, status)
+		TS_CALL(try, err, ts_int_deboornet_new_sized(
+		        max_degree, max_dimension, &ctx->pImpl->net, status))
+	TS_CATCH(err)
+		ts_int_free(ctx->pImpl);
+		ctx->pImpl = NULL;
+	TS_END_TRY_RETURN(err)
+}
 
-	/* Copy control points and knots. */
-	if (!back && n < 0) {
-		memcpy(to_ctrlp, from_ctrlp - n*dim, sof_min_num_ctrlp);
-		memcpy(to_knots, from_knots - n    , sof_min_num_knots);
-	} else if (!back && n > 0) {
-		memcpy(to_ctrlp + n*dim, from_ctrlp, sof_min_num_ctrlp);
-		memcpy(to_knots + n    , from_knots, sof_min_num_knots);
-	} else {
-		/* n != 0 implies back == true */
-		memcpy(to_ctrlp, from_ctrlp, sof_min_num_ctrlp);
-		memcpy(to_knots, from_knots, sof_min_num_knots);
+void
+ts_eval_context_free(tsEvalContext *ctx)
+{
+	if (ctx->pImpl) {
+		ts_deboornet_free(&ctx->pImpl->net);
+		ts_int_free(ctx->pImpl);
 	}
-
-	if (spline == resized)
-		ts_bspline_free(resized);
-	ts_bspline_move(&tmp, resized);
-	TS_RETURN_SUCCESS(status)
+	ctx->pImpl = NULL;
 }
 
 tsError
-ts_bspline_derive(const tsBSpline *spline,
-                  size_t n,
-                  tsReal epsilon,
-                  tsBSpline *deriv,
-                  tsStatus *status)
+ts_int_eval_context_reserve(tsEvalContext *ctx,
+                            size_t deg,
+                            size_t dim,
+                            tsStatus *status)
 {
-	const size_t sof_real = sizeof(tsReal);
-	const size_t dim = ts_bspline_dimension(spline);
-	const size_t sof_ctrlp = dim * sof_real;
-	size_t deg = ts_bspline_degree(spline);
-	size_t num_ctrlp = ts_bspline_num_control_points(spline);
-	size_t num_knots = ts_bspline_num_knots(spline);
+	struct tsEvalContextImpl *impl = ctx->pImpl;
+	tsDeBoorNet net = ts_deboornet_init();
+	tsError err;
 
-	tsBSpline worker; /**< Stores the intermediate result. */
-	tsReal* ctrlp;    /**< Pointer to the control points of worker. */
-	tsReal* knots;    /**< Pointer to the knots of worker. */
+	if (!impl)
+		return ts_eval_context_new(deg, dim, ctx, status);
+	if (deg <= impl->max_deg && dim <= impl->max_dim)
+		TS_RETURN_SUCCESS(status)
 
-	size_t m, i, j, k, l; /**< Used in for loops. */
-	tsReal *fst, *snd; /**< Pointer to first and second control point. */
-	tsReal dist; /**< Distance between fst and snd. */
-	tsReal kid1, ki1; /**< Knots at i+deg+1 and i+1. */
-	tsReal span; /**< Distance between kid1 and ki1. */
+	deg = deg > impl->max_deg ? deg : impl->max_deg;
+	dim = dim > impl->max_dim ? dim : impl->max_dim;
+	TS_CALL_ROE(err, ts_int_deboornet_new_sized(deg, dim, &net, status))
+	net.pImpl->k = impl->net.pImpl->k; /* keep hint */
+	ts_deboornet_free(&impl->net);
+	ts_deboornet_move(&net, &impl->net);
+	impl->max_deg = deg;
+	impl->max_dim = dim;
+	TS_RETURN_SUCCESS(status)
+}
 
-	tsBSpline swap; /**< Used to swap worker and derivative. */
+tsError
+ts_int_eval_context_view_eval(tsEvalContext *ctx,
+                              const tsBSplineView *view,
+                              tsReal knot,
+                              tsReal *point,
+                              tsStatus *status)
+{
+	const size_t dim = view->dimension;
+	tsDeBoorNet *net;
 	tsError err;
 
-	INIT_OUT_BSPLINE(spline, deriv)
-	TS_CALL_ROE(err, ts_bspline_copy(spline, &worker, status))
-	ctrlp = ts_int_bspline_access_ctrlp(&worker);
-	knots = ts_int_bspline_access_knots(&worker);
-
-	TS_TRY(try, err, status)
-		for (m = 1; m <= n; m++) { /* from 1st to n'th derivative */
-			if (deg == 0) {
-				ts_arr_fill(ctrlp, dim, 0.f);
-				ts_bspline_domain(spline,
-				                  &knots[0],
-				                  &knots[1]);
-				num_ctrlp = 1;
-				num_knots = 2;
-				break;
-			}
-			/* Check and, if possible, fix discontinuity. */
-			for (i = 2*deg + 1; i < num_knots - (deg+1); i++) {
-				if (!ts_knots_equal(knots[i], knots[i-deg]))
-					continue;
-				fst = ctrlp + (i - (deg+1)) * dim;
-				snd = fst + dim;
-				dist = ts_distance(fst, snd, dim);
-				if (epsilon >= 0.f && dist > epsilon) {
-					TS_THROW_1(try, err, status,
-					           TS_UNDERIVABLE,
-					           "discontinuity at knot: %f",
-					           knots[i])
-				}
-				memmove(snd,
-				        snd + dim,
-				        (num_ctrlp - (i+1-deg)) * sof_ctrlp);
-				memmove(&knots[i],
-				        &knots[i+1],
-				        (num_knots - (i+1)) * sof_real);
-				num_ctrlp--;
-				num_knots--;
-				i += deg-1;
-			}
-			/* Derive continuous worker. */
-			for (i = 0; i < num_ctrlp-1; i++) {
-				for (j = 0; j < dim; j++) {
-					k = i    *dim + j;
-					l = (i+1)*dim + j;
-					ctrlp[k] = ctrlp[l] - ctrlp[k];
-					kid1 = knots[i+deg+1];
-					ki1  = knots[i+1];
-					span = kid1 - ki1;
-					if (span < TS_KNOT_EPSILON)
-						span = TS_KNOT_EPSILON;
-					ctrlp[k] *= deg;
-					ctrlp[k] /= span;
-				}
-			}
-			deg       -= 1;
-			num_ctrlp -= 1;
-			num_knots -= 2;
-			knots     += 1;
-		}
-		TS_CALL(try, err, ts_bspline_new(
-		        num_ctrlp, dim, deg, TS_OPENED,
-		        &swap, status))
-		memcpy(ts_int_bspline_access_ctrlp(&swap),
-		       ctrlp,
-		       num_ctrlp * sof_ctrlp);
-		memcpy(ts_int_bspline_access_knots(&swap),
-		       knots,
-		       num_knots * sof_real);
-		if (spline == deriv)
-			ts_bspline_free(deriv);
-		ts_bspline_move(&swap, deriv);
-	TS_FINALLY
-		ts_bspline_free(&worker);
-	TS_END_TRY_RETURN(err)
+	TS_CALL_ROE(err, ts_int_eval_context_reserve(
+	            ctx, view->degree, dim, status))
+	net = &ctx->pImpl->net;
+	net->pImpl->dim = dim;
+	TS_CALL_ROE(err, ts_int_view_eval_woa(view, knot, net, status))
+	if (point) {
+		memcpy(point, ts_int_deboornet_access_result(net),
+		       dim * sizeof(tsReal));
+	}
+	TS_RETURN_SUCCESS(status)
 }
 
 tsError
-ts_int_bspline_insert_knot(const tsBSpline *spline,
-                           const tsDeBoorNet *net,
-                           size_t n,
-                           tsBSpline *result,
-                           tsStatus *status)
+ts_eval_context_view_eval(tsEvalContext *ctx,
+                          const tsBSplineView *view,
+                          tsReal knot,
+                          tsReal *point,
+                          tsStatus *status)
 {
-	const size_t deg = ts_bspline_degree(spline);
-	const size_t order = ts_bspline_order(spline);
-	const size_t dim = ts_bspline_dimension(spline);
-	const tsReal knot = ts_deboornet_knot(net);
-	const size_t k = ts_deboornet_index(net);
-	const size_t mult = ts_deboornet_multiplicity(net);
-	const size_t sof_real = sizeof(tsReal);
-	const size_t sof_ctrlp = dim * sof_real;
+	TS_INT_API_SCOPE(ts_eval_context_view_eval,
+		ts_int_eval_context_view_eval(ctx, view, knot, point, status))
+}
 
-	size_t N;     /**< Number of affected control points. */
-	tsReal* from; /**< Pointer to copy the values from. */
-	tsReal* to;   /**< Pointer to copy the values to. */
-	int stride;   /**< Stride of the next pointer to copy. */
-	size_t i;     /**< Used in for loops. */
+tsError
+ts_eval_context_eval(tsEvalContext *ctx,
+                     const tsBSpline *spline,
+                     tsReal knot,
+                     tsReal *point,
+                     tsStatus *status)
+{
+	tsBSplineView view;
+	ts_bspline_as_view(spline, &view);
+	TS_INT_API_SCOPE(ts_eval_context_eval,
+		ts_int_eval_context_view_eval(ctx, &view, knot, point, status))
+}
 
-	tsReal *ctrlp_spline, *ctrlp_result;
-	tsReal *knots_spline, *knots_result;
-	size_t num_ctrlp_result;
-	size_t num_knots_result;
+const tsDeBoorNet *
+ts_eval_context_net(const tsEvalContext *ctx)
+{
+	return ctx->pImpl ? &ctx->pImpl->net : NULL;
+}
+/*! @} */
 
-	tsError err;
 
-	INIT_OUT_BSPLINE(spline, result)
-	if (n == 0)
-		return ts_bspline_copy(spline, result, status);
-	if (mult + n > order) {
-		TS_RETURN_4(status, TS_MULTIPLICITY,
-		            "multiplicity(%f) (%lu) + %lu > order (%lu)",
-		            knot, (unsigned long) mult, (unsigned long) n,
-		            (unsigned long) order)
-	}
 
-	TS_CALL_ROE(err, ts_int_bspline_resize(
-	            spline, (int)n, 1, result, status))
-	ctrlp_spline = ts_int_bspline_access_ctrlp(spline);
-	knots_spline = ts_int_bspline_access_knots(spline);
-	ctrlp_result = ts_int_bspline_access_ctrlp(result);
-	knots_result = ts_int_bspline_access_knots(result);
-	num_ctrlp_result = ts_bspline_num_control_points(result);
-	num_knots_result = ts_bspline_num_knots(result);
+/*! @name B-Spline Sets
+ *
+ * @{
+ */
+/**
+ * Stores the private data of ::tsBSplineSet. The knots and the control
+ * points (in this order) are stored right after this struct.
+ */
+struct tsBSplineSetImpl
+{
+	size_t deg; /**< Degree of the splines. */
+	size_t dim; /**< Dimensionality of the control points. */
+	size_t n_ctrlp; /**< Number of control points per spline. */
+	size_t n_splines; /**< Number of splines. */
+};
 
-	/* mult + n <= deg + 1 (order) with n >= 1
-	 * =>  mult <= deg
-	 * =>  regular evaluation
-	 * =>  N = h + 1 is valid */
-	N = ts_deboornet_num_insertions(net) + 1;
+/**
+ * Orders up to this value are evaluated without allocating memory (see
+ * ::ts_int_basis_funcs).
+ */
+#define TS_INT_MAX_STACK_ORDER 16
 
-	/* 1. Copy the relevant control points and knots from `spline'.
-	 * 2. Copy the relevant control points and knots from `net'. */
+tsReal *
+ts_int_bsplineset_access_knots(const tsBSplineSet *set)
+{
+	return (tsReal *) (& set->pImpl[1]);
+}
 
-	/* 1.
-	 *
-	 * a) Copy left hand side control points from `spline'.
-	 * b) Copy right hand side control points from `spline'.
-	 * c) Copy left hand side knots from `spline'.
-	 * d) Copy right hand side knots form `spline'. */
-	/*** Copy Control Points ***/
-	memmove(ctrlp_result, ctrlp_spline, (k-deg) * sof_ctrlp);      /* a) */
-	from = (tsReal *) ctrlp_spline + dim*(k-deg+N);
-	/* n >= 0 implies to >= from */
-	to = ctrlp_result + dim*(k-deg+N+n);
-	memmove(to, from, (num_ctrlp_result-n-(k-deg+N)) * sof_ctrlp); /* b) */
-	/*** Copy Knots ***/
-	memmove(knots_result, knots_spline, (k+1) * sof_real);         /* c) */
-	from = (tsReal *) knots_spline + k+1;
-	/* n >= 0 implies to >= from */
-	to = knots_result + k+1+n;
-	memmove(to, from, (num_knots_result-n-(k+1)) * sof_real);      /* d) */
+tsReal *
+ts_int_bsplineset_access_ctrlp(const tsBSplineSet *set)
+{
+	return ts_int_bsplineset_access_knots(set) +
+		set->pImpl->n_ctrlp + set->pImpl->deg + 1;
+}
 
-	/* 2.
-	 *
-	 * a) Copy left hand side control points from `net'.
-	 * b) Copy middle part control points from `net'.
-	 * c) Copy right hand side control points from `net'.
-	 * d) Copy knot from `net' (`knot'). */
-	from = ts_int_deboornet_access_points(net);
-	to = ctrlp_result + (k-deg)*dim;
-	stride = (int)(N*dim);
+tsBSplineSet
+ts_bsplineset_init(void)
+{
+	tsBSplineSet set;
+	set.pImpl = NULL;
+	return set;
+}
 
-	/*** Copy Control Points ***/
-	for (i = 0; i < n; i++) {                                      /* a) */
-		memcpy(to, from, sof_ctrlp);
-		from += stride;
-		to += dim;
-		stride -= (int)dim;
+tsError
+ts_bsplineset_new(const tsBSpline *splines,
+                  size_t num,
+                  tsBSplineSet *set,
+                  tsStatus *status)
+{
+	size_t deg, dim, num_ctrlp, num_knots, sof_set;
+	const tsReal *knots, *ctrlp;
+	tsReal *to_ctrlp;
+	size_t m, i, d;
+
+	set->pImpl = NULL;
+	if (num == 0)
+		TS_RETURN_0(status, TS_NUM_POINTS, "num(splines) == 0")
+	deg = ts_bspline_degree(splines);
+	dim = ts_bspline_dimension(splines);
+	num_ctrlp = ts_bspline_num_control_points(splines);
+	num_knots = ts_bspline_num_knots(splines);
+	knots = ts_bspline_knots_ptr(splines);
+	for (m = 1; m < num; m++) {
+		if (ts_bspline_degree(splines + m) != deg ||
+		    ts_bspline_dimension(splines + m) != dim ||
+		    ts_bspline_num_control_points(splines + m) != num_ctrlp) {
+			TS_RETURN_1(status, TS_INCOMPATIBLE,
+			            "spline %lu differs in degree, dimension, "
+			            "or number of control points",
+			            (unsigned long) m)
+		}
+		for (i = 0; i < num_knots; i++) {
+			if (!ts_knots_equal(knots[i],
+			                    ts_bspline_knots_ptr(splines + m)[i]))
+				TS_RETURN_1(status, TS_INCOMPATIBLE,
+				            "spline %lu differs in knots",
+				            (unsigned long) m)
+		}
 	}
-	memcpy(to, from, (N-n) * sof_ctrlp);                           /* b) */
-
-	from -= dim;
-	to += (N-n)*dim;
-	/* N = h+1 with h = deg-mult (ts_int_bspline_eval)
-	 * =>  N = deg-mult+1 = order-mult.
-	 *
-	 * n <= order-mult
-	 * =>  N-n+1 >= order-mult - order-mult + 1 = 1
-	 * =>  -(int)(N-n+1) <= -1. */
-	stride = -(int)(N-n+1) * (int)dim;
 
-	for (i = 0; i < n; i++) {                                      /* c) */
-		memcpy(to, from, sof_ctrlp);
-		from += stride;
-		stride -= (int)dim;
-		to += dim;
-	}
-	/*** Copy Knot ***/
-	to = knots_result + k+1;
-	for (i = 0; i < n; i++) {                                      /* d) */
-		*to = knot;
-		to++;
+	sof_set = sizeof(struct tsBSplineSetImpl) +
+		(num_knots + num_ctrlp * dim * num) * sizeof(tsReal);
+	set->pImpl = (struct tsBSplineSetImpl *) ts_int_malloc(sof_set);
+	if (!set->pImpl)
+		TS_RETURN_0(status, TS_MALLOC, "out of memory")
+	set->pImpl->deg = deg;
+	set->pImpl->dim = dim;
+	set->pImpl->n_ctrlp = num_ctrlp;
+	set->pImpl->n_splines = num;
+	memcpy(ts_int_bsplineset_access_knots(set), knots,
+	       num_knots * sizeof(tsReal));
+	to_ctrlp = ts_int_bsplineset_access_ctrlp(set);
+	for (m = 0; m < num; m++) {
+		ctrlp = ts_bspline_control_points_ptr(splines + m);
+		for (i = 0; i < num_ctrlp; i++) {
+			for (d = 0; d < dim; d++) {
+				to_ctrlp[(i * dim + d) * num + m] =
+					ctrlp[i * dim + d];
+			}
+		}
 	}
 	TS_RETURN_SUCCESS(status)
 }
 
-tsError
-ts_bspline_insert_knot(const tsBSpline *spline,
-                       tsReal knot,
-                       size_t num,
-                       tsBSpline *result,
-                       size_t* k,
-                       tsStatus *status)
+void
+ts_bsplineset_free(tsBSplineSet *set)
 {
-	tsDeBoorNet net;
-	tsError err;
-	INIT_OUT_BSPLINE(spline, result)
-	ts_int_deboornet_init(&net);
-	TS_TRY(try, err, status)
-		TS_CALL(try, err, ts_bspline_eval(
-		        spline, knot, &net, status))
-		TS_CALL(try, err, ts_int_bspline_insert_knot(
-		        spline, &net, num, result, status))
-		ts_deboornet_free(&net);
-		TS_CALL(try, err, ts_bspline_eval(
-		        result, knot, &net, status))
-		*k = ts_deboornet_index(&net);
-	TS_CATCH(err)
-		*k = 0;
-	TS_FINALLY
-		ts_deboornet_free(&net);
-	TS_END_TRY_RETURN(err)
+	if (set->pImpl) ts_int_free(set->pImpl);
+	set->pImpl = NULL;
 }
 
-tsError
-ts_bspline_split(const tsBSpline *spline,
-                 tsReal knot,
-                 tsBSpline *split,
-                 size_t* k,
-                 tsStatus *status)
+size_t
+ts_bsplineset_num_splines(const tsBSplineSet *set)
 {
-	tsDeBoorNet net;
-	tsError err;
-	INIT_OUT_BSPLINE(spline, split)
-	ts_int_deboornet_init(&net);
-	TS_TRY(try, err, status)
-		TS_CALL(try, err, ts_bspline_eval(
-		        spline, knot, &net, status))
-		if (ts_deboornet_multiplicity(&net)
-		    == ts_bspline_order(spline)) {
-			TS_CALL(try, err, ts_bspline_copy(
-			        spline, split, status))
-			*k = ts_deboornet_index(&net);
-		} else {
-			TS_CALL(try, err, ts_int_bspline_insert_knot(
-			        spline, &net,
-			        ts_deboornet_num_insertions(&net) + 1,
-			        split, status))
-			*k = ts_deboornet_index(&net) +
-			     ts_deboornet_num_insertions(&net) + 1;
+	return set->pImpl ? set->pImpl->n_splines : 0;
+}
+
+size_t
+ts_bsplineset_degree(const tsBSplineSet *set)
+{
+	return set->pImpl->deg;
+}
+
+size_t
+ts_bsplineset_dimension(const tsBSplineSet *set)
+{
+	return set->pImpl->dim;
+}
+
+size_t
+ts_bsplineset_num_control_points(const tsBSplineSet *set)
+{
+	return set->pImpl->n_ctrlp;
+}
+
+const tsReal *
+ts_bsplineset_knots_ptr(const tsBSplineSet *set)
+{
+	return ts_int_bsplineset_access_knots(set);
+}
+
+const tsReal *
+ts_bsplineset_control_points_ptr(const tsBSplineSet *set)
+{
+	return ts_int_bsplineset_access_ctrlp(set);
+}
+
+/* Computes the `deg + 1' basis functions that are non-zero in span `k' at
+ * `u' (Algorithm A2.2 of 'The NURBS Book' by Les Piegl and Wayne Tiller).
+ * `work' must have space for `3 * (deg + 1)' values. The result is stored in
+ * the first `deg + 1' values of `work'. */
+void
+ts_int_basis_funcs(const tsReal *knots,
+                   size_t deg,
+                   size_t k,
+                   tsReal u,
+                   tsReal *work)
+{
+	tsReal *N = work;
+	tsReal *left = work + deg + 1;
+	tsReal *right = left + deg + 1;
+	tsReal saved, temp;
+	size_t j, r;
+
+	N[0] = (tsReal) 1.0;
+	for (j = 1; j <= deg; j++) {
+		left[j] = u - knots[k + 1 - j];
+		right[j] = knots[k + j] - u;
+		saved = (tsReal) 0.0;
+		for (r = 0; r < j; r++) {
+			temp = N[r] / (right[r + 1] + left[j - r]);
+			N[r] = saved + right[r + 1] * temp;
+			saved = left[j - r] * temp;
 		}
-	TS_CATCH(err)
-		*k = 0;
-	TS_FINALLY
-		ts_deboornet_free(&net);
-	TS_END_TRY_RETURN(err)
+		N[j] = saved;
+	}
 }
 
 tsError
-ts_bspline_tension(const tsBSpline *spline,
-                   tsReal beta,
-                   tsBSpline *out,
-                   tsStatus *status)
+ts_int_bsplineset_eval(const tsBSplineSet *set,
+                       tsReal knot,
+                       tsReal *points,
+                       tsStatus *status)
 {
-	const size_t dim = ts_bspline_dimension(spline);
-	const size_t N = ts_bspline_num_control_points(spline);
-	const tsReal* p0 = ts_int_bspline_access_ctrlp(spline);
-	const tsReal* pn_1 = p0 + (N-1)*dim;
-
-	tsReal s; /**< The straightening factor. */
-	tsReal *ctrlp; /**< Pointer to the control points of `out'. */
-	size_t i, d; /**< Used in for loops. */
-	tsReal vec; /**< Straightening vector. */
+	const size_t deg = set->pImpl->deg;
+	const size_t order = deg + 1;
+	const size_t dim = set->pImpl->dim;
+	const size_t num = set->pImpl->n_splines;
+	const tsReal *knots = ts_int_bsplineset_access_knots(set);
+	const tsReal *ctrlp = ts_int_bsplineset_access_ctrlp(set);
+	tsReal stack[3 * TS_INT_MAX_STACK_ORDER];
+	tsReal *work = stack;
+	tsBSplineView view;
+	const tsReal *row;
+	tsReal *out, N;
+	size_t k = 0, s, first, r, d, m;
 	tsError err;
 
-	TS_CALL_ROE(err, ts_bspline_copy(spline, out, status))
-	ctrlp = ts_int_bspline_access_ctrlp(out);
-	if (beta < (tsReal) 0.0) beta = (tsReal) 0.0;
-	if (beta > (tsReal) 1.0) beta = (tsReal) 1.0;
-	s = 1.f - beta;
+	/* The knot search of the views handles rounding errors. */
+	view.degree = deg;
+	view.dimension = dim;
+	view.num_control_points = set->pImpl->n_ctrlp;
+	view.control_points = ctrlp;
+	view.control_point_stride = dim;
+	view.knots = knots;
+	view.knot_stride = 1;
+	TS_CALL_ROE(err, ts_int_view_find_knot(
+	            &view, &knot, &k, &s, status))
+
+	/* Same cases as in ::ts_int_view_eval_woa. The result of a net with
+	 * two points is the first one (see ::ts_deboornet_result). */
+	if (s == order) {
+		first = k == deg ? 0 : k - s;
+		memcpy(points, ctrlp + first * dim * num,
+		       dim * num * sizeof(tsReal));
+		TS_RETURN_SUCCESS(status)
+	}
 
-	for (i = 0; i < N; i++) {
-		for (d = 0; d < dim; d++) {
-			vec = ((tsReal)i / (N-1)) * (pn_1[d] - p0[d]);
-			ctrlp[i*dim + d] = beta * ctrlp[i*dim + d] +
-			                   s * (p0[d] + vec);
+	if (order > TS_INT_MAX_STACK_ORDER) {
+		work = (tsReal *) ts_int_malloc(3 * order * sizeof(tsReal));
+		if (!work) TS_RETURN_0(status, TS_MALLOC, "out of memory")
+	}
+	/* The last control point affected by span `k' does not exist if
+	 * `knot' is the upper end of the domain of a spline that is not
+	 * clamped. As `s <= deg', the curve is continuous at `knot', i.e., the
+	 * span to the left yields the same point. */
+	if (k >= set->pImpl->n_ctrlp)
+		k -= s;
+	ts_int_basis_funcs(knots, deg, k, knot, work);
+	first = k - deg;
+	for (d = 0; d < dim; d++) {
+		out = points + d * num;
+		for (m = 0; m < num; m++)
+			out[m] = (tsReal) 0.0;
+		for (r = 0; r < order; r++) {
+			N = work[r];
+			row = ctrlp + ((first + r) * dim + d) * num;
+			/* Contiguous in `m', which allows to vectorize the
+			 * sweep. */
+			for (m = 0; m < num; m++)
+				out[m] += N * row[m];
 		}
 	}
+	if (work != stack) ts_int_free(work);
 	TS_RETURN_SUCCESS(status)
 }
 
 tsError
-ts_bspline_to_beziers(const tsBSpline *spline,
-                      tsBSpline *beziers,
-                      tsStatus *status)
+ts_bsplineset_eval(const tsBSplineSet *set,
+                   tsReal knot,
+                   tsReal *points,
+                   tsStatus *status)
 {
-	const size_t deg = ts_bspline_degree(spline);
-	const size_t order = ts_bspline_order(spline);
-
-	int resize;    /**< Number of control points to add/remove. */
-	size_t k;      /**< Index of the split knot value. */
-	tsReal u_min;  /**< Minimum of the knot values. */
-	tsReal u_max;  /**< Maximum of the knot values. */
-
-	tsBSpline tmp;    /**< Temporarily stores the result. */
-	tsReal *knots;    /**< Pointer to the knots of tmp. */
-	size_t num_knots; /**< Number of knots in tmp. */
+	TS_INT_API_SCOPE(ts_bsplineset_eval,
+		ts_int_bsplineset_eval(set, knot, points, status))
+}
 
+tsError
+ts_bsplineset_spline_at(const tsBSplineSet *set,
+                        size_t index,
+                        tsBSpline *spline,
+                        tsStatus *status)
+{
+	const size_t dim = set->pImpl->dim;
+	const size_t num = set->pImpl->n_splines;
+	const size_t num_ctrlp = set->pImpl->n_ctrlp;
+	const tsReal *ctrlp = ts_int_bsplineset_access_ctrlp(set);
+	tsReal *to_ctrlp;
+	size_t i, d;
 	tsError err;
 
-	INIT_OUT_BSPLINE(spline, beziers)
-	TS_CALL_ROE(err, ts_bspline_copy(spline, &tmp, status))
-	knots = ts_int_bspline_access_knots(&tmp);
-	num_knots = ts_bspline_num_knots(&tmp);
+	ts_int_bspline_init(spline);
+	if (index >= num) {
+		TS_RETURN_2(status, TS_INDEX_ERROR, "index (%lu) >= num(%lu)",
+		            (unsigned long) index, (unsigned long) num)
+	}
+	TS_CALL_ROE(err, ts_bspline_new(num_ctrlp, dim, set->pImpl->deg,
+	            TS_OPENED, spline, status))
+	memcpy(ts_int_bspline_access_knots(spline),
+	       ts_int_bsplineset_access_knots(set),
+	       ts_bspline_sof_knots(spline));
+	to_ctrlp = ts_int_bspline_access_ctrlp(spline);
+	for (i = 0; i < num_ctrlp; i++) {
+		for (d = 0; d < dim; d++)
+			to_ctrlp[i * dim + d] = ctrlp[(i * dim + d) * num +
+			                              index];
+	}
+	TS_RETURN_SUCCESS(status)
+}
+/*! @} */
 
-	TS_TRY(try, err, status)
-		/* DO NOT FORGET TO UPDATE knots AND num_knots AFTER EACH
-		 * TRANSFORMATION OF tmp! */
 
-		/* Fix first control point if necessary. */
-		u_min = knots[deg];
-		if (!ts_knots_equal(knots[0], u_min)) {
-			TS_CALL(try, err, ts_bspline_split(
-			        &tmp, u_min, &tmp, &k, status))
-			resize = (int)(-1*deg + (deg*2 - k));
-			TS_CALL(try, err, ts_int_bspline_resize(
-			        &tmp, resize, 0, &tmp, status))
-			knots = ts_int_bspline_access_knots(&tmp);
-			num_knots = ts_bspline_num_knots(&tmp);
-		}
 
-		/* Fix last control point if necessary. */
-		u_max = knots[num_knots - order];
-		if (!ts_knots_equal(knots[num_knots - 1], u_max)) {
-			TS_CALL(try, err, ts_bspline_split(
-			        &tmp, u_max, &tmp, &k, status))
-			num_knots = ts_bspline_num_knots(&tmp);
-			resize = (int)(-1*deg + (k - (num_knots - order)));
-			TS_CALL(try, err, ts_int_bspline_resize(
-			        &tmp, resize, 1, &tmp, status))
-			knots = ts_int_bspline_access_knots(&tmp);
-			num_knots = ts_bspline_num_knots(&tmp);
-		}
+/*! @name Morphisms
+ *
+ * @{
+ */
+/**
+ * Stores the private data of ::tsMorphism. The control points and knots of
+ * the aligned origin, followed by the control points and knots of the
+ * aligned target, are stored right after this struct. That is, each spline
+ * is stored like the data of a ::tsBSpline.
+ */
+struct tsMorphismImpl
+{
+	size_t deg; /**< Degree of the aligned splines. */
+	size_t dim; /**< Dimensionality of the control points. */
+	size_t n_ctrlp; /**< Number of control points. */
+};
 
-		/* Split internal knots. */
-		k = order;
-		while (k < num_knots - order) {
-			TS_CALL(try, err, ts_bspline_split(
-			        &tmp, knots[k], &tmp, &k, status))
-			knots = ts_int_bspline_access_knots(&tmp);
-			num_knots = ts_bspline_num_knots(&tmp);
-			k++;
-		}
+size_t
+ts_int_morphism_len_spline(const tsMorphism *morphism)
+{
+	const struct tsMorphismImpl *impl = morphism->pImpl;
+	return impl->n_ctrlp * impl->dim + impl->n_ctrlp + impl->deg + 1;
+}
 
-		if (spline == beziers)
-			ts_bspline_free(beziers);
-		ts_bspline_move(&tmp, beziers);
+size_t
+ts_int_morphism_sof_state(const tsMorphism *morphism)
+{
+	return sizeof(struct tsMorphismImpl) +
+		2 * ts_int_morphism_len_spline(morphism) * sizeof(tsReal);
+}
+
+tsReal *
+ts_int_morphism_access_origin(const tsMorphism *morphism)
+{
+	return (tsReal *) (& morphism->pImpl[1]);
+}
+
+tsMorphism
+ts_morphism_init(void)
+{
+	tsMorphism morphism;
+	morphism.pImpl = NULL;
+	return morphism;
+}
+
+tsError
+ts_int_morphism_new(const tsBSpline *origin,
+                    const tsBSpline *target,
+                    tsReal epsilon,
+                    tsMorphism *morphism,
+                    tsStatus *status)
+{
+	tsBSpline origin_al, target_al; /* aligned origin and target */
+	struct tsMorphismImpl impl;
+	const tsBSpline *from;
+	const tsReal *from_ctrlp;
+	tsReal *to;
+	size_t from_dim, len, i, s;
+	tsError err;
+
+	morphism->pImpl = NULL;
+	origin_al = ts_bspline_init();
+	target_al = ts_bspline_init();
+	TS_TRY(try, err, status)
+		/* Same check as in ::ts_bspline_morph. */
+		if (ts_bspline_degree(origin) != ts_bspline_degree(target) ||
+		 ts_bspline_num_knots(origin) != ts_bspline_num_knots(target)) {
+			TS_CALL(try, err, ts_bspline_align(
+			        origin, target, epsilon, &origin_al, &target_al,
+			        status))
+		} else {
+			/* Flat copy. */
+			origin_al = *origin;
+			target_al = *target;
+		}
+		impl.deg = ts_bspline_degree(&origin_al);
+		impl.n_ctrlp = ts_bspline_num_control_points(&origin_al);
+		impl.dim = ts_bspline_dimension(&origin_al);
+		if (ts_bspline_dimension(&target_al) < impl.dim)
+			impl.dim = ts_bspline_dimension(&target_al);
+
+		morphism->pImpl = &impl;
+		len = ts_int_morphism_len_spline(morphism);
+		morphism->pImpl = (struct tsMorphismImpl *) ts_int_malloc(
+			ts_int_morphism_sof_state(morphism));
+		if (!morphism->pImpl) {
+			TS_THROW_0(try, err, status, TS_MALLOC,
+			           "out of memory")
+		}
+		*morphism->pImpl = impl;
+
+		/* Copy the control points (reduced to `impl.dim') and knots
+		 * of the aligned splines. */
+		to = ts_int_morphism_access_origin(morphism);
+		for (s = 0; s < 2; s++) {
+			from = s == 0 ? &origin_al : &target_al;
+			from_ctrlp = ts_int_bspline_access_ctrlp(from);
+			from_dim = ts_bspline_dimension(from);
+			for (i = 0; i < impl.n_ctrlp; i++) {
+				memcpy(to + i * impl.dim,
+				       from_ctrlp + i * from_dim,
+				       impl.dim * sizeof(tsReal));
+			}
+			memcpy(to + impl.n_ctrlp * impl.dim,
+			       ts_int_bspline_access_knots(from),
+			       ts_bspline_sof_knots(from));
+			to += len;
+		}
 	TS_FINALLY
-		ts_bspline_free(&tmp);
+		if (origin->pImpl != origin_al.pImpl)
+			ts_bspline_free(&origin_al);
+		if (target->pImpl != target_al.pImpl)
+			ts_bspline_free(&target_al);
 	TS_END_TRY_RETURN(err)
 }
 
 tsError
-ts_bspline_elevate_degree(const tsBSpline *spline,
-                          size_t amount,
-                          tsReal epsilon,
-                          tsBSpline *elevated,
-                          tsStatus * status)
+ts_morphism_new(const tsBSpline *origin,
+                const tsBSpline *target,
+                tsReal epsilon,
+                tsMorphism *morphism,
+                tsStatus *status)
 {
-	tsBSpline worker;
-	size_t dim, order;
-	tsReal *ctrlp, *knots;
-	size_t num_beziers, i, a, c, d, offset, idx;
-	tsReal f, f_hat, *first, *last;
+	TS_INT_API_SCOPE(ts_morphism_new,
+		ts_int_morphism_new(origin, target, epsilon, morphism, status))
+}
+
+tsError
+ts_morphism_copy(const tsMorphism *src,
+                 tsMorphism *dest,
+                 tsStatus *status)
+{
+	size_t size;
+	if (src == dest) TS_RETURN_SUCCESS(status)
+	dest->pImpl = NULL;
+	size = ts_int_morphism_sof_state(src);
+	dest->pImpl = (struct tsMorphismImpl *) ts_int_malloc(size);
+	if (!dest->pImpl) TS_RETURN_0(status, TS_MALLOC, "out of memory")
+	memcpy(dest->pImpl, src->pImpl, size);
+	TS_RETURN_SUCCESS(status)
+}
+
+void
+ts_morphism_free(tsMorphism *morphism)
+{
+	if (morphism->pImpl) ts_int_free(morphism->pImpl);
+	morphism->pImpl = NULL;
+}
+
+size_t
+ts_morphism_degree(const tsMorphism *morphism)
+{
+	return morphism->pImpl->deg;
+}
+
+size_t
+ts_morphism_dimension(const tsMorphism *morphism)
+{
+	return morphism->pImpl->dim;
+}
+
+size_t
+ts_morphism_num_control_points(const tsMorphism *morphism)
+{
+	return morphism->pImpl->n_ctrlp;
+}
+
+tsError
+ts_morphism_new_spline(const tsMorphism *morphism,
+                       tsBSpline *spline,
+                       tsStatus *status)
+{
+	const struct tsMorphismImpl *impl = morphism->pImpl;
 	tsError err;
+	TS_CALL_ROE(err, ts_bspline_new(impl->n_ctrlp, impl->dim, impl->deg,
+	            TS_OPENED /* doesn't matter */, spline, status))
+	memcpy(ts_int_bspline_access_ctrlp(spline),
+	       ts_int_morphism_access_origin(morphism),
+	       ts_int_morphism_len_spline(morphism) * sizeof(tsReal));
+	TS_RETURN_SUCCESS(status)
+}
 
-	/* Trivial case. */
-	if (amount == 0)
-		return ts_bspline_copy(spline, elevated, status);
+void
+ts_morphism_eval(const tsMorphism *morphism,
+                 tsReal t,
+                 tsBSpline *spline)
+{
+	const size_t len = ts_int_morphism_len_spline(morphism);
+	const tsReal *origin = ts_int_morphism_access_origin(morphism);
+	const tsReal *target = origin + len;
+	tsReal *out = ts_int_bspline_access_ctrlp(spline);
+	tsReal t_hat;
+	size_t i;
 
-	/* An overview of this algorithm can be found at:
-	 * https://pages.mtu.edu/~shene/COURSES/cs3621/LAB/curve/elevation.html */
-	INIT_OUT_BSPLINE(spline, elevated);
-	worker = ts_bspline_init();
-	TS_TRY(try, err, status)
-		/* Decompose `spline' into a sequence of bezier curves and make
-		 * space for the additional control points and knots that are
-		 * to be inserted. Results are stored in `worker'. */
-		TS_CALL(try, err, ts_bspline_to_beziers(
-		        spline, &worker, status));
-		num_beziers = ts_bspline_num_control_points(&worker) /
-		              ts_bspline_order(&worker);
-		TS_CALL(try, err, ts_int_bspline_resize(
-		        /* Resize by the number of knots to be inserted. Note
-		         * that this creates too many control points (due to
-		         * increasing the degree), which are removed at the end
-		         * of this function. */
-		        &worker, (int) ((num_beziers+1) * amount), 1, &worker,
-		        status));
-		dim = ts_bspline_dimension(&worker);
-		order = ts_bspline_order(&worker);
-		ctrlp = ts_int_bspline_access_ctrlp(&worker);
-		knots = ts_int_bspline_access_knots(&worker);
+	if (t < (tsReal) 0.0) t = (tsReal) 0.0;
+	if (t > (tsReal) 1.0) t = (tsReal) 1.0;
+	t_hat = (tsReal) 1.0 - t;
+	/* Control points and knots in one go. */
+	for (i = 0; i < len; i++)
+		out[i] = t * target[i] + t_hat * origin[i];
+}
 
-		/* Move all but the first bezier curve to their new location in
-		 * the control point array so that the additional control
-		 * points can be inserted without overwriting the others. Note
-		 * that iteration must run backwards. Otherwise, the moved
-		 * values overwrite each other. */
-		for (i = num_beziers - 1; i > 0; i--) {
-			/* `i' can be interpreted as the number of bezier
-			 * curves before the current bezier curve. */
+/* Evaluates `morphism' at (`t', `u'). `span' is the span of the previous
+ * evaluation (hint) and receives the span of `u'. `work' must have space for
+ * `5 * order' values. `t' must be clamped to [0, 1]. */
+tsError
+ts_int_morphism_eval_at(const tsMorphism *morphism,
+                        tsReal t,
+                        tsReal u,
+                        size_t *span,
+                        tsReal *work,
+                        tsReal *point,
+                        tsStatus *status)
+{
+	const size_t deg = morphism->pImpl->deg;
+	const size_t order = deg + 1;
+	const size_t dim = morphism->pImpl->dim;
+	const size_t num_ctrlp = morphism->pImpl->n_ctrlp;
+	const tsReal *origin = ts_int_morphism_access_origin(morphism);
+	const tsReal *target = origin + ts_int_morphism_len_spline(morphism);
+	const tsReal *ok = origin + num_ctrlp * dim; /* knots of origin */
+	const tsReal *tk = target + num_ctrlp * dim; /* knots of target */
+	tsReal *knots = work; /* the `2 * deg' knots affecting `u' */
+	tsReal *N = work + 2 * deg; /* basis functions */
+	size_t k = *span, s, r, d, idx;
+	tsError err;
 
-			/* Location of current bezier curve. */
-			offset = i * order * dim;
-			/* Each elevation inserts an additional control point
-			 * into every bezier curve. `i * amount' is the total
-			 * number of control points to be inserted before the
-			 * current bezier curve. */
-			memmove(ctrlp + offset + (i * amount * dim),
-			        ctrlp + offset,
-			        dim * order * sizeof(tsReal));
+	/* Same knot search (including the handling of rounding errors) as in
+	 * ::ts_bspline_eval, but on the interpolated knot vector. */
+	TS_CALL_ROE(err, ts_int_find_knot(ok, tk, t, 1, deg,
+	            num_ctrlp + order, &u, &k, &s, status))
+	*span = k;
+
+	/* Same cases as in ::ts_int_view_eval_woa. The result of a net with
+	 * two points is the first one (see ::ts_deboornet_result). */
+	if (s == order) {
+		idx = (k == deg ? 0 : k - s) * dim;
+		for (d = 0; d < dim; d++)
+			point[d] = ts_int_lerp(origin, target, t, idx + d);
+		TS_RETURN_SUCCESS(status)
+	}
+	/* The last control point affected by span `k' does not exist if `u' is
+	 * the upper end of the domain of a spline that is not clamped. As `s <=
+	 * deg', the curve is continuous at `u', i.e., the span to the left
+	 * yields the same point. */
+	if (k >= num_ctrlp)
+		k -= s;
+
+	for (r = 0; r < 2 * deg; r++)
+		knots[r] = ts_int_lerp(ok, tk, t, k - deg + 1 + r);
+	/* `knots' starts at index `k - deg + 1'. Thus, span `k' is located at
+	 * index `deg - 1' (unused if `deg' is 0). */
+	ts_int_basis_funcs(knots, deg, deg > 0 ? deg - 1 : 0, u, N);
+
+	for (d = 0; d < dim; d++)
+		point[d] = (tsReal) 0.0;
+	for (r = 0; r <= deg; r++) {
+		idx = (k - deg + r) * dim;
+		for (d = 0; d < dim; d++) {
+			point[d] += N[r] *
+				ts_int_lerp(origin, target, t, idx + d);
 		}
+	}
+	TS_RETURN_SUCCESS(status)
+}
 
-		/* Move all but the first group of knots to their new location
-		 * in the knot vector so that the additional knots can be
-		 * inserted without overwriting the others. Note that iteration
-		 * must run backwards. Otherwise, the moved values overwrite
-		 * each other. */
-		for (i = num_beziers; i > 0; i--) {
-			/* Note that the number of knot groups is one more than
-			 * the number of bezier curves. `i' can be interpreted
-			 * as the number of knot groups before the current
-			 * group. */
+tsError
+ts_int_morphism_eval_grid(const tsMorphism *morphism,
+                          const tsReal *ts,
+                          size_t num_ts,
+                          const tsReal *knots,
+                          size_t num_knots,
+                          tsReal *points,
+                          tsStatus *status)
+{
+	const size_t order = morphism->pImpl->deg + 1;
+	const size_t dim = morphism->pImpl->dim;
+	tsReal stack[5 * TS_INT_MAX_STACK_ORDER];
+	tsReal *work = stack;
+	tsReal t;
+	size_t i, j, span;
+	tsError err;
 
-			/* Location of current knot group. */
-			offset = i * order;
-			/* Each elevation inserts an additional knot into every
-			 * group of knots. `i * amount' is the total number of
-			 * knots to be inserted before the current knot
-			 * group. */
-			memmove(knots + offset + (i * amount),
-			        knots + offset,
-			        order * sizeof(tsReal));
+	if (order > TS_INT_MAX_STACK_ORDER) {
+		work = (tsReal *) ts_int_malloc(5 * order * sizeof(tsReal));
+		if (!work) TS_RETURN_0(status, TS_MALLOC, "out of memory")
+	}
+	TS_TRY(try, err, status)
+		for (i = 0; i < num_ts; i++) {
+			t = ts[i];
+			if (t < (tsReal) 0.0) t = (tsReal) 0.0;
+			if (t > (tsReal) 1.0) t = (tsReal) 1.0;
+			span = 0;
+			for (j = 0; j < num_knots; j++) {
+				TS_CALL(try, err, ts_int_morphism_eval_at(
+				        morphism, t, knots[j], &span, work,
+				        points + (i * num_knots + j) * dim,
+				        status))
+			}
 		}
+	TS_FINALLY
+		if (work != stack) ts_int_free(work);
+	TS_END_TRY_RETURN(err)
+}
 
-		/* `worker' is now fully set up.
-		 * The following formulas are based on:
-		 * https://pages.mtu.edu/~shene/COURSES/cs3621/NOTES/spline/Bezier/bezier-elev.html */
-		for (a = 0; a < amount; a++) {
-			/* For each bezier curve... */
-			for (i = 0; i < num_beziers; i++) {
-				/* ... 1) Insert and update control points. */
-
-				/* Location of current bezier curve. Each
-				 * elevation (`a') inserts an additional
-				 * control point into every bezier curve and
-				 * increases the degree (`order') by one. The
-				 * location is thus made up of two parts:
-				 *
-				 * i) `i * order', which is the location taking
-				 * into account the increasing order but
-				 * neglecting the control points that are to be
-				 * inserted before the current bezier curve. It
-				 * can be seen as some sort of base location:
-				 * Where would the bezier curve be (with
-				 * respect to the current value of `order') if
-				 * no additional control points had to be
-				 * inserted?
-				 *
-				 * ii) `i * (amount - a)', which is the total
-				 * number of control points to be inserted
-				 * before the current bezier curve
-				 * (`i * amount') taking into account the
-				 * increasing order (`order' and `a' are
-				 * increased equally, thus, `a' compensates for
-				 * the increasing value of `order'). This part
-				 * adds the necessary offset to the base
-				 * location (`i * order'). */
-				offset = (i * order + i * (amount - a)) * dim;
-				/* Duplicate last control point to the new end
-				 * position (next control point). */
-				memmove(ctrlp + offset + ((order) * dim),
-				        ctrlp + offset + ((order-1) * dim),
-				        dim * sizeof(tsReal));
-				/* All but the outer control points must be
-				 * recalculated (domain: [1, order - 1]). By
-				 * traversing backwards, control points can be
-				 * modified in-place. */
-				for (c = order - 1; c > 0; c--) {
-					/* Location of current control point
-					 * within current bezier curve. */
-					idx = offset + c * dim;
-					f = (tsReal) c / (tsReal) (order);
-					f_hat = 1 - f;
-					for (d = 0; d < dim; d++) {
-						/* For the sake of space, we
-						 * increment idx by d and
-						 * decrement it at the end of
-						 * this loop. */
-						idx += d;
-						ctrlp[idx] =
-							f * ctrlp[idx - dim] +
-							f_hat * ctrlp[idx];
-						/* Reset idx. */
-						idx -= d;
-					}
-				}
+tsError
+ts_morphism_eval_grid(const tsMorphism *morphism,
+                      const tsReal *ts,
+                      size_t num_ts,
+                      const tsReal *knots,
+                      size_t num_knots,
+                      tsReal *points,
+                      tsStatus *status)
+{
+	TS_INT_API_SCOPE(ts_morphism_eval_grid,
+		ts_int_morphism_eval_grid(morphism, ts, num_ts, knots,
+		                          num_knots, points, status))
+}
 
-				/* ...2) Increase the multiplicity of the
-				 * second knot group (maximum of the domain of
-				 * the current bezier curve) by one. Note that
+tsError
+ts_morphism_eval_at(const tsMorphism *morphism,
+                    tsReal t,
+                    tsReal knot,
+                    tsReal *point,
+                    tsStatus *status)
+{
+	TS_INT_API_SCOPE(ts_morphism_eval_at,
+		ts_int_morphism_eval_grid(morphism, &t, 1, &knot, 1, point,
+		                          status))
+}
+/*! @} */
+
+
+
+/*! @name Transformation Functions
+ *
+ * @{
+ */
+tsError
+ts_int_bspline_resize(const tsBSpline *spline,
+                      ptrdiff_t n,
+                      int back,
+                      tsBSpline *resized,
+                      tsStatus *status)
+{
+	const size_t deg = ts_bspline_degree(spline);
+	const size_t dim = ts_bspline_dimension(spline);
+	const size_t sof_real = sizeof(tsReal);
+
+	/* Number of control points and knots to add (n > 0) or to remove
+	 * (n < 0). Using the absolute value avoids mixing signed and unsigned
+	 * arithmetic when working with large splines. */
+	const size_t abs_n = n < 0 ? (size_t) -n : (size_t) n;
+	const size_t num_ctrlp = ts_bspline_num_control_points(spline);
+	const size_t num_knots = ts_bspline_num_knots(spline);
+	/* New length of ctrlp. */
+	const size_t nnum_ctrlp = n < 0 ? num_ctrlp - abs_n : num_ctrlp + abs_n;
+	/* New length of knots. */
+	const size_t nnum_knots = n < 0 ? num_knots - abs_n : num_knots + abs_n;
+	const size_t min_num_ctrlp_vec = n < 0 ? nnum_ctrlp : num_ctrlp;
+	const size_t min_num_knots_vec = n < 0 ? nnum_knots : num_knots;
+
+	const size_t sof_min_num_ctrlp = min_num_ctrlp_vec * dim * sof_real;
+	const size_t sof_min_num_knots = min_num_knots_vec * sof_real;
+
+	tsBSpline tmp; /**< Temporarily stores the result. */
+	const tsReal* from_ctrlp = ts_int_bspline_access_ctrlp(spline);
+	const tsReal* from_knots = ts_int_bspline_access_knots(spline);
+	tsReal* to_ctrlp = NULL; /**< Pointer to the control points of tmp. */
+	tsReal* to_knots = NULL; /**< Pointer to the knots of tmp. */
+
+	tsError err;
+
+	if (n == 0) return ts_bspline_copy(spline, resized, status);
+
+	INIT_OUT_BSPLINE(spline, resized)
+	TS_CALL_ROE(err, ts_bspline_new(
+	            nnum_ctrlp, dim, deg, TS_OPENED,
+	            &tmp, status))
+	to_ctrlp = ts_int_bspline_access_ctrlp(&tmp);
+	to_knots = ts_int_bspline_access_knots(&tmp);
+
+	/* Copy control points and knots. */
+	if (!back && n < 0) {
+		memcpy(to_ctrlp, from_ctrlp + abs_n*dim, sof_min_num_ctrlp);
+		memcpy(to_knots, from_knots + abs_n    , sof_min_num_knots);
+	} else if (!back && n > 0) {
+		memcpy(to_ctrlp + abs_n*dim, from_ctrlp, sof_min_num_ctrlp);
+		memcpy(to_knots + abs_n    , from_knots, sof_min_num_knots);
+	} else {
+		/* n != 0 implies back == true */
+		memcpy(to_ctrlp, from_ctrlp, sof_min_num_ctrlp);
+		memcpy(to_knots, from_knots, sof_min_num_knots);
+	}
+
+	if (spline == resized)
+		ts_bspline_free(resized);
+	ts_bspline_move(&tmp, resized);
+	TS_RETURN_SUCCESS(status)
+}
+
+tsError
+ts_int_bspline_derive(const tsBSpline *spline,
+                      size_t n,
+                      tsReal epsilon,
+                      tsBSpline *deriv,
+                      tsStatus *status)
+{
+	const size_t sof_real = sizeof(tsReal);
+	const size_t dim = ts_bspline_dimension(spline);
+	const size_t sof_ctrlp = dim * sof_real;
+	size_t deg = ts_bspline_degree(spline);
+	size_t num_ctrlp = ts_bspline_num_control_points(spline);
+	size_t num_knots = ts_bspline_num_knots(spline);
+
+	tsBSpline worker; /**< Stores the intermediate result. */
+	tsReal* ctrlp;    /**< Pointer to the control points of worker. */
+	tsReal* knots;    /**< Pointer to the knots of worker. */
+
+	size_t m, i, j, k, l; /**< Used in for loops. */
+	tsReal *fst, *snd; /**< Pointer to first and second control point. */
+	tsReal dist; /**< Distance between fst and snd. */
+	tsReal kid1, ki1; /**< Knots at i+deg+1 and i+1. */
+	tsReal span; /**< Distance between kid1 and ki1. */
+
+	tsBSpline swap; /**< Used to swap worker and derivative. */
+	tsError err;
+
+	INIT_OUT_BSPLINE(spline, deriv)
+	TS_CALL_ROE(err, ts_bspline_copy(spline, &worker, status))
+	ctrlp = ts_int_bspline_access_ctrlp(&worker);
+	knots = ts_int_bspline_access_knots(&worker);
+
+	TS_TRY(try, err, status)
+		for (m = 1; m <= n; m++) { /* from 1st to n'th derivative */
+			if (deg == 0) {
+				ts_arr_fill(ctrlp, dim, 0.f);
+				ts_bspline_domain(spline,
+				                  &knots[0],
+				                  &knots[1]);
+				num_ctrlp = 1;
+				num_knots = 2;
+				break;
+			}
+			/* Check and, if possible, fix discontinuity. */
+			for (i = 2*deg + 1; i < num_knots - (deg+1); i++) {
+				if (!ts_knots_equal(knots[i], knots[i-deg]))
+					continue;
+				fst = ctrlp + (i - (deg+1)) * dim;
+				snd = fst + dim;
+				dist = ts_distance(fst, snd, dim);
+				if (epsilon >= 0.f && dist > epsilon) {
+					TS_THROW_1(try, err, status,
+					           TS_UNDERIVABLE,
+					           "discontinuity at knot: %f",
+					           knots[i])
+				}
+				memmove(snd,
+				        snd + dim,
+				        (num_ctrlp - (i+1-deg)) * sof_ctrlp);
+				memmove(&knots[i],
+				        &knots[i+1],
+				        (num_knots - (i+1)) * sof_real);
+				num_ctrlp--;
+				num_knots--;
+				i += deg-1;
+			}
+			/* Derive continuous worker. */
+			for (i = 0; i < num_ctrlp-1; i++) {
+				for (j = 0; j < dim; j++) {
+					k = i    *dim + j;
+					l = (i+1)*dim + j;
+					ctrlp[k] = ctrlp[l] - ctrlp[k];
+					kid1 = knots[i+deg+1];
+					ki1  = knots[i+1];
+					span = kid1 - ki1;
+					if (span < TS_KNOT_EPSILON)
+						span = TS_KNOT_EPSILON;
+					ctrlp[k] *= deg;
+					ctrlp[k] /= span;
+				}
+			}
+			deg       -= 1;
+			num_ctrlp -= 1;
+			num_knots -= 2;
+			knots     += 1;
+		}
+		TS_CALL(try, err, ts_bspline_new(
+		        num_ctrlp, dim, deg, TS_OPENED,
+		        &swap, status))
+		memcpy(ts_int_bspline_access_ctrlp(&swap),
+		       ctrlp,
+		       num_ctrlp * sof_ctrlp);
+		memcpy(ts_int_bspline_access_knots(&swap),
+		       knots,
+		       num_knots * sof_real);
+		if (spline == deriv)
+			ts_bspline_free(deriv);
+		ts_bspline_move(&swap, deriv);
+	TS_FINALLY
+		ts_bspline_free(&worker);
+	TS_END_TRY_RETURN(err)
+}
+
+tsError
+ts_bspline_derive(const tsBSpline *spline,
+                  size_t n,
+                  tsReal epsilon,
+                  tsBSpline *deriv,
+                  tsStatus *status)
+{
+	TS_INT_API_SCOPE(ts_bspline_derive,
+		ts_int_bspline_derive(spline, n, epsilon, deriv, status))
+}
+
+tsError
+ts_int_bspline_insert_knot(const tsBSpline *spline,
+                           const tsDeBoorNet *net,
+                           size_t n,
+                           tsBSpline *result,
+                           tsStatus *status)
+{
+	const size_t deg = ts_bspline_degree(spline);
+	const size_t order = ts_bspline_order(spline);
+	const size_t dim = ts_bspline_dimension(spline);
+	const tsReal knot = ts_deboornet_knot(net);
+	const size_t k = ts_deboornet_index(net);
+	const size_t mult = ts_deboornet_multiplicity(net);
+	const size_t sof_real = sizeof(tsReal);
+	const size_t sof_ctrlp = dim * sof_real;
+
+	size_t N;     /**< Number of affected control points. */
+	tsReal* from; /**< Pointer to copy the values from. */
+	tsReal* to;   /**< Pointer to copy the values to. */
+	int stride;   /**< Stride of the next pointer to copy. */
+	size_t i;     /**< Used in for loops. */
+
+	tsReal *ctrlp_spline, *ctrlp_result;
+	tsReal *knots_spline, *knots_result;
+	size_t num_ctrlp_result;
+	size_t num_knots_result;
+
+	tsError err;
+
+	INIT_OUT_BSPLINE(spline, result)
+	if (n == 0)
+		return ts_bspline_copy(spline, result, status);
+	if (mult + n > order) {
+		TS_RETURN_4(status, TS_MULTIPLICITY,
+		            "multiplicity(%f) (%lu) + %lu > order (%lu)",
+		            knot, (unsigned long) mult, (unsigned long) n,
+		            (unsigned long) order)
+	}
+
+	TS_INT_STATS_ADD(num_knot_insertions, n)
+	TS_CALL_ROE(err, ts_int_bspline_resize(
+	            spline, (ptrdiff_t) n, 1, result, status))
+	ctrlp_spline = ts_int_bspline_access_ctrlp(spline);
+	knots_spline = ts_int_bspline_access_knots(spline);
+	ctrlp_result = ts_int_bspline_access_ctrlp(result);
+	knots_result = ts_int_bspline_access_knots(result);
+	num_ctrlp_result = ts_bspline_num_control_points(result);
+	num_knots_result = ts_bspline_num_knots(result);
+
+	/* mult + n <= deg + 1 (order) with n >= 1
+	 * =>  mult <= deg
+	 * =>  regular evaluation
+	 * =>  N = h + 1 is valid */
+	N = ts_deboornet_num_insertions(net) + 1;
+
+	/* 1. Copy the relevant control points and knots from `spline'.
+	 * 2. Copy the relevant control points and knots from `net'. */
+
+	/* 1.
+	 *
+	 * a) Copy left hand side control points from `spline'.
+	 * b) Copy right hand side control points from `spline'.
+	 * c) Copy left hand side knots from `spline'.
+	 * d) Copy right hand side knots form `spline'. */
+	/*** Copy Control Points ***/
+	memmove(ctrlp_result, ctrlp_spline, (k-deg) * sof_ctrlp);      /* a) */
+	from = (tsReal *) ctrlp_spline + dim*(k-deg+N);
+	/* n >= 0 implies to >= from */
+	to = ctrlp_result + dim*(k-deg+N+n);
+	memmove(to, from, (num_ctrlp_result-n-(k-deg+N)) * sof_ctrlp); /* b) */
+	/*** Copy Knots ***/
+	memmove(knots_result, knots_spline, (k+1) * sof_real);         /* c) */
+	from = (tsReal *) knots_spline + k+1;
+	/* n >= 0 implies to >= from */
+	to = knots_result + k+1+n;
+	memmove(to, from, (num_knots_result-n-(k+1)) * sof_real);      /* d) */
+
+	/* 2.
+	 *
+	 * a) Copy left hand side control points from `net'.
+	 * b) Copy middle part control points from `net'.
+	 * c) Copy right hand side control points from `net'.
+	 * d) Copy knot from `net' (`knot'). */
+	from = ts_int_deboornet_access_points(net);
+	to = ctrlp_result + (k-deg)*dim;
+	stride = (int)(N*dim);
+
+	/*** Copy Control Points ***/
+	for (i = 0; i < n; i++) {                                      /* a) */
+		memcpy(to, from, sof_ctrlp);
+		from += stride;
+		to += dim;
+		stride -= (int)dim;
+	}
+	memcpy(to, from, (N-n) * sof_ctrlp);                           /* b) */
+
+	from -= dim;
+	to += (N-n)*dim;
+	/* N = h+1 with h = deg-mult (ts_int_bspline_eval)
+	 * =>  N = deg-mult+1 = order-mult.
+	 *
+	 * n <= order-mult
+	 * =>  N-n+1 >= order-mult - order-mult + 1 = 1
+	 * =>  -(int)(N-n+1) <= -1. */
+	stride = -(int)(N-n+1) * (int)dim;
+
+	for (i = 0; i < n; i++) {                                      /* c) */
+		memcpy(to, from, sof_ctrlp);
+		from += stride;
+		stride -= (int)dim;
+		to += dim;
+	}
+	/*** Copy Knot ***/
+	to = knots_result + k+1;
+	for (i = 0; i < n; i++) {                                      /* d) */
+		*to = knot;
+		to++;
+	}
+	TS_RETURN_SUCCESS(status)
+}
+
+tsError
+ts_int_bspline_insert_knot_at(const tsBSpline *spline,
+                              tsReal knot,
+                              size_t num,
+                              tsBSpline *result,
+                              size_t* k,
+                              tsStatus *status)
+{
+	tsDeBoorNet net;
+	tsError err;
+	INIT_OUT_BSPLINE(spline, result)
+	ts_int_deboornet_init(&net);
+	TS_TRY(try, err, status)
+		TS_CALL(try, err, ts_bspline_eval(
+		        spline, knot, &net, status))
+		TS_CALL(try, err, ts_int_bspline_insert_knot(
+		        spline, &net, num, result, status))
+		ts_deboornet_free(&net);
+		TS_CALL(try, err, ts_bspline_eval(
+		        result, knot, &net, status))
+		*k = ts_deboornet_index(&net);
+	TS_CATCH(err)
+		*k = 0;
+	TS_FINALLY
+		ts_deboornet_free(&net);
+	TS_END_TRY_RETURN(err)
+}
+
+tsError
+ts_bspline_insert_knot(const tsBSpline *spline,
+                       tsReal knot,
+                       size_t num,
+                       tsBSpline *result,
+                       size_t* k,
+                       tsStatus *status)
+{
+	TS_INT_API_SCOPE(ts_bspline_insert_knot,
+		ts_int_bspline_insert_knot_at(spline, knot, num, result, k,
+		                              status))
+}
+
+tsError
+ts_int_bspline_split(const tsBSpline *spline,
+                     tsReal knot,
+                     tsBSpline *split,
+                     size_t* k,
+                     tsStatus *status)
+{
+	tsDeBoorNet net;
+	tsError err;
+	INIT_OUT_BSPLINE(spline, split)
+	ts_int_deboornet_init(&net);
+	TS_TRY(try, err, status)
+		TS_CALL(try, err, ts_bspline_eval(
+		        spline, knot, &net, status))
+		if (ts_deboornet_multiplicity(&net)
+		    == ts_bspline_order(spline)) {
+			TS_CALL(try, err, ts_bspline_copy(
+			        spline, split, status))
+			*k = ts_deboornet_index(&net);
+		} else {
+			TS_CALL(try, err, ts_int_bspline_insert_knot(
+			        spline, &net,
+			        ts_deboornet_num_insertions(&net) + 1,
+			        split, status))
+			*k = ts_deboornet_index(&net) +
+			     ts_deboornet_num_insertions(&net) + 1;
+		}
+	TS_CATCH(err)
+		*k = 0;
+	TS_FINALLY
+		ts_deboornet_free(&net);
+	TS_END_TRY_RETURN(err)
+}
+
+tsError
+ts_bspline_split(const tsBSpline *spline,
+                 tsReal knot,
+                 tsBSpline *split,
+                 size_t* k,
+                 tsStatus *status)
+{
+	TS_INT_API_SCOPE(ts_bspline_split,
+		ts_int_bspline_split(spline, knot, split, k, status))
+}
+
+tsError
+ts_bspline_tension(const tsBSpline *spline,
+                   tsReal beta,
+                   tsBSpline *out,
+                   tsStatus *status)
+{
+	const size_t dim = ts_bspline_dimension(spline);
+	const size_t N = ts_bspline_num_control_points(spline);
+	const tsReal* p0 = ts_int_bspline_access_ctrlp(spline);
+	const tsReal* pn_1 = p0 + (N-1)*dim;
+
+	tsReal s; /**< The straightening factor. */
+	tsReal *ctrlp; /**< Pointer to the control points of `out'. */
+	size_t i, d; /**< Used in for loops. */
+	tsReal vec; /**< Straightening vector. */
+	tsError err;
+
+	TS_CALL_ROE(err, ts_bspline_copy(spline, out, status))
+	ctrlp = ts_int_bspline_access_ctrlp(out);
+	if (beta < (tsReal) 0.0) beta = (tsReal) 0.0;
+	if (beta > (tsReal) 1.0) beta = (tsReal) 1.0;
+	s = 1.f - beta;
+
+	for (i = 0; i < N; i++) {
+		for (d = 0; d < dim; d++) {
+			vec = ((tsReal)i / (N-1)) * (pn_1[d] - p0[d]);
+			ctrlp[i*dim + d] = beta * ctrlp[i*dim + d] +
+			                   s * (p0[d] + vec);
+		}
+	}
+	TS_RETURN_SUCCESS(status)
+}
+
+/* Fixes the first and last control point of `spline' (in-place) such that
+ * the first and last knot have multiplicity `order'. The shape of `spline'
+ * is retained. */
+tsError
+ts_int_bspline_clamp(tsBSpline *spline,
+                     tsStatus *status)
+{
+	const size_t deg = ts_bspline_degree(spline);
+	const size_t order = ts_bspline_order(spline);
+
+	ptrdiff_t resize; /**< Number of control points to add/remove. */
+	size_t k;      /**< Index of the split knot value. */
+	tsReal u_min;  /**< Minimum of the knot values. */
+	tsReal u_max;  /**< Maximum of the knot values. */
+
+	tsReal *knots;    /**< Pointer to the knots of spline. */
+	size_t num_knots; /**< Number of knots in spline. */
+
+	tsError err;
+
+	knots = ts_int_bspline_access_knots(spline);
+	num_knots = ts_bspline_num_knots(spline);
+
+	/* Fix first control point if necessary. */
+	u_min = knots[deg];
+	if (!ts_knots_equal(knots[0], u_min)) {
+		TS_CALL_ROE(err, ts_bspline_split(
+		            spline, u_min, spline, &k, status))
+		resize = (ptrdiff_t) deg - (ptrdiff_t) k;
+		TS_CALL_ROE(err, ts_int_bspline_resize(
+		            spline, resize, 0, spline, status))
+		knots = ts_int_bspline_access_knots(spline);
+		num_knots = ts_bspline_num_knots(spline);
+	}
+
+	/* Fix last control point if necessary. */
+	u_max = knots[num_knots - order];
+	if (!ts_knots_equal(knots[num_knots - 1], u_max)) {
+		TS_CALL_ROE(err, ts_bspline_split(
+		            spline, u_max, spline, &k, status))
+		num_knots = ts_bspline_num_knots(spline);
+		resize = (ptrdiff_t) k -
+		         (ptrdiff_t) (num_knots - order) -
+		         (ptrdiff_t) deg;
+		TS_CALL_ROE(err, ts_int_bspline_resize(
+		            spline, resize, 1, spline, status))
+	}
+	TS_RETURN_SUCCESS(status)
+}
+
+tsError
+ts_int_bspline_to_beziers(const tsBSpline *spline,
+                          tsBSpline *beziers,
+                          tsStatus *status)
+{
+	const size_t order = ts_bspline_order(spline);
+
+	size_t k;      /**< Index of the split knot value. */
+
+	tsBSpline tmp;    /**< Temporarily stores the result. */
+	tsReal *knots;    /**< Pointer to the knots of tmp. */
+	size_t num_knots; /**< Number of knots in tmp. */
+
+	tsError err;
+
+	INIT_OUT_BSPLINE(spline, beziers)
+	TS_CALL_ROE(err, ts_bspline_copy(spline, &tmp, status))
+
+	TS_TRY(try, err, status)
+		/* DO NOT FORGET TO UPDATE knots AND num_knots AFTER EACH
+		 * TRANSFORMATION OF tmp! */
+		TS_CALL(try, err, ts_int_bspline_clamp(&tmp, status))
+		knots = ts_int_bspline_access_knots(&tmp);
+		num_knots = ts_bspline_num_knots(&tmp);
+
+		/* Split internal knots. */
+		k = order;
+		while (k < num_knots - order) {
+			TS_CALL(try, err, ts_bspline_split(
+			        &tmp, knots[k], &tmp, &k, status))
+			knots = ts_int_bspline_access_knots(&tmp);
+			num_knots = ts_bspline_num_knots(&tmp);
+			k++;
+		}
+
+		if (spline == beziers)
+			ts_bspline_free(beziers);
+		ts_bspline_move(&tmp, beziers);
+	TS_FINALLY
+		ts_bspline_free(&tmp);
+	TS_END_TRY_RETURN(err)
+}
+
+tsError
+ts_bspline_to_beziers(const tsBSpline *spline,
+                      tsBSpline *beziers,
+                      tsStatus *status)
+{
+	TS_INT_API_SCOPE(ts_bspline_to_beziers,
+		ts_int_bspline_to_beziers(spline, beziers, status))
+}
+
+tsError
+ts_int_bspline_elevate_degree(const tsBSpline *spline,
+                              size_t amount,
+                              tsReal epsilon,
+                              tsBSpline *elevated,
+                              tsStatus * status)
+{
+	tsBSpline worker;
+	size_t dim, order;
+	tsReal *ctrlp, *knots;
+	size_t num_beziers, i, a, c, d, offset, idx;
+	tsReal f, f_hat, *first, *last;
+	tsError err;
+
+	/* Trivial case. */
+	if (amount == 0)
+		return ts_bspline_copy(spline, elevated, status);
+
+	/* An overview of this algorithm can be found at:
+	 * https://pages.mtu.edu/~shene/COURSES/cs3621/LAB/curve/elevation.html */
+	INIT_OUT_BSPLINE(spline, elevated);
+	worker = ts_bspline_init();
+	TS_TRY(try, err, status)
+		/* Decompose `spline' into a sequence of bezier curves and make
+		 * space for the additional control points and knots that are
+		 * to be inserted. Results are stored in `worker'. */
+		TS_CALL(try, err, ts_bspline_to_beziers(
+		        spline, &worker, status));
+		num_beziers = ts_bspline_num_control_points(&worker) /
+		              ts_bspline_order(&worker);
+		TS_CALL(try, err, ts_int_bspline_resize(
+		        /* Resize by the number of knots to be inserted. Note
+		         * that this creates too many control points (due to
+		         * increasing the degree), which are removed at the end
+		         * of this function. */
+		        &worker, (ptrdiff_t) ((num_beziers+1) * amount), 1,
+		        &worker, status));
+		dim = ts_bspline_dimension(&worker);
+		order = ts_bspline_order(&worker);
+		ctrlp = ts_int_bspline_access_ctrlp(&worker);
+		knots = ts_int_bspline_access_knots(&worker);
+
+		TS_INT_TRACE_BEGIN("ts_bspline_elevate_degree/elevate")
+		/* Move all but the first bezier curve to their new location in
+		 * the control point array so that the additional control
+		 * points can be inserted without overwriting the others. Note
+		 * that iteration must run backwards. Otherwise, the moved
+		 * values overwrite each other. */
+		for (i = num_beziers - 1; i > 0; i--) {
+			/* `i' can be interpreted as the number of bezier
+			 * curves before the current bezier curve. */
+
+			/* Location of current bezier curve. */
+			offset = i * order * dim;
+			/* Each elevation inserts an additional control point
+			 * into every bezier curve. `i * amount' is the total
+			 * number of control points to be inserted before the
+			 * current bezier curve. */
+			memmove(ctrlp + offset + (i * amount * dim),
+			        ctrlp + offset,
+			        dim * order * sizeof(tsReal));
+		}
+
+		/* Move all but the first group of knots to their new location
+		 * in the knot vector so that the additional knots can be
+		 * inserted without overwriting the others. Note that iteration
+		 * must run backwards. Otherwise, the moved values overwrite
+		 * each other. */
+		for (i = num_beziers; i > 0; i--) {
+			/* Note that the number of knot groups is one more than
+			 * the number of bezier curves. `i' can be interpreted
+			 * as the number of knot groups before the current
+			 * group. */
+
+			/* Location of current knot group. */
+			offset = i * order;
+			/* Each elevation inserts an additional knot into every
+			 * group of knots. `i * amount' is the total number of
+			 * knots to be inserted before the current knot
+			 * group. */
+			memmove(knots + offset + (i * amount),
+			        knots + offset,
+			        order * sizeof(tsReal));
+		}
+
+		/* `worker' is now fully set up.
+		 * The following formulas are based on:
+		 * https://pages.mtu.edu/~shene/COURSES/cs3621/NOTES/spline/Bezier/bezier-elev.html */
+		for (a = 0; a < amount; a++) {
+			/* For each bezier curve... */
+			for (i = 0; i < num_beziers; i++) {
+				/* ... 1) Insert and update control points. */
+
+				/* Location of current bezier curve. Each
+				 * elevation (`a') inserts an additional
+				 * control point into every bezier curve and
+				 * increases the degree (`order') by one. The
+				 * location is thus made up of two parts:
+				 *
+				 * i) `i * order', which is the location taking
+				 * into account the increasing order but
+				 * neglecting the control points that are to be
+				 * inserted before the current bezier curve. It
+				 * can be seen as some sort of base location:
+				 * Where would the bezier curve be (with
+				 * respect to the current value of `order') if
+				 * no additional control points had to be
+				 * inserted?
+				 *
+				 * ii) `i * (amount - a)', which is the total
+				 * number of control points to be inserted
+				 * before the current bezier curve
+				 * (`i * amount') taking into account the
+				 * increasing order (`order' and `a' are
+				 * increased equally, thus, `a' compensates for
+				 * the increasing value of `order'). This part
+				 * adds the necessary offset to the base
+				 * location (`i * order'). */
+				offset = (i * order + i * (amount - a)) * dim;
+				/* Duplicate last control point to the new end
+				 * position (next control point). */
+				memmove(ctrlp + offset + ((order) * dim),
+				        ctrlp + offset + ((order-1) * dim),
+				        dim * sizeof(tsReal));
+				/* All but the outer control points must be
+				 * recalculated (domain: [1, order - 1]). By
+				 * traversing backwards, control points can be
+				 * modified in-place. */
+				for (c = order - 1; c > 0; c--) {
+					/* Location of current control point
+					 * within current bezier curve. */
+					idx = offset + c * dim;
+					f = (tsReal) c / (tsReal) (order);
+					f_hat = 1 - f;
+					for (d = 0; d < dim; d++) {
+						/* For the sake of space, we
+						 * increment idx by d and
+						 * decrement it at the end of
+						 * this loop. */
+						idx += d;
+						ctrlp[idx] =
+							f * ctrlp[idx - dim] +
+							f_hat * ctrlp[idx];
+						/* Reset idx. */
+						idx -= d;
+					}
+				}
+
+				/* ...2) Increase the multiplicity of the
+				 * second knot group (maximum of the domain of
+				 * the current bezier curve) by one. Note that
 				 * this loop misses the last knot group (the
 				 * group of the last bezier curve) as there is
 				 * one more knot group than bezier curves to
 				 * process. Thus, the last group must be
 				 * increased separately after this loop. */
 
-				/* Location of current knot group. Each
-				 * elevation (`a') inserts an additional
-				 * knot into the knot vector of every bezier
-				 * curve and increases the degree (`order') by
-				 * one. The location is thus made up of two
-				 * parts:
-				 *
-				 * i) `i * order', which is the location taking
-				 * into account the increasing order but
-				 * neglecting the knots that are to be inserted
-				 * before the current knot group. It can be
-				 * seen as some sort of base location: Where
-				 * would the knot group be (with respect to the
-				 * current value of `order') if no additional
-				 * knots had to be inserted?
-				 *
-				 * ii) `i * (amount - a)', which is the total
-				 * number of knots to be inserted before the
-				 * current knot group (`i * amount') taking
-				 * into account the increasing order (`order'
-				 * and `a' are increased equally, thus, `a'
-				 * compensates for the increasing value of
-				 * `order'). This part adds the necessary
-				 * offset to the base location
-				 * (`i * order'). */
-				offset = i * order + i * (amount - a);
-				/* Duplicate knot. */
-				knots[offset + order] = knots[offset];
-			}
+				/* Location of current knot group. Each
+				 * elevation (`a') inserts an additional
+				 * knot into the knot vector of every bezier
+				 * curve and increases the degree (`order') by
+				 * one. The location is thus made up of two
+				 * parts:
+				 *
+				 * i) `i * order', which is the location taking
+				 * into account the increasing order but
+				 * neglecting the knots that are to be inserted
+				 * before the current knot group. It can be
+				 * seen as some sort of base location: Where
+				 * would the knot group be (with respect to the
+				 * current value of `order') if no additional
+				 * knots had to be inserted?
+				 *
+				 * ii) `i * (amount - a)', which is the total
+				 * number of knots to be inserted before the
+				 * current knot group (`i * amount') taking
+				 * into account the increasing order (`order'
+				 * and `a' are increased equally, thus, `a'
+				 * compensates for the increasing value of
+				 * `order'). This part adds the necessary
+				 * offset to the base location
+				 * (`i * order'). */
+				offset = i * order + i * (amount - a);
+				/* Duplicate knot. */
+				knots[offset + order] = knots[offset];
+			}
+
+			/* Increase the multiplicity of the very last knot
+			 * group (the second group of the last bezier curve)
+			 * by one. For more details, see knot duplication in
+			 * previous loop. */
+			offset = num_beziers * order +
+			         num_beziers * (amount - a);
+			knots[offset + order] = knots[offset];
+
+			/* Elevated by one. */
+			order++;
+		}
+		TS_INT_TRACE_END("ts_bspline_elevate_degree/elevate")
+
+		/* Combine bezier curves. */
+		TS_INT_TRACE_BEGIN("ts_bspline_elevate_degree/merge")
+		d = 0; /* Number of removed knots/control points. */
+		for (i = 0; i < num_beziers - 1; i++) {
+			/* Is the last control point of bezier curve `i' equal
+			 * to the first control point of bezier curve `i+1'? */
+			last = ctrlp + (
+				i * order /* base location of `i' */
+				- d /* minus the number of removed values */
+				+ (order - 1) /* jump to last control point */
+				) * dim;
+			first = last + dim; /* next control point */
+			if (ts_distance(last, first, dim) <= epsilon) {
+				/* Move control points. */
+				memmove(last, first, (num_beziers - 1 - i) *
+				        order * dim * sizeof(tsReal));
+
+				/* Move knots. `last' is the last knot of the
+				 * second knot group of bezier curve `i'.
+				 * `first' is the first knot of the first knot
+				 * group of bezier curve `i+1'. The
+				 * calculations are quite similar to those for
+				 * the control points `last' and `first' (see
+				 * above). */
+				last = knots + i * order - d + (2 * order - 1);
+				first = last + 1;
+				memmove(last, first, (num_beziers - 1 - i) *
+				        order * sizeof(tsReal));
+
+				/* Removed one knot/control point. */
+				d++;
+			}
+		}
+		TS_INT_TRACE_END("ts_bspline_elevate_degree/merge")
+
+		/* Repair internal state. */
+		worker.pImpl->deg = order - 1;
+		worker.pImpl->n_knots -= d;
+		worker.pImpl->n_ctrlp = ts_bspline_num_knots(&worker) - order;
+		memmove(ts_int_bspline_access_knots(&worker),
+		        knots, ts_bspline_sof_knots(&worker));
+		worker.pImpl = ts_int_realloc(
+			worker.pImpl, ts_int_bspline_sof_state(&worker));
+		if (worker.pImpl == NULL) {
+			TS_THROW_0(try, err, status, TS_MALLOC,
+			           "out of memory")
+		}
+
+		/* Move `worker' to output parameter. */
+		if (spline == elevated)
+			ts_bspline_free(elevated);
+		ts_bspline_move(&worker, elevated);
+	TS_FINALLY
+		ts_bspline_free(&worker);
+	TS_END_TRY_RETURN(err)
+}
+
+tsError
+ts_bspline_elevate_degree(const tsBSpline *spline,
+                          size_t amount,
+                          tsReal epsilon,
+                          tsBSpline *elevated,
+                          tsStatus * status)
+{
+	TS_INT_API_SCOPE(ts_bspline_elevate_degree,
+		ts_int_bspline_elevate_degree(spline, amount, epsilon, elevated,
+		                              status))
+}
+
+/* Returns the binomial coefficient `n' over `k'. */
+tsReal
+ts_int_binomial(size_t n,
+                size_t k)
+{
+	tsReal result = (tsReal) 1.0;
+	size_t i;
+	if (k > n) return (tsReal) 0.0;
+	if (k > n - k) k = n - k;
+	for (i = 1; i <= k; i++)
+		result = result * (tsReal) (n - k + i) / (tsReal) i;
+	return result;
+}
+
+/* Sets `out' to `a * x + (1 - a) * y'. `out' may be `x' or `y'. */
+void
+ts_int_vec_blend(const tsReal *x,
+                 const tsReal *y,
+                 tsReal a,
+                 size_t dim,
+                 tsReal *out)
+{
+	size_t d;
+	for (d = 0; d < dim; d++)
+		out[d] = a * x[d] + ((tsReal) 1.0 - a) * y[d];
+}
+
+/* Computes the coefficients that elevate a bezier curve of degree `p' by `t'.
+ * Coefficient (i, j) is stored at `coeffs[i * (p + 1) + j]'. */
+void
+ts_int_bezier_elevation_coeffs(size_t p,
+                               size_t t,
+                               tsReal *coeffs)
+{
+	const size_t ph = p + t;
+	const size_t stride = p + 1;
+	tsReal inv;
+	size_t i, j, mpi;
+
+	memset(coeffs, 0, (ph + 1) * stride * sizeof(tsReal));
+	coeffs[0] = coeffs[ph * stride + p] = (tsReal) 1.0;
+	for (i = 1; i <= ph / 2; i++) {
+		inv = (tsReal) 1.0 / ts_int_binomial(ph, i);
+		mpi = p < i ? p : i;
+		for (j = i > t ? i - t : 0; j <= mpi; j++) {
+			coeffs[i * stride + j] = inv * ts_int_binomial(p, j) *
+				ts_int_binomial(t, i - j);
+		}
+	}
+	/* Symmetry. */
+	for (i = ph / 2 + 1; i < ph; i++) {
+		mpi = p < i ? p : i;
+		for (j = i > t ? i - t : 0; j <= mpi; j++) {
+			coeffs[i * stride + j] =
+				coeffs[(ph - i) * stride + p - j];
+		}
+	}
+}
+
+/* Removes the knot `ua', which has been inserted `oldr' times to extract the
+ * previous bezier segment, from the (partial) result `Q'/`Uh' and the
+ * elevated segment `ebpts' (see algorithm A5.9 of 'The NURBS Book'). */
+void
+ts_int_elevate_remove_knot(tsReal *Q,
+                           const tsReal *Uh,
+                           tsReal *ebpts,
+                           size_t dim,
+                           ptrdiff_t ph,
+                           ptrdiff_t kind,
+                           ptrdiff_t cind,
+                           ptrdiff_t lbz,
+                           ptrdiff_t oldr,
+                           tsReal ua,
+                           tsReal ub)
+{
+	const tsReal den = ub - ua;
+	const tsReal bet = (ub - Uh[kind - 1]) / den;
+	ptrdiff_t first = kind - 2, last = kind;
+	ptrdiff_t tr, i, j, kj;
+	tsReal alf, gam;
+
+	for (tr = 1; tr < oldr; tr++) {
+		i = first;
+		j = last;
+		kj = j - kind + 1;
+		while (j - i > tr) {
+			if (i < cind) {
+				alf = (ub - Uh[i]) / (ua - Uh[i]);
+				ts_int_vec_blend(Q + i * dim,
+				                 Q + (i - 1) * dim,
+				                 alf, dim, Q + i * dim);
+			}
+			if (j >= lbz) {
+				gam = j - tr <= kind - ph + oldr
+					? (ub - Uh[j - tr]) / den : bet;
+				ts_int_vec_blend(ebpts + kj * dim,
+				                 ebpts + (kj + 1) * dim,
+				                 gam, dim, ebpts + kj * dim);
+			}
+			i++;
+			j--;
+			kj--;
+		}
+		first--;
+		last++;
+	}
+}
+
+tsError
+ts_int_bspline_elevate_degree_direct(const tsBSpline *spline,
+                                     size_t amount,
+                                     tsBSpline *elevated,
+                                     tsStatus *status)
+{
+	const size_t t = amount;
+	size_t p, ph, dim, m, num_knots, num_ctrlp, s, sof_mem;
+	tsBSpline clamped, worker;
+	const tsReal *U, *P; /* knots and control points of `clamped' */
+	tsReal *Uh, *Q;      /* knots and control points of `worker' */
+
+	/* Sliding window (one bezier segment). */
+	tsReal *mem = NULL;
+	tsReal *coeffs; /* see ::ts_int_bezier_elevation_coeffs */
+	tsReal *bpts;   /* current bezier segment */
+	tsReal *ebpts;  /* current elevated bezier segment */
+	tsReal *next;   /* leftmost control points of the next segment */
+	tsReal *alfs;   /* knot insertion coefficients */
+	const tsReal *row;
+
+	size_t a, b, i, j, k, mul, mpi, lbz, rbz, kind, cind, nr;
+	ptrdiff_t r, oldr;
+	tsReal numer, ua, ub;
+	tsError err;
+
+	/* Trivial case. */
+	if (amount == 0)
+		return ts_bspline_copy(spline, elevated, status);
+	/* Splines of degree 0 are discontinuous at every knot. Hence, the
+	 * minimal result is a sequence of bezier curves. */
+	if (ts_bspline_degree(spline) == 0) {
+		return ts_int_bspline_elevate_degree(
+			spline, amount, (tsReal) -1.0, elevated, status);
+	}
+
+	INIT_OUT_BSPLINE(spline, elevated)
+	clamped = ts_bspline_init();
+	worker = ts_bspline_init();
+	TS_TRY(try, err, status)
+		/* The algorithm requires clamped ends. */
+		TS_CALL(try, err, ts_bspline_copy(spline, &clamped, status))
+		TS_CALL(try, err, ts_int_bspline_clamp(&clamped, status))
+		p = ts_bspline_degree(&clamped);
+		dim = ts_bspline_dimension(&clamped);
+		num_knots = ts_bspline_num_knots(&clamped);
+		U = ts_int_bspline_access_knots(&clamped);
+		P = ts_int_bspline_access_ctrlp(&clamped);
+		m = num_knots - 1;
+		ph = p + t;
+
+		/* The multiplicity of each of the `s' distinct interior knots
+		 * and of both ends is increased by `t'. */
+		s = 0;
+		for (i = p + 1; i < num_knots - p - 1; i++) {
+			if (i == p + 1 || !ts_knots_equal(U[i - 1], U[i]))
+				s++;
+		}
+		num_ctrlp = ts_bspline_num_control_points(&clamped) +
+			(s + 1) * t;
+		TS_CALL(try, err, ts_bspline_new(
+		        num_ctrlp, dim, ph, TS_OPENED /* overridden below */,
+		        &worker, status))
+		Uh = ts_int_bspline_access_knots(&worker);
+		Q = ts_int_bspline_access_ctrlp(&worker);
+
+		sof_mem = (ph + 1) * (p + 1) + /* coeffs */
+			(p + 1) * dim +        /* bpts */
+			(ph + 1) * dim +       /* ebpts */
+			(p + 1) * dim +        /* next */
+			(p + 1);               /* alfs */
+		mem = (tsReal *) ts_int_malloc(sof_mem * sizeof(tsReal));
+		if (!mem) {
+			TS_THROW_0(try, err, status, TS_MALLOC,
+			           "out of memory")
+		}
+		coeffs = mem;
+		bpts = coeffs + (ph + 1) * (p + 1);
+		ebpts = bpts + (p + 1) * dim;
+		next = ebpts + (ph + 1) * dim;
+		alfs = next + (p + 1) * dim;
+		ts_int_bezier_elevation_coeffs(p, t, coeffs);
+
+		/* The following is based on algorithm A5.9 of 'The NURBS
+		 * Book' (Les Piegl and Wayne Tiller). Each bezier segment is
+		 * extracted by knot insertion, elevated, and written to
+		 * `worker', where the knots that were inserted are removed
+		 * again right away. Thus, `worker' never holds more than the
+		 * minimal result. */
+		kind = ph + 1;
+		r = -1;
+		a = p;
+		b = p + 1;
+		cind = 1;
+		ua = U[0];
+		memcpy(Q, P, dim * sizeof(tsReal));
+		for (i = 0; i <= ph; i++)
+			Uh[i] = ua;
+		memcpy(bpts, P, (p + 1) * dim * sizeof(tsReal));
+
+		while (b < m) {
+			i = b;
+			while (b < m && ts_knots_equal(U[b], U[b + 1]))
+				b++;
+			mul = b - i + 1;
+			ub = U[b];
+			oldr = r;
+			r = (ptrdiff_t) p - (ptrdiff_t) mul;
+			nr = r > 0 ? (size_t) r : 0;
+			/* A5.9 assumes that the multiplicity of interior knots
+			 * is at most `p'. If `ua' is a discontinuity (`oldr' <
+			 * 0 and not the first segment), the first control
+			 * point of the segment must be loaded as well. */
+			if (oldr > 0) lbz = (size_t) (oldr + 2) / 2;
+			else if (oldr < 0 && a != p) lbz = 0;
+			else lbz = 1;
+			rbz = r > 0 ? ph - (nr + 1) / 2 : ph;
+
+			/* Insert `ub' `r' times to get the bezier segment. */
+			numer = ub - ua;
+			for (k = p; nr > 0 && k > mul; k--)
+				alfs[k - mul - 1] = numer / (U[a + k] - ua);
+			for (j = 1; j <= nr; j++) {
+				for (k = p; k >= mul + j; k--) {
+					ts_int_vec_blend(bpts + k * dim,
+					                 bpts + (k - 1) * dim,
+					                 alfs[k - mul - j], dim,
+					                 bpts + k * dim);
+				}
+				memcpy(next + (nr - j) * dim, bpts + p * dim,
+				       dim * sizeof(tsReal));
+			}
+
+			/* Elevate the bezier segment. */
+			for (i = lbz; i <= ph; i++) {
+				row = coeffs + i * (p + 1);
+				memset(ebpts + i * dim, 0,
+				       dim * sizeof(tsReal));
+				mpi = p < i ? p : i;
+				for (j = i > t ? i - t : 0; j <= mpi; j++) {
+					for (k = 0; k < dim; k++) {
+						ebpts[i * dim + k] += row[j] *
+							bpts[j * dim + k];
+					}
+				}
+			}
+
+			/* Remove `ua' `oldr' times. */
+			if (oldr > 1) {
+				ts_int_elevate_remove_knot(Q, Uh, ebpts, dim,
+					(ptrdiff_t) ph, (ptrdiff_t) kind,
+					(ptrdiff_t) cind, (ptrdiff_t) lbz,
+					oldr, ua, ub);
+			}
+
+			/* Load the knot `ua' and the control points. */
+			if (a != p) {
+				/* Multiplicity of `ua' in the result. */
+				mul = (size_t) ((ptrdiff_t) ph - oldr);
+				for (i = 0; i < mul; i++)
+					Uh[kind++] = ua;
+			}
+			for (j = lbz; j <= rbz; j++) {
+				memcpy(Q + cind * dim, ebpts + j * dim,
+				       dim * sizeof(tsReal));
+				cind++;
+			}
+
+			if (b < m) {
+				/* Set up the next segment. */
+				memcpy(bpts, next, nr * dim * sizeof(tsReal));
+				memcpy(bpts + nr * dim, P + (b - p + nr) * dim,
+				       (p + 1 - nr) * dim * sizeof(tsReal));
+				a = b;
+				b++;
+				ua = ub;
+			} else {
+				/* End knot. */
+				for (i = 0; i <= ph; i++)
+					Uh[kind + i] = ub;
+			}
+		}
+
+		if (spline == elevated)
+			ts_bspline_free(elevated);
+		ts_bspline_move(&worker, elevated);
+	TS_FINALLY
+		ts_bspline_free(&clamped);
+		ts_bspline_free(&worker);
+		if (mem) ts_int_free(mem);
+	TS_END_TRY_RETURN(err)
+}
+
+tsError
+ts_bspline_elevate_degree_direct(const tsBSpline *spline,
+                                 size_t amount,
+                                 tsBSpline *elevated,
+                                 tsStatus *status)
+{
+	TS_INT_API_SCOPE(ts_bspline_elevate_degree_direct,
+		ts_int_bspline_elevate_degree_direct(spline, amount, elevated,
+		                                     status))
+}
+
+/* Reduces the degree of the bezier curve `P' (degree `p' > 0) by one and
+ * stores the `p' control points of the result in `Q' (equations 5.41 to 5.45
+ * of 'The NURBS Book'). The interior control points are computed from both
+ * ends towards the middle. If `p' is odd, the two values computed for the
+ * middle control point are averaged. */
+void
+ts_int_bezier_reduce_degree(const tsReal *P,
+                            size_t p,
+                            size_t dim,
+                            tsReal *Q)
+{
+	const size_t r = (p - 1) / 2;
+	tsReal alf;
+	size_t i, d;
+
+	if (p == 1) {
+		ts_int_vec_blend(P, P + dim, (tsReal) 0.5, dim, Q);
+		return;
+	}
+	memcpy(Q, P, dim * sizeof(tsReal));
+	memcpy(Q + (p - 1) * dim, P + p * dim, dim * sizeof(tsReal));
+	for (i = 1; i <= r; i++) {
+		alf = (tsReal) i / (tsReal) p;
+		for (d = 0; d < dim; d++) {
+			Q[i * dim + d] = (P[i * dim + d] -
+				alf * Q[(i - 1) * dim + d]) / (1 - alf);
+		}
+	}
+	for (i = p - 2; i > r; i--) {
+		alf = (tsReal) (i + 1) / (tsReal) p;
+		for (d = 0; d < dim; d++) {
+			Q[i * dim + d] = (P[(i + 1) * dim + d] -
+				(1 - alf) * Q[(i + 1) * dim + d]) / alf;
+		}
+	}
+	if (p % 2 == 1) {
+		alf = (tsReal) (r + 1) / (tsReal) p;
+		for (d = 0; d < dim; d++) {
+			Q[r * dim + d] = (tsReal) 0.5 * (Q[r * dim + d] +
+				(P[(r + 1) * dim + d] -
+				(1 - alf) * Q[(r + 1) * dim + d]) / alf);
+		}
+	}
+}
+
+/* Computes the control points of the spline (degree `p', knots `U', control
+ * points `P') that results from removing the knot `U[r]' once. `U[r]' is the
+ * last occurrence of the knot and `s' its multiplicity. On return, the control
+ * points `P[*first]' to `P[*first + *num - 1]' are to be replaced by the `*num
+ * - 1' control points stored at `T + dim'. `T' must have space for `p + 2'
+ * points. Returns the maximum distance between the control points of the
+ * spline and the control points of the result with `U[r]' reinserted, which
+ * bounds the deviation of the result (on the knot interval from `U[*first]' to
+ * `U[*first + *num + p]'). */
+tsReal
+ts_int_remove_knot(const tsReal *U,
+                   const tsReal *P,
+                   size_t p,
+                   size_t dim,
+                   size_t r,
+                   size_t s,
+                   tsReal *T,
+                   size_t *first,
+                   size_t *num)
+{
+	const tsReal u = U[r];
+	const size_t off = r - p - 1; /* T[0] corresponds to P[off] */
+	size_t i, j, d;
+	tsReal alfi, alfj, dev, max_dev = (tsReal) 0.0;
+
+	/* Two bezier segments: merge the adjacent end points. */
+	if (s > p) {
+		*first = r - s;
+		*num = 2;
+		ts_int_vec_blend(P + (r - s) * dim, P + (r - p) * dim,
+		                 (tsReal) 0.5, dim, T + dim);
+		return ts_distance(P + (r - s) * dim, T + dim, dim);
+	}
+
+	/* The control points `P[r - p - 1]' and `P[r - s + 1]' are retained.
+	 * The `p - s' control points in between are computed from both
+	 * sides (see algorithm A5.8 of 'The NURBS Book'). */
+	*first = r - p;
+	*num = p - s + 1;
+	memcpy(T, P + off * dim, dim * sizeof(tsReal));
+	memcpy(T + (p - s + 1) * dim, P + (r - s + 1) * dim,
+	       dim * sizeof(tsReal));
+	i = r - p;
+	j = r - s - 1;
+	while (i < j) {
+		alfi = (u - U[i]) / (U[i + p + 1] - U[i]);
+		alfj = (u - U[j + 1]) / (U[j + p + 2] - U[j + 1]);
+		for (d = 0; d < dim; d++) {
+			T[(i - off) * dim + d] = (P[i * dim + d] -
+				(1 - alfi) * T[(i - off - 1) * dim + d]) / alfi;
+			T[(j - off) * dim + d] = (P[(j + 1) * dim + d] -
+				alfj * T[(j - off + 1) * dim + d]) / (1 - alfj);
+		}
+		i++;
+		j--;
+	}
+	if (i == j) {
+		/* Average the values obtained from both sides. */
+		alfi = (u - U[i]) / (U[i + p + 1] - U[i]);
+		alfj = (u - U[i + 1]) / (U[i + p + 2] - U[i + 1]);
+		for (d = 0; d < dim; d++) {
+			T[(i - off) * dim + d] = (tsReal) 0.5 * (
+				(P[i * dim + d] - (1 - alfi) *
+				 T[(i - off - 1) * dim + d]) / alfi +
+				(P[(i + 1) * dim + d] - alfj *
+				 T[(i - off + 1) * dim + d]) / (1 - alfj));
+		}
+	}
+
+	/* Reinsert `u' and compare with `P'. */
+	for (i = r - p; i <= r - s; i++) {
+		alfi = (u - U[i]) / (U[i + p + 1] - U[i]);
+		ts_int_vec_blend(T + (i - off) * dim, T + (i - off - 1) * dim,
+		                 alfi, dim, T + (p + 1) * dim);
+		dev = ts_distance(P + i * dim, T + (p + 1) * dim, dim);
+		if (dev > max_dev)
+			max_dev = dev;
+	}
+	return max_dev;
+}
+
+/* Adds `dev' to the errors (`seg_err') of the `num' segments (separated by
+ * `bps') that overlap the interval (`lo', `hi'), provided that none of them
+ * exceeds `tolerance' afterwards. Returns 1 if `dev' has been added, 0
+ * otherwise. */
+int
+ts_int_reduce_add_error(const tsReal *bps,
+                        tsReal *seg_err,
+                        size_t num,
+                        tsReal lo,
+                        tsReal hi,
+                        tsReal dev,
+                        tsReal tolerance)
+{
+	size_t a = 0, b = num, m;
+	/* First segment ending after `lo'. */
+	while (a < b) {
+		m = (a + b) / 2;
+		if (bps[m + 1] > lo) b = m;
+		else a = m + 1;
+	}
+	for (m = a; m < num && bps[m] < hi; m++) {
+		if (seg_err[m] + dev > tolerance)
+			return 0;
+	}
+	for (m = a; m < num && bps[m] < hi; m++)
+		seg_err[m] += dev;
+	return 1;
+}
+
+tsError
+ts_int_bspline_reduce_degree(const tsBSpline *spline,
+                             size_t amount,
+                             tsReal tolerance,
+                             tsBSpline *reduced,
+                             tsReal *error,
+                             tsStatus *status)
+{
+	size_t p, q, dim, num_beziers, num_ctrlp, num_knots;
+	size_t b, i, j, d, k, r, s, first, num;
+	tsBSpline beziers, worker;
+	struct tsBSplineImpl *impl; /* shrunk state of `worker' */
+	const tsReal *P, *knots; /* control points and knots of `beziers' */
+	tsReal *Q, *U;           /* control points and knots of `worker' */
+
+	tsReal *mem = NULL;
+	tsReal *coeffs;  /* see ::ts_int_bezier_elevation_coeffs */
+	tsReal *bpts;    /* current bezier segment */
+	tsReal *tmp;     /* scratch space (one bezier segment) */
+	tsReal *T;       /* see ::ts_int_remove_knot */
+	tsReal *seg_err; /* error bound of each bezier segment */
+	tsReal *bps;     /* breakpoints of the bezier segments */
+
+	tsReal dev, max_err = (tsReal) 0.0;
+	tsError err;
+
+	if (error)
+		*error = (tsReal) 0.0;
+	/* Trivial case. */
+	if (amount == 0)
+		return ts_bspline_copy(spline, reduced, status);
+	p = ts_bspline_degree(spline);
+	if (amount > p) {
+		TS_RETURN_2(status, TS_NO_RESULT,
+		            "amount (%lu) > degree (%lu)",
+		            (unsigned long) amount,
+		            (unsigned long) p)
+	}
+	q = p - amount;
+
+	INIT_OUT_BSPLINE(spline, reduced)
+	beziers = ts_bspline_init();
+	worker = ts_bspline_init();
+	TS_TRY(try, err, status)
+		TS_CALL(try, err, ts_bspline_to_beziers(
+		        spline, &beziers, status))
+		dim = ts_bspline_dimension(&beziers);
+		num_beziers = ts_bspline_num_control_points(&beziers) / (p + 1);
+		P = ts_int_bspline_access_ctrlp(&beziers);
+		knots = ts_int_bspline_access_knots(&beziers);
+		TS_CALL(try, err, ts_bspline_new(
+		        num_beziers * (q + 1), dim, q, TS_BEZIERS,
+		        &worker, status))
+		Q = ts_int_bspline_access_ctrlp(&worker);
+		U = ts_int_bspline_access_knots(&worker);
+
+		mem = (tsReal *) ts_int_malloc(
+			((p + 1) * (q + 1) + (3 * p + 4) * dim +
+			 2 * num_beziers + 1) * sizeof(tsReal));
+		if (!mem) {
+			TS_THROW_0(try, err, status, TS_MALLOC,
+			           "out of memory")
+		}
+		coeffs = mem;
+		bpts = coeffs + (p + 1) * (q + 1);
+		tmp = bpts + (p + 1) * dim;
+		T = tmp + (p + 1) * dim;
+		seg_err = T + (p + 2) * dim;
+		bps = seg_err + num_beziers;
+
+		TS_INT_TRACE_BEGIN("ts_bspline_reduce_degree/reduce")
+		ts_int_bezier_elevation_coeffs(q, amount, coeffs);
+		for (b = 0; b <= num_beziers; b++) {
+			bps[b] = knots[b * (p + 1)];
+			for (i = 0; i <= q; i++)
+				U[b * (q + 1) + i] = bps[b];
+		}
+		for (b = 0; b < num_beziers; b++) {
+			memcpy(bpts, P + b * (p + 1) * dim,
+			       (p + 1) * dim * sizeof(tsReal));
+			for (i = p; i > q; i--) {
+				ts_int_bezier_reduce_degree(bpts, i, dim, tmp);
+				memcpy(bpts, tmp, i * dim * sizeof(tsReal));
+			}
+			memcpy(Q + b * (q + 1) * dim, bpts,
+			       (q + 1) * dim * sizeof(tsReal));
+			/* Elevate the result back to degree `p'. The distance
+			 * to the original control points bounds the error. */
+			seg_err[b] = (tsReal) 0.0;
+			for (i = 0; i <= p; i++) {
+				for (d = 0; d < dim; d++) {
+					tmp[d] = (tsReal) 0.0;
+					for (j = 0; j <= q; j++) {
+						tmp[d] += coeffs[i * (q + 1) + j]
+							* bpts[j * dim + d];
+					}
+				}
+				dev = ts_distance(tmp,
+					P + (b * (p + 1) + i) * dim, dim);
+				if (dev > seg_err[b])
+					seg_err[b] = dev;
+			}
+			if (seg_err[b] > max_err)
+				max_err = seg_err[b];
+		}
+		TS_INT_TRACE_END("ts_bspline_reduce_degree/reduce")
+		if (max_err > tolerance) {
+			if (error)
+				*error = max_err;
+			TS_THROW_2(try, err, status, TS_NO_RESULT,
+			           "error (%f) > tolerance (%f)",
+			           max_err, tolerance)
+		}
+
+		/* Remove as many interior knots as the remaining tolerance of
+		 * the affected segments allows. Degree 0 splines are
+		 * discontinuous at every knot. */
+		TS_INT_TRACE_BEGIN("ts_bspline_reduce_degree/remove_knots")
+		num_ctrlp = num_beziers * (q + 1);
+		num_knots = num_ctrlp + q + 1;
+		k = q + 1; /* first index of the current knot value */
+		while (q > 0 && k < num_knots - q - 1) {
+			r = k;
+			while (ts_knots_equal(U[r + 1], U[k]))
+				r++;
+			s = r - k + 1;
+			while (s > 0) {
+				dev = ts_int_remove_knot(U, Q, q, dim, r, s, T,
+				                         &first, &num);
+				if (!ts_int_reduce_add_error(bps, seg_err,
+						num_beziers, U[first],
+						U[first + num + q], dev,
+						tolerance)) {
+					break;
+				}
+				memcpy(Q + first * dim, T + dim,
+				       (num - 1) * dim * sizeof(tsReal));
+				memmove(Q + (first + num - 1) * dim,
+				        Q + (first + num) * dim,
+				        (num_ctrlp - first - num) * dim *
+				        sizeof(tsReal));
+				memmove(U + r, U + r + 1,
+				        (num_knots - r - 1) * sizeof(tsReal));
+				num_ctrlp--;
+				num_knots--;
+				r--;
+				s--;
+			}
+			k = r + 1;
+		}
+		TS_INT_TRACE_END("ts_bspline_reduce_degree/remove_knots")
+
+		/* Repair internal state. */
+		worker.pImpl->n_ctrlp = num_ctrlp;
+		worker.pImpl->n_knots = num_knots;
+		memmove(ts_int_bspline_access_knots(&worker), U,
+		        ts_bspline_sof_knots(&worker));
+		/* Keep the old state on failure so that it is released by
+		 * ::ts_bspline_free below. */
+		impl = (struct tsBSplineImpl *) ts_int_realloc(
+			worker.pImpl, ts_int_bspline_sof_state(&worker));
+		if (impl == NULL) {
+			TS_THROW_0(try, err, status, TS_MALLOC,
+			           "out of memory")
+		}
+		worker.pImpl = impl;
+
+		max_err = (tsReal) 0.0;
+		for (b = 0; b < num_beziers; b++) {
+			if (seg_err[b] > max_err)
+				max_err = seg_err[b];
+		}
+		if (error)
+			*error = max_err;
+		if (spline == reduced)
+			ts_bspline_free(reduced);
+		ts_bspline_move(&worker, reduced);
+	TS_FINALLY
+		ts_bspline_free(&beziers);
+		ts_bspline_free(&worker);
+		if (mem) ts_int_free(mem);
+	TS_END_TRY_RETURN(err)
+}
+
+tsError
+ts_bspline_reduce_degree(const tsBSpline *spline,
+                         size_t amount,
+                         tsReal tolerance,
+                         tsBSpline *reduced,
+                         tsReal *error,
+                         tsStatus *status)
+{
+	TS_INT_API_SCOPE(ts_bspline_reduce_degree,
+		ts_int_bspline_reduce_degree(spline, amount, tolerance,
+		                             reduced, error, status))
+}
+
+/* Inserts `missing' knots into `spline', which are distributed evenly over
+ * the domain of `spline'. */
+tsError
+ts_int_bspline_insert_missing_knots(tsBSpline *spline,
+                                    size_t missing,
+                                    tsStatus *status)
+{
+	tsDeBoorNet net;
+	size_t i;
+	tsReal min, max, shift, nextKnot;
+	tsError err;
+
+	if (missing == 0)
+		TS_RETURN_SUCCESS(status)
+	TS_CALL_ROE(err, ts_int_deboornet_new(spline, &net, status))
+	TS_TRY(try, err, status)
+		ts_bspline_domain(spline, &min, &max);
+		shift = ( (tsReal) 1.0 / missing ) * (tsReal) 0.5;
+		for (i = 0; i < missing; i++) {
+			nextKnot = (max - min) * ((tsReal)i / missing) + min;
+			nextKnot += shift;
+			TS_CALL(try, err, ts_int_bspline_eval_woa(
+			        spline, nextKnot, &net, status))
+			while (!ts_deboornet_num_insertions(&net)) {
+				/* Linear exploration for next knot. */
+				nextKnot += 5 * TS_KNOT_EPSILON;
+				if (nextKnot > max) {
+					TS_THROW_0(try, err, status,
+					           TS_NO_RESULT,
+					          "no more knots for insertion")
+				}
+				TS_CALL(try, err, ts_int_bspline_eval_woa(
+				        spline, nextKnot, &net, status))
+			}
+			TS_CALL(try, err, ts_int_bspline_insert_knot(
+			        spline, &net, 1, spline, status))
+		}
+	TS_FINALLY
+		ts_deboornet_free(&net);
+	TS_END_TRY_RETURN(err)
+}
+
+tsError
+ts_int_bspline_align(const tsBSpline *s1,
+                     const tsBSpline *s2,
+                     tsReal epsilon,
+                     tsBSpline *s1_out,
+                     tsBSpline *s2_out,
+                     tsStatus *status)
+{
+	tsBSpline s1_worker, s2_worker, *smaller, *larger;
+	tsError err;
+
+	INIT_OUT_BSPLINE(s1, s1_out)
+	INIT_OUT_BSPLINE(s2, s2_out)
+	s1_worker = ts_bspline_init();
+	s2_worker = ts_bspline_init();
+	smaller = larger = NULL;
+	TS_TRY(try, err, status)
+		/* Set up `s1_worker' and `s2_worker'. After this
+		 * if-elseif-else-block, `s1_worker' and `s2_worker' have same
+		 * degree. */
+		if (ts_bspline_degree(s1) < ts_bspline_degree(s2)) {
+			TS_CALL(try, err, ts_bspline_elevate_degree(s1,
+			        ts_bspline_degree(s2) - ts_bspline_degree(s1),
+			        epsilon, &s1_worker, status))
+			TS_CALL(try, err, ts_bspline_copy(
+			        s2, &s2_worker, status))
+		} else if (ts_bspline_degree(s2) < ts_bspline_degree(s1)) {
+			TS_CALL(try, err, ts_bspline_elevate_degree(s2,
+			        ts_bspline_degree(s1) - ts_bspline_degree(s2),
+			        epsilon, &s2_worker, status))
+			TS_CALL(try, err, ts_bspline_copy(
+			        s1, &s1_worker, status))
+		} else {
+			TS_CALL(try, err, ts_bspline_copy(
+			        s1, &s1_worker, status))
+			TS_CALL(try, err, ts_bspline_copy(
+			        s2, &s2_worker, status))
+		}
+
+		/* Set up `smaller' and `larger'. */
+		if (ts_bspline_num_knots(&s1_worker) <
+		    ts_bspline_num_knots(&s2_worker)) {
+			smaller = &s1_worker;
+			larger  = &s2_worker;
+		} else {
+			smaller = &s2_worker;
+			larger  = &s1_worker;
+		}
+
+		/* Insert knots into `smaller' until it has the same number of
+		 * knots (and therefore the same number of control points) as
+		 * `larger'. */
+		TS_INT_TRACE_CALL(try, err, "ts_bspline_align/insert_knots",
+		        ts_int_bspline_insert_missing_knots(smaller,
+		        ts_bspline_num_knots(larger) -
+		        ts_bspline_num_knots(smaller), status))
+
+		if (s1 == s1_out)
+			ts_bspline_free(s1_out);
+		if (s2 == s2_out)
+			ts_bspline_free(s2_out);
+		ts_bspline_move(&s1_worker, s1_out);
+		/* if `s1_out' == `s2_out', `s2_worker' must not be moved
+		 * because otherwise the memory of `s1_worker' is leaked
+		 * (`s2_worker' overrides `s1_worker'). */
+		if (s1_out != s2_out)
+			ts_bspline_move(&s2_worker, s2_out);
+	TS_FINALLY
+		ts_bspline_free(&s1_worker);
+		ts_bspline_free(&s2_worker);
+	TS_END_TRY_RETURN(err)
+}
+
+tsError
+ts_bspline_align(const tsBSpline *s1,
+                 const tsBSpline *s2,
+                 tsReal epsilon,
+                 tsBSpline *s1_out,
+                 tsBSpline *s2_out,
+                 tsStatus *status)
+{
+	TS_INT_API_SCOPE(ts_bspline_align,
+		ts_int_bspline_align(s1, s2, epsilon, s1_out, s2_out, status))
+}
+
+tsError
+ts_int_bspline_morph(const tsBSpline *origin,
+                     const tsBSpline *target,
+                     tsReal t,
+                     tsReal epsilon,
+                     tsBSpline *out,
+                     tsStatus *status)
+{
+	tsBSpline origin_al, target_al; /* aligned origin and target */
+	tsReal *origin_al_c, *origin_al_k; /* control points and knots */
+	tsReal *target_al_c, *target_al_k; /* control points and knots */
+
+	/* Properties of `out'. */
+	size_t deg, dim, num_ctrlp, num_knots;
+	tsReal *ctrlp, *knots;
+	tsBSpline tmp; /* temporary buffer if `out' must be resized */
+
+	tsReal t_hat;
+	size_t i, offset, d;
+	tsError err;
+
+	origin_al = ts_bspline_init();
+	target_al = ts_bspline_init();
+	TS_TRY(try, err, status)
+		/* Clamp `t' to domain [0, 1] and set up `t_hat'. */
+		if (t < (tsReal) 0.0) t = (tsReal) 0.0;
+		if (t > (tsReal) 1.0) t = (tsReal) 1.0;
+		t_hat = (tsReal) 1.0 - t;
+
+		/* Set up `origin_al' and `target_al'. */
+		/* Degree must be elevated... */
+		if (ts_bspline_degree(origin) != ts_bspline_degree(target) ||
+		 /* .. or knots (and thus control points) must be inserted. */
+		 ts_bspline_num_knots(origin) != ts_bspline_num_knots(target)) {
+			TS_CALL(try, err, ts_bspline_align(
+			        origin, target, epsilon, &origin_al, &target_al,
+			        status));
+		} else {
+			/* Flat copy. */
+			origin_al = *origin;
+			target_al = *target;
+		}
+		origin_al_c = ts_int_bspline_access_ctrlp(&origin_al);
+		origin_al_k = ts_int_bspline_access_knots(&origin_al);
+		target_al_c = ts_int_bspline_access_ctrlp(&target_al);
+		target_al_k = ts_int_bspline_access_knots(&target_al);
+
+		/* Set up `out'. */
+		deg = ts_bspline_degree(&origin_al);
+		num_ctrlp = ts_bspline_num_control_points(&origin_al);
+		dim = ts_bspline_dimension(&origin_al);
+		if (ts_bspline_dimension(&target_al) < dim)
+			dim = ts_bspline_dimension(&target_al);
+		if (out->pImpl == NULL) {
+			TS_CALL(try, err, ts_bspline_new(num_ctrlp, dim, deg,
+			        TS_OPENED /* doesn't matter */, out, status))
+		} else if (ts_bspline_degree(out) != deg ||
+		           ts_bspline_num_control_points(out) != num_ctrlp ||
+		           ts_bspline_dimension(out) != dim) {
+			TS_CALL(try, err, ts_bspline_new(num_ctrlp, dim, deg,
+			        TS_OPENED /* doesn't matter */, &tmp, status))
+			ts_bspline_free(out);
+			ts_bspline_move(&tmp, out);
+		}
+		num_knots = ts_bspline_num_knots(out);
+		ctrlp = ts_int_bspline_access_ctrlp(out);
+		knots = ts_int_bspline_access_knots(out);
+
+		/* Interpolate control points. */
+		TS_INT_TRACE_BEGIN("ts_bspline_morph/interpolate")
+		for (i = 0; i < num_ctrlp; i++) {
+			for (d = 0; d < dim; d++) {
+				offset = i * dim + d;
+				ctrlp[offset] = t * target_al_c[offset] +
+				                t_hat * origin_al_c[offset];
+			}
+		}
+
+		/* Interpolate knots. */
+		for (i = 0; i < num_knots; i++) {
+			knots[i] = t * target_al_k[i] +
+			           t_hat * origin_al_k[i];
+		}
+		TS_INT_TRACE_END("ts_bspline_morph/interpolate")
+	TS_FINALLY
+		if (origin->pImpl != origin_al.pImpl)
+			ts_bspline_free(&origin_al);
+		if (target->pImpl != target_al.pImpl)
+			ts_bspline_free(&target_al);
+	TS_END_TRY_RETURN(err)
+}
+
+tsError
+ts_bspline_morph(const tsBSpline *origin,
+                 const tsBSpline *target,
+                 tsReal t,
+                 tsReal epsilon,
+                 tsBSpline *out,
+                 tsStatus *status)
+{
+	TS_INT_API_SCOPE(ts_bspline_morph,
+		ts_int_bspline_morph(origin, target, t, epsilon, out, status))
+}
+/*! @} */
+
+
+
+/*! @name Serialization and Persistence
+ *
+ * @{
+ */
+/* Number of bytes buffered by file streams. */
+#define TS_INT_JSON_CHUNK_SIZE 8192
+
+/* Maximum length of a number token (including sign and exponent). */
+#define TS_INT_JSON_MAX_NUMBER 128
+
+/* Maximum nesting depth of values that are skipped by the parser. */
+#define TS_INT_JSON_MAX_DEPTH 64
+
+/* Real values are formatted with the least number of digits that are
+ * necessary to read them back without loss (shortest round trip), and they
+ * are parsed with correct rounding (ties to even). Both directions use exact
+ * integer arithmetic in the spirit of Ryu (Ulf Adams, 2018). To keep the
+ * implementation free of large tables, the fast path is restricted to
+ * decimal exponents whose power of five fits into 64 bits. This covers the
+ * values spline data usually consist of. All other values (and compilers
+ * without 64-bit integers) fall back to printf/strtod. Since C89 has no
+ * strtof, float builds round the result of strtod a second time. If strtod
+ * yields a value exactly halfway between two floats, the tie is resolved by
+ * comparing the decimal number with the halfway value exactly. */
+
+/* Size of the buffer passed to ts_int_format_real. */
+#define TS_INT_REAL_BUF_SIZE 32
+
+#ifdef TINYSPLINE_FLOAT_PRECISION
+#define TS_INT_REAL_MANT_DIG FLT_MANT_DIG
+#define TS_INT_REAL_MAX_DIGITS 9
+#else
+#define TS_INT_REAL_MANT_DIG DBL_MANT_DIG
+#define TS_INT_REAL_MAX_DIGITS 17
+#endif
+
+/* 64-bit unsigned integers (if supported by the compiler). */
+#if ((ULONG_MAX >> 31) >> 31) >= 3
+#define TS_INT_UINT64
+typedef unsigned long tsUInt64;
+#elif defined(_MSC_VER)
+#define TS_INT_UINT64
+typedef unsigned __int64 tsUInt64;
+#elif defined(__GNUC__) || defined(__clang__)
+#define TS_INT_UINT64
+__extension__ typedef unsigned long long tsUInt64;
+#endif
+
+#ifdef TS_INT_UINT64
+/* Largest exponent of ts_int_pow5. */
+#define TS_INT_POW5_MAX 27
+
+typedef struct
+{
+	tsUInt64 hi, lo;
+} tsUInt128;
+
+/* 5^k split into 32-bit halves (C89 lacks 64-bit literals). */
+static const unsigned long TS_INT_POW5[TS_INT_POW5_MAX + 1][2] = {
+	{ 0x00000000UL, 0x00000001UL }, /* 5^0 */
+	{ 0x00000000UL, 0x00000005UL }, /* 5^1 */
+	{ 0x00000000UL, 0x00000019UL }, /* 5^2 */
+	{ 0x00000000UL, 0x0000007DUL }, /* 5^3 */
+	{ 0x00000000UL, 0x00000271UL }, /* 5^4 */
+	{ 0x00000000UL, 0x00000C35UL }, /* 5^5 */
+	{ 0x00000000UL, 0x00003D09UL }, /* 5^6 */
+	{ 0x00000000UL, 0x0001312DUL }, /* 5^7 */
+	{ 0x00000000UL, 0x0005F5E1UL }, /* 5^8 */
+	{ 0x00000000UL, 0x001DCD65UL }, /* 5^9 */
+	{ 0x00000000UL, 0x009502F9UL }, /* 5^10 */
+	{ 0x00000000UL, 0x02E90EDDUL }, /* 5^11 */
+	{ 0x00000000UL, 0x0E8D4A51UL }, /* 5^12 */
+	{ 0x00000000UL, 0x48C27395UL }, /* 5^13 */
+	{ 0x00000001UL, 0x6BCC41E9UL }, /* 5^14 */
+	{ 0x00000007UL, 0x1AFD498DUL }, /* 5^15 */
+	{ 0x00000023UL, 0x86F26FC1UL }, /* 5^16 */
+	{ 0x000000B1UL, 0xA2BC2EC5UL }, /* 5^17 */
+	{ 0x00000378UL, 0x2DACE9D9UL }, /* 5^18 */
+	{ 0x00001158UL, 0xE460913DUL }, /* 5^19 */
+	{ 0x000056BCUL, 0x75E2D631UL }, /* 5^20 */
+	{ 0x0001B1AEUL, 0x4D6E2EF5UL }, /* 5^21 */
+	{ 0x00087867UL, 0x8326EAC9UL }, /* 5^22 */
+	{ 0x002A5A05UL, 0x8FC295EDUL }, /* 5^23 */
+	{ 0x00D3C21BUL, 0xCECCEDA1UL }, /* 5^24 */
+	{ 0x0422CA8BUL, 0x0A00A425UL }, /* 5^25 */
+	{ 0x14ADF4B7UL, 0x320334B9UL }, /* 5^26 */
+	{ 0x6765C793UL, 0xFA10079DUL }  /* 5^27 */
+};
+
+tsUInt64
+ts_int_pow5(int k)
+{
+	return ((tsUInt64) TS_INT_POW5[k][0] << 32) | TS_INT_POW5[k][1];
+}
+
+int
+ts_int_bitlen64(tsUInt64 x)
+{
+	int n = 0;
+	if (x >> 32) { x >>= 32; n += 32; }
+	if (x >> 16) { x >>= 16; n += 16; }
+	if (x >> 8) { x >>= 8; n += 8; }
+	if (x >> 4) { x >>= 4; n += 4; }
+	if (x >> 2) { x >>= 2; n += 2; }
+	if (x >> 1) { x >>= 1; n += 1; }
+	return n + (int) x;
+}
+
+int
+ts_int_bitlen128(tsUInt128 x)
+{
+	return x.hi ? 64 + ts_int_bitlen64(x.hi) : ts_int_bitlen64(x.lo);
+}
+
+tsUInt128
+ts_int_mul64(tsUInt64 a,
+             tsUInt64 b)
+{
+	const tsUInt64 mask = 0xFFFFFFFFUL;
+	const tsUInt64 a0 = a & mask, a1 = a >> 32;
+	const tsUInt64 b0 = b & mask, b1 = b >> 32;
+	const tsUInt64 p00 = a0 * b0, p01 = a0 * b1;
+	const tsUInt64 p10 = a1 * b0, p11 = a1 * b1;
+	const tsUInt64 mid = (p00 >> 32) + (p01 & mask) + (p10 & mask);
+	tsUInt128 r;
+	r.lo = (mid << 32) | (p00 & mask);
+	r.hi = p11 + (p01 >> 32) + (p10 >> 32) + (mid >> 32);
+	return r;
+}
+
+/* Shifts `x' to the left by `n' (< 128) bits. Bits shifted out are lost. */
+tsUInt128
+ts_int_shl128(tsUInt128 x,
+              int n)
+{
+	tsUInt128 r;
+	if (n == 0) return x;
+	if (n >= 64) {
+		r.hi = x.lo << (n - 64);
+		r.lo = 0;
+	} else {
+		r.hi = (x.hi << n) | (x.lo >> (64 - n));
+		r.lo = x.lo << n;
+	}
+	return r;
+}
+
+/* Shifts `x' to the right by `n' bits and sets `sticky' if a 1-bit is shifted
+   out. */
+tsUInt128
+ts_int_shr128(tsUInt128 x,
+              int n,
+              int *sticky)
+{
+	tsUInt128 r;
+	if (n == 0) return x;
+	if (n >= 128) {
+		*sticky |= x.hi || x.lo;
+		r.hi = r.lo = 0;
+	} else if (n >= 64) {
+		*sticky |= x.lo || (n > 64 && (x.hi << (128 - n)));
+		r.lo = n == 64 ? x.hi : x.hi >> (n - 64);
+		r.hi = 0;
+	} else {
+		*sticky |= (x.lo << (64 - n)) != 0;
+		r.lo = (x.lo >> n) | (x.hi << (64 - n));
+		r.hi = x.hi >> n;
+	}
+	return r;
+}
+
+/* Divides `x' by `d'. The quotient must fit into 64 bits, that is, `x.hi' <
+   `d'. Long division with 32-bit digits (cf. divlu in Hacker's Delight, Henry
+   S. Warren). */
+tsUInt64
+ts_int_div128(tsUInt128 x,
+              tsUInt64 d,
+              tsUInt64 *rem)
+{
+	const tsUInt64 b = (tsUInt64) 1 << 32;
+	const int s = 64 - ts_int_bitlen64(d);
+	tsUInt64 dn1, dn0, xn32, xn21, xn10, xn1, xn0, q1, q0, rhat;
+
+	/* Normalize divisor and dividend. */
+	d <<= s;
+	dn1 = d >> 32;
+	dn0 = d & (b - 1);
+	xn32 = s ? (x.hi << s) | (x.lo >> (64 - s)) : x.hi;
+	xn10 = x.lo << s;
+	xn1 = xn10 >> 32;
+	xn0 = xn10 & (b - 1);
+
+	q1 = xn32 / dn1;
+	rhat = xn32 - q1 * dn1;
+	while (q1 >= b || q1 * dn0 > b * rhat + xn1) {
+		q1--;
+		rhat += dn1;
+		if (rhat >= b) break;
+	}
+	xn21 = xn32 * b + xn1 - q1 * d;
+
+	q0 = xn21 / dn1;
+	rhat = xn21 - q0 * dn1;
+	while (q0 >= b || q0 * dn0 > b * rhat + xn0) {
+		q0--;
+		rhat += dn1;
+		if (rhat >= b) break;
+	}
+	*rem = (xn21 * b + xn0 - q0 * d) >> s;
+	return q1 * b + q0;
+}
+
+/* Computes floor(x * 2^e2 / 10^q) and whether the division is exact.
+   Returns 0 if the computation exceeds 128 bits. */
+int
+ts_int_scale_pow10(tsUInt64 x,
+                   int e2,
+                   int q,
+                   tsUInt64 *out,
+                   int *exact)
+{
+	const int s = e2 - q;
+	tsUInt128 n;
+	tsUInt64 rem;
+	int sticky = 0;
+
+	n = ts_int_mul64(x, ts_int_pow5(q < 0 ? -q : 0));
+	if (s >= 0) {
+		if (ts_int_bitlen128(n) + s > 127)
+			return 0;
+		n = ts_int_shl128(n, s);
+	} else {
+		n = ts_int_shr128(n, -s, &sticky);
+	}
+	if (q > 0) {
+		if (n.hi >= ts_int_pow5(q))
+			return 0;
+		*out = ts_int_div128(n, ts_int_pow5(q), &rem);
+		sticky |= rem != 0;
+	} else {
+		if (n.hi)
+			return 0;
+		*out = n.lo;
+	}
+	*exact = !sticky;
+	return 1;
+}
+
+/* Computes the shortest decimal `digits' * 10^`exp10' that rounds to `a'
+   (a positive normal number with TS_INT_REAL_MANT_DIG significant bits).
+   Returns 0 if `a' is out of the supported range. */
+int
+ts_int_shortest_decimal(double a,
+                        tsUInt64 *digits,
+                        int *exp10)
+{
+	const int mbits = TS_INT_REAL_MANT_DIG;
+	tsUInt64 m, vr, vp, vm, vr_div10, vp_div10, vm_div10;
+	int e, e2, q, removed = 0, accept;
+	int vr_exact, vp_exact, vm_exact;
+	unsigned int last_removed = 0, vr_mod10, vm_mod10;
+
+	if (a < 1e-10 || a >= 1e26)
+		return 0;
+	m = (tsUInt64) ldexp(frexp(a, &e), mbits);
+	e2 = e - mbits - 2;
+	q = (int) floor(log10(a)) - 17;
+	if (q < -TS_INT_POW5_MAX || q > TS_INT_POW5_MAX)
+		return 0;
+	/* The rounding interval is [vm, vp] (cf. Ryu). Its lower bound is
+	   closer if `m' is a power of two. */
+	if (!ts_int_scale_pow10(4 * m, e2, q, &vr, &vr_exact) ||
+	    !ts_int_scale_pow10(4 * m + 2, e2, q, &vp, &vp_exact) ||
+	    !ts_int_scale_pow10(4 * m - 1 -
+	                        (m != ((tsUInt64) 1 << (mbits - 1))),
+	                        e2, q, &vm, &vm_exact)) {
+		return 0;
+	}
+	/* Ties are rounded to even when parsed. */
+	accept = (m & 1) == 0;
+	if (!accept && vp_exact)
+		vp--;
+
+	/* Remove digits as long as the result stays within the interval. */
+	for (;;) {
+		vp_div10 = vp / 10;
+		vm_div10 = vm / 10;
+		if (vp_div10 <= vm_div10)
+			break;
+		vm_mod10 = (unsigned int) (vm - 10 * vm_div10);
+		vr_div10 = vr / 10;
+		vr_mod10 = (unsigned int) (vr - 10 * vr_div10);
+		vm_exact &= vm_mod10 == 0;
+		vr_exact &= last_removed == 0;
+		last_removed = vr_mod10;
+		vr = vr_div10;
+		vp = vp_div10;
+		vm = vm_div10;
+		removed++;
+	}
+	if (accept && vm_exact) {
+		for (;;) {
+			vm_div10 = vm / 10;
+			vm_mod10 = (unsigned int) (vm - 10 * vm_div10);
+			if (vm_mod10 != 0)
+				break;
+			vr_div10 = vr / 10;
+			vr_mod10 = (unsigned int) (vr - 10 * vr_div10);
+			vr_exact &= last_removed == 0;
+			last_removed = vr_mod10;
+			vr = vr_div10;
+			vp = vp / 10;
+			vm = vm_div10;
+			removed++;
+		}
+	}
+	/* Round half to even if `vr' is exactly in the middle. */
+	if (vr_exact && last_removed == 5 && (vr & 1) == 0)
+		last_removed = 4;
+	*digits = vr + ((vr == vm && (!accept || !vm_exact)) ||
+	                last_removed >= 5);
+	if (*digits > vp)
+		*digits = vr;
+	*exp10 = q + removed;
+	return 1;
+}
+
+/* Converts `w' * 10^`e10' to the nearest value with TS_INT_REAL_MANT_DIG
+   significant bits (ties to even). Returns 0 if `e10' is out of the supported
+   range. */
+int
+ts_int_decimal_to_real(tsUInt64 w,
+                       int e10,
+                       double *value)
+{
+	const int mbits = TS_INT_REAL_MANT_DIG;
+	tsUInt128 n;
+	tsUInt64 d, rem, mant;
+	int shift, e2, sticky = 0, guard;
+
+	if (w == 0) {
+		*value = 0.0;
+		return 1;
+	}
+	if (e10 < -TS_INT_POW5_MAX || e10 > TS_INT_POW5_MAX)
+		return 0;
+	if (e10 >= 0) {
+		/* w * 5^e10 * 2^e10 */
+		n = ts_int_mul64(w, ts_int_pow5(e10));
+		e2 = e10;
+	} else {
+		/* w * 2^shift / 5^-e10 with mbits + 3 significant bits. */
+		d = ts_int_pow5(-e10);
+		shift = mbits + 3 + ts_int_bitlen64(d) - ts_int_bitlen64(w);
+		n.hi = 0;
+		n.lo = w;
+		n = shift >= 0 ? ts_int_shl128(n, shift)
+		               : ts_int_shr128(n, -shift, &sticky);
+		n.lo = ts_int_div128(n, d, &rem);
+		n.hi = 0;
+		sticky |= rem != 0;
+		e2 = e10 - shift;
+	}
+	/* Round to `mbits' significant bits. */
+	shift = ts_int_bitlen128(n) - mbits;
+	if (shift > 0) {
+		n = ts_int_shr128(n, shift - 1, &sticky);
+		guard = (int) (n.lo & 1);
+		mant = n.lo >> 1;
+		if (guard && (sticky || (mant & 1)))
+			mant++;
+		e2 += shift;
+	} else {
+		mant = n.lo;
+	}
+	*value = ldexp((double) mant, e2);
+	return 1;
+}
+#endif /* TS_INT_UINT64 */
+
+/* Writes the shortest representation of `value' that is read back without
+   loss to `buf' (TS_INT_REAL_BUF_SIZE bytes). Returns the number of
+   characters written (excluding the terminating null character). */
+size_t
+ts_int_format_real(tsReal value,
+                   char *buf)
+{
+	double a = (double) value;
+	char *out = buf;
+	tsReal parsed;
+#ifdef TS_INT_UINT64
+	char digits[24];
+	tsUInt64 w;
+	int num, exp10, k, i;
+#endif
+	int p;
+
+	if (!(a < 0) && !(a > 0)) /* 0 or -0 */
+		return (size_t) sprintf(buf, "%g", a);
+	if (a < 0) {
+		*out++ = '-';
+		a = -a;
+	}
+#ifdef TS_INT_UINT64
+	if (ts_int_shortest_decimal(a, &w, &exp10)) {
+		/* Digits are extracted in reverse order. */
+		for (num = 0; w > 0; num++) {
+			digits[num] = (char) ('0' + (int) (w % 10));
+			w /= 10;
+		}
+		/* Same layout as %g, with the decimal point at `k'. */
+		k = num + exp10;
+		if (k > 0 && k <= TS_INT_REAL_MAX_DIGITS) {
+			for (i = 0; i < num || i < k; i++) {
+				if (i == k) *out++ = '.';
+				*out++ = i < num ? digits[num - 1 - i] : '0';
+			}
+		} else if (k <= 0 && k > -4) {
+			*out++ = '0';
+			*out++ = '.';
+			for (i = k; i < 0; i++)
+				*out++ = '0';
+			for (i = num; i > 0; i--)
+				*out++ = digits[i - 1];
+		} else {
+			*out++ = digits[num - 1];
+			if (num > 1) {
+				*out++ = '.';
+				for (i = num - 1; i > 0; i--)
+					*out++ = digits[i - 1];
+			}
+			out += sprintf(out, "e%c%02d", k < 1 ? '-' : '+',
+			               k < 1 ? 1 - k : k - 1);
+		}
+		*out = '\0';
+		return (size_t) (out - buf);
+	}
+#endif
+	/* The first precision that round trips is the shortest one. */
+	for (p = 1; p < TS_INT_REAL_MAX_DIGITS; p++) {
+		sprintf(out, "%.*g", p, a);
+		parsed = (tsReal) strtod(out, NULL);
+		if (!(parsed < (tsReal) a) && !(parsed > (tsReal) a))
+			break;
+	}
+	return (size_t) (out - buf) + (size_t) sprintf(out, "%.*g", p, a);
+}
+
+#ifdef TINYSPLINE_FLOAT_PRECISION
+/* Natural numbers with up to TS_INT_BIG_LIMBS * 16 bits. Limbs hold 16 bits
+   so that their products fit into unsigned long. */
+#define TS_INT_BIG_LIMBS 64
+struct tsBigNat
+{
+	unsigned long limbs[TS_INT_BIG_LIMBS]; /**< Least significant first. */
+	size_t len;                            /**< Number of used limbs. */
+};
+
+/* `b' = `b' * `m' + `a' with `m', `a' < 2^16. Returns 0 on overflow. */
+int
+ts_int_big_mul_add(struct tsBigNat *b,
+                   unsigned long m,
+                   unsigned long a)
+{
+	size_t i;
+	for (i = 0; i < b->len; i++) {
+		a += b->limbs[i] * m;
+		b->limbs[i] = a & 0xFFFFUL;
+		a >>= 16;
+	}
+	if (a > 0) {
+		if (b->len == TS_INT_BIG_LIMBS)
+			return 0;
+		b->limbs[b->len++] = a;
+	}
+	return 1;
+}
+
+/* `b' = `b' * 5^`e' * 2^`shift'. Returns 0 on overflow. */
+int
+ts_int_big_scale(struct tsBigNat *b,
+                 int e,
+                 int shift)
+{
+	int success = 1;
+	for (; success && e >= 6; e -= 6)
+		success = ts_int_big_mul_add(b, 15625UL, 0); /* 5^6 */
+	for (; success && e > 0; e--)
+		success = ts_int_big_mul_add(b, 5UL, 0);
+	for (; success && shift >= 15; shift -= 15)
+		success = ts_int_big_mul_add(b, 1UL << 15, 0);
+	return success && ts_int_big_mul_add(b, 1UL << shift, 0);
+}
+
+int
+ts_int_big_cmp(const struct tsBigNat *a,
+               const struct tsBigNat *b)
+{
+	size_t i;
+	if (a->len != b->len)
+		return a->len < b->len ? -1 : 1;
+	for (i = a->len; i > 0; i--) {
+		if (a->limbs[i - 1] != b->limbs[i - 1])
+			return a->limbs[i - 1] < b->limbs[i - 1] ? -1 : 1;
+	}
+	return 0;
+}
+
+/* Rounds `value', which is the result of strtod(`str'), to float. Rounding
+   twice (decimal to double to float) is off by one ulp if `value' is exactly
+   halfway between two floats, but the decimal number `str' is not. This is
+   detected and corrected by an exact comparison. */
+double
+ts_int_round_to_float(const char *str,
+                      double value)
+{
+	const double mag = fabs(value);
+	const double lower = (double) (float) mag; /* ties to even */
+	const double other = mag + (mag - lower);  /* exact if halfway */
+	struct tsBigNat dec, mid;
+	const char *s = str;
+	int e10 = 0, exp = 0, exp_neg = 0, point = 0, e2, cmp;
+	double frac;
+	unsigned long m;
+
+	/* `mag' is halfway iff its mirror image at `lower' is a float. */
+	if (!(mag < lower) && !(mag > lower))
+		return (double) (float) value;
+	if ((double) (float) other < other || (double) (float) other > other)
+		return (double) (float) value;
+	/* Decimal number: dec * 10^e10. */
+	dec.len = 0;
+	if (*s == '-') s++;
+	for (; (*s >= '0' && *s <= '9') || *s == '.'; s++) {
+		if (*s == '.') {
+			point = 1;
+			continue;
+		}
+		if (!ts_int_big_mul_add(&dec, 10UL, (unsigned long) (*s - '0')))
+			return (double) (float) value;
+		e10 -= point;
+	}
+	if (*s == 'e' || *s == 'E') {
+		s++;
+		exp_neg = *s == '-';
+		if (*s == '-' || *s == '+') s++;
+		for (; *s >= '0' && *s <= '9' && exp < 10000; s++)
+			exp = exp * 10 + (*s - '0');
+		e10 += exp_neg ? -exp : exp;
+	}
+	/* Halfway value: m * 2^e2 (with at most 26 significant bits). */
+	frac = frexp(mag, &e2);
+	m = (unsigned long) ldexp(frac, 26);
+	e2 -= 26;
+	mid.limbs[0] = m & 0xFFFFUL;
+	mid.limbs[1] = m >> 16;
+	mid.len = mid.limbs[1] > 0 ? 2 : 1;
+	/* Compare dec * 5^e10 * 2^e10 with m * 2^e2. The number of digits
+	   (at most TS_INT_JSON_MAX_NUMBER) bounds e10 for values that are close
+	   to a float. */
+	if (e10 < -200 || e10 > 50)
+		return (double) (float) value;
+	if (!ts_int_big_scale(&dec, e10 > 0 ? e10 : 0,
+	                      e10 - e2 > 0 ? e10 - e2 : 0) ||
+	    !ts_int_big_scale(&mid, e10 < 0 ? -e10 : 0,
+	                      e2 - e10 > 0 ? e2 - e10 : 0))
+		return (double) (float) value;
+	cmp = ts_int_big_cmp(&dec, &mid);
+	if (cmp != 0)
+		value = cmp < 0 ? (lower < other ? lower : other)
+		                : (lower < other ? other : lower);
+	else
+		value = lower;
+	return *str == '-' ? -value : value;
+}
+#endif
+
+/* Parses the JSON number `str' (which must be valid) and rounds it to the
+   precision of tsReal. */
+double
+ts_int_parse_real(const char *str)
+{
+#ifdef TS_INT_UINT64
+	const char *s = str;
+	tsUInt64 w = 0;
+	int e10 = 0, num = 0, exp = 0, exp_neg = 0, neg = 0, truncated = 0;
+	double value, upper;
+
+	if (*s == '-') {
+		neg = 1;
+		s++;
+	}
+	for (; *s >= '0' && *s <= '9'; s++) {
+		if (num < 19) {
+			w = w * 10 + (tsUInt64) (*s - '0');
+			num += w > 0; /* skip leading zeros */
+		} else {
+			e10++;
+			truncated |= *s != '0';
+		}
+	}
+	if (*s == '.') {
+		for (s++; *s >= '0' && *s <= '9'; s++) {
+			if (num < 19) {
+				w = w * 10 + (tsUInt64) (*s - '0');
+				num += w > 0;
+				e10--;
+			} else {
+				truncated |= *s != '0';
+			}
+		}
+	}
+	if (*s == 'e' || *s == 'E') {
+		s++;
+		exp_neg = *s == '-';
+		if (*s == '-' || *s == '+') s++;
+		for (; *s >= '0' && *s <= '9' && exp < 10000; s++)
+			exp = exp * 10 + (*s - '0');
+		e10 += exp_neg ? -exp : exp;
+	}
+	/* The digits beyond the 19th place the number strictly between w and
+	 * w + 1 (times 10^e10). If both bounds round to the same value, so does
+	 * the number. */
+	if (exp < 10000 && ts_int_decimal_to_real(w, e10, &value) &&
+	    (!truncated ||
+	     (ts_int_decimal_to_real(w + 1, e10, &upper) &&
+	      !(value < upper) && !(value > upper))))
+		return neg ? -value : value;
+#endif
+#ifdef TINYSPLINE_FLOAT_PRECISION
+	return ts_int_round_to_float(str, strtod(str, NULL));
+#else
+	return strtod(str, NULL);
+#endif
+}
+
+/* The JSON writer. Writes to a growable buffer (if `file' is NULL) or to a
+   fixed chunk that is flushed to `file' whenever it is full. */
+struct tsJsonWriter
+{
+	char *buf;   /**< The buffer to write to. */
+	size_t len;  /**< Number of bytes in `buf'. */
+	size_t cap;  /**< Capacity of `buf'. */
+	FILE *file;  /**< File to flush `buf' to (or NULL). */
+};
+
+int
+ts_int_json_flush(struct tsJsonWriter *writer)
+{
+	if (writer->len > 0 && fwrite(writer->buf, 1, writer->len,
+	                              writer->file) != writer->len) {
+		return 0;
+	}
+	writer->len = 0;
+	return 1;
+}
+
+/* Ensures that at least `n' (< TS_INT_JSON_CHUNK_SIZE) bytes can be written
+   to `writer->buf'. */
+int
+ts_int_json_reserve(struct tsJsonWriter *writer,
+                    size_t n)
+{
+	char *buf;
+	size_t cap;
+
+	if (writer->cap - writer->len >= n)
+		return 1;
+	if (writer->file)
+		return ts_int_json_flush(writer);
+	cap = writer->cap * 2 + n;
+	TS_INT_STATS_ALLOC(cap)
+	buf = (char *) realloc(writer->buf, cap);
+	if (!buf)
+		return 0;
+	writer->buf = buf;
+	writer->cap = cap;
+	return 1;
+}
+
+int
+ts_int_json_write(struct tsJsonWriter *writer,
+                  const char *str)
+{
+	const size_t n = strlen(str);
+	if (!ts_int_json_reserve(writer, n))
+		return 0;
+	memcpy(writer->buf + writer->len, str, n);
+	writer->len += n;
+	return 1;
+}
+
+int
+ts_int_json_write_size(struct tsJsonWriter *writer,
+                       size_t value)
+{
+	if (!ts_int_json_reserve(writer, 32))
+		return 0;
+	writer->len += sprintf(writer->buf + writer->len, "%lu",
+	                       (unsigned long) value);
+	return 1;
+}
+
+int
+ts_int_json_write_real(struct tsJsonWriter *writer,
+                       tsReal value)
+{
+	if (!ts_int_json_reserve(writer, TS_INT_REAL_BUF_SIZE))
+		return 0;
+	writer->len += ts_int_format_real(value, writer->buf + writer->len);
+	return 1;
+}
+
+int
+ts_int_json_finite(tsReal value)
+{
+	/* NaN fails both comparisons. */
+	return (double) value >= -DBL_MAX && (double) value <= DBL_MAX;
+}
+
+/* Failing memory streams are out of memory, file streams failed to flush. */
+tsError
+ts_int_json_write_error(const struct tsJsonWriter *writer,
+                        tsStatus *status)
+{
+	if (writer->file)
+		TS_RETURN_0(status, TS_IO_ERROR, "unexpected io error")
+	TS_RETURN_0(status, TS_MALLOC, "out of memory")
+}
+
+/* Writes `num' reals (with stride `stride') as pretty (or compact) JSON
+   array. */
+tsError
+ts_int_json_write_reals(struct tsJsonWriter *writer,
+                        const char *name,
+                        const tsReal *values,
+                        size_t num,
+                        size_t stride,
+                        size_t dim,
+                        int compact,
+                        tsStatus *status)
+{
+	const char *first = compact ? "" : "\n        ";
+	const char *sep = compact ? "," : ",\n        ";
+	size_t i, d;
+	int success;
+
+	success = ts_int_json_write(writer, compact ? "\"" : "    \"") &&
+	          ts_int_json_write(writer, name) &&
+	          ts_int_json_write(writer, compact ? "\":[" : "\": [");
+	for (i = 0; success && i < num; i++) {
+		for (d = 0; success && d < dim; d++) {
+			/* NaN and infinity are not representable in JSON. */
+			if (!ts_int_json_finite(values[i * stride + d])) {
+				TS_RETURN_2(status, TS_PARSE_ERROR,
+				            "%s: value at index %lu is not finite",
+				            name, (unsigned long) (i * dim + d))
+			}
+			success = ts_int_json_write(writer,
+				i + d == 0 ? first : sep) &&
+				ts_int_json_write_real(writer,
+					values[i * stride + d]);
+		}
+	}
+	success = success &&
+		ts_int_json_write(writer, compact ? "]" : "\n    ]");
+	if (!success)
+		return ts_int_json_write_error(writer, status);
+	TS_RETURN_SUCCESS(status)
+}
+
+/* Writes `view' in the format of TinySpline's JSON schema. The pretty layout
+   spans multiple lines, the compact layout is a single line (e.g., for
+   newline-delimited JSON). */
+tsError
+ts_int_view_write_json(const tsBSplineView *view,
+                       int compact,
+                       struct tsJsonWriter *writer,
+                       tsStatus *status)
+{
+	const size_t num_knots = view->num_control_points + view->degree + 1;
+	const char *sep = compact ? "," : ",\n";
+	tsError err;
+
+	if (!ts_int_json_write(writer, compact ? "{\"degree\":"
+	                                       : "{\n    \"degree\": ") ||
+	    !ts_int_json_write_size(writer, view->degree) ||
+	    !ts_int_json_write(writer, compact ? ",\"dimension\":"
+	                                       : ",\n    \"dimension\": ") ||
+	    !ts_int_json_write_size(writer, view->dimension) ||
+	    !ts_int_json_write(writer, sep)) {
+		return ts_int_json_write_error(writer, status);
+	}
+	TS_CALL_ROE(err, ts_int_json_write_reals(
+	            writer, "control_points", view->control_points,
+	            view->num_control_points, view->control_point_stride,
+	            view->dimension, compact, status))
+	if (!ts_int_json_write(writer, sep))
+		return ts_int_json_write_error(writer, status);
+	TS_CALL_ROE(err, ts_int_json_write_reals(
+	            writer, "knots", view->knots, num_knots,
+	            view->knot_stride, 1, compact, status))
+	if (!ts_int_json_write(writer, compact ? "}" : "\n}"))
+		return ts_int_json_write_error(writer, status);
+	TS_RETURN_SUCCESS(status)
+}
+
+/* The JSON reader. Reads from a string (if `file' is NULL) or from a file
+   (chunk by chunk). */
+struct tsJsonReader
+{
+	const char *cur; /**< Current position. */
+	const char *end; /**< End of the current chunk. */
+	FILE *file;      /**< File to read from (or NULL). */
+	char *chunk;     /**< Buffer of `file' (TS_INT_JSON_CHUNK_SIZE). */
+	size_t offset;   /**< Position of `chunk' in `file'. */
+};
+
+/* Returns the current character of `reader' or -1 at the end of input. */
+int
+ts_int_json_peek(struct tsJsonReader *reader)
+{
+	size_t n;
+	if (reader->cur < reader->end)
+		return (unsigned char) *reader->cur;
+	if (!reader->file)
+		return -1;
+	reader->offset += (size_t) (reader->end - reader->chunk);
+	n = fread(reader->chunk, 1, TS_INT_JSON_CHUNK_SIZE, reader->file);
+	reader->cur = reader->chunk;
+	reader->end = reader->chunk + n;
+	return n > 0 ? (unsigned char) *reader->cur : -1;
+}
+
+/* Skips whitespace and returns the next character (see ts_int_json_peek). */
+int
+ts_int_json_skip_ws(struct tsJsonReader *reader)
+{
+	int c = ts_int_json_peek(reader);
+	while (c == ' ' || c == '\t' || c == '\n' || c == '\r') {
+		reader->cur++;
+		c = ts_int_json_peek(reader);
+	}
+	return c;
+}
+
+/* Consumes `c' (after whitespace). */
+int
+ts_int_json_accept(struct tsJsonReader *reader,
+                   int c)
+{
+	if (ts_int_json_skip_ws(reader) != c)
+		return 0;
+	reader->cur++;
+	return 1;
+}
+
+/* Reads a string into `str' (truncated to `cap' - 1 characters; `*len' is the
+   actual length). Escape sequences are not resolved. */
+int
+ts_int_json_read_string(struct tsJsonReader *reader,
+                        char *str,
+                        size_t cap,
+                        size_t *len)
+{
+	int c, escaped = 0;
+	*len = 0;
+	if (!ts_int_json_accept(reader, '"'))
+		return 0;
+	for (;;) {
+		c = ts_int_json_peek(reader);
+		if (c < 0x20) /* end of input or control character */
+			return 0;
+		reader->cur++;
+		if (!escaped && c == '"')
+			break;
+		escaped = !escaped && c == '\\';
+		if (*len + 1 < cap)
+			str[*len] = (char) c;
+		(*len)++;
+	}
+	str[*len + 1 < cap ? *len : cap - 1] = '\0';
+	return 1;
+}
+
+/* Consumes the current character and returns the next one. */
+int
+ts_int_json_next(struct tsJsonReader *reader)
+{
+	reader->cur++;
+	return ts_int_json_peek(reader);
+}
+
+/* Appends the digits at the current position (at least one) to `buf'. */
+int
+ts_int_json_read_digits(struct tsJsonReader *reader,
+                        char *buf,
+                        size_t *len,
+                        int *c)
+{
+	const size_t start = *len;
+	while (*c >= '0' && *c <= '9') {
+		/* Leave space for `.', `e', sign, and `\0'. */
+		if (*len + 4 >= TS_INT_JSON_MAX_NUMBER)
+			return 0;
+		buf[(*len)++] = (char) *c;
+		*c = ts_int_json_next(reader);
+	}
+	return *len > start;
+}
+
+/* Reads a number according to the JSON grammar. */
+int
+ts_int_json_read_number(struct tsJsonReader *reader,
+                        double *value)
+{
+	char buf[TS_INT_JSON_MAX_NUMBER];
+	size_t len = 0;
+	int c = ts_int_json_skip_ws(reader);
+
+	if (c == '-') {
+		buf[len++] = '-';
+		c = ts_int_json_next(reader);
+	}
+	if (c == '0') { /* no leading zeros */
+		buf[len++] = '0';
+		c = ts_int_json_next(reader);
+	} else if (!ts_int_json_read_digits(reader, buf, &len, &c)) {
+		return 0;
+	}
+	if (c == '.') {
+		buf[len++] = '.';
+		c = ts_int_json_next(reader);
+		if (!ts_int_json_read_digits(reader, buf, &len, &c))
+			return 0;
+	}
+	if (c == 'e' || c == 'E') {
+		buf[len++] = 'e';
+		c = ts_int_json_next(reader);
+		if (c == '+' || c == '-') {
+			buf[len++] = (char) c;
+			c = ts_int_json_next(reader);
+		}
+		if (!ts_int_json_read_digits(reader, buf, &len, &c))
+			return 0;
+	}
+	buf[len] = '\0';
+	*value = ts_int_parse_real(buf);
+	return 1;
+}
+
+/* Skips any JSON value. */
+int
+ts_int_json_skip_value(struct tsJsonReader *reader,
+                       size_t depth)
+{
+	const char *literal;
+	char str[1];
+	size_t len;
+	double number;
+	int c, close;
+
+	if (depth > TS_INT_JSON_MAX_DEPTH)
+		return 0;
+	c = ts_int_json_skip_ws(reader);
+	if (c == '"')
+		return ts_int_json_read_string(reader, str, 1, &len);
+	if (c == '-' || (c >= '0' && c <= '9'))
+		return ts_int_json_read_number(reader, &number);
+	if (c == '[' || c == '{') {
+		close = c == '[' ? ']' : '}';
+		reader->cur++;
+		if (ts_int_json_accept(reader, close))
+			return 1;
+		do {
+			if (close == '}' && (
+			    !ts_int_json_read_string(reader, str, 1, &len) ||
+			    !ts_int_json_accept(reader, ':')))
+				return 0;
+			if (!ts_int_json_skip_value(reader, depth + 1))
+				return 0;
+		} while (ts_int_json_accept(reader, ','));
+		return ts_int_json_accept(reader, close);
+	}
+	literal = c == 't' ? "true" : c == 'f' ? "false" :
+	          c == 'n' ? "null" : "";
+	if (!*literal)
+		return 0;
+	for (; *literal; literal++) {
+		if (ts_int_json_peek(reader) != *literal)
+			return 0;
+		reader->cur++;
+	}
+	return 1;
+}
+
+/* Reads an array of numbers into a growable buffer. */
+tsError
+ts_int_json_read_reals(struct tsJsonReader *reader,
+                       const char *name,
+                       tsReal **values,
+                       size_t *num,
+                       tsStatus *status)
+{
+	size_t cap = 0;
+	double value;
+	tsReal *tmp;
+
+	if (!ts_int_json_accept(reader, '[')) {
+		TS_RETURN_1(status, TS_PARSE_ERROR,
+		            "%s is not an array", name)
+	}
+	*num = 0;
+	if (ts_int_json_accept(reader, ']'))
+		TS_RETURN_SUCCESS(status)
+	do {
+		if (!ts_int_json_read_number(reader, &value)) {
+			TS_RETURN_2(status, TS_PARSE_ERROR,
+			            "%s: value at index %lu is not a number",
+			            name, (unsigned long) *num)
+		}
+		if (*num == cap) {
+			cap = cap == 0 ? 64 : cap * 2;
+			tmp = (tsReal *) ts_int_realloc(*values,
+				cap * sizeof(tsReal));
+			if (!tmp)
+				TS_RETURN_0(status, TS_MALLOC, "out of memory")
+			*values = tmp;
+		}
+		(*values)[(*num)++] = (tsReal) value;
+	} while (ts_int_json_accept(reader, ','));
+	if (!ts_int_json_accept(reader, ']')) {
+		TS_RETURN_1(status, TS_PARSE_ERROR,
+		            "%s: missing closing bracket", name)
+	}
+	TS_RETURN_SUCCESS(status)
+}
+
+/* Reads a spline (an object) in a single pass. Because the number of control
+   points and knots is known only at the end of their arrays, they are read
+   into temporary buffers that are copied into the spline eventually. */
+tsError
+ts_int_bspline_read_json(struct tsJsonReader *reader,
+                         tsBSpline *spline,
+                         tsStatus *status)
+{
+	char key[32];
+	size_t len, dim = 0, len_ctrlp = 0, num_knots = 0;
+	double deg = -1.0, dim_value = -1.0, *number;
+	tsReal *ctrlp = NULL, *knots = NULL;
+	int has_deg = 0, has_dim = 0, has_ctrlp = 0, has_knots = 0, *has;
+	tsError err;
+
+	ts_int_bspline_init(spline);
+	TS_TRY(try, err, status)
+		if (!ts_int_json_accept(reader, '{')) {
+			TS_THROW_0(try, err, status, TS_PARSE_ERROR,
+			           "invalid json input")
+		}
+		if (!ts_int_json_accept(reader, '}')) do {
+			if (!ts_int_json_read_string(reader, key, sizeof(key),
+			                             &len) ||
+			    !ts_int_json_accept(reader, ':')) {
+				TS_THROW_0(try, err, status, TS_PARSE_ERROR,
+				           "invalid json input")
+			}
+			if (strcmp(key, "control_points") == 0 && !has_ctrlp) {
+				TS_CALL(try, err, ts_int_json_read_reals(
+				        reader, "control_points", &ctrlp,
+				        &len_ctrlp, status))
+				has_ctrlp = 1;
+			} else if (strcmp(key, "knots") == 0 && !has_knots) {
+				TS_CALL(try, err, ts_int_json_read_reals(
+				        reader, "knots", &knots, &num_knots,
+				        status))
+				has_knots = 1;
+			} else if (strcmp(key, "control_points") == 0 ||
+			           strcmp(key, "knots") == 0) {
+				TS_THROW_1(try, err, status, TS_PARSE_ERROR,
+				           "duplicate key: %s", key)
+			} else if (strcmp(key, "degree") == 0 ||
+			           strcmp(key, "dimension") == 0) {
+				has = key[1] == 'e' ? &has_deg : &has_dim;
+				number = key[1] == 'e' ? &deg : &dim_value;
+				if (!ts_int_json_read_number(reader, number)) {
+					TS_THROW_1(try, err, status,
+					           TS_PARSE_ERROR,
+					           "%s is not a number", key)
+				}
+				*has = 1;
+			} else if (!ts_int_json_skip_value(reader, 0)) {
+				TS_THROW_0(try, err, status, TS_PARSE_ERROR,
+				           "invalid json input")
+			}
+		} while (ts_int_json_accept(reader, ','));
+		if (!ts_int_json_accept(reader, '}')) {
+			TS_THROW_0(try, err, status, TS_PARSE_ERROR,
+			           "invalid json input")
+		}
+
+		if (!has_deg) {
+			TS_THROW_0(try, err, status, TS_PARSE_ERROR,
+			           "degree is not a number")
+		}
+		if (deg < -0.01f) {
+			TS_THROW_1(try, err, status, TS_PARSE_ERROR,
+			           "degree (%f) < 0", deg)
+		}
+		if (!has_dim) {
+			TS_THROW_0(try, err, status, TS_PARSE_ERROR,
+			           "dimension is not a number")
+		}
+		if (dim_value < 0.99f) {
+			TS_THROW_1(try, err, status, TS_PARSE_ERROR,
+			           "dimension (%f) < 1", dim_value)
+		}
+		dim = (size_t) dim_value;
+		if (!has_ctrlp) {
+			TS_THROW_0(try, err, status, TS_PARSE_ERROR,
+			           "control_points is not an array")
+		}
+		if (!has_knots) {
+			TS_THROW_0(try, err, status, TS_PARSE_ERROR,
+			           "knots is not an array")
+		}
+		if (len_ctrlp % dim != 0) {
+			TS_THROW_2(try, err, status, TS_PARSE_ERROR,
+			      "len(control_points) (%lu) %% dimension (%lu) != 0",
+			           (unsigned long) len_ctrlp, (unsigned long) dim)
+		}
+
+		/* Create spline. */
+		TS_CALL(try, err, ts_bspline_new(
+		        len_ctrlp/dim, dim, (size_t) deg,
+		        TS_CLAMPED, spline, status))
+		if (num_knots != ts_bspline_num_knots(spline))
+			TS_THROW_2(try, err, status, TS_NUM_KNOTS,
+			           "unexpected num(knots): (%lu) != (%lu)",
+			           (unsigned long) num_knots,
+			          (unsigned long) ts_bspline_num_knots(spline))
+		memcpy(ts_int_bspline_access_ctrlp(spline), ctrlp,
+		       ts_bspline_sof_control_points(spline));
+		TS_CALL(try, err, ts_bspline_set_knots(
+		        spline, knots, status))
+	TS_CATCH(err)
+		ts_bspline_free(spline);
+	TS_FINALLY
+		ts_int_free(ctrlp);
+		ts_int_free(knots);
+	TS_END_TRY_RETURN(err)
+}
+
+/* Reads a spline that must be the only value of `reader'. */
+tsError
+ts_int_bspline_read_json_document(struct tsJsonReader *reader,
+                                  tsBSpline *spline,
+                                  tsStatus *status)
+{
+	tsError err;
+	TS_CALL_ROE(err, ts_int_bspline_read_json(reader, spline, status))
+	if (ts_int_json_skip_ws(reader) != -1) {
+		ts_bspline_free(spline);
+		TS_RETURN_0(status, TS_PARSE_ERROR, "invalid json input")
+	}
+	TS_RETURN_SUCCESS(status)
+}
+
+tsError
+ts_int_bspline_view_to_json(const tsBSplineView *view,
+                            char **json,
+                            tsStatus *status)
+{
+	struct tsJsonWriter writer;
+	tsError err;
+
+	*json = NULL;
+	writer.len = 0;
+	writer.file = NULL;
+	/* About 25 bytes per value. */
+	writer.cap = 128 + 25 * (view->num_control_points *
+		(view->dimension + 1) + view->degree + 1);
+	TS_INT_STATS_ALLOC(writer.cap)
+	writer.buf = (char *) malloc(writer.cap);
+	if (!writer.buf)
+		TS_RETURN_0(status, TS_MALLOC, "out of memory")
+	TS_TRY(try, err, status)
+		TS_CALL(try, err, ts_int_view_write_json(
+		        view, 0, &writer, status))
+		if (!ts_int_json_reserve(&writer, 1)) {
+			TS_THROW_0(try, err, status, TS_MALLOC,
+			           "out of memory")
+		}
+		writer.buf[writer.len] = '\0';
+		*json = writer.buf;
+	TS_CATCH(err)
+		free(writer.buf);
+	TS_END_TRY_RETURN(err)
+}
+
+tsError
+ts_bspline_view_to_json(const tsBSplineView *view,
+                        char **json,
+                        tsStatus *status)
+{
+	TS_INT_API_SCOPE(ts_bspline_view_to_json,
+		ts_int_bspline_view_to_json(view, json, status))
+}
+
+tsError
+ts_bspline_to_json(const tsBSpline *spline,
+                   char **json,
+                   tsStatus *status)
+{
+	tsBSplineView view;
+	ts_bspline_as_view(spline, &view);
+	TS_INT_API_SCOPE(ts_bspline_to_json,
+		ts_int_bspline_view_to_json(&view, json, status))
+}
+
+tsError
+ts_bspline_parse_json(const char *json,
+                      tsBSpline *spline,
+                      tsStatus *status)
+{
+	struct tsJsonReader reader;
+	reader.cur = json;
+	reader.end = json + strlen(json);
+	reader.file = NULL;
+	reader.chunk = NULL;
+	reader.offset = 0;
+	TS_INT_API_SCOPE(ts_bspline_parse_json,
+		ts_int_bspline_read_json_document(&reader, spline, status))
+}
+
+tsError
+ts_int_bspline_view_save(const tsBSplineView *view,
+                         const char *path,
+                         tsStatus *status)
+{
+	struct tsJsonWriter writer;
+	tsError err;
+
+	writer.buf = (char *) ts_int_malloc(TS_INT_JSON_CHUNK_SIZE);
+	if (!writer.buf)
+		TS_RETURN_0(status, TS_MALLOC, "out of memory")
+	writer.len = 0;
+	writer.cap = TS_INT_JSON_CHUNK_SIZE;
+	writer.file = fopen(path, "wb");
+	if (!writer.file) {
+		ts_int_free(writer.buf);
+		TS_RETURN_0(status, TS_IO_ERROR, "unable to open file")
+	}
+	err = ts_int_view_write_json(view, 0, &writer, status);
+	if (!err && !ts_int_json_flush(&writer))
+		err = ts_int_json_write_error(&writer, status);
+	ts_int_free(writer.buf);
+	if (fclose(writer.file) != 0 && !err)
+		TS_RETURN_0(status, TS_IO_ERROR, "unexpected io error")
+	return err;
+}
+
+tsError
+ts_bspline_view_save(const tsBSplineView *view,
+                     const char *path,
+                     tsStatus *status)
+{
+	TS_INT_API_SCOPE(ts_bspline_view_save,
+		ts_int_bspline_view_save(view, path, status))
+}
+
+tsError
+ts_bspline_save(const tsBSpline *spline,
+                const char *path,
+                tsStatus *status)
+{
+	tsBSplineView view;
+	ts_bspline_as_view(spline, &view);
+	TS_INT_API_SCOPE(ts_bspline_save,
+		ts_int_bspline_view_save(&view, path, status))
+}
+
+tsError
+ts_int_bspline_load(const char *path,
+                    tsBSpline *spline,
+                    tsStatus *status)
+{
+	struct tsJsonReader reader;
+	tsError err;
+
+	ts_int_bspline_init(spline);
+	reader.chunk = (char *) ts_int_malloc(TS_INT_JSON_CHUNK_SIZE);
+	if (!reader.chunk)
+		TS_RETURN_0(status, TS_MALLOC, "out of memory")
+	reader.cur = reader.end = reader.chunk;
+	reader.offset = 0;
+	reader.file = fopen(path, "rb");
+	if (!reader.file) {
+		ts_int_free(reader.chunk);
+		TS_RETURN_0(status, TS_IO_ERROR, "unable to open file")
+	}
+	err = ts_int_bspline_read_json_document(&reader, spline, status);
+	ts_int_free(reader.chunk);
+	if (!err && ferror(reader.file)) {
+		ts_bspline_free(spline);
+		fclose(reader.file);
+		TS_RETURN_0(status, TS_IO_ERROR, "unexpected io error")
+	}
+	fclose(reader.file);
+	return err;
+}
+
+tsError
+ts_bspline_load(const char *path,
+                tsBSpline *spline,
+                tsStatus *status)
+{
+	TS_INT_API_SCOPE(ts_bspline_load,
+		ts_int_bspline_load(path, spline, status))
+}
+
+/* The binary format. */
+struct tsBinaryStream
+{
+	unsigned char *out;      /**< Memory to write to (or NULL). */
+	const unsigned char *in; /**< Memory to read from (or NULL). */
+	size_t remaining;        /**< Remaining bytes of `out' or `in'. */
+	FILE *file;              /**< File to read from/write to (or NULL). */
+};
+
+/* Number of real values converted at once if the byte order of the host or
+   the precision of a file does not match. */
+#define TS_INT_BINARY_CHUNK_SIZE 256
+
+int
+ts_int_little_endian(void)
+{
+	const unsigned int one = 1;
+	return *((const unsigned char *) &one) == 1;
+}
+
+/* Seeks `file' to `offset'. MSVC provides 64-bit file positions with
+ * _fseeki64. Elsewhere, fseek is used, whose long offsets are 64 bits wide on
+ * 64-bit Unix systems. Offsets that do not fit into long are rejected rather
+ * than truncated. */
+int
+ts_int_file_seek(FILE *file,
+                 size_t offset)
+{
+#if defined(_MSC_VER)
+	return _fseeki64(file, (__int64) offset, SEEK_SET) == 0;
+#else
+	if (offset > (size_t) LONG_MAX) return 0;
+	return fseek(file, (long) offset, SEEK_SET) == 0;
+#endif
+}
+
+/* Determines the size of `file' (cf. ts_int_file_seek) and rewinds it. */
+int
+ts_int_file_size(FILE *file,
+                 size_t *size)
+{
+#if defined(_MSC_VER)
+	__int64 pos;
+	if (_fseeki64(file, 0, SEEK_END) != 0 ||
+	    (pos = _ftelli64(file)) < 0)
+		return 0;
+	/* size_t is 32 bits wide on 32-bit Windows. */
+	if ((__int64) (size_t) pos != pos)
+		return 0;
+#else
+	long pos;
+	if (fseek(file, 0, SEEK_END) != 0 || (pos = ftell(file)) < 0)
+		return 0;
+#endif
+	*size = (size_t) pos;
+	return ts_int_file_seek(file, 0);
+}
+
+int
+ts_int_binary_write(struct tsBinaryStream *stream,
+                    const void *data,
+                    size_t size)
+{
+	if (stream->file)
+		return fwrite(data, 1, size, stream->file) == size;
+	if (size > stream->remaining)
+		return 0;
+	memcpy(stream->out, data, size);
+	stream->out += size;
+	stream->remaining -= size;
+	return 1;
+}
+
+int
+ts_int_binary_read(struct tsBinaryStream *stream,
+                   void *data,
+                   size_t size)
+{
+	if (size > stream->remaining)
+		return 0;
+	if (stream->file) {
+		if (fread(data, 1, size, stream->file) != size)
+			return 0;
+	} else {
+		memcpy(data, stream->in, size);
+		stream->in += size;
+	}
+	stream->remaining -= size;
+	return 1;
+}
+
+int
+ts_int_binary_write_reals(struct tsBinaryStream *stream,
+                          const tsReal *values,
+                          size_t num)
+{
+	const size_t sof_real = sizeof(tsReal);
+	unsigned char chunk[TS_INT_BINARY_CHUNK_SIZE * sizeof(tsReal)];
+	const unsigned char *bytes;
+	size_t i, j, n;
+
+	if (ts_int_little_endian())
+		return ts_int_binary_write(stream, values, num * sof_real);
+	while (num > 0) {
+		n = num < TS_INT_BINARY_CHUNK_SIZE
+			? num : TS_INT_BINARY_CHUNK_SIZE;
+		for (i = 0; i < n; i++) {
+			bytes = (const unsigned char *) (values + i);
+			for (j = 0; j < sof_real; j++)
+				chunk[i*sof_real + j] = bytes[sof_real - 1 - j];
+		}
+		if (!ts_int_binary_write(stream, chunk, n * sof_real))
+			return 0;
+		values += n;
+		num -= n;
+	}
+	return 1;
+}
+
+int
+ts_int_binary_read_reals(struct tsBinaryStream *stream,
+                         size_t sof_file_real, /* 4 or 8 */
+                         tsReal *values,
+                         size_t num)
+{
+	const int little_endian = ts_int_little_endian();
+	unsigned char chunk[TS_INT_BINARY_CHUNK_SIZE * 8];
+	unsigned char bytes[8];
+	float f;
+	double d;
+	size_t i, j, n;
+
+	if (little_endian && sof_file_real == sizeof(tsReal))
+		return ts_int_binary_read(stream, values, num * sof_file_real);
+	while (num > 0) {
+		n = num < TS_INT_BINARY_CHUNK_SIZE
+			? num : TS_INT_BINARY_CHUNK_SIZE;
+		if (!ts_int_binary_read(stream, chunk, n * sof_file_real))
+			return 0;
+		for (i = 0; i < n; i++) {
+			for (j = 0; j < sof_file_real; j++) {
+				bytes[j] = chunk[i*sof_file_real + (little_endian
+					? j : sof_file_real - 1 - j)];
+			}
+			if (sof_file_real == 4) {
+				memcpy(&f, bytes, 4);
+				values[i] = (tsReal) f;
+			} else {
+				memcpy(&d, bytes, 8);
+				values[i] = (tsReal) d;
+			}
+		}
+		values += n;
+		num -= n;
+	}
+	return 1;
+}
+
+void
+ts_int_binary_encode_size(unsigned char *out, /* 8 bytes */
+                          size_t value)
+{
+	size_t i;
+	for (i = 0; i < 8; i++) {
+		out[i] = (unsigned char) (value & 0xFF);
+		value >>= 8;
+	}
+}
+
+int
+ts_int_binary_decode_size(const unsigned char *in, /* 8 bytes */
+                          size_t *value)
+{
+	size_t i;
+	*value = 0;
+	for (i = 8; i > 0; i--) {
+		/* Is `value' representable by size_t? */
+		if (*value > ((size_t) -1 >> 8))
+			return 0;
+		*value = (*value << 8) | in[i - 1];
+	}
+	return 1;
+}
+
+size_t
+ts_int_view_sof_binary(const tsBSplineView *view)
+{
+	const size_t num_knots = view->num_control_points + view->degree + 1;
+	return TS_BINARY_HEADER_SIZE + sizeof(tsReal) *
+		(view->num_control_points * view->dimension + num_knots);
+}
+
+tsError
+ts_int_view_write_binary(const tsBSplineView *view,
+                         struct tsBinaryStream *stream,
+                         tsStatus *status)
+{
+	const size_t deg = view->degree;
+	const size_t dim = view->dimension;
+	const size_t num_ctrlp = view->num_control_points;
+	const size_t num_knots = num_ctrlp + deg + 1;
+	const size_t cs = view->control_point_stride;
+	const size_t ks = view->knot_stride;
+	unsigned char header[TS_BINARY_HEADER_SIZE];
+	int success;
+	size_t i;
+
+	memset(header, 0, sizeof(header));
+	memcpy(header, TS_BINARY_MAGIC, 4);
+	header[4] = (unsigned char) TS_BINARY_VERSION;
+	header[5] = (unsigned char) sizeof(tsReal);
+	ts_int_binary_encode_size(header +  8, deg);
+	ts_int_binary_encode_size(header + 16, dim);
+	ts_int_binary_encode_size(header + 24, num_ctrlp);
+	ts_int_binary_encode_size(header + 32, num_knots);
+	success = ts_int_binary_write(stream, header, sizeof(header));
+
+	if (cs == dim) {
+		success = success && ts_int_binary_write_reals(stream,
+			view->control_points, num_ctrlp * dim);
+	} else {
+		for (i = 0; success && i < num_ctrlp; i++) {
+			success = ts_int_binary_write_reals(stream,
+				view->control_points + i * cs, dim);
+		}
+	}
+	if (ks == 1) {
+		success = success && ts_int_binary_write_reals(stream,
+			view->knots, num_knots);
+	} else {
+		for (i = 0; success && i < num_knots; i++) {
+			success = ts_int_binary_write_reals(stream,
+				view->knots + i * ks, 1);
+		}
+	}
+	if (!success)
+		TS_RETURN_0(status, TS_IO_ERROR, "unexpected io error")
+	TS_RETURN_SUCCESS(status)
+}
+
+/* The quantized format (see ts_bspline_to_quantized). */
+#define TS_INT_QUANTIZED_CHUNK_SIZE 256
+
+void
+ts_int_binary_encode_double(unsigned char *out, /* 8 bytes */
+                            double value)
+{
+	const int little_endian = ts_int_little_endian();
+	unsigned char bytes[8];
+	size_t i;
+	memcpy(bytes, &value, 8);
+	for (i = 0; i < 8; i++)
+		out[i] = bytes[little_endian ? i : 7 - i];
+}
+
+double
+ts_int_binary_decode_double(const unsigned char *in) /* 8 bytes */
+{
+	const int little_endian = ts_int_little_endian();
+	unsigned char bytes[8];
+	double value;
+	size_t i;
+	for (i = 0; i < 8; i++)
+		bytes[i] = in[little_endian ? i : 7 - i];
+	memcpy(&value, bytes, 8);
+	return value;
+}
+
+/* Maps `value' in [`min', `max'] to the nearest integer in [0, `qmax']. */
+unsigned long
+ts_int_quantize(double value,
+                double min,
+                double max,
+                unsigned long qmax)
+{
+	double q;
+	if (!(max > min))
+		return 0;
+	q = (value - min) / (max - min) * (double) qmax + 0.5;
+	if (q <= 0.0)
+		return 0;
+	if (q >= (double) qmax)
+		return qmax;
+	return (unsigned long) q;
+}
+
+/* Inverse of ts_int_quantize. The bounds are reproduced exactly. */
+tsReal
+ts_int_dequantize(unsigned long q,
+                  double min,
+                  double max,
+                  unsigned long qmax)
+{
+	if (q >= qmax)
+		return (tsReal) max;
+	return (tsReal) (min + (max - min) * ((double) q / (double) qmax));
+}
+
+unsigned long
+ts_int_quantized_max(size_t bits)
+{
+	/* Shifting by 32 is undefined if unsigned long has 32 bits. */
+	return ((1UL << (bits - 1)) - 1) * 2 + 1;
+}
+
+/* Quantizes the knots of `view' and computes the size (in bytes) of their
+   deltas. */
+tsError
+ts_int_view_quantize_knots(const tsBSplineView *view,
+                           unsigned long qmax,
+                           unsigned long *qknots,
+                           size_t *sof_deltas,
+                           tsStatus *status)
+{
+	const size_t order = view->degree + 1;
+	const size_t num_knots = view->num_control_points + order;
+	const size_t ks = view->knot_stride;
+	const double first = (double) view->knots[0];
+	const double last = (double) view->knots[(num_knots - 1) * ks];
+	unsigned long delta;
+	size_t i;
+
+	*sof_deltas = 0;
+	for (i = 0; i < num_knots; i++) {
+		qknots[i] = ts_int_quantize((double) view->knots[i * ks],
+		                            first, last, qmax);
+		if (i == 0) continue;
+		if (qknots[i] < qknots[i - 1])
+			TS_RETURN_0(status, TS_KNOTS_DECR, "decreasing knot vector")
+		/* Unsigned LEB128. */
+		delta = qknots[i] - qknots[i - 1];
+		do {
+			(*sof_deltas)++;
+			delta >>= 7;
+		} while (delta > 0);
+	}
+	for (i = order; i < num_knots; i++) {
+		if (qknots[i] == qknots[i - order]) {
+			TS_RETURN_1(status, TS_MULTIPLICITY,
+			            "quantization merges knot at index %lu",
+			            (unsigned long) i)
+		}
+	}
+	TS_RETURN_SUCCESS(status)
+}
+
+size_t
+ts_int_quantized_sof(size_t dim,
+                     size_t num_ctrlp,
+                     size_t bits,
+                     size_t sof_deltas)
+{
+	return TS_BINARY_HEADER_SIZE + 16 * dim + 16 +
+		num_ctrlp * dim * (bits / 8) + sof_deltas;
+}
+
+tsError
+ts_int_quantized_check_bits(size_t bits,
+                            tsStatus *status)
+{
+	if (bits != 8 && bits != 16 && bits != 32) {
+		TS_RETURN_1(status, TS_INDEX_ERROR,
+		            "bits (%lu) not in {8, 16, 32}",
+		            (unsigned long) bits)
+	}
+	TS_RETURN_SUCCESS(status)
+}
+
+/* Writes `view' in the quantized format. `qknots' are the quantized knots
+   (see ts_int_view_quantize_knots). */
+tsError
+ts_int_view_write_quantized(const tsBSplineView *view,
+                            size_t bits,
+                            const unsigned long *qknots,
+                            struct tsBinaryStream *stream,
+                            tsReal *max_error,
+                            tsStatus *status)
+{
+	const size_t deg = view->degree;
+	const size_t dim = view->dimension;
+	const size_t num_ctrlp = view->num_control_points;
+	const size_t num_knots = num_ctrlp + deg + 1;
+	const size_t cs = view->control_point_stride;
+	const size_t ks = view->knot_stride;
+	const size_t sof_int = bits / 8;
+	const unsigned long qmax = ts_int_quantized_max(bits);
+	unsigned char header[TS_BINARY_HEADER_SIZE];
+	unsigned char chunk[TS_INT_QUANTIZED_CHUNK_SIZE * 4];
+	unsigned char bytes[16];
+	double *bounds = NULL, min, max, value;
+	unsigned long q, delta;
+	size_t i, d, b, n = 0;
+	tsReal error;
+	int success;
+	tsError err;
+
+	*max_error = 0;
+	memset(header, 0, sizeof(header));
+	memcpy(header, TS_QUANTIZED_MAGIC, 4);
+	header[4] = (unsigned char) TS_QUANTIZED_VERSION;
+	header[5] = (unsigned char) bits;
+	ts_int_binary_encode_size(header +  8, deg);
+	ts_int_binary_encode_size(header + 16, dim);
+	ts_int_binary_encode_size(header + 24, num_ctrlp);
+	ts_int_binary_encode_size(header + 32, num_knots);
+
+	TS_TRY(try, err, status)
+		/* Bounding box. */
+		bounds = (double *) ts_int_malloc(2 * dim * sizeof(double));
+		if (!bounds) {
+			TS_THROW_0(try, err, status, TS_MALLOC,
+			           "out of memory")
+		}
+		for (d = 0; d < dim; d++) {
+			bounds[2*d] = bounds[2*d + 1] =
+				(double) view->control_points[d];
+			for (i = 1; i < num_ctrlp; i++) {
+				value = (double) view->control_points[i*cs + d];
+				if (value < bounds[2*d]) bounds[2*d] = value;
+				if (value > bounds[2*d + 1])
+					bounds[2*d + 1] = value;
+			}
+		}
+		success = ts_int_binary_write(stream, header, sizeof(header));
+		for (d = 0; success && d < dim; d++) {
+			ts_int_binary_encode_double(bytes, bounds[2*d]);
+			ts_int_binary_encode_double(bytes + 8, bounds[2*d + 1]);
+			success = ts_int_binary_write(stream, bytes, 16);
+		}
+		ts_int_binary_encode_double(bytes, (double) view->knots[0]);
+		ts_int_binary_encode_double(bytes + 8,
+			(double) view->knots[(num_knots - 1) * ks]);
+		success = success && ts_int_binary_write(stream, bytes, 16);
+
+		/* Control points (little endian integers). */
+		for (i = 0; success && i < num_ctrlp; i++) {
+			for (d = 0; d < dim; d++) {
+				min = bounds[2*d];
+				max = bounds[2*d + 1];
+				value = (double) view->control_points[i*cs + d];
+				q = ts_int_quantize(value, min, max, qmax);
+				error = (tsReal) fabs((double) ts_int_dequantize(
+					q, min, max, qmax) - value);
+				if (error > *max_error) *max_error = error;
+				for (b = 0; b < sof_int; b++) {
+					chunk[n++] = (unsigned char) (q & 0xFF);
+					q >>= 8;
+				}
+				if (n + 4 > sizeof(chunk)) {
+					success = ts_int_binary_write(
+						stream, chunk, n);
+					n = 0;
+				}
+			}
+		}
+
+		/* Knot deltas (unsigned LEB128). */
+		min = (double) view->knots[0];
+		max = (double) view->knots[(num_knots - 1) * ks];
+		for (i = 0; success && i < num_knots; i++) {
+			value = (double) view->knots[i * ks];
+			error = (tsReal) fabs((double) ts_int_dequantize(
+				qknots[i], min, max, qmax) - value);
+			if (error > *max_error) *max_error = error;
+			if (i == 0) continue;
+			delta = qknots[i] - qknots[i - 1];
+			do {
+				chunk[n++] = (unsigned char) ((delta & 0x7F) |
+					(delta > 0x7F ? 0x80 : 0));
+				delta >>= 7;
+			} while (delta > 0);
+			if (n + 8 > sizeof(chunk)) {
+				success = ts_int_binary_write(stream, chunk, n);
+				n = 0;
+			}
+		}
+		success = success && ts_int_binary_write(stream, chunk, n);
+		if (!success) {
+			TS_THROW_0(try, err, status, TS_IO_ERROR,
+			           "unexpected io error")
+		}
+	TS_FINALLY
+		ts_int_free(bounds);
+	TS_END_TRY_RETURN(err)
+}
+
+/* Decodes the header of a quantized spline. */
+tsError
+ts_int_quantized_decode_header(const unsigned char *header,
+                               size_t *bits,
+                               size_t *deg,
+                               size_t *dim,
+                               size_t *num_ctrlp,
+                               size_t *num_knots,
+                               tsStatus *status)
+{
+	if (memcmp(header, TS_QUANTIZED_MAGIC, 4) != 0)
+		TS_RETURN_0(status, TS_PARSE_ERROR, "not a quantized spline")
+	if (header[4] != TS_QUANTIZED_VERSION) {
+		TS_RETURN_1(status, TS_PARSE_ERROR,
+		            "unsupported quantized version: %d",
+		            (int) header[4])
+	}
+	*bits = header[5];
+	if (ts_int_quantized_check_bits(*bits, NULL)) {
+		TS_RETURN_1(status, TS_PARSE_ERROR,
+		            "unsupported number of bits: %d", (int) header[5])
+	}
+	if (!ts_int_binary_decode_size(header +  8, deg) ||
+	    !ts_int_binary_decode_size(header + 16, dim) ||
+	    !ts_int_binary_decode_size(header + 24, num_ctrlp) ||
+	    !ts_int_binary_decode_size(header + 32, num_knots)) {
+		TS_RETURN_0(status, TS_PARSE_ERROR,
+		            "quantized spline exceeds addressable memory")
+	}
+	if (*dim == 0)
+		TS_RETURN_0(status, TS_DIM_ZERO, "unsupported dimension: 0")
+	if (*deg >= *num_ctrlp) {
+		TS_RETURN_2(status, TS_DEG_GE_NCTRLP,
+		            "degree (%lu) >= num(control_points) (%lu)",
+		            (unsigned long) *deg, (unsigned long) *num_ctrlp)
+	}
+	if (*num_knots != *num_ctrlp + *deg + 1) {
+		TS_RETURN_2(status, TS_NUM_KNOTS,
+		            "num(knots) (%lu) != expected (%lu)",
+		            (unsigned long) *num_knots,
+		            (unsigned long) (*num_ctrlp + *deg + 1))
+	}
+	/* Guard against overflows (each knot delta takes at least one
+	   byte). */
+	if (*num_ctrlp > ((size_t) -1) / 8 / *dim) {
+		TS_RETURN_0(status, TS_PARSE_ERROR,
+		            "quantized spline exceeds addressable memory")
+	}
+	TS_RETURN_SUCCESS(status)
+}
+
+/* Returns whether `remaining' bytes can hold the body of a quantized
+   spline. */
+int
+ts_int_quantized_fits(size_t remaining,
+                      size_t bits,
+                      size_t dim,
+                      size_t num_ctrlp,
+                      size_t num_knots)
+{
+	size_t sof;
+	if (remaining < 16 || dim > remaining / 16 - 1)
+		return 0;
+	remaining -= 16 * dim + 16;
+	sof = bits / 8 * dim;
+	if (num_ctrlp > remaining / sof)
+		return 0;
+	remaining -= num_ctrlp * sof;
+	/* Each knot delta takes at least one byte. */
+	return num_knots - 1 <= remaining;
+}
+
+/* Reads the body of a quantized spline (i.e., everything after the header)
+   into `ctrlp' and `knots'. */
+tsError
+ts_int_quantized_read_body(struct tsBinaryStream *stream,
+                           size_t bits,
+                           size_t dim,
+                           size_t num_ctrlp,
+                           size_t num_knots,
+                           tsReal *ctrlp,
+                           tsReal *knots,
+                           tsStatus *status)
+{
+	const size_t sof_int = bits / 8;
+	const unsigned long qmax = ts_int_quantized_max(bits);
+	unsigned char chunk[TS_INT_QUANTIZED_CHUNK_SIZE * 4];
+	unsigned char bytes[16];
+	double *bounds = NULL, first, last;
+	unsigned long q, qknot = 0;
+	size_t i, d, b, n, num, shift;
+	int byte;
+	tsError err;
+
+	TS_TRY(try, err, status)
+		bounds = (double *) ts_int_malloc(2 * dim * sizeof(double));
+		if (!bounds) {
+			TS_THROW_0(try, err, status, TS_MALLOC,
+			           "out of memory")
+		}
+		for (d = 0; d < dim; d++) {
+			if (!ts_int_binary_read(stream, bytes, 16)) {
+				TS_THROW_0(try, err, status, TS_PARSE_ERROR,
+				           "unexpected end of quantized data")
+			}
+			bounds[2*d] = ts_int_binary_decode_double(bytes);
+			bounds[2*d + 1] = ts_int_binary_decode_double(bytes + 8);
+		}
+		if (!ts_int_binary_read(stream, bytes, 16)) {
+			TS_THROW_0(try, err, status, TS_PARSE_ERROR,
+			           "unexpected end of quantized data")
+		}
+		first = ts_int_binary_decode_double(bytes);
+		last = ts_int_binary_decode_double(bytes + 8);
+
+		/* Control points. */
+		num = num_ctrlp * dim;
+		for (i = 0, d = 0; i < num; ) {
+			n = num - i < TS_INT_QUANTIZED_CHUNK_SIZE
+				? num - i : TS_INT_QUANTIZED_CHUNK_SIZE;
+			if (!ts_int_binary_read(stream, chunk, n * sof_int)) {
+				TS_THROW_0(try, err, status, TS_PARSE_ERROR,
+				           "unexpected end of quantized data")
+			}
+			for (b = 0; b < n; b++, i++) {
+				q = 0;
+				for (shift = sof_int; shift > 0; shift--) {
+					q = (q << 8) |
+					    chunk[b * sof_int + shift - 1];
+				}
+				ctrlp[i] = ts_int_dequantize(q, bounds[2*d],
+					bounds[2*d + 1], qmax);
+				d = d + 1 == dim ? 0 : d + 1;
+			}
+		}
+
+		/* Knots. */
+		knots[0] = (tsReal) first;
+		for (i = 1; i < num_knots; i++) {
+			q = 0;
+			shift = 0;
+			do {
+				if (!ts_int_binary_read(stream, bytes, 1) ||
+				    shift > 28) {
+					TS_THROW_0(try, err, status,
+					           TS_PARSE_ERROR,
+					    "unexpected end of quantized data")
+				}
+				byte = bytes[0];
+				if (shift == 28 && (byte & 0x70)) {
+					TS_THROW_0(try, err, status,
+					           TS_PARSE_ERROR,
+					           "corrupted knot deltas")
+				}
+				q |= (unsigned long) (byte & 0x7F) << shift;
+				shift += 7;
+			} while (byte & 0x80);
+			if (q > qmax - qknot) {
+				TS_THROW_0(try, err, status, TS_PARSE_ERROR,
+				           "corrupted knot deltas")
+			}
+			qknot += q;
+			knots[i] = ts_int_dequantize(qknot, first, last, qmax);
+		}
+	TS_FINALLY
+		ts_int_free(bounds);
+	TS_END_TRY_RETURN(err)
+}
+
+/* Reads a quantized spline whose header has already been read. */
+tsError
+ts_int_bspline_read_quantized(struct tsBinaryStream *stream,
+                              const unsigned char *header,
+                              tsBSpline *spline,
+                              tsStatus *status)
+{
+	size_t bits, deg, dim, num_ctrlp, num_knots;
+	tsError err;
+
+	ts_int_bspline_init(spline);
+	TS_CALL_ROE(err, ts_int_quantized_decode_header(
+	            header, &bits, &deg, &dim, &num_ctrlp, &num_knots,
+	            status))
+	/* The minimum size of the data is known in advance. */
+	if (!ts_int_quantized_fits(
+	    stream->remaining, bits, dim, num_ctrlp, num_knots)) {
+		TS_RETURN_0(status, TS_PARSE_ERROR,
+		            "size of quantized data does not match header")
+	}
+	TS_TRY(try, err, status)
+		TS_CALL(try, err, ts_bspline_new(
+		        num_ctrlp, dim, deg, TS_OPENED, spline, status))
+		TS_CALL(try, err, ts_int_quantized_read_body(
+		        stream, bits, dim, num_ctrlp, num_knots,
+		        ts_int_bspline_access_ctrlp(spline),
+		        ts_int_bspline_access_knots(spline), status))
+		if (stream->remaining != 0) {
+			TS_THROW_0(try, err, status, TS_PARSE_ERROR,
+			           "size of quantized data does not match header")
+		}
+		/* Validate the knots in place. */
+		TS_CALL(try, err, ts_bspline_set_knots(
+		        spline, ts_int_bspline_access_knots(spline), status))
+	TS_CATCH(err)
+		ts_bspline_free(spline);
+	TS_END_TRY_RETURN(err)
+}
+
+tsError
+ts_int_bspline_read_binary(struct tsBinaryStream *stream,
+                           tsBSpline *spline,
+                           tsStatus *status)
+{
+	unsigned char header[TS_BINARY_HEADER_SIZE];
+	size_t deg, dim, num_ctrlp, num_knots, sof_file_real;
+	tsError err;
+
+	ts_int_bspline_init(spline);
+	if (!ts_int_binary_read(stream, header, sizeof(header)))
+		TS_RETURN_0(status, TS_PARSE_ERROR, "missing binary header")
+	if (memcmp(header, TS_QUANTIZED_MAGIC, 4) == 0) {
+		return ts_int_bspline_read_quantized(stream, header, spline,
+		                                     status);
+	}
+	if (memcmp(header, TS_BINARY_MAGIC, 4) != 0)
+		TS_RETURN_0(status, TS_PARSE_ERROR, "not a binary spline")
+	if (header[4] != TS_BINARY_VERSION) {
+		TS_RETURN_1(status, TS_PARSE_ERROR,
+		            "unsupported binary version: %d",
+		            (int) header[4])
+	}
+	sof_file_real = header[5];
+	if (sof_file_real != 4 && sof_file_real != 8) {
+		TS_RETURN_1(status, TS_PARSE_ERROR,
+		            "unsupported size of real values: %lu",
+		            (unsigned long) sof_file_real)
+	}
+	if (!ts_int_binary_decode_size(header +  8, &deg) ||
+	    !ts_int_binary_decode_size(header + 16, &dim) ||
+	    !ts_int_binary_decode_size(header + 24, &num_ctrlp) ||
+	    !ts_int_binary_decode_size(header + 32, &num_knots)) {
+		TS_RETURN_0(status, TS_PARSE_ERROR,
+		            "binary spline exceeds addressable memory")
+	}
+	/* The size of the data is known in advance. Check it before
+	 * allocating memory for the spline. */
+	if (dim > 0 && (
+	    num_ctrlp > stream->remaining / sof_file_real / dim ||
+	    num_knots > stream->remaining / sof_file_real ||
+	    stream->remaining / sof_file_real !=
+	    num_ctrlp * dim + num_knots ||
+	    stream->remaining % sof_file_real != 0)) {
+		TS_RETURN_0(status, TS_PARSE_ERROR,
+		            "size of binary data does not match header")
+	}
+
+	TS_TRY(try, err, status)
+		TS_CALL(try, err, ts_bspline_new(
+		        num_ctrlp, dim, deg, TS_OPENED, spline, status))
+		if (ts_bspline_num_knots(spline) != num_knots) {
+			TS_THROW_2(try, err, status, TS_NUM_KNOTS,
+			           "num(knots) (%lu) != expected (%lu)",
+			           (unsigned long) num_knots,
+			           (unsigned long)
+			           ts_bspline_num_knots(spline))
+		}
+		if (!ts_int_binary_read_reals(stream, sof_file_real,
+		                              ts_int_bspline_access_ctrlp(spline),
+		                              num_ctrlp * dim) ||
+		    !ts_int_binary_read_reals(stream, sof_file_real,
+		                              ts_int_bspline_access_knots(spline),
+		                              num_knots)) {
+			TS_THROW_0(try, err, status, TS_PARSE_ERROR,
+			           "unexpected end of binary data")
+		}
+		/* Validate the knots in place. */
+		TS_CALL(try, err, ts_bspline_set_knots(
+		        spline, ts_int_bspline_access_knots(spline), status))
+	TS_CATCH(err)
+		ts_bspline_free(spline);
+	TS_END_TRY_RETURN(err)
+}
+
+tsError
+ts_int_bspline_view_to_binary(const tsBSplineView *view,
+                              unsigned char **data,
+                              size_t *size,
+                              tsStatus *status)
+{
+	struct tsBinaryStream stream;
+	tsError err;
+
+	*size = ts_int_view_sof_binary(view);
+	TS_INT_STATS_ALLOC(*size)
+	*data = (unsigned char *) malloc(*size);
+	if (!*data) {
+		*size = 0;
+		TS_RETURN_0(status, TS_MALLOC, "out of memory")
+	}
+	stream.out = *data;
+	stream.in = NULL;
+	stream.remaining = *size;
+	stream.file = NULL;
+	TS_TRY(try, err, status)
+		TS_CALL(try, err, ts_int_view_write_binary(
+		        view, &stream, status))
+	TS_CATCH(err)
+		free(*data);
+		*data = NULL;
+		*size = 0;
+	TS_END_TRY_RETURN(err)
+}
+
+tsError
+ts_bspline_view_to_binary(const tsBSplineView *view,
+                          unsigned char **data,
+                          size_t *size,
+                          tsStatus *status)
+{
+	TS_INT_API_SCOPE(ts_bspline_view_to_binary,
+		ts_int_bspline_view_to_binary(view, data, size, status))
+}
+
+tsError
+ts_bspline_to_binary(const tsBSpline *spline,
+                     unsigned char **data,
+                     size_t *size,
+                     tsStatus *status)
+{
+	tsBSplineView view;
+	ts_bspline_as_view(spline, &view);
+	TS_INT_API_SCOPE(ts_bspline_to_binary,
+		ts_int_bspline_view_to_binary(&view, data, size, status))
+}
+
+tsError
+ts_int_bspline_from_binary(const unsigned char *data,
+                           size_t size,
+                           tsBSpline *spline,
+                           tsStatus *status)
+{
+	struct tsBinaryStream stream;
+	stream.out = NULL;
+	stream.in = data;
+	stream.remaining = size;
+	stream.file = NULL;
+	return ts_int_bspline_read_binary(&stream, spline, status);
+}
 
-			/* Increase the multiplicity of the very last knot
-			 * group (the second group of the last bezier curve)
-			 * by one. For more details, see knot duplication in
-			 * previous loop. */
-			offset = num_beziers * order +
-			         num_beziers * (amount - a);
-			knots[offset + order] = knots[offset];
+tsError
+ts_bspline_from_binary(const unsigned char *data,
+                       size_t size,
+                       tsBSpline *spline,
+                       tsStatus *status)
+{
+	TS_INT_API_SCOPE(ts_bspline_from_binary,
+		ts_int_bspline_from_binary(data, size, spline, status))
+}
 
-			/* Elevated by one. */
-			order++;
+tsError
+ts_int_bspline_view_save_binary(const tsBSplineView *view,
+                                const char *path,
+                                tsStatus *status)
+{
+	struct tsBinaryStream stream;
+	tsError err;
+
+	stream.out = NULL;
+	stream.in = NULL;
+	stream.remaining = 0;
+	stream.file = fopen(path, "wb");
+	if (!stream.file)
+		TS_RETURN_0(status, TS_IO_ERROR, "unable to open file")
+	err = ts_int_view_write_binary(view, &stream, status);
+	if (fclose(stream.file) != 0 && !err)
+		TS_RETURN_0(status, TS_IO_ERROR, "unexpected io error")
+	return err;
+}
+
+tsError
+ts_bspline_view_save_binary(const tsBSplineView *view,
+                            const char *path,
+                            tsStatus *status)
+{
+	TS_INT_API_SCOPE(ts_bspline_view_save_binary,
+		ts_int_bspline_view_save_binary(view, path, status))
+}
+
+tsError
+ts_bspline_save_binary(const tsBSpline *spline,
+                       const char *path,
+                       tsStatus *status)
+{
+	tsBSplineView view;
+	ts_bspline_as_view(spline, &view);
+	TS_INT_API_SCOPE(ts_bspline_save_binary,
+		ts_int_bspline_view_save_binary(&view, path, status))
+}
+
+tsError
+ts_int_bspline_load_binary(const char *path,
+                           tsBSpline *spline,
+                           tsStatus *status)
+{
+	struct tsBinaryStream stream;
+	tsError err;
+
+	ts_int_bspline_init(spline);
+	stream.out = NULL;
+	stream.in = NULL;
+	stream.remaining = 0;
+	stream.file = fopen(path, "rb");
+	if (!stream.file)
+		TS_RETURN_0(status, TS_IO_ERROR, "unable to open file")
+	/* Files are subject to the same size checks as in-memory data. */
+	if (!ts_int_file_size(stream.file, &stream.remaining)) {
+		fclose(stream.file);
+		TS_RETURN_0(status, TS_IO_ERROR, "unable to stat file")
+	}
+	err = ts_int_bspline_read_binary(&stream, spline, status);
+	if (!err && ferror(stream.file)) {
+		ts_bspline_free(spline);
+		fclose(stream.file);
+		TS_RETURN_0(status, TS_IO_ERROR, "unexpected io error")
+	}
+	fclose(stream.file);
+	return err;
+}
+
+tsError
+ts_bspline_load_binary(const char *path,
+                       tsBSpline *spline,
+                       tsStatus *status)
+{
+	TS_INT_API_SCOPE(ts_bspline_load_binary,
+		ts_int_bspline_load_binary(path, spline, status))
+}
+
+tsError
+ts_int_bspline_view_to_quantized(const tsBSplineView *view,
+                                 size_t bits,
+                                 unsigned char **data,
+                                 size_t *size,
+                                 tsReal *max_error,
+                                 tsStatus *status)
+{
+	const size_t num_knots = view->num_control_points + view->degree + 1;
+	struct tsBinaryStream stream;
+	unsigned long *qknots = NULL;
+	size_t sof_deltas;
+	tsReal error;
+	tsError err;
+
+	*data = NULL;
+	*size = 0;
+	if (max_error) *max_error = 0;
+	TS_CALL_ROE(err, ts_int_quantized_check_bits(bits, status))
+	TS_TRY(try, err, status)
+		qknots = (unsigned long *) ts_int_malloc(
+			num_knots * sizeof(unsigned long));
+		if (!qknots) {
+			TS_THROW_0(try, err, status, TS_MALLOC,
+			           "out of memory")
+		}
+		TS_CALL(try, err, ts_int_view_quantize_knots(
+		        view, ts_int_quantized_max(bits), qknots,
+		        &sof_deltas, status))
+		*size = ts_int_quantized_sof(view->dimension,
+			view->num_control_points, bits, sof_deltas);
+		TS_INT_STATS_ALLOC(*size)
+		*data = (unsigned char *) malloc(*size);
+		if (!*data) {
+			TS_THROW_0(try, err, status, TS_MALLOC,
+			           "out of memory")
 		}
+		stream.out = *data;
+		stream.in = NULL;
+		stream.remaining = *size;
+		stream.file = NULL;
+		TS_CALL(try, err, ts_int_view_write_quantized(
+		        view, bits, qknots, &stream, &error, status))
+		if (max_error) *max_error = error;
+	TS_CATCH(err)
+		free(*data);
+		*data = NULL;
+		*size = 0;
+	TS_FINALLY
+		ts_int_free(qknots);
+	TS_END_TRY_RETURN(err)
+}
 
-		/* Combine bezier curves. */
-		d = 0; /* Number of removed knots/control points. */
-		for (i = 0; i < num_beziers - 1; i++) {
-			/* Is the last control point of bezier curve `i' equal
-			 * to the first control point of bezier curve `i+1'? */
-			last = ctrlp + (
-				i * order /* base location of `i' */
-				- d /* minus the number of removed values */
-				+ (order - 1) /* jump to last control point */
-				) * dim;
-			first = last + dim; /* next control point */
-			if (ts_distance(last, first, dim) <= epsilon) {
-				/* Move control points. */
-				memmove(last, first, (num_beziers - 1 - i) *
-				        order * dim * sizeof(tsReal));
+tsError
+ts_bspline_view_to_quantized(const tsBSplineView *view,
+                             size_t bits,
+                             unsigned char **data,
+                             size_t *size,
+                             tsReal *max_error,
+                             tsStatus *status)
+{
+	TS_INT_API_SCOPE(ts_bspline_view_to_quantized,
+		ts_int_bspline_view_to_quantized(view, bits, data, size,
+		                                 max_error, status))
+}
+
+tsError
+ts_bspline_to_quantized(const tsBSpline *spline,
+                        size_t bits,
+                        unsigned char **data,
+                        size_t *size,
+                        tsReal *max_error,
+                        tsStatus *status)
+{
+	tsBSplineView view;
+	ts_bspline_as_view(spline, &view);
+	TS_INT_API_SCOPE(ts_bspline_to_quantized,
+		ts_int_bspline_view_to_quantized(&view, bits, data, size,
+		                                 max_error, status))
+}
+
+tsError
+ts_int_bspline_view_save_quantized(const tsBSplineView *view,
+                                   size_t bits,
+                                   const char *path,
+                                   tsReal *max_error,
+                                   tsStatus *status)
+{
+	unsigned char *data = NULL;
+	size_t size;
+	FILE *file;
+	int success;
+	tsError err;
+
+	TS_CALL_ROE(err, ts_int_bspline_view_to_quantized(
+	            view, bits, &data, &size, max_error, status))
+	file = fopen(path, "wb");
+	if (!file) {
+		free(data);
+		TS_RETURN_0(status, TS_IO_ERROR, "unable to open file")
+	}
+	success = fwrite(data, 1, size, file) == size;
+	success = fclose(file) == 0 && success;
+	free(data);
+	if (!success)
+		TS_RETURN_0(status, TS_IO_ERROR, "unexpected io error")
+	TS_RETURN_SUCCESS(status)
+}
+
+tsError
+ts_bspline_view_save_quantized(const tsBSplineView *view,
+                               size_t bits,
+                               const char *path,
+                               tsReal *max_error,
+                               tsStatus *status)
+{
+	TS_INT_API_SCOPE(ts_bspline_view_save_quantized,
+		ts_int_bspline_view_save_quantized(view, bits, path, max_error,
+		                                   status))
+}
+
+tsError
+ts_bspline_save_quantized(const tsBSpline *spline,
+                          size_t bits,
+                          const char *path,
+                          tsReal *max_error,
+                          tsStatus *status)
+{
+	tsBSplineView view;
+	ts_bspline_as_view(spline, &view);
+	TS_INT_API_SCOPE(ts_bspline_save_quantized,
+		ts_int_bspline_view_save_quantized(&view, bits, path, max_error,
+		                                   status))
+}
+
+tsError
+ts_bspline_dequantized_len(const unsigned char *data,
+                           size_t size,
+                           size_t *len,
+                           tsStatus *status)
+{
+	size_t bits, deg, dim, num_ctrlp, num_knots;
+	tsError err;
+
+	*len = 0;
+	if (size < TS_BINARY_HEADER_SIZE)
+		TS_RETURN_0(status, TS_PARSE_ERROR, "missing quantized header")
+	TS_CALL_ROE(err, ts_int_quantized_decode_header(
+	            data, &bits, &deg, &dim, &num_ctrlp, &num_knots,
+	            status))
+	if (!ts_int_quantized_fits(size - TS_BINARY_HEADER_SIZE,
+	                           bits, dim, num_ctrlp, num_knots)) {
+		TS_RETURN_0(status, TS_PARSE_ERROR,
+		            "size of quantized data does not match header")
+	}
+	*len = num_ctrlp * dim + num_knots;
+	TS_RETURN_SUCCESS(status)
+}
+
+tsError
+ts_int_bspline_dequantize(const unsigned char *data,
+                          size_t size,
+                          tsReal *buffer,
+                          size_t len,
+                          tsBSplineView *view,
+                          tsStatus *status)
+{
+	struct tsBinaryStream stream;
+	size_t bits, deg, dim, num_ctrlp, num_knots, required;
+	tsBSplineView tmp;
+	tsError err;
+
+	TS_CALL_ROE(err, ts_bspline_dequantized_len(
+	            data, size, &required, status))
+	if (len < required) {
+		TS_RETURN_2(status, TS_INDEX_ERROR,
+		            "buffer length (%lu) < required length (%lu)",
+		            (unsigned long) len, (unsigned long) required)
+	}
+	ts_int_quantized_decode_header(data, &bits, &deg, &dim, &num_ctrlp,
+	                               &num_knots, NULL);
+	stream.out = NULL;
+	stream.in = data + TS_BINARY_HEADER_SIZE;
+	stream.remaining = size - TS_BINARY_HEADER_SIZE;
+	stream.file = NULL;
+	TS_CALL_ROE(err, ts_int_quantized_read_body(
+	            &stream, bits, dim, num_ctrlp, num_knots, buffer,
+	            buffer + num_ctrlp * dim, status))
+	if (stream.remaining != 0) {
+		TS_RETURN_0(status, TS_PARSE_ERROR,
+		            "size of quantized data does not match header")
+	}
+	TS_CALL_ROE(err, ts_bspline_view_init(
+	            num_ctrlp, dim, deg, buffer, 0, buffer + num_ctrlp * dim,
+	            0, &tmp, status))
+	*view = tmp;
+	TS_RETURN_SUCCESS(status)
+}
+
+tsError
+ts_bspline_dequantize(const unsigned char *data,
+                      size_t size,
+                      tsReal *buffer,
+                      size_t len,
+                      tsBSplineView *view,
+                      tsStatus *status)
+{
+	TS_INT_API_SCOPE(ts_bspline_dequantize,
+		ts_int_bspline_dequantize(data, size, buffer, len, view,
+		                          status))
+}
+/*! @} */
+
+
+
+/*! @name Spline Containers
+ *
+ * @{
+ */
+struct tsContainerImpl
+{
+	const unsigned char *data; /**< The mapped file. */
+	size_t size;               /**< Size of `data'. */
+	size_t num;                /**< Number of splines. */
+	size_t index;              /**< Offset of the index table. */
+	int mapped;                /**< Whether `data' is mapped (or malloced). */
+};
+
+struct tsContainerWriterImpl
+{
+	FILE *file;        /**< The container file. */
+	size_t num;        /**< Number of splines. */
+	size_t cap;        /**< Capacity of `offsets'. */
+	size_t *offsets;   /**< Offsets of the splines. */
+	size_t pos;        /**< Current write position (end of data). */
+};
+
+void
+ts_int_container_encode_header(unsigned char *header,
+                               size_t num,
+                               size_t index)
+{
+	memset(header, 0, TS_CONTAINER_HEADER_SIZE);
+	memcpy(header, TS_CONTAINER_MAGIC, 4);
+	header[4] = (unsigned char) TS_CONTAINER_VERSION;
+	header[5] = (unsigned char) sizeof(tsReal);
+	ts_int_binary_encode_size(header +  8, num);
+	ts_int_binary_encode_size(header + 16, index);
+}
+
+tsError
+ts_int_container_decode_header(const unsigned char *header,
+                               size_t size, /* of the container */
+                               size_t *num,
+                               size_t *index,
+                               tsStatus *status)
+{
+	if (size < TS_CONTAINER_HEADER_SIZE ||
+	    memcmp(header, TS_CONTAINER_MAGIC, 4) != 0)
+		TS_RETURN_0(status, TS_PARSE_ERROR, "not a spline container")
+	if (header[4] != TS_CONTAINER_VERSION) {
+		TS_RETURN_1(status, TS_PARSE_ERROR,
+		            "unsupported container version: %d",
+		            (int) header[4])
+	}
+	if (header[5] != 4 && header[5] != 8) {
+		TS_RETURN_1(status, TS_PARSE_ERROR,
+		            "unsupported size of real values: %d",
+		            (int) header[5])
+	}
+	if (!ts_int_binary_decode_size(header +  8, num) ||
+	    !ts_int_binary_decode_size(header + 16, index) ||
+	    *index < TS_CONTAINER_HEADER_SIZE || *index > size ||
+	    *num > (size - *index) / 8) {
+		TS_RETURN_0(status, TS_PARSE_ERROR,
+		            "corrupted container index table")
+	}
+	TS_RETURN_SUCCESS(status)
+}
+
+/* Maps (or reads) the entire file `path' into memory. */
+tsError
+ts_int_container_map(const char *path,
+                     struct tsContainerImpl *impl,
+                     tsStatus *status)
+{
+#if defined(TS_INT_MMAP_POSIX)
+	struct stat st;
+	void *data;
+	int fd = open(path, O_RDONLY);
+	if (fd < 0)
+		TS_RETURN_0(status, TS_IO_ERROR, "unable to open file")
+	if (fstat(fd, &st) != 0) {
+		close(fd);
+		TS_RETURN_0(status, TS_IO_ERROR, "unable to stat file")
+	}
+	if (st.st_size < TS_CONTAINER_HEADER_SIZE) {
+		close(fd);
+		TS_RETURN_0(status, TS_PARSE_ERROR, "not a spline container")
+	}
+	impl->size = (size_t) st.st_size;
+	if ((off_t) impl->size != st.st_size) {
+		close(fd);
+		TS_RETURN_0(status, TS_IO_ERROR,
+		            "container exceeds addressable memory")
+	}
+	data = mmap(NULL, impl->size, PROT_READ, MAP_SHARED, fd, 0);
+	/* The mapping keeps the file alive. */
+	close(fd);
+	if (data == MAP_FAILED)
+		TS_RETURN_0(status, TS_IO_ERROR, "unable to map file")
+	impl->data = (const unsigned char *) data;
+	impl->mapped = 1;
+	TS_RETURN_SUCCESS(status)
+#elif defined(TS_INT_MMAP_WIN32)
+	HANDLE file, mapping;
+	LARGE_INTEGER size;
+	void *data;
+	file = CreateFileA(path, GENERIC_READ, FILE_SHARE_READ, NULL,
+	                   OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, NULL);
+	if (file == INVALID_HANDLE_VALUE)
+		TS_RETURN_0(status, TS_IO_ERROR, "unable to open file")
+	if (!GetFileSizeEx(file, &size)) {
+		CloseHandle(file);
+		TS_RETURN_0(status, TS_IO_ERROR, "unable to stat file")
+	}
+	if (size.QuadPart < TS_CONTAINER_HEADER_SIZE) {
+		CloseHandle(file);
+		TS_RETURN_0(status, TS_PARSE_ERROR, "not a spline container")
+	}
+	impl->size = (size_t) size.QuadPart;
+	if ((LONGLONG) impl->size != size.QuadPart) {
+		CloseHandle(file);
+		TS_RETURN_0(status, TS_IO_ERROR,
+		            "container exceeds addressable memory")
+	}
+	mapping = CreateFileMappingA(file, NULL, PAGE_READONLY, 0, 0, NULL);
+	/* The mapping keeps the file alive. */
+	CloseHandle(file);
+	if (!mapping)
+		TS_RETURN_0(status, TS_IO_ERROR, "unable to map file")
+	data = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+	/* The view keeps the mapping alive. */
+	CloseHandle(mapping);
+	if (!data)
+		TS_RETURN_0(status, TS_IO_ERROR, "unable to map file")
+	impl->data = (const unsigned char *) data;
+	impl->mapped = 1;
+	TS_RETURN_SUCCESS(status)
+#else
+	unsigned char *data;
+	long size;
+	FILE *file = fopen(path, "rb");
+	if (!file)
+		TS_RETURN_0(status, TS_IO_ERROR, "unable to open file")
+	if (fseek(file, 0, SEEK_END) != 0 || (size = ftell(file)) < 0 ||
+	    fseek(file, 0, SEEK_SET) != 0) {
+		fclose(file);
+		TS_RETURN_0(status, TS_IO_ERROR, "unable to stat file")
+	}
+	if (size < TS_CONTAINER_HEADER_SIZE) {
+		fclose(file);
+		TS_RETURN_0(status, TS_PARSE_ERROR, "not a spline container")
+	}
+	impl->size = (size_t) size;
+	data = (unsigned char *) ts_int_malloc(impl->size);
+	if (!data) {
+		fclose(file);
+		TS_RETURN_0(status, TS_MALLOC, "out of memory")
+	}
+	if (fread(data, 1, impl->size, file) != impl->size) {
+		ts_int_free(data);
+		fclose(file);
+		TS_RETURN_0(status, TS_IO_ERROR, "unexpected io error")
+	}
+	fclose(file);
+	impl->data = data;
+	impl->mapped = 0;
+	TS_RETURN_SUCCESS(status)
+#endif
+}
+
+void
+ts_int_container_unmap(struct tsContainerImpl *impl)
+{
+	if (!impl->data) return;
+#if defined(TS_INT_MMAP_POSIX)
+	munmap((void *) impl->data, impl->size);
+#elif defined(TS_INT_MMAP_WIN32)
+	UnmapViewOfFile(impl->data);
+#else
+	ts_int_free((void *) impl->data);
+#endif
+	impl->data = NULL;
+}
+
+/* Locates the spline at `index' and validates its header. */
+tsError
+ts_int_container_locate(const tsContainer *container,
+                        size_t index,
+                        const unsigned char **record,
+                        size_t *size, /* of `record' */
+                        tsStatus *status)
+{
+	const struct tsContainerImpl *impl = container->pImpl;
+	size_t offset, deg, dim, num_ctrlp, num_knots, sof_real, num_reals;
+	const unsigned char *header;
+
+	if (!impl || index >= impl->num) {
+		TS_RETURN_2(status, TS_INDEX_ERROR,
+		            "index (%lu) >= num(splines) (%lu)",
+		            (unsigned long) index,
+		            (unsigned long) (impl ? impl->num : 0))
+	}
+	if (!ts_int_binary_decode_size(impl->data + impl->index + index * 8,
+	                               &offset) ||
+	    offset < TS_CONTAINER_HEADER_SIZE || offset % 8 != 0 ||
+	    offset > impl->index ||
+	    impl->index - offset < TS_BINARY_HEADER_SIZE) {
+		TS_RETURN_1(status, TS_PARSE_ERROR,
+		            "corrupted offset of spline %lu",
+		            (unsigned long) index)
+	}
+	header = impl->data + offset;
+	sof_real = header[5];
+	if (memcmp(header, TS_BINARY_MAGIC, 4) != 0 ||
+	    header[4] != TS_BINARY_VERSION ||
+	    (sof_real != 4 && sof_real != 8) ||
+	    !ts_int_binary_decode_size(header +  8, &deg) ||
+	    !ts_int_binary_decode_size(header + 16, &dim) ||
+	    !ts_int_binary_decode_size(header + 24, &num_ctrlp) ||
+	    !ts_int_binary_decode_size(header + 32, &num_knots)) {
+		TS_RETURN_1(status, TS_PARSE_ERROR,
+		            "corrupted header of spline %lu",
+		            (unsigned long) index)
+	}
+	/* The data must fit into the space in front of the index table. */
+	*size = (impl->index - offset - TS_BINARY_HEADER_SIZE) / sof_real;
+	if (dim == 0 || num_ctrlp > *size / dim ||
+	    num_knots > *size - num_ctrlp * dim) {
+		TS_RETURN_1(status, TS_PARSE_ERROR,
+		            "data of spline %lu exceeds container",
+		            (unsigned long) index)
+	}
+	num_reals = num_ctrlp * dim + num_knots;
+	*record = header;
+	*size = TS_BINARY_HEADER_SIZE + num_reals * sof_real;
+	TS_RETURN_SUCCESS(status)
+}
+
+tsContainer
+ts_container_init(void)
+{
+	tsContainer container;
+	container.pImpl = NULL;
+	return container;
+}
+
+tsError
+ts_int_container_open(const char *path,
+                      tsContainer *container,
+                      tsStatus *status)
+{
+	struct tsContainerImpl *impl;
+	tsError err;
+
+	container->pImpl = NULL;
+	impl = (struct tsContainerImpl *) ts_int_malloc(sizeof(*impl));
+	if (!impl)
+		TS_RETURN_0(status, TS_MALLOC, "out of memory")
+	impl->data = NULL;
+	TS_TRY(try, err, status)
+		TS_CALL(try, err, ts_int_container_map(path, impl, status))
+		TS_CALL(try, err, ts_int_container_decode_header(
+		        impl->data, impl->size, &impl->num, &impl->index,
+		        status))
+		container->pImpl = impl;
+	TS_CATCH(err)
+		ts_int_container_unmap(impl);
+		ts_int_free(impl);
+	TS_END_TRY_RETURN(err)
+}
+
+tsError
+ts_container_open(const char *path,
+                  tsContainer *container,
+                  tsStatus *status)
+{
+	TS_INT_API_SCOPE(ts_container_open,
+		ts_int_container_open(path, container, status))
+}
 
-				/* Move knots. `last' is the last knot of the
-				 * second knot group of bezier curve `i'.
-				 * `first' is the first knot of the first knot
-				 * group of bezier curve `i+1'. The
-				 * calculations are quite similar to those for
-				 * the control points `last' and `first' (see
-				 * above). */
-				last = knots + i * order - d + (2 * order - 1);
-				first = last + 1;
-				memmove(last, first, (num_beziers - 1 - i) *
-				        order * sizeof(tsReal));
+void
+ts_container_close(tsContainer *container)
+{
+	if (!container->pImpl) return;
+	ts_int_container_unmap(container->pImpl);
+	ts_int_free(container->pImpl);
+	container->pImpl = NULL;
+}
 
-				/* Removed one knot/control point. */
-				d++;
-			}
-		}
+size_t
+ts_container_num_splines(const tsContainer *container)
+{
+	return container->pImpl ? container->pImpl->num : 0;
+}
 
-		/* Repair internal state. */
-		worker.pImpl->deg = order - 1;
-		worker.pImpl->n_knots -= d;
-		worker.pImpl->n_ctrlp = ts_bspline_num_knots(&worker) - order;
-		memmove(ts_int_bspline_access_knots(&worker),
-		        knots, ts_bspline_sof_knots(&worker));
-		worker.pImpl = realloc(worker.pImpl,
-		                       ts_int_bspline_sof_state(&worker));
-		if (worker.pImpl == NULL) {
-			TS_THROW_0(try, err, status, TS_MALLOC,
-			           "out of memory")
-		}
+tsError
+ts_int_container_view(const tsContainer *container,
+                      size_t index,
+                      tsBSplineView *view,
+                      tsStatus *status)
+{
+	const unsigned char *record;
+	const tsReal *ctrlp;
+	size_t size, deg, dim, num_ctrlp, num_knots;
+	tsError err;
 
-		/* Move `worker' to output parameter. */
-		if (spline == elevated)
-			ts_bspline_free(elevated);
-		ts_bspline_move(&worker, elevated);
-	TS_FINALLY
-		ts_bspline_free(&worker);
-	TS_END_TRY_RETURN(err)
+	TS_CALL_ROE(err, ts_int_container_locate(
+	            container, index, &record, &size, status))
+	if (!ts_int_little_endian() || record[5] != sizeof(tsReal)) {
+		TS_RETURN_1(status, TS_PARSE_ERROR,
+		            "spline %lu cannot be accessed without conversion",
+		            (unsigned long) index)
+	}
+	ts_int_binary_decode_size(record +  8, &deg);
+	ts_int_binary_decode_size(record + 16, &dim);
+	ts_int_binary_decode_size(record + 24, &num_ctrlp);
+	ts_int_binary_decode_size(record + 32, &num_knots);
+	/* The view derives the number of knots from degree and number of
+	 * control points. */
+	if (deg >= num_ctrlp) {
+		TS_RETURN_2(status, TS_DEG_GE_NCTRLP,
+		            "degree (%lu) >= num(control_points) (%lu)",
+		            (unsigned long) deg, (unsigned long) num_ctrlp)
+	}
+	if (num_knots != num_ctrlp + deg + 1) {
+		TS_RETURN_2(status, TS_NUM_KNOTS,
+		            "num(knots) (%lu) != num(control_points) + order "
+		            "(%lu)", (unsigned long) num_knots,
+		            (unsigned long) (num_ctrlp + deg + 1))
+	}
+	/* Splines are 8-byte aligned. */
+	ctrlp = (const tsReal *) (record + TS_BINARY_HEADER_SIZE);
+	return ts_bspline_view_init(num_ctrlp, dim, deg,
+	                            ctrlp, dim,
+	                            ctrlp + num_ctrlp * dim, 1,
+	                            view, status);
 }
 
 tsError
-ts_bspline_align(const tsBSpline *s1,
-                 const tsBSpline *s2,
-                 tsReal epsilon,
-                 tsBSpline *s1_out,
-                 tsBSpline *s2_out,
-                 tsStatus *status)
+ts_container_view(const tsContainer *container,
+                  size_t index,
+                  tsBSplineView *view,
+                  tsStatus *status)
 {
-	tsBSpline s1_worker, s2_worker, *smaller, *larger;
-	tsDeBoorNet net; /* the net of `smaller'. */
-	size_t i, missing, remaining;
-	tsReal min, max, shift, nextKnot;
+	TS_INT_API_SCOPE(ts_container_view,
+		ts_int_container_view(container, index, view, status))
+}
+
+tsError
+ts_int_container_view_checked(const tsContainer *container,
+                              size_t index,
+                              tsBSplineView *view,
+                              tsStatus *status)
+{
+	tsBSplineView tmp;
 	tsError err;
 
-	INIT_OUT_BSPLINE(s1, s1_out)
-	INIT_OUT_BSPLINE(s2, s2_out)
-	s1_worker = ts_bspline_init();
-	s2_worker = ts_bspline_init();
-	smaller = larger = NULL;
-	TS_TRY(try, err, status)
-		/* Set up `s1_worker' and `s2_worker'. After this
-		 * if-elseif-else-block, `s1_worker' and `s2_worker' have same
-		 * degree. */
-		if (ts_bspline_degree(s1) < ts_bspline_degree(s2)) {
-			TS_CALL(try, err, ts_bspline_elevate_degree(s1,
-			        ts_bspline_degree(s2) - ts_bspline_degree(s1),
-			        epsilon, &s1_worker, status))
-			TS_CALL(try, err, ts_bspline_copy(
-			        s2, &s2_worker, status))
-		} else if (ts_bspline_degree(s2) < ts_bspline_degree(s1)) {
-			TS_CALL(try, err, ts_bspline_elevate_degree(s2,
-			        ts_bspline_degree(s1) - ts_bspline_degree(s2),
-			        epsilon, &s2_worker, status))
-			TS_CALL(try, err, ts_bspline_copy(
-			        s1, &s1_worker, status))
-		} else {
-			TS_CALL(try, err, ts_bspline_copy(
-			        s1, &s1_worker, status))
-			TS_CALL(try, err, ts_bspline_copy(
-			        s2, &s2_worker, status))
-		}
+	TS_CALL_ROE(err, ts_int_container_view(container, index, &tmp, status))
+	TS_CALL_ROE(err, ts_int_check_knots(
+	            tmp.knots, tmp.knot_stride,
+	            tmp.num_control_points + tmp.degree + 1,
+	            tmp.degree + 1, status))
+	*view = tmp;
+	TS_RETURN_SUCCESS(status)
+}
 
-		/* Set up `smaller', `larger', and `net'. */
-		if (ts_bspline_num_knots(&s1_worker) <
-		    ts_bspline_num_knots(&s2_worker)) {
-			smaller = &s1_worker;
-			larger  = &s2_worker;
-		} else {
-			smaller = &s2_worker;
-			larger  = &s1_worker;
-		}
-		TS_CALL(try, err, ts_int_deboornet_new(
-		        smaller, &net, status))
+tsError
+ts_container_view_checked(const tsContainer *container,
+                          size_t index,
+                          tsBSplineView *view,
+                          tsStatus *status)
+{
+	TS_INT_API_SCOPE(ts_container_view_checked,
+		ts_int_container_view_checked(container, index, view, status))
+}
 
-		/* Insert knots into `smaller' until it has the same number of
-		 * knots (and therefore the same number of control points) as
-		 * `larger'. */
-		ts_bspline_domain(smaller, &min, &max);
-		missing = remaining = ts_bspline_num_knots(larger) -
-			              ts_bspline_num_knots(smaller);
-		shift = (tsReal) 0.0;
-		if (missing > 0)
-			shift = ( (tsReal) 1.0 / missing ) * (tsReal) 0.5;
-		for (i = 0; remaining > 0; i++, remaining--) {
-			nextKnot = (max - min) * ((tsReal)i / missing) + min;
-			nextKnot += shift;
-			TS_CALL(try, err, ts_int_bspline_eval_woa(
-			        smaller, nextKnot, &net, status))
-			while (!ts_deboornet_num_insertions(&net)) {
-				/* Linear exploration for next knot. */
-				nextKnot += 5 * TS_KNOT_EPSILON;
-				if (nextKnot > max) {
-					TS_THROW_0(try, err, status,
-					           TS_NO_RESULT,
-					          "no more knots for insertion")
-				}
-				TS_CALL(try, err, ts_int_bspline_eval_woa(
-				        smaller, nextKnot, &net, status))
-			}
-			TS_CALL(try, err, ts_int_bspline_insert_knot(
-			        smaller, &net, 1, smaller, status))
-		}
+tsError
+ts_int_container_load(const tsContainer *container,
+                      size_t index,
+                      tsBSpline *spline,
+                      tsStatus *status)
+{
+	const unsigned char *record;
+	size_t size;
+	tsError err;
 
-		if (s1 == s1_out)
-			ts_bspline_free(s1_out);
-		if (s2 == s2_out)
-			ts_bspline_free(s2_out);
-		ts_bspline_move(&s1_worker, s1_out);
-		/* if `s1_out' == `s2_out', `s2_worker' must not be moved
-		 * because otherwise the memory of `s1_worker' is leaked
-		 * (`s2_worker' overrides `s1_worker'). */
-		if (s1_out != s2_out)
-			ts_bspline_move(&s2_worker, s2_out);
-	TS_FINALLY
-		ts_bspline_free(&s1_worker);
-		ts_bspline_free(&s2_worker);
-		ts_deboornet_free(&net);
-	TS_END_TRY_RETURN(err)
+	ts_int_bspline_init(spline);
+	TS_CALL_ROE(err, ts_int_container_locate(
+	            container, index, &record, &size, status))
+	return ts_int_bspline_from_binary(record, size, spline, status);
 }
 
 tsError
-ts_bspline_morph(const tsBSpline *origin,
-                 const tsBSpline *target,
-                 tsReal t,
-                 tsReal epsilon,
-                 tsBSpline *out,
-                 tsStatus *status)
+ts_container_load(const tsContainer *container,
+                  size_t index,
+                  tsBSpline *spline,
+                  tsStatus *status)
 {
-	tsBSpline origin_al, target_al; /* aligned origin and target */
-	tsReal *origin_al_c, *origin_al_k; /* control points and knots */
-	tsReal *target_al_c, *target_al_k; /* control points and knots */
+	TS_INT_API_SCOPE(ts_container_load,
+		ts_int_container_load(container, index, spline, status))
+}
 
-	/* Properties of `out'. */
-	size_t deg, dim, num_ctrlp, num_knots;
-	tsReal *ctrlp, *knots;
-	tsBSpline tmp; /* temporary buffer if `out' must be resized */
+tsContainerWriter
+ts_container_writer_init(void)
+{
+	tsContainerWriter writer;
+	writer.pImpl = NULL;
+	return writer;
+}
 
-	tsReal t_hat;
-	size_t i, offset, d;
+/* Reads the index table of an existing container into `impl'. */
+tsError
+ts_int_container_writer_resume(struct tsContainerWriterImpl *impl,
+                               tsStatus *status)
+{
+	unsigned char header[TS_CONTAINER_HEADER_SIZE];
+	unsigned char offset[8];
+	size_t size, i;
 	tsError err;
 
-	origin_al = ts_bspline_init();
-	target_al = ts_bspline_init();
-	TS_TRY(try, err, status)
-		/* Clamp `t' to domain [0, 1] and set up `t_hat'. */
-		if (t < (tsReal) 0.0) t = (tsReal) 0.0;
-		if (t > (tsReal) 1.0) t = (tsReal) 1.0;
-		t_hat = (tsReal) 1.0 - t;
-
-		/* Set up `origin_al' and `target_al'. */
-		/* Degree must be elevated... */
-		if (ts_bspline_degree(origin) != ts_bspline_degree(target) ||
-		 /* .. or knots (and thus control points) must be inserted. */
-		 ts_bspline_num_knots(origin) != ts_bspline_num_knots(target)) {
-			TS_CALL(try, err, ts_bspline_align(
-			        origin, target, epsilon, &origin_al, &target_al,
-			        status));
-		} else {
-			/* Flat copy. */
-			origin_al = *origin;
-			target_al = *target;
+	if (!ts_int_file_size(impl->file, &size))
+		TS_RETURN_0(status, TS_IO_ERROR, "unable to stat file")
+	if (fread(header, 1, sizeof(header), impl->file) != sizeof(header))
+		TS_RETURN_0(status, TS_PARSE_ERROR, "not a spline container")
+	TS_CALL_ROE(err, ts_int_container_decode_header(
+	            header, size, &impl->num, &impl->pos, status))
+	if (header[5] != sizeof(tsReal)) {
+		TS_RETURN_2(status, TS_PARSE_ERROR,
+		            "size of real values (%d) != sizeof(tsReal) (%lu)",
+		            (int) header[5], (unsigned long) sizeof(tsReal))
+	}
+	impl->cap = impl->num;
+	if (impl->cap > 0) {
+		impl->offsets = (size_t *) ts_int_malloc(
+			impl->cap * sizeof(size_t));
+		if (!impl->offsets)
+			TS_RETURN_0(status, TS_MALLOC, "out of memory")
+	}
+	if (!ts_int_file_seek(impl->file, impl->pos))
+		TS_RETURN_0(status, TS_IO_ERROR, "unable to seek file")
+	for (i = 0; i < impl->num; i++) {
+		if (fread(offset, 1, 8, impl->file) != 8 ||
+		    !ts_int_binary_decode_size(offset, impl->offsets + i)) {
+			TS_RETURN_0(status, TS_PARSE_ERROR,
+			            "corrupted container index table")
 		}
-		origin_al_c = ts_int_bspline_access_ctrlp(&origin_al);
-		origin_al_k = ts_int_bspline_access_knots(&origin_al);
-		target_al_c = ts_int_bspline_access_ctrlp(&target_al);
-		target_al_k = ts_int_bspline_access_knots(&target_al);
+	}
+	/* New splines overwrite the index table. */
+	if (!ts_int_file_seek(impl->file, impl->pos))
+		TS_RETURN_0(status, TS_IO_ERROR, "unable to seek file")
+	TS_RETURN_SUCCESS(status)
+}
 
-		/* Set up `out'. */
-		deg = ts_bspline_degree(&origin_al);
-		num_ctrlp = ts_bspline_num_control_points(&origin_al);
-		dim = ts_bspline_dimension(&origin_al);
-		if (ts_bspline_dimension(&target_al) < dim)
-			dim = ts_bspline_dimension(&target_al);
-		if (out->pImpl == NULL) {
-			TS_CALL(try, err, ts_bspline_new(num_ctrlp, dim, deg,
-			        TS_OPENED /* doesn't matter */, out, status))
-		} else if (ts_bspline_degree(out) != deg ||
-		           ts_bspline_num_control_points(out) != num_ctrlp ||
-		           ts_bspline_dimension(out) != dim) {
-			TS_CALL(try, err, ts_bspline_new(num_ctrlp, dim, deg,
-			        TS_OPENED /* doesn't matter */, &tmp, status))
-			ts_bspline_free(out);
-			ts_bspline_move(&tmp, out);
-		}
-		num_knots = ts_bspline_num_knots(out);
-		ctrlp = ts_int_bspline_access_ctrlp(out);
-		knots = ts_int_bspline_access_knots(out);
+tsError
+ts_int_container_writer_open(const char *path,
+                             int append,
+                             tsContainerWriter *writer,
+                             tsStatus *status)
+{
+	struct tsContainerWriterImpl *impl;
+	unsigned char header[TS_CONTAINER_HEADER_SIZE];
+	tsError err;
 
-		/* Interpolate control points. */
-		for (i = 0; i < num_ctrlp; i++) {
-			for (d = 0; d < dim; d++) {
-				offset = i * dim + d;
-				ctrlp[offset] = t * target_al_c[offset] +
-				                t_hat * origin_al_c[offset];
+	writer->pImpl = NULL;
+	impl = (struct tsContainerWriterImpl *)
+		ts_int_malloc(sizeof(*impl));
+	if (!impl)
+		TS_RETURN_0(status, TS_MALLOC, "out of memory")
+	impl->num = impl->cap = 0;
+	impl->offsets = NULL;
+	impl->pos = TS_CONTAINER_HEADER_SIZE;
+	impl->file = append ? fopen(path, "r+b") : NULL;
+	TS_TRY(try, err, status)
+		if (impl->file) {
+			TS_CALL(try, err, ts_int_container_writer_resume(
+			        impl, status))
+		} else {
+			impl->file = fopen(path, "wb");
+			if (!impl->file) {
+				TS_THROW_0(try, err, status, TS_IO_ERROR,
+				           "unable to open file")
+			}
+			/* Placeholder, completed on close. */
+			ts_int_container_encode_header(header, 0, impl->pos);
+			if (fwrite(header, 1, sizeof(header), impl->file) !=
+			    sizeof(header)) {
+				TS_THROW_0(try, err, status, TS_IO_ERROR,
+				           "unexpected io error")
 			}
 		}
+		writer->pImpl = impl;
+	TS_CATCH(err)
+		if (impl->file) fclose(impl->file);
+		ts_int_free(impl->offsets);
+		ts_int_free(impl);
+	TS_END_TRY_RETURN(err)
+}
 
-		/* Interpolate knots. */
-		for (i = 0; i < num_knots; i++) {
-			knots[i] = t * target_al_k[i] +
-			           t_hat * origin_al_k[i];
+tsError
+ts_container_writer_open(const char *path,
+                         int append,
+                         tsContainerWriter *writer,
+                         tsStatus *status)
+{
+	TS_INT_API_SCOPE(ts_container_writer_open,
+		ts_int_container_writer_open(path, append, writer, status))
+}
+
+tsError
+ts_int_container_writer_append_view(tsContainerWriter *writer,
+                                    const tsBSplineView *view,
+                                    tsStatus *status)
+{
+	struct tsContainerWriterImpl *impl = writer->pImpl;
+	const unsigned char padding[8] = { 0 };
+	struct tsBinaryStream stream;
+	size_t *offsets, sof_binary, sof_padding;
+	tsError err;
+
+	if (!impl)
+		TS_RETURN_0(status, TS_IO_ERROR, "writer is not open")
+	if (impl->num == impl->cap) {
+		impl->cap = impl->cap == 0 ? 64 : impl->cap * 2;
+		offsets = (size_t *) ts_int_realloc(impl->offsets,
+			impl->cap * sizeof(size_t));
+		if (!offsets) {
+			impl->cap = impl->num;
+			TS_RETURN_0(status, TS_MALLOC, "out of memory")
+		}
+		impl->offsets = offsets;
+	}
+	sof_binary = ts_int_view_sof_binary(view);
+	sof_padding = (8 - sof_binary % 8) % 8;
+	if (sof_binary + sof_padding > (size_t) -1 - impl->pos) {
+		TS_RETURN_0(status, TS_IO_ERROR,
+		            "container exceeds addressable memory")
+	}
+	stream.out = NULL;
+	stream.in = NULL;
+	stream.remaining = 0;
+	stream.file = impl->file;
+	TS_TRY(try, err, status)
+		TS_CALL(try, err, ts_int_view_write_binary(
+		        view, &stream, status))
+		if (fwrite(padding, 1, sof_padding, impl->file) !=
+		    sof_padding) {
+			TS_THROW_0(try, err, status, TS_IO_ERROR,
+			           "unexpected io error")
 		}
-	TS_FINALLY
-		if (origin->pImpl != origin_al.pImpl)
-			ts_bspline_free(&origin_al);
-		if (target->pImpl != target_al.pImpl)
-			ts_bspline_free(&target_al);
+		/* The spline is registered only if it has been written
+		 * completely. */
+		impl->offsets[impl->num++] = impl->pos;
+		impl->pos += sof_binary + sof_padding;
+	TS_CATCH(err)
+		/* Subsequent splines (or the index table) overwrite the
+		 * partially written data. */
+		clearerr(impl->file);
+		ts_int_file_seek(impl->file, impl->pos);
 	TS_END_TRY_RETURN(err)
 }
+
+tsError
+ts_container_writer_append_view(tsContainerWriter *writer,
+                                const tsBSplineView *view,
+                                tsStatus *status)
+{
+	TS_INT_API_SCOPE(ts_container_writer_append_view,
+		ts_int_container_writer_append_view(writer, view, status))
+}
+
+tsError
+ts_container_writer_append(tsContainerWriter *writer,
+                           const tsBSpline *spline,
+                           tsStatus *status)
+{
+	tsBSplineView view;
+	ts_bspline_as_view(spline, &view);
+	TS_INT_API_SCOPE(ts_container_writer_append,
+		ts_int_container_writer_append_view(writer, &view, status))
+}
+
+tsError
+ts_int_container_writer_close(tsContainerWriter *writer,
+                              tsStatus *status)
+{
+	struct tsContainerWriterImpl *impl = writer->pImpl;
+	unsigned char header[TS_CONTAINER_HEADER_SIZE];
+	unsigned char offset[8];
+	int success = 1;
+	size_t i;
+
+	if (!impl)
+		TS_RETURN_SUCCESS(status)
+	writer->pImpl = NULL;
+	for (i = 0; success && i < impl->num; i++) {
+		ts_int_binary_encode_size(offset, impl->offsets[i]);
+		success = fwrite(offset, 1, 8, impl->file) == 8;
+	}
+	ts_int_container_encode_header(header, impl->num, impl->pos);
+	success = success &&
+		fseek(impl->file, 0, SEEK_SET) == 0 &&
+		fwrite(header, 1, sizeof(header), impl->file) ==
+		sizeof(header);
+	success = fclose(impl->file) == 0 && success;
+	ts_int_free(impl->offsets);
+	ts_int_free(impl);
+	if (!success)
+		TS_RETURN_0(status, TS_IO_ERROR, "unexpected io error")
+	TS_RETURN_SUCCESS(status)
+}
+
+tsError
+ts_container_writer_close(tsContainerWriter *writer,
+                          tsStatus *status)
+{
+	TS_INT_API_SCOPE(ts_container_writer_close,
+		ts_int_container_writer_close(writer, status))
+}
 /*! @} */
 
 
 
-/*! @name Serialization and Persistence
+/*! @name JSON Streams
  *
  * @{
  */
+struct tsJsonStreamImpl
+{
+	struct tsJsonReader reader;
+	int array;   /**< Whether the splines are enclosed in an array. */
+	int done;    /**< Whether the end of the stream has been reached. */
+	size_t num;  /**< Number of splines read so far. */
+	size_t line; /**< Position of the current line. */
+	size_t end;  /**< Lines starting at or after `end' are not read. */
+};
+
+struct tsJsonStreamWriterImpl
+{
+	struct tsJsonWriter writer;
+	int array;  /**< Whether the splines are enclosed in an array. */
+	size_t num; /**< Number of splines written so far. */
+};
+
+/* Returns the position of `reader' in its file. */
+size_t
+ts_int_json_position(const struct tsJsonReader *reader)
+{
+	return reader->offset + (size_t) (reader->cur - reader->chunk);
+}
+
+tsJsonStream
+ts_json_stream_init(void)
+{
+	tsJsonStream stream;
+	stream.pImpl = NULL;
+	return stream;
+}
+
+/* Allocates the data of `stream' and opens `path' (if not NULL). */
 tsError
-ts_int_bspline_to_json(const tsBSpline *spline,
-                       JSON_Value **value,
+ts_int_json_stream_new(const char *path,
+                       tsJsonStream *stream,
                        tsStatus *status)
 {
-	const size_t deg = ts_bspline_degree(spline);
-	const size_t dim = ts_bspline_dimension(spline);
-	const size_t len_ctrlp = ts_bspline_len_control_points(spline);
-	const size_t len_knots = ts_bspline_num_knots(spline);
-	const tsReal *ctrlp = ts_int_bspline_access_ctrlp(spline);
-	const tsReal *knots = ts_int_bspline_access_knots(spline);
-
-	size_t i; /**< Used in loops */
-	tsError err;
-
-	JSON_Value  *ctrlp_value;
-	JSON_Value  *knots_value;
-	JSON_Object *spline_object;
-	JSON_Array  *ctrlp_array;
-	JSON_Array  *knots_array;
-
-	*value = ctrlp_value = knots_value = NULL;
-	TS_TRY(values, err, status)
-		/* Init memory. */
-		*value = json_value_init_object();
-		if (!*value) {
-			TS_THROW_0(values, err, status, TS_MALLOC,
-			           "out of memory")
-		}
-		ctrlp_value = json_value_init_array();
-		if (!ctrlp_value) {
-			TS_THROW_0(values, err, status, TS_MALLOC,
-			           "out of memory")
+	struct tsJsonStreamImpl *impl;
+
+	stream->pImpl = NULL;
+	impl = (struct tsJsonStreamImpl *) ts_int_malloc(sizeof(*impl));
+	if (!impl)
+		TS_RETURN_0(status, TS_MALLOC, "out of memory")
+	impl->reader.cur = impl->reader.end = NULL;
+	impl->reader.file = NULL;
+	impl->reader.chunk = NULL;
+	impl->reader.offset = 0;
+	impl->array = impl->done = 0;
+	impl->num = impl->line = 0;
+	impl->end = (size_t) -1;
+	if (path) {
+		impl->reader.chunk = (char *) ts_int_malloc(
+			TS_INT_JSON_CHUNK_SIZE);
+		if (!impl->reader.chunk) {
+			ts_int_free(impl);
+			TS_RETURN_0(status, TS_MALLOC, "out of memory")
 		}
-		knots_value = json_value_init_array();
-		if (!knots_value) {
-			TS_THROW_0(values, err, status, TS_MALLOC,
-			           "out of memory")
+		impl->reader.cur = impl->reader.end = impl->reader.chunk;
+		impl->reader.file = fopen(path, "rb");
+		if (!impl->reader.file) {
+			ts_int_free(impl->reader.chunk);
+			ts_int_free(impl);
+			TS_RETURN_0(status, TS_IO_ERROR, "unable to open file")
 		}
+	}
+	stream->pImpl = impl;
+	TS_RETURN_SUCCESS(status)
+}
 
-		/* Although the following functions cannot fail, that is, they
-		 * won't return NULL or JSONFailure, we nevertheless handle
-		 * unexpected return values. */
+/* Determines the layout of a stream that has just been opened. */
+void
+ts_int_json_stream_detect(struct tsJsonStreamImpl *impl)
+{
+	impl->array = ts_int_json_accept(&impl->reader, '[');
+}
 
-		/* Init output. */
-		spline_object = json_value_get_object(*value);
-		if (!spline_object) {
-			TS_THROW_0(values, err, status, TS_MALLOC,
-			           "out of memory")
-		}
+tsError
+ts_int_json_stream_open(const char *path,
+                        tsJsonStream *stream,
+                        tsStatus *status)
+{
+	tsError err;
+	TS_CALL_ROE(err, ts_int_json_stream_new(path, stream, status))
+	ts_int_json_stream_detect(stream->pImpl);
+	TS_RETURN_SUCCESS(status)
+}
 
-		/* Set degree and dimension. */
-		if (JSONSuccess != json_object_set_number(spline_object,
-		                                          "degree",
-		                                          (double) deg)) {
-			TS_THROW_0(values, err, status, TS_MALLOC,
-			           "out of memory")
-		}
-		if (JSONSuccess != json_object_set_number(spline_object,
-		                                          "dimension",
-		                                          (double) dim)) {
-			TS_THROW_0(values, err, status, TS_MALLOC,
-			           "out of memory")
-		}
+tsError
+ts_json_stream_open(const char *path,
+                    tsJsonStream *stream,
+                    tsStatus *status)
+{
+	TS_INT_API_SCOPE(ts_json_stream_open,
+		ts_int_json_stream_open(path, stream, status))
+}
 
-		/* Set control points. */
-		if (JSONSuccess != json_object_set_value(spline_object,
-		                                         "control_points",
-		                                         ctrlp_value)) {
-			TS_THROW_0(values, err, status, TS_MALLOC,
-			           "out of memory")
-		}
-		ctrlp_array = json_array(ctrlp_value);
-		if (!ctrlp_array) {
-			TS_THROW_0(values, err, status, TS_MALLOC,
-			           "out of memory")
-		}
-		for (i = 0; i < len_ctrlp; i++) {
-			if (JSONSuccess != json_array_append_number(
-				    ctrlp_array, (double) ctrlp[i])) {
-				TS_THROW_0(values, err, status, TS_MALLOC,
-				           "out of memory")
-			}
-		}
+tsError
+ts_int_json_stream_open_range(const char *path,
+                              size_t begin,
+                              size_t end,
+                              tsJsonStream *stream,
+                              tsStatus *status)
+{
+	struct tsJsonStreamImpl *impl;
+	int c;
+	tsError err;
 
-		/* Set knots. */
-		if (JSONSuccess != json_object_set_value(spline_object,
-		                                         "knots",
-		                                         knots_value)) {
-			TS_THROW_0(values, err, status, TS_MALLOC,
-			           "out of memory")
-		}
-		knots_array = json_array(knots_value);
-		if (!knots_array) {
-			TS_THROW_0(values, err, status, TS_MALLOC,
-				"out of memory")
-		}
-		for (i = 0; i < len_knots; i++) {
-			if (JSONSuccess != json_array_append_number(
-				    knots_array, (double) knots[i])) {
-				TS_THROW_0(values, err, status, TS_MALLOC,
-				           "out of memory")
+	TS_CALL_ROE(err, ts_int_json_stream_new(path, stream, status))
+	impl = stream->pImpl;
+	impl->end = end;
+	TS_TRY(try, err, status)
+		if (begin == 0) {
+			ts_int_json_stream_detect(impl);
+			if (impl->array) {
+				TS_THROW_0(try, err, status, TS_PARSE_ERROR,
+				           "ranges require newline-delimited "
+				           "json")
+			}
+		} else {
+			/* Continue with the first line starting at or after
+			   `begin'. That is, skip the rest of the line
+			   containing `begin - 1'. */
+			if (begin - 1 > (size_t) LONG_MAX ||
+			    fseek(impl->reader.file, (long) (begin - 1),
+			          SEEK_SET) != 0) {
+				TS_THROW_0(try, err, status, TS_IO_ERROR,
+				           "unable to seek file")
 			}
+			impl->reader.offset = begin - 1;
+			do {
+				c = ts_int_json_peek(&impl->reader);
+				if (c >= 0) impl->reader.cur++;
+			} while (c >= 0 && c != '\n');
+			impl->line = ts_int_json_position(&impl->reader);
 		}
 	TS_CATCH(err)
-		if (*value)
-			json_value_free(*value);
-		if (ctrlp_value && !json_value_get_parent(ctrlp_value))
-			json_value_free(ctrlp_value);
-		if (knots_value && !json_value_get_parent(knots_value))
-			json_value_free(knots_value);
-		*value = NULL;
+		ts_json_stream_close(stream);
 	TS_END_TRY_RETURN(err)
 }
 
 tsError
-ts_int_bspline_parse_json(const JSON_Value *spline_value,
-                          tsBSpline *spline,
+ts_json_stream_open_range(const char *path,
+                          size_t begin,
+                          size_t end,
+                          tsJsonStream *stream,
                           tsStatus *status)
 {
-	size_t deg, dim, len_ctrlp, num_knots;
-	tsReal *ctrlp, *knots;
+	TS_INT_API_SCOPE(ts_json_stream_open_range,
+		ts_int_json_stream_open_range(path, begin, end, stream, status))
+}
 
-	JSON_Object *spline_object;
-	JSON_Value *deg_value;
-	JSON_Value *dim_value;
-	JSON_Value *ctrlp_value;
-	JSON_Array *ctrlp_array;
-	JSON_Value *knots_value;
-	JSON_Array *knots_array;
-	JSON_Value *real_value;
-	size_t i;
+tsError
+ts_int_json_stream_open_string(const char *json,
+                               tsJsonStream *stream,
+                               tsStatus *status)
+{
 	tsError err;
+	TS_CALL_ROE(err, ts_int_json_stream_new(NULL, stream, status))
+	stream->pImpl->reader.cur = json;
+	stream->pImpl->reader.end = json + strlen(json);
+	ts_int_json_stream_detect(stream->pImpl);
+	TS_RETURN_SUCCESS(status)
+}
 
-	ts_int_bspline_init(spline);
-
-	/* Read spline object. */
-	if (json_value_get_type(spline_value) != JSONObject)
-		TS_RETURN_0(status, TS_PARSE_ERROR, "invalid json input")
-	spline_object = json_value_get_object(spline_value);
-	if (!spline_object)
-		TS_RETURN_0(status, TS_PARSE_ERROR, "invalid json input")
+tsError
+ts_json_stream_open_string(const char *json,
+                           tsJsonStream *stream,
+                           tsStatus *status)
+{
+	TS_INT_API_SCOPE(ts_json_stream_open_string,
+		ts_int_json_stream_open_string(json, stream, status))
+}
 
-	/* Read degree. */
-	deg_value = json_object_get_value(spline_object, "degree");
-	if (json_value_get_type(deg_value) != JSONNumber)
-		TS_RETURN_0(status, TS_PARSE_ERROR, "degree is not a number")
-	if (json_value_get_number(deg_value) < -0.01f) {
-		TS_RETURN_1(status, TS_PARSE_ERROR,
-		            "degree (%f) < 0",
-		            json_value_get_number(deg_value))
+/* Moves `impl' to the next spline and determines whether there is one. */
+tsError
+ts_int_json_stream_advance(struct tsJsonStreamImpl *impl,
+                           tsStatus *status)
+{
+	struct tsJsonReader *reader = &impl->reader;
+	int c;
+
+	if (impl->array) {
+		if (ts_int_json_accept(reader, ']')) {
+			if (ts_int_json_skip_ws(reader) != -1) {
+				TS_RETURN_0(status, TS_PARSE_ERROR,
+				            "invalid json input")
+			}
+			impl->done = 1;
+		} else if (impl->num > 0 && !ts_int_json_accept(reader, ',')) {
+			TS_RETURN_1(status, TS_PARSE_ERROR,
+			            "missing ',' after spline %lu",
+			            (unsigned long) (impl->num - 1))
+		} else if (ts_int_json_skip_ws(reader) == -1) {
+			TS_RETURN_0(status, TS_PARSE_ERROR,
+			            "missing closing bracket")
+		}
+	} else {
+		/* Skip whitespace and keep track of the current line. */
+		c = ts_int_json_peek(reader);
+		while (c == ' ' || c == '\t' || c == '\n' || c == '\r') {
+			reader->cur++;
+			if (c == '\n' && reader->file)
+				impl->line = ts_int_json_position(reader);
+			c = ts_int_json_peek(reader);
+		}
+		impl->done = c == -1 || impl->line >= impl->end;
 	}
-	deg = (size_t) json_value_get_number(deg_value);
+	TS_RETURN_SUCCESS(status)
+}
 
-	/* Read dimension. */
-	dim_value = json_object_get_value(spline_object, "dimension");
-	if (json_value_get_type(dim_value) != JSONNumber) {
-		TS_RETURN_0(status, TS_PARSE_ERROR,
-		            "dimension is not a number")
-	}
-	if (json_value_get_number(dim_value) < 0.99f) {
-		TS_RETURN_1(status, TS_PARSE_ERROR,
-		            "dimension (%f) < 1",
-		            json_value_get_number(deg_value))
+tsError
+ts_int_json_stream_next(tsJsonStream *stream,
+                        tsBSpline *spline,
+                        int *done,
+                        tsStatus *status)
+{
+	struct tsJsonStreamImpl *impl = stream->pImpl;
+	tsError err;
+
+	ts_int_bspline_init(spline);
+	*done = 1;
+	if (!impl)
+		TS_RETURN_0(status, TS_IO_ERROR, "stream is not open")
+	if (!impl->done) {
+		TS_CALL_ROE(err, ts_int_json_stream_advance(impl, status))
 	}
-	dim = (size_t) json_value_get_number(dim_value);
+	if (impl->reader.file && ferror(impl->reader.file))
+		TS_RETURN_0(status, TS_IO_ERROR, "unexpected io error")
+	if (impl->done)
+		TS_RETURN_SUCCESS(status)
+	TS_CALL_ROE(err, ts_int_bspline_read_json(
+	            &impl->reader, spline, status))
+	impl->num++;
+	*done = 0;
+	TS_RETURN_SUCCESS(status)
+}
 
-	/* Read length of control point vector. */
-	ctrlp_value = json_object_get_value(spline_object, "control_points");
-	if (json_value_get_type(ctrlp_value) != JSONArray) {
-		TS_RETURN_0(status, TS_PARSE_ERROR,
-		            "control_points is not an array")
+tsError
+ts_json_stream_next(tsJsonStream *stream,
+                    tsBSpline *spline,
+                    int *done,
+                    tsStatus *status)
+{
+	TS_INT_API_SCOPE(ts_json_stream_next,
+		ts_int_json_stream_next(stream, spline, done, status))
+}
+
+size_t
+ts_json_stream_num_read(const tsJsonStream *stream)
+{
+	return stream->pImpl ? stream->pImpl->num : 0;
+}
+
+void
+ts_json_stream_close(tsJsonStream *stream)
+{
+	if (!stream->pImpl) return;
+	if (stream->pImpl->reader.file)
+		fclose(stream->pImpl->reader.file);
+	ts_int_free(stream->pImpl->reader.chunk);
+	ts_int_free(stream->pImpl);
+	stream->pImpl = NULL;
+}
+
+tsJsonStreamWriter
+ts_json_stream_writer_init(void)
+{
+	tsJsonStreamWriter writer;
+	writer.pImpl = NULL;
+	return writer;
+}
+
+tsError
+ts_int_json_stream_writer_open(const char *path,
+                               tsJsonFormat format,
+                               tsJsonStreamWriter *writer,
+                               tsStatus *status)
+{
+	struct tsJsonStreamWriterImpl *impl;
+
+	writer->pImpl = NULL;
+	impl = (struct tsJsonStreamWriterImpl *)
+		ts_int_malloc(sizeof(*impl));
+	if (!impl)
+		TS_RETURN_0(status, TS_MALLOC, "out of memory")
+	impl->writer.buf = (char *) ts_int_malloc(TS_INT_JSON_CHUNK_SIZE);
+	if (!impl->writer.buf) {
+		ts_int_free(impl);
+		TS_RETURN_0(status, TS_MALLOC, "out of memory")
 	}
-	ctrlp_array = json_value_get_array(ctrlp_value);
-	len_ctrlp = json_array_get_count(ctrlp_array);
-	if (len_ctrlp % dim != 0) {
-		TS_RETURN_2(status, TS_PARSE_ERROR,
-		           "len(control_points) (%lu) %% dimension (%lu) != 0",
-		            (unsigned long) len_ctrlp, (unsigned long) dim)
+	impl->writer.len = 0;
+	impl->writer.cap = TS_INT_JSON_CHUNK_SIZE;
+	impl->writer.file = fopen(path, "wb");
+	if (!impl->writer.file) {
+		ts_int_free(impl->writer.buf);
+		ts_int_free(impl);
+		TS_RETURN_0(status, TS_IO_ERROR, "unable to open file")
 	}
+	impl->array = format == TS_JSON_ARRAY;
+	impl->num = 0;
+	if (impl->array) /* fits into the (empty) buffer */
+		ts_int_json_write(&impl->writer, "[");
+	writer->pImpl = impl;
+	TS_RETURN_SUCCESS(status)
+}
 
-	/* Read number of knots. */
-	knots_value = json_object_get_value(spline_object, "knots");
-	if (json_value_get_type(knots_value) != JSONArray) {
-		TS_RETURN_0(status, TS_PARSE_ERROR,
-		            "knots is not an array")
-	}
-	knots_array = json_value_get_array(knots_value);
-	num_knots = json_array_get_count(knots_array);
+tsError
+ts_json_stream_writer_open(const char *path,
+                           tsJsonFormat format,
+                           tsJsonStreamWriter *writer,
+                           tsStatus *status)
+{
+	TS_INT_API_SCOPE(ts_json_stream_writer_open,
+		ts_int_json_stream_writer_open(path, format, writer, status))
+}
 
-	/* Create spline. */
-	TS_TRY(try, err, status)
-		TS_CALL(try, err, ts_bspline_new(
-		        len_ctrlp/dim, dim, deg,
-		        TS_CLAMPED, spline, status))
-		if (num_knots != ts_bspline_num_knots(spline))
-			TS_THROW_2(try, err, status, TS_NUM_KNOTS,
-			           "unexpected num(knots): (%lu) != (%lu)",
-			           (unsigned long) num_knots,
-			          (unsigned long) ts_bspline_num_knots(spline))
+tsError
+ts_int_json_stream_writer_append_view(tsJsonStreamWriter *writer,
+                                      const tsBSplineView *view,
+                                      tsStatus *status)
+{
+	struct tsJsonStreamWriterImpl *impl = writer->pImpl;
+	tsError err;
 
-		/* Set control points. */
-		ctrlp = ts_int_bspline_access_ctrlp(spline);
-		for (i = 0; i < len_ctrlp; i++) {
-			real_value = json_array_get_value(ctrlp_array, i);
-			if (json_value_get_type(real_value) != JSONNumber)
-				TS_THROW_1(try, err, status, TS_PARSE_ERROR,
-				"control_points: value at index %lu is not a number",
-				           (unsigned long) i)
-			ctrlp[i] = (tsReal) json_value_get_number(real_value);
-		}
-		TS_CALL(try, err, ts_bspline_set_control_points(
-		        spline, ctrlp, status))
+	if (!impl)
+		TS_RETURN_0(status, TS_IO_ERROR, "writer is not open")
+	if (impl->array && !ts_int_json_write(&impl->writer,
+	                                      impl->num == 0 ? "\n" : ",\n"))
+		return ts_int_json_write_error(&impl->writer, status);
+	TS_CALL_ROE(err, ts_int_view_write_json(
+	            view, 1, &impl->writer, status))
+	if (!impl->array && !ts_int_json_write(&impl->writer, "\n"))
+		return ts_int_json_write_error(&impl->writer, status);
+	impl->num++;
+	TS_RETURN_SUCCESS(status)
+}
 
-		/* Set knots. */
-		knots = ts_int_bspline_access_knots(spline);
-		for (i = 0; i < num_knots; i++) {
-			real_value = json_array_get_value(knots_array, i);
-			if (json_value_get_type(real_value) != JSONNumber)
-			TS_THROW_1(try, err, status, TS_PARSE_ERROR,
-			           "knots: value at index %lu is not a number",
-			           (unsigned long) i)
-			knots[i] = (tsReal) json_value_get_number(real_value);
-		}
-		TS_CALL(try, err, ts_bspline_set_knots(
-		        spline, knots, status))
-	TS_CATCH(err)
-		ts_bspline_free(spline);
-	TS_END_TRY_RETURN(err)
+tsError
+ts_json_stream_writer_append_view(tsJsonStreamWriter *writer,
+                                  const tsBSplineView *view,
+                                  tsStatus *status)
+{
+	TS_INT_API_SCOPE(ts_json_stream_writer_append_view,
+		ts_int_json_stream_writer_append_view(writer, view, status))
 }
 
 tsError
-ts_bspline_to_json(const tsBSpline *spline,
-                   char **json,
-                   tsStatus *status)
+ts_json_stream_writer_append(tsJsonStreamWriter *writer,
+                             const tsBSpline *spline,
+                             tsStatus *status)
 {
-	tsError err;
-	JSON_Value *value = NULL;
-	*json = NULL;
-	TS_CALL_ROE(err, ts_int_bspline_to_json(spline, &value, status))
-	*json = json_serialize_to_string_pretty(value);
-	json_value_free(value);
-	if (!*json)
-		TS_RETURN_0(status, TS_MALLOC, "out of memory")
+	tsBSplineView view;
+	ts_bspline_as_view(spline, &view);
+	TS_INT_API_SCOPE(ts_json_stream_writer_append,
+		ts_int_json_stream_writer_append_view(writer, &view, status))
+}
+
+tsError
+ts_int_json_stream_writer_close(tsJsonStreamWriter *writer,
+                                tsStatus *status)
+{
+	struct tsJsonStreamWriterImpl *impl = writer->pImpl;
+	int success = 1;
+
+	if (!impl)
+		TS_RETURN_SUCCESS(status)
+	writer->pImpl = NULL;
+	if (impl->array) {
+		success = ts_int_json_write(&impl->writer,
+			impl->num == 0 ? "]\n" : "\n]\n");
+	}
+	success = success && ts_int_json_flush(&impl->writer);
+	success = fclose(impl->writer.file) == 0 && success;
+	ts_int_free(impl->writer.buf);
+	ts_int_free(impl);
+	if (!success)
+		TS_RETURN_0(status, TS_IO_ERROR, "unexpected io error")
 	TS_RETURN_SUCCESS(status)
 }
 
 tsError
-ts_bspline_parse_json(const char *json,
-                      tsBSpline *spline,
-                      tsStatus *status)
+ts_json_stream_writer_close(tsJsonStreamWriter *writer,
+                            tsStatus *status)
+{
+	TS_INT_API_SCOPE(ts_json_stream_writer_close,
+		ts_int_json_stream_writer_close(writer, status))
+}
+
+tsError
+ts_int_bspline_save_all(const tsBSpline *splines,
+                        size_t num,
+                        const char *path,
+                        tsJsonFormat format,
+                        tsStatus *status)
 {
+	tsJsonStreamWriter writer = ts_json_stream_writer_init();
+	size_t i;
 	tsError err;
-	JSON_Value *value = NULL;
-	ts_int_bspline_init(spline);
+
 	TS_TRY(try, err, status)
-		value = json_parse_string(json);
-		if (!value) {
-			TS_RETURN_0(status, TS_PARSE_ERROR,
-			            "invalid json input")
+		TS_CALL(try, err, ts_int_json_stream_writer_open(
+		        path, format, &writer, status))
+		for (i = 0; i < num; i++) {
+			TS_CALL(try, err, ts_json_stream_writer_append(
+			        &writer, splines + i, status))
 		}
-		TS_CALL(try, err, ts_int_bspline_parse_json(
-		        value, spline, status))
-	TS_FINALLY
-		if (value)
-			json_value_free(value);
+		TS_CALL(try, err, ts_int_json_stream_writer_close(
+		        &writer, status))
+	TS_CATCH(err)
+		ts_int_json_stream_writer_close(&writer, NULL);
 	TS_END_TRY_RETURN(err)
 }
 
 tsError
-ts_bspline_save(const tsBSpline *spline,
-                const char *path,
-                tsStatus *status)
+ts_bspline_save_all(const tsBSpline *splines,
+                    size_t num,
+                    const char *path,
+                    tsJsonFormat format,
+                    tsStatus *status)
 {
-	tsError err;
-	JSON_Status json_status;
-	JSON_Value *value = NULL;
-	TS_CALL_ROE(err, ts_int_bspline_to_json(spline, &value, status))
-	json_status = json_serialize_to_file_pretty(value, path);
-	json_value_free(value);
-	if (json_status != JSONSuccess)
-		TS_RETURN_0(status, TS_IO_ERROR, "unexpected io error")
-	TS_RETURN_SUCCESS(status)
+	TS_INT_API_SCOPE(ts_bspline_save_all,
+		ts_int_bspline_save_all(splines, num, path, format, status))
 }
 
 tsError
-ts_bspline_load(const char *path,
-                tsBSpline *spline,
-                tsStatus *status)
+ts_int_bspline_load_all(const char *path,
+                        tsBSpline **splines,
+                        size_t *num,
+                        tsStatus *status)
 {
+	tsJsonStream stream = ts_json_stream_init();
+	tsBSpline spline = ts_bspline_init();
+	tsBSpline *tmp;
+	size_t cap = 0, i;
+	int done = 0;
 	tsError err;
-	FILE *file = NULL;
-	JSON_Value *value = NULL;
-	ts_int_bspline_init(spline);
+
+	*splines = NULL;
+	*num = 0;
 	TS_TRY(try, err, status)
-		file = fopen(path, "r");
-		if (!file) {
-			TS_THROW_0(try, err, status, TS_IO_ERROR,
-			           "unable to open file")
-		}
-		value = json_parse_file(path);
-		if (!value) {
-			TS_THROW_0(try, err, status, TS_PARSE_ERROR,
-			           "invalid json input")
+		TS_CALL(try, err, ts_int_json_stream_open(
+		        path, &stream, status))
+		for (;;) {
+			TS_CALL(try, err, ts_int_json_stream_next(
+			        &stream, &spline, &done, status))
+			if (done) break;
+			if (*num == cap) {
+				cap = cap == 0 ? 64 : cap * 2;
+				TS_INT_STATS_ALLOC(cap * sizeof(tsBSpline))
+				tmp = (tsBSpline *) realloc(*splines,
+					cap * sizeof(tsBSpline));
+				if (!tmp) {
+					TS_THROW_0(try, err, status, TS_MALLOC,
+					           "out of memory")
+				}
+				*splines = tmp;
+			}
+			ts_bspline_move(&spline, (*splines) + (*num)++);
 		}
-		TS_CALL(try, err, ts_int_bspline_parse_json(
-		        value, spline, status))
-	TS_FINALLY
-		if (file) fclose(file);
-		if (value) json_value_free(value);
 	TS_CATCH(err)
-		ts_bspline_free(spline);
+		ts_bspline_free(&spline);
+		for (i = 0; i < *num; i++)
+			ts_bspline_free((*splines) + i);
+		free(*splines);
+		*splines = NULL;
+		*num = 0;
+	TS_FINALLY
+		ts_json_stream_close(&stream);
 	TS_END_TRY_RETURN(err)
 }
+
+tsError
+ts_bspline_load_all(const char *path,
+                    tsBSpline **splines,
+                    size_t *num,
+                    tsStatus *status)
+{
+	TS_INT_API_SCOPE(ts_bspline_load_all,
+		ts_int_bspline_load_all(path, splines, num, status))
+}
 /*! @} */
 
 
@@ -3372,7 +9403,7 @@ ts_chord_lengths_length_to_knot(const tsReal *knots,
 	   index `idx + 1`. */
 
 	/* Binary search. Similar to how locating a knot within a knot vector
-	   is implemented in ::ts_int_bspline_find_knot. */
+	   is implemented in ::ts_int_view_find_knot. */
 	low = 0;
 	high = num - 1;
 	idx = (low+high) / 2;
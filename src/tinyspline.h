@@ -108,17 +108,30 @@ extern "C" {
 #define TS_PI 3.14159265358979323846
 
 /**
- * The maximum number of knots a spline can have. This constant is strongly
- * related to ::TS_KNOT_EPSILON in that the larger ::TS_MAX_NUM_KNOTS is, the
- * less precise ::TS_KNOT_EPSILON has to be (i.e., knots with greater distance
- * are considered equal). Likewise, the more precise ::TS_KNOT_EPSILON is
- * (i.e., knots with smaller distance are considered equal), the less
- * ::TS_MAX_NUM_KNOTS has to be. By default, the relation between
- * ::TS_MAX_NUM_KNOTS and ::TS_KNOT_EPSILON is as follows:
+ * The maximum number of knots that fit into the default domain
+ * [::TS_DOMAIN_DEFAULT_MIN, ::TS_DOMAIN_DEFAULT_MAX] of newly created splines.
+ * This constant is strongly related to ::TS_KNOT_EPSILON in that the larger
+ * ::TS_MAX_NUM_KNOTS is, the less precise ::TS_KNOT_EPSILON has to be (i.e.,
+ * knots with greater distance are considered equal). Likewise, the more
+ * precise ::TS_KNOT_EPSILON is (i.e., knots with smaller distance are
+ * considered equal), the less ::TS_MAX_NUM_KNOTS has to be. By default, the
+ * relation between ::TS_MAX_NUM_KNOTS and ::TS_KNOT_EPSILON is as follows:
  *
  *     TS_MAX_NUM_KNOTS = 1 / TS_KNOTS_EPSILON
+ *
+ * Despite its name, this constant does not limit the number of knots of a
+ * spline. Newly created splines with more than ::TS_MAX_NUM_KNOTS knots
+ * receive a domain that is enlarged by a multiple of the default domain, such
+ * that distinct knots are at least twice ::TS_KNOT_EPSILON apart (the margin
+ * absorbs rounding errors, which grow with the magnitude of the domain). With
+ * single precision (see \c TINYSPLINE_FLOAT_PRECISION), about two million knots
+ * is the limit for newly created splines. Splines whose knots are set
+ * explicitly (see ::ts_bspline_set_knots) may have any number of knots as
+ * long as their distinct knots are farther apart than ::TS_KNOT_EPSILON.
  */
+#ifndef TS_MAX_NUM_KNOTS
 #define TS_MAX_NUM_KNOTS 10000
+#endif
 
 /**
  * The minimum of the domain of newly created splines. Must be less than
@@ -153,7 +166,9 @@ extern "C" {
  * ::TS_KNOT_EPSILON. This is in particular recommended when ::TS_KNOT_EPSILON
  * and ::TS_MAX_NUM_KNOTS are related to each other as described above.
  */
+#ifndef TS_KNOT_EPSILON
 #define TS_KNOT_EPSILON 1e-4f
+#endif
 
 /**
  * If the distance between two (control) points is less than or equal to this
@@ -467,7 +482,10 @@ typedef enum
 	TS_NO_RESULT = -14,
 
 	/** Unexpected number of points. */
-	TS_NUM_POINTS = -15
+	TS_NUM_POINTS = -15,
+
+	/** Splines differ in degree, dimension, or knot vector. */
+	TS_INCOMPATIBLE = -16
 } tsError;
 
 /**
@@ -679,6 +697,352 @@ typedef struct
 
 
 
+/*! @name Memory Management
+ *
+ * By default, TinySpline allocates memory with \c malloc and releases it with
+ * \c free. The functions of this section allow to replace these functions
+ * with a custom allocator (::tsAllocator), either globally
+ * (::ts_set_allocator) or for the calling thread only
+ * (::ts_set_thread_allocator). The allocator of the calling thread takes
+ * precedence over the global allocator, which, in turn, takes precedence over
+ * the default allocator. Installing an allocator for a thread allows to
+ * scope a batch of operations, for example:
+ *
+ *     tsArena arena;
+ *     const tsAllocator *prev;
+ *     ts_arena_init(&arena, buffer, sizeof(buffer));
+ *     prev = ts_set_thread_allocator(&arena.allocator);
+ *     ... // call TinySpline functions
+ *     ts_set_thread_allocator(prev);
+ *     ts_arena_reset(&arena);
+ *
+ * Custom allocators are used for the internal state of ::tsBSpline and
+ * ::tsDeBoorNet as well as for all temporary buffers of the library. Each
+ * allocated block remembers the allocator it was obtained from so that it is
+ * always released with the correct allocator, even if the active allocator
+ * has been changed in the meantime. Hence, an allocator must remain valid as
+ * long as there are blocks allocated with it. Arrays that are passed to the
+ * caller and need to be released by the caller (e.g., the result of
+ * ::ts_bspline_control_points or ::ts_bspline_sample) are not affected by
+ * custom allocators. They are still allocated with \c malloc and must be
+ * released with \c free.
+ *
+ * @{
+ */
+/**
+ * A pluggable memory allocator.
+ */
+typedef struct
+{
+	/**
+	 * Allocates \p size bytes. Returns NULL if allocating memory failed.
+	 * The returned memory must be suitably aligned for any kind of
+	 * variable. Must not be NULL.
+	 */
+	void *(*allocate)(size_t size,
+	                  void *user_data);
+
+	/**
+	 * Resizes the block \p ptr of size \p old_size to \p size bytes.
+	 * Returns NULL (and keeps \p ptr valid) if allocating memory failed.
+	 * May be NULL, in which case \c allocate, \c memcpy, and \c deallocate
+	 * are used.
+	 */
+	void *(*reallocate)(void *ptr,
+	                    size_t old_size,
+	                    size_t size,
+	                    void *user_data);
+
+	/**
+	 * Releases the block \p ptr of size \p size. Must not be NULL.
+	 */
+	void (*deallocate)(void *ptr,
+	                   size_t size,
+	                   void *user_data);
+
+	/** Passed to the functions of this allocator. May be NULL. */
+	void *user_data;
+} tsAllocator;
+
+/**
+ * A bump allocator (arena) operating on a caller-supplied memory block.
+ * Allocating memory is merely a matter of incrementing an offset, and
+ * releasing memory is a no-op (except for the most recent allocation, which
+ * is rolled back). Once a batch of operations is done, ::ts_arena_reset
+ * makes the entire memory block available again. If the memory block is
+ * exhausted, the arena falls back to \c malloc and \c free and keeps track
+ * of these blocks so that they are released on reset. Thus, an arena never
+ * fails unless the system runs out of memory.
+ *
+ * Arenas are not thread-safe. Use one arena per thread (see
+ * ::ts_set_thread_allocator). Since ::tsArena.allocator refers to the arena
+ * it is part of, an arena must not be copied after initialization.
+ */
+typedef struct
+{
+	/** The memory block of this arena. */
+	unsigned char *memory;
+
+	/** The size of ::memory in bytes. */
+	size_t size;
+
+	/** The number of bytes in use. */
+	size_t used;
+
+	/** The maximum of ::used since the last reset. */
+	size_t peak;
+
+	/**
+	 * The number of allocations that did not fit into ::memory since the
+	 * last reset. Can be used to adjust the size of the memory block.
+	 */
+	size_t num_overflows;
+
+	/** Internal list of the blocks that did not fit into ::memory. */
+	void *overflows;
+
+	/**
+	 * Allocates from this arena. Set up by ::ts_arena_init. Install with
+	 * ::ts_set_allocator or ::ts_set_thread_allocator.
+	 */
+	tsAllocator allocator;
+} tsArena;
+
+/**
+ * Installs \p allocator as global allocator. Pass NULL to restore the default
+ * allocator. This function is not thread-safe. It should be called once
+ * before any other function of TinySpline is called.
+ *
+ * @param[in] allocator
+ * 	The allocator to install. May be NULL.
+ * @return
+ * 	The previously installed global allocator (NULL for the default
+ * 	allocator).
+ */
+const tsAllocator TINYSPLINE_API *
+ts_set_allocator(const tsAllocator *allocator);
+
+/**
+ * Installs \p allocator for the calling thread. Pass NULL to fall back to
+ * the global allocator. If the compiler does not support thread-local
+ * storage, this function affects all threads.
+ *
+ * @param[in] allocator
+ * 	The allocator to install. May be NULL.
+ * @return
+ * 	The previously installed allocator of the calling thread (may be
+ * 	NULL).
+ */
+const tsAllocator TINYSPLINE_API *
+ts_set_thread_allocator(const tsAllocator *allocator);
+
+/**
+ * Returns the allocator that is currently used by the calling thread.
+ *
+ * @return
+ * 	The active allocator. Never NULL.
+ */
+const tsAllocator TINYSPLINE_API *
+ts_active_allocator(void);
+
+/**
+ * Initializes \p arena with the memory block \p memory of size \p size. The
+ * memory block must remain valid as long as \p arena is in use.
+ *
+ * @param[out] arena
+ * 	The arena to initialize.
+ * @param[in] memory
+ * 	The memory block of \p arena. May be NULL if \p size is 0.
+ * @param[in] size
+ * 	The size of \p memory in bytes.
+ */
+void TINYSPLINE_API
+ts_arena_init(tsArena *arena,
+              void *memory,
+              size_t size);
+
+/**
+ * Resets \p arena, i.e., makes the entire memory block of \p arena available
+ * again and releases all blocks that did not fit into the memory block. All
+ * blocks previously allocated from \p arena become invalid and must not be
+ * released anymore (e.g., with ::ts_bspline_free). Use ::ts_bspline_init and
+ * ::ts_deboornet_init to reset instances that refer to such blocks.
+ *
+ * @param[in, out] arena
+ * 	The arena to reset.
+ */
+void TINYSPLINE_API
+ts_arena_reset(tsArena *arena);
+/*! @} */
+
+
+
+/*! @name Statistics
+ *
+ * If TinySpline is built with \c TINYSPLINE_ENABLE_STATS (CMake option of the
+ * same name), the library counts memory allocations and the basic operations
+ * of its algorithms (evaluations, knot searches, and knot insertions). The
+ * counters are attributed to the outermost instrumented API function that is
+ * running when the event occurs. That is, if ::ts_bspline_align calls
+ * ::ts_bspline_elevate_degree, the allocations of the latter are attributed
+ * to ::ts_bspline_align. Events outside of instrumented functions are
+ * attributed to \c "other". The counters are kept per thread, i.e.,
+ * ::ts_stats_get and ::ts_stats_reset only refer to the calling thread. This
+ * requires a compiler with thread-local storage (MSVC, GCC, Clang, and
+ * compatible compilers). With other compilers, all threads share the same
+ * counters, which are not synchronized. In this case, statistics must only be
+ * collected while a single thread is calling TinySpline. Statistics allow to
+ * verify that a hot loop does not allocate memory:
+ *
+ *     ts_stats_reset();
+ *     ... // hot loop
+ *     num = ts_stats_get(stats, 32);
+ *     for (i = 0; i < num && i < 32; i++)
+ *         assert(stats[i].num_allocs == 0);
+ *
+ * Without \c TINYSPLINE_ENABLE_STATS, the functions of this section are
+ * no-ops and the library does not pay for the instrumentation.
+ *
+ * @{
+ */
+/**
+ * The counters of an API function.
+ */
+typedef struct
+{
+	/** Name of the function, e.g., \c "ts_bspline_eval". */
+	const char *function;
+
+	/** Number of (outermost) calls of ::function. */
+	size_t num_calls;
+
+	/**
+	 * Number of memory allocations, including the memory that is passed
+	 * to the caller and memory obtained from a custom allocator (see
+	 * ::tsAllocator). Reallocations are counted as allocations.
+	 */
+	size_t num_allocs;
+
+	/** Number of bytes allocated. */
+	size_t num_bytes;
+
+	/** Number of evaluations with the de Boor algorithm. */
+	size_t num_evals;
+
+	/** Number of searches of the knot span of a knot. */
+	size_t num_knot_searches;
+
+	/** Number of inserted knots. */
+	size_t num_knot_insertions;
+} tsStats;
+
+/**
+ * Returns whether TinySpline has been built with \c TINYSPLINE_ENABLE_STATS.
+ *
+ * @return
+ * 	1 if statistics are enabled, 0 otherwise.
+ */
+int TINYSPLINE_API
+ts_stats_enabled(void);
+
+/**
+ * Copies the counters of the calling thread into \p stats (one element per
+ * function with at least one event since the last call of ::ts_stats_reset).
+ * If \p num is less than the number of functions, only the first \p num
+ * elements are copied.
+ *
+ * @param[out] stats
+ * 	Stores the counters. May be NULL if \p num is 0.
+ * @param[in] num
+ * 	The number of elements \p stats can store.
+ * @return
+ * 	The number of functions with counters (may be greater than \p num).
+ * 	Always 0 if statistics are not enabled.
+ */
+size_t TINYSPLINE_API
+ts_stats_get(tsStats *stats,
+             size_t num);
+
+/**
+ * Resets the counters of the calling thread.
+ */
+void TINYSPLINE_API
+ts_stats_reset(void);
+/*! @} */
+
+
+
+/*! @name Tracing
+ *
+ * If TinySpline is built with \c TINYSPLINE_ENABLE_TRACING (CMake option of
+ * the same name), the library calls the callbacks of the installed tracer
+ * (::tsTracer) when an API function or one of the major phases of a
+ * long-running function (e.g., the degree elevation step of
+ * ::ts_bspline_align) begins and ends. Unlike statistics, nested API calls
+ * are reported as well, so that the callbacks form a properly nested
+ * sequence of begin/end pairs per thread. This allows to attribute the
+ * latency of an operation to its phases, for example, by writing the events
+ * in the Chrome trace-event format (see \c examples/c/chrome_trace.c) and
+ * loading the result into \c chrome://tracing or https://ui.perfetto.dev.
+ *
+ * Without \c TINYSPLINE_ENABLE_TRACING, the hooks are compiled out entirely
+ * and ::ts_set_tracer has no effect.
+ *
+ * @{
+ */
+/**
+ * A pair of user-installable trace callbacks.
+ */
+typedef struct
+{
+	/**
+	 * Called when \p name begins. \p name is either the name of an API
+	 * function (e.g., \c "ts_bspline_align") or the name of a phase,
+	 * which is prefixed with the name of its function (e.g.,
+	 * \c "ts_bspline_align/insert_knots"). The string has static
+	 * storage duration. Must not be NULL.
+	 */
+	void (*begin)(const char *name,
+	              void *user_data);
+
+	/**
+	 * Called when \p name ends (even if it failed). Must not be NULL.
+	 */
+	void (*end)(const char *name,
+	            void *user_data);
+
+	/** Passed to the callbacks of this tracer. May be NULL. */
+	void *user_data;
+} tsTracer;
+
+/**
+ * Returns whether TinySpline has been built with
+ * \c TINYSPLINE_ENABLE_TRACING.
+ *
+ * @return
+ * 	1 if tracing is enabled, 0 otherwise.
+ */
+int TINYSPLINE_API
+ts_tracing_enabled(void);
+
+/**
+ * Installs \p tracer. Pass NULL to uninstall the current tracer. This
+ * function is not thread-safe. The callbacks, however, are called from all
+ * threads that call TinySpline functions and must synchronize themselves if
+ * necessary. \p tracer must remain valid as long as it is installed.
+ *
+ * @param[in] tracer
+ * 	The tracer to install. May be NULL.
+ * @return
+ * 	The previously installed tracer (may be NULL). Always NULL if tracing
+ * 	is not enabled.
+ */
+const tsTracer TINYSPLINE_API *
+ts_set_tracer(const tsTracer *tracer);
+/*! @} */
+
+
+
 /*! @name B-Spline Data
  *
  * The internal state of ::tsBSpline is protected using the PIMPL design
@@ -686,6 +1050,18 @@ typedef struct
  * details). The data of an instance can be accessed with the functions listed
  * in this section.
  *
+ * Thread safety: TinySpline does not have any hidden mutable state. Functions
+ * that receive a spline (or view) as \c const pointer, e.g.,
+ * ::ts_bspline_eval, ::ts_bspline_sample, and ::ts_eval_context_eval, only
+ * read from it and are reentrant. Hence, a spline that is no longer modified
+ * can be shared between any number of threads without synchronization,
+ * provided that each thread writes into objects of its own (output splines,
+ * ::tsDeBoorNet, ::tsEvalContext, result arrays, and so on). A spline that
+ * is passed as non-const pointer must not be accessed by other threads
+ * during the call. The global settings (::ts_set_allocator and
+ * ::ts_set_tracer) are not synchronized and should be configured before
+ * threads are started.
+ *
  * @{
  */
 /**
@@ -1098,7 +1474,12 @@ tsBSpline TINYSPLINE_API
 ts_bspline_init(void);
 
 /**
- * Creates a new spline and stores the result in \p spline.
+ * Creates a new spline and stores the result in \p spline. The domain of
+ * \p spline is [::TS_DOMAIN_DEFAULT_MIN, ::TS_DOMAIN_DEFAULT_MAX], unless
+ * \p spline has more than ::TS_MAX_NUM_KNOTS knots. In this case, the domain
+ * is enlarged by a multiple of (::TS_DOMAIN_DEFAULT_MAX -
+ * ::TS_DOMAIN_DEFAULT_MIN) such that distinct knots are at least twice
+ * ::TS_KNOT_EPSILON apart (see ::TS_MAX_NUM_KNOTS).
  *
  * @param[in] num_control_points
  * 	The number of control points of \p spline.
@@ -1121,6 +1502,12 @@ ts_bspline_init(void);
  * @return TS_NUM_KNOTS
  * 	If \p type is ::TS_BEZIERS and
  * 	(\p num_control_points % \p degree + 1) != 0.
+ * @return TS_NUM_KNOTS
+ * 	If the size of \p spline (in bytes) is not representable by \c
+ * 	size_t.
+ * @return TS_NUM_KNOTS
+ * 	If the distinct knots of \p spline cannot be kept apart with the
+ * 	precision of ::tsReal.
  * @return TS_MALLOC
  * 	If allocating memory failed.
  */
@@ -1816,6 +2203,85 @@ ts_bspline_sample(const tsBSpline *spline,
                   size_t *actual_num,
                   tsStatus *status);
 
+/**
+ * Callback used to grow caller-supplied output buffers. The contract is the
+ * same as the one of \c realloc: \p buffer (which may be NULL) is resized to
+ * \p size bytes and the (possibly moved) buffer is returned. If growing
+ * failed, NULL must be returned and \p buffer must remain valid.
+ *
+ * @param[in] buffer
+ * 	The buffer to grow. May be NULL.
+ * @param[in] size
+ * 	The requested size of the buffer in bytes.
+ * @param[in] user_data
+ * 	The user data passed to the function using this callback.
+ * @return
+ * 	The grown buffer or NULL if growing failed.
+ */
+typedef void *(*tsGrowFunc)(void *buffer,
+                            size_t size,
+                            void *user_data);
+
+/**
+ * Approximates \p spline with a polyline whose maximum deviation from \p
+ * spline is less than or equal to \p tolerance. In contrast to
+ * ::ts_bspline_sample, the vertices of the polyline are not distributed
+ * uniformly. Instead, \p spline is decomposed into a sequence of Bezier
+ * curves (see ::ts_bspline_to_beziers) and each Bezier curve is subdivided
+ * recursively at its midpoint until its control polygon is flat, i.e., until
+ * the distance between each control point and the line segment connecting
+ * the first and last control point (the chord) is less than or equal to \p
+ * tolerance. Because a Bezier curve lies within the convex hull of its control
+ * points, the distance between each point of the curve and the chord is
+ * bounded by \p tolerance. Thus, straight sections are approximated with only
+ * a few vertices, whereas sections with high curvature are approximated with
+ * many.
+ *
+ * The vertices are written to the caller-supplied buffer \p points, which
+ * provides storage for \p capacity points (each consisting of
+ * ::ts_bspline_dimension values). If the buffer is too small, it is grown
+ * with \p grow. If \p grow is NULL, \c realloc is used, i.e., \p points must
+ * then be NULL or allocated with \c malloc. After calling this function, \p
+ * points and \p capacity reflect the (possibly grown) buffer, even if an
+ * error occurred. That is, the caller is responsible for releasing \p points
+ * in any case.
+ *
+ * If \p tolerance is less than ::TS_POINT_EPSILON, ::TS_POINT_EPSILON is used
+ * instead. In order to prevent infinite subdivision in the presence of
+ * floating point errors, the subdivision depth of each Bezier curve is
+ * limited to 24.
+ *
+ * @param[in] spline
+ * 	The spline to tessellate.
+ * @param[in] tolerance
+ * 	The maximum deviation of the polyline from \p spline.
+ * @param[in, out] points
+ * 	The output buffer. May point to NULL if \p capacity is 0.
+ * @param[in, out] capacity
+ * 	The number of points \p points can store.
+ * @param[out] num_points
+ * 	The number of points written to \p points.
+ * @param[in] grow
+ * 	Used to grow \p points. May be NULL (\c realloc).
+ * @param[in] user_data
+ * 	Passed to \p grow. May be NULL.
+ * @param[out] status
+ * 	The status of this function. May be NULL.
+ * @return TS_SUCCESS
+ * 	On success.
+ * @return TS_MALLOC
+ * 	If allocating memory failed or if \p grow returned NULL.
+ */
+tsError TINYSPLINE_API
+ts_bspline_tessellate(const tsBSpline *spline,
+                      tsReal tolerance,
+                      tsReal **points,
+                      size_t *capacity,
+                      size_t *num_points,
+                      tsGrowFunc grow,
+                      void *user_data,
+                      tsStatus *status);
+
 /**
  * Tries to find a point P on \p spline such that:
  *
@@ -2423,6 +2889,81 @@ ts_bspline_elevate_degree(const tsBSpline *spline,
                           tsBSpline *elevated,
                           tsStatus *status);
 
+/**
+ * Elevates the degree of \p spline by \p amount without decomposing \p
+ * spline into a sequence of bezier curves first (in contrast to
+ * ::ts_bspline_elevate_degree). Instead, each bezier segment is extracted,
+ * elevated, and merged into the result right away (algorithm A5.9 of 'The
+ * NURBS Book' by Les Piegl and Wayne Tiller). Thus, the memory required is
+ * proportional to the size of the result. The result is minimal: the
+ * multiplicity of each interior knot is increased by \p amount, so the
+ * continuity of \p spline is retained. Note that ::ts_bspline_elevate_degree,
+ * on the other hand, yields a spline that is C0-continuous at every interior
+ * knot. If \p spline is not clamped, it is clamped first.
+ *
+ * @param[in] spline
+ * 	The spline to elevate.
+ * @param[in] amount
+ * 	How often to elevate the degree of \p spline.
+ * @param[out] elevated
+ * 	The elevated spline.
+ * @param[out] status
+ * 	The status of this function. May be NULL.
+ * @return TS_SUCCESS
+ * 	On success.
+ * @return TS_MALLOC
+ * 	If memory allocation failed.
+ */
+tsError TINYSPLINE_API
+ts_bspline_elevate_degree_direct(const tsBSpline *spline,
+                                 size_t amount,
+                                 tsBSpline *elevated,
+                                 tsStatus *status);
+
+/**
+ * Reduces the degree of \p spline by \p amount. Unlike degree elevation,
+ * degree reduction is, in general, not exact. First, \p spline is decomposed
+ * into a sequence of bezier curves, each of which is reduced one degree at a
+ * time (equations 5.41 to 5.45 of 'The NURBS Book' by Les Piegl and Wayne
+ * Tiller). Afterwards, the interior knots are removed as often as the
+ * remaining tolerance of the affected bezier segments allows (algorithm A5.8
+ * of 'The NURBS Book'), which restores the continuity of the result as far as
+ * possible. The error reported in \p error is an upper bound of the distance
+ * between \p spline and \p reduced at any knot of the domain. If \p spline is
+ * not clamped, it is clamped first.
+ *
+ * @param[in] spline
+ * 	The spline to reduce.
+ * @param[in] amount
+ * 	How often to reduce the degree of \p spline. Must not be greater than
+ * 	the degree of \p spline.
+ * @param[in] tolerance
+ * 	The maximum permitted error. Note that knots can be removed exactly only
+ * 	up to floating point precision. A viable value for exact reductions
+ * 	(e.g., undoing ::ts_bspline_elevate_degree) is ::TS_POINT_EPSILON.
+ * @param[out] reduced
+ * 	The reduced spline.
+ * @param[out] error
+ * 	The error bound of \p reduced. If the error of the bezier segments
+ * 	exceeds \p tolerance, it is set to this error (and ::TS_NO_RESULT is
+ * 	returned). May be NULL.
+ * @param[out] status
+ * 	The status of this function. May be NULL.
+ * @return TS_SUCCESS
+ * 	On success.
+ * @return TS_NO_RESULT
+ * 	If \p amount > degree of \p spline or if the error exceeds \p tolerance.
+ * @return TS_MALLOC
+ * 	If memory allocation failed.
+ */
+tsError TINYSPLINE_API
+ts_bspline_reduce_degree(const tsBSpline *spline,
+                         size_t amount,
+                         tsReal tolerance,
+                         tsBSpline *reduced,
+                         tsReal *error,
+                         tsStatus *status);
+
 /**
  * Modifies the splines \p s1 and \p s2 such that they have same the degree and
  * number of control points/knots (without modifying the shape of \p s1 and \p
@@ -2480,7 +3021,8 @@ ts_bspline_align(const tsBSpline *s1,
  *
  * It should be noted that this function, if necessary, aligns \p origin and \p
  * target using ::ts_bspline_align. In order to avoid the overhead of spline
- * alignment, \p origin and \p target should be aligned in advance.
+ * alignment, \p origin and \p target should be aligned in advance. Use a
+ * ::tsMorphism if the same splines are morphed repeatedly.
  *
  * @param[in] origin
  * 	Origin spline.
@@ -2517,10 +3059,39 @@ ts_bspline_morph(const tsBSpline *origin,
  *
  * The following functions can be used to serialize and persist (i.e., store
  * the serialized data in a file) splines. There are also functions to load
- * serialized splines.
+ * serialized splines. Splines can be serialized as JSON (human-readable) or in
+ * a compact binary format (see ::ts_bspline_to_binary).
  *
  * @{
  */
+/**
+ * The magic number (first four bytes) of binary splines.
+ */
+#define TS_BINARY_MAGIC "TSBS"
+
+/**
+ * The current version of the binary format.
+ */
+#define TS_BINARY_VERSION 1
+
+/**
+ * The size (in bytes) of the header of binary splines. The control points
+ * start right after the header and are therefore 8-byte aligned (relative to
+ * the beginning of the header).
+ */
+#define TS_BINARY_HEADER_SIZE 40
+
+/**
+ * The magic number (first four bytes) of quantized splines (see
+ * ::ts_bspline_to_quantized).
+ */
+#define TS_QUANTIZED_MAGIC "TSBQ"
+
+/**
+ * The current version of the quantized format.
+ */
+#define TS_QUANTIZED_VERSION 1
+
 /**
  * Serializes \p spline to a null-terminated JSON string and stores the result
  * in \p json.
@@ -2632,6 +3203,1809 @@ ts_bspline_load(const char *path,
                 tsBSpline *spline,
                 tsStatus *status);
 
+/**
+ * Serializes \p spline to the binary format of TinySpline and stores the
+ * result in \p data. The binary format is much more compact than JSON and can
+ * be read and written at memory bandwidth. All values are stored in little
+ * endian byte order. A file consists of a header of ::TS_BINARY_HEADER_SIZE
+ * bytes followed by the control points and knots of the spline:
+ *
+ *     Offset  Size  Description
+ *          0     4  Magic number "TSBS"
+ *          4     1  Format version (::TS_BINARY_VERSION)
+ *          5     1  Size of a real value in bytes (4 = float, 8 = double)
+ *          6     2  Reserved (0)
+ *          8     8  Degree (unsigned)
+ *         16     8  Dimension (unsigned)
+ *         24     8  Number of control points (unsigned)
+ *         32     8  Number of knots (unsigned)
+ *         40     -  Control points, then knots (IEEE 754)
+ *
+ * The size of a real value corresponds to ::tsReal when writing. Files with a
+ * different precision can be read nonetheless (values are converted).
+ *
+ * @param[in] spline
+ * 	The spline to be serialized.
+ * @param[out] data
+ * 	The serialized spline. Must be released with \c free.
+ * @param[out] size
+ * 	The number of bytes of \p data.
+ * @param[out] status
+ * 	The status of this function. May be NULL.
+ * @return TS_SUCCESS
+ * 	On success.
+ * @return TS_MALLOC
+ * 	If allocating memory failed.
+ */
+tsError TINYSPLINE_API
+ts_bspline_to_binary(const tsBSpline *spline,
+                     unsigned char **data,
+                     size_t *size,
+                     tsStatus *status);
+
+/**
+ * Deserializes the binary spline \p data (see ::ts_bspline_to_binary) and
+ * stores the result in \p spline.
+ *
+ * @param[in] data
+ * 	The binary data to be deserialized.
+ * @param[in] size
+ * 	The number of bytes of \p data.
+ * @param[out] spline
+ * 	The output spline.
+ * @param[out] status
+ * 	The status of this function. May be NULL.
+ * @return TS_SUCCESS
+ * 	On success.
+ * @return TS_PARSE_ERROR
+ * 	If \p data is not a binary spline of a supported version, or if \p
+ * 	size does not match to the size given in the header of \p data.
+ * @return TS_DIM_ZERO
+ * 	If the dimension is \c 0.
+ * @return TS_DEG_GE_NCTRLP
+ * 	If the degree is greater or equals to the number of control points.
+ * @return TS_NUM_KNOTS
+ * 	If the number of knots does not match to the number of control points
+ * 	plus the degree of the spline.
+ * @return TS_KNOTS_DECR
+ * 	If the knot vector is decreasing.
+ * @return TS_MULTIPLICITY
+ * 	If there is a knot with multiplicity greater than order.
+ * @return TS_MALLOC
+ * 	If allocating memory failed.
+ */
+tsError TINYSPLINE_API
+ts_bspline_from_binary(const unsigned char *data,
+                       size_t size,
+                       tsBSpline *spline,
+                       tsStatus *status);
+
+/**
+ * Saves \p spline as binary file (see ::ts_bspline_to_binary). Unlike
+ * ::ts_bspline_to_binary, this function does not need to buffer the
+ * serialized spline.
+ *
+ * @param[in] spline
+ * 	The spline to be saved.
+ * @param[in] path
+ * 	Path of the binary file.
+ * @param[out] status
+ * 	The status of this function. May be NULL.
+ * @return TS_SUCCESS
+ * 	On success.
+ * @return TS_IO_ERROR
+ * 	If an error occurred while saving \p spline.
+ */
+tsError TINYSPLINE_API
+ts_bspline_save_binary(const tsBSpline *spline,
+                       const char *path,
+                       tsStatus *status);
+
+/**
+ * Loads \p spline from a binary file (see ::ts_bspline_to_binary). The
+ * control points and knots are read directly into \p spline.
+ *
+ * @param[in] path
+ * 	Path of the binary file to be loaded.
+ * @param[out] spline
+ * 	The output spline.
+ * @param[out] status
+ * 	The status of this function. May be NULL.
+ * @return TS_SUCCESS
+ * 	On success.
+ * @return TS_IO_ERROR
+ * 	If \p path does not exist or could not be read.
+ * @return TS_PARSE_ERROR
+ * 	If \p path is not a binary spline of a supported version, or if the
+ * 	size of \p path does not match its header.
+ * @return TS_DIM_ZERO
+ * 	If the dimension is \c 0.
+ * @return TS_DEG_GE_NCTRLP
+ * 	If the degree is greater or equals to the number of control points.
+ * @return TS_NUM_KNOTS
+ * 	If the number of knots does not match to the number of control points
+ * 	plus the degree of the spline.
+ * @return TS_KNOTS_DECR
+ * 	If the knot vector is decreasing.
+ * @return TS_MULTIPLICITY
+ * 	If there is a knot with multiplicity greater than order.
+ * @return TS_MALLOC
+ * 	If allocating memory failed.
+ */
+tsError TINYSPLINE_API
+ts_bspline_load_binary(const char *path,
+                       tsBSpline *spline,
+                       tsStatus *status);
+
+/**
+ * Serializes \p spline to the quantized (lossy) variant of the binary format
+ * and stores the result in \p data. Each coordinate of the control points is
+ * mapped to a \p bits wide unsigned integer relative to the bounding box of
+ * the control points. The knots are mapped to integers relative to the domain
+ * of \p spline, and only the differences between consecutive knots are
+ * stored (as variable-length integers). With 16 bits, the serialized spline
+ * is about a quarter of the size of ::ts_bspline_to_binary (with double
+ * precision). The bounds of the bounding box and of the domain are stored
+ * exactly. The header is the same as the one of ::ts_bspline_to_binary except
+ * for the magic number (::TS_QUANTIZED_MAGIC), the version
+ * (::TS_QUANTIZED_VERSION), and byte 5, which contains \p bits:
+ *
+ *     Offset  Size  Description
+ *          0    40  Header (see ::ts_bspline_to_binary)
+ *         40  16*d  Minimum and maximum of each dimension (double)
+ *    40+16*d    16  First and last knot (double)
+ *    56+16*d     -  Control points (bits / 8 bytes per coordinate), then
+ *                   knot differences (unsigned LEB128)
+ *
+ * Quantized splines are read with ::ts_bspline_from_binary and
+ * ::ts_bspline_load_binary. They can also be decoded into a user supplied
+ * buffer and evaluated from there (see ::ts_bspline_dequantize).
+ *
+ * @param[in] spline
+ * 	The spline to be serialized.
+ * @param[in] bits
+ * 	The number of bits per coordinate (8, 16, or 32).
+ * @param[out] data
+ * 	The serialized spline. Must be released with \c free.
+ * @param[out] size
+ * 	The number of bytes of \p data.
+ * @param[out] max_error
+ * 	The maximum absolute difference between a coordinate (or knot) of
+ * 	\p spline and its dequantized value. May be NULL.
+ * @param[out] status
+ * 	The status of this function. May be NULL.
+ * @return TS_SUCCESS
+ * 	On success.
+ * @return TS_INDEX_ERROR
+ * 	If \p bits is not 8, 16, or 32.
+ * @return TS_MULTIPLICITY
+ * 	If \p bits is too small to keep distinct knots apart (i.e., if the
+ * 	quantized knot vector contains a knot whose multiplicity is greater
+ * 	than the order of \p spline).
+ * @return TS_MALLOC
+ * 	If allocating memory failed.
+ */
+tsError TINYSPLINE_API
+ts_bspline_to_quantized(const tsBSpline *spline,
+                        size_t bits,
+                        unsigned char **data,
+                        size_t *size,
+                        tsReal *max_error,
+                        tsStatus *status);
+
+/**
+ * Saves \p spline as quantized binary file (see ::ts_bspline_to_quantized).
+ *
+ * @param[in] spline
+ * 	The spline to be saved.
+ * @param[in] bits
+ * 	The number of bits per coordinate (8, 16, or 32).
+ * @param[in] path
+ * 	Path of the binary file.
+ * @param[out] max_error
+ * 	See ::ts_bspline_to_quantized. May be NULL.
+ * @param[out] status
+ * 	The status of this function. May be NULL.
+ * @return TS_SUCCESS
+ * 	On success.
+ * @return TS_INDEX_ERROR
+ * 	If \p bits is not 8, 16, or 32.
+ * @return TS_MULTIPLICITY
+ * 	If \p bits is too small to keep distinct knots apart.
+ * @return TS_IO_ERROR
+ * 	If an error occurred while saving \p spline.
+ * @return TS_MALLOC
+ * 	If allocating memory failed.
+ */
+tsError TINYSPLINE_API
+ts_bspline_save_quantized(const tsBSpline *spline,
+                          size_t bits,
+                          const char *path,
+                          tsReal *max_error,
+                          tsStatus *status);
+
+/**
+ * Returns the number of ::tsReal values that are required to decode the
+ * quantized spline \p data with ::ts_bspline_dequantize, that is, the number
+ * of control point coordinates plus the number of knots.
+ *
+ * @param[in] data
+ * 	The quantized spline (see ::ts_bspline_to_quantized).
+ * @param[in] size
+ * 	The number of bytes of \p data.
+ * @param[out] len
+ * 	The required length.
+ * @param[out] status
+ * 	The status of this function. May be NULL.
+ * @return TS_SUCCESS
+ * 	On success.
+ * @return TS_PARSE_ERROR
+ * 	If \p data is not a quantized spline of a supported version, or if
+ * 	\p size is too small.
+ * @return TS_DIM_ZERO
+ * 	If the dimension is \c 0.
+ * @return TS_DEG_GE_NCTRLP
+ * 	If the degree is greater or equals to the number of control points.
+ * @return TS_NUM_KNOTS
+ * 	If the number of knots does not match to the number of control points
+ * 	plus the degree of the spline.
+ */
+tsError TINYSPLINE_API
+ts_bspline_dequantized_len(const unsigned char *data,
+                           size_t size,
+                           size_t *len,
+                           tsStatus *status);
+/*! @} */
+
+
+
+/*! @name B-Spline Views
+ *
+ * A ::tsBSplineView is a non-owning, read-only reference to the control
+ * points and knots of a spline that are stored in external memory (e.g., in
+ * large pre-allocated or memory-mapped arrays). Views are plain structs that
+ * do not need to be released. The referenced memory must remain valid as long
+ * as a view is in use. Control points and knots are accessed with a stride
+ * (given in number of ::tsReal values), which allows views to refer to
+ * interleaved data.
+ *
+ * All query functions of this section behave exactly like their ::tsBSpline
+ * counterparts. In fact, the latter are implemented by creating a view of the
+ * given spline (see ::ts_bspline_as_view).
+ *
+ * @{
+ */
+/**
+ * A non-owning, read-only view of a spline. The number of knots is implied by
+ * \c num_control_points + \c degree + 1. The knot vector is assumed to be
+ * valid, i.e., non-decreasing and without knots whose multiplicity is greater
+ * than the order of the spline. Use ::ts_bspline_view_init to set up a view.
+ */
+typedef struct
+{
+	/** Degree of the spline. */
+	size_t degree;
+
+	/** Dimensionality of the control points. */
+	size_t dimension;
+
+	/** Number of control points. */
+	size_t num_control_points;
+
+	/** First component of the first control point. */
+	const tsReal *control_points;
+
+	/**
+	 * Distance between the first components of two consecutive control
+	 * points (in number of ::tsReal values). Must be greater than or equal
+	 * to \c dimension.
+	 */
+	size_t control_point_stride;
+
+	/** First knot. */
+	const tsReal *knots;
+
+	/**
+	 * Distance between two consecutive knots (in number of ::tsReal
+	 * values). Must be greater than \c 0.
+	 */
+	size_t knot_stride;
+} tsBSplineView;
+
+/**
+ * Sets up \p view to refer to the control points \p control_points and the
+ * knots \p knots. The knots are not validated.
+ *
+ * @param[in] num_control_points
+ * 	The number of control points of the spline.
+ * @param[in] dimension
+ * 	The dimensionality of the control points.
+ * @param[in] degree
+ * 	The degree of the spline.
+ * @param[in] control_points
+ * 	The control points of the spline.
+ * @param[in] control_point_stride
+ * 	The stride of \p control_points. If \c 0, \p dimension is used.
+ * @param[in] knots
+ * 	The knots of the spline (\p num_control_points + \p degree + 1).
+ * @param[in] knot_stride
+ * 	The stride of \p knots. If \c 0, \c 1 is used.
+ * @param[out] view
+ * 	The output parameter.
+ * @param[out] status
+ * 	The status of this function. May be NULL.
+ * @return TS_SUCCESS
+ * 	On success.
+ * @return TS_DIM_ZERO
+ * 	If \p dimension is 0.
+ * @return TS_LCTRLP_DIM_MISMATCH
+ * 	If \p control_point_stride is not 0 and less than \p dimension.
+ * @return TS_DEG_GE_NCTRLP
+ * 	If \p degree >= \p num_control_points.
+ */
+tsError TINYSPLINE_API
+ts_bspline_view_init(size_t num_control_points,
+                     size_t dimension,
+                     size_t degree,
+                     const tsReal *control_points,
+                     size_t control_point_stride,
+                     const tsReal *knots,
+                     size_t knot_stride,
+                     tsBSplineView *view,
+                     tsStatus *status);
+
+/**
+ * Sets up \p view to refer to the control points and knots of \p spline. The
+ * view becomes invalid as soon as \p spline is modified or released.
+ *
+ * @param[in] spline
+ * 	The spline to create a view of.
+ * @param[out] view
+ * 	The output parameter.
+ */
+void TINYSPLINE_API
+ts_bspline_as_view(const tsBSpline *spline,
+                   tsBSplineView *view);
+
+/**
+ * Copies the spline referenced by \p view into the newly created spline \p
+ * spline. In contrast to ::ts_bspline_view_init, the knots are validated.
+ *
+ * @param[in] view
+ * 	The view to copy.
+ * @param[out] spline
+ * 	The output spline.
+ * @param[out] status
+ * 	The status of this function. May be NULL.
+ * @return TS_SUCCESS
+ * 	On success.
+ * @return TS_KNOTS_DECR
+ * 	If the knot vector is decreasing.
+ * @return TS_MULTIPLICITY
+ * 	If there is a knot with multiplicity > order.
+ * @return TS_MALLOC
+ * 	If allocating memory failed.
+ */
+tsError TINYSPLINE_API
+ts_bspline_view_to_bspline(const tsBSplineView *view,
+                           tsBSpline *spline,
+                           tsStatus *status);
+
+/**
+ * See ::ts_bspline_domain.
+ */
+void TINYSPLINE_API
+ts_bspline_view_domain(const tsBSplineView *view,
+                       tsReal *min,
+                       tsReal *max);
+
+/**
+ * See ::ts_bspline_eval.
+ */
+tsError TINYSPLINE_API
+ts_bspline_view_eval(const tsBSplineView *view,
+                     tsReal knot,
+                     tsDeBoorNet *net,
+                     tsStatus *status);
+
+/**
+ * See ::ts_bspline_eval_all.
+ */
+tsError TINYSPLINE_API
+ts_bspline_view_eval_all(const tsBSplineView *view,
+                         const tsReal *knots,
+                         size_t num,
+                         tsReal **points,
+                         tsStatus *status);
+
+/**
+ * See ::ts_bspline_sample.
+ */
+tsError TINYSPLINE_API
+ts_bspline_view_sample(const tsBSplineView *view,
+                       size_t num,
+                       tsReal **points,
+                       size_t *actual_num,
+                       tsStatus *status);
+
+/**
+ * See ::ts_bspline_bisect.
+ */
+tsError TINYSPLINE_API
+ts_bspline_view_bisect(const tsBSplineView *view,
+                       tsReal value,
+                       tsReal epsilon,
+                       int persnickety,
+                       size_t index,
+                       int ascending,
+                       size_t max_iter,
+                       tsDeBoorNet *net,
+                       tsStatus *status);
+
+/**
+ * See ::ts_bspline_chord_lengths.
+ */
+tsError TINYSPLINE_API
+ts_bspline_view_chord_lengths(const tsBSplineView *view,
+                              const tsReal *knots,
+                              size_t num,
+                              tsReal *lengths,
+                              tsStatus *status);
+
+/**
+ * See ::ts_bspline_to_json.
+ */
+tsError TINYSPLINE_API
+ts_bspline_view_to_json(const tsBSplineView *view,
+                        char **json,
+                        tsStatus *status);
+
+/**
+ * See ::ts_bspline_save.
+ */
+tsError TINYSPLINE_API
+ts_bspline_view_save(const tsBSplineView *view,
+                     const char *path,
+                     tsStatus *status);
+
+/**
+ * See ::ts_bspline_to_binary.
+ */
+tsError TINYSPLINE_API
+ts_bspline_view_to_binary(const tsBSplineView *view,
+                          unsigned char **data,
+                          size_t *size,
+                          tsStatus *status);
+
+/**
+ * See ::ts_bspline_save_binary.
+ */
+tsError TINYSPLINE_API
+ts_bspline_view_save_binary(const tsBSplineView *view,
+                            const char *path,
+                            tsStatus *status);
+
+/**
+ * See ::ts_bspline_to_quantized.
+ */
+tsError TINYSPLINE_API
+ts_bspline_view_to_quantized(const tsBSplineView *view,
+                             size_t bits,
+                             unsigned char **data,
+                             size_t *size,
+                             tsReal *max_error,
+                             tsStatus *status);
+
+/**
+ * See ::ts_bspline_save_quantized.
+ */
+tsError TINYSPLINE_API
+ts_bspline_view_save_quantized(const tsBSplineView *view,
+                               size_t bits,
+                               const char *path,
+                               tsReal *max_error,
+                               tsStatus *status);
+
+/**
+ * Decodes the quantized spline \p data (see ::ts_bspline_to_quantized) into
+ * \p buffer and sets up \p view to refer to it. The control points
+ * (interleaved) are stored first, followed by the knots. Since no spline is
+ * allocated, a single buffer can be reused for decoding any number of
+ * quantized splines, which can then be evaluated with the functions of this
+ * section. The knot vector is not validated (see ::tsBSplineView).
+ *
+ * @param[in] data
+ * 	The quantized spline.
+ * @param[in] size
+ * 	The number of bytes of \p data.
+ * @param[out] buffer
+ * 	The decoded control points and knots.
+ * @param[in] len
+ * 	The number of ::tsReal values of \p buffer. Must be at least the
+ * 	value returned by ::ts_bspline_dequantized_len.
+ * @param[out] view
+ * 	The view of \p buffer.
+ * @param[out] status
+ * 	The status of this function. May be NULL.
+ * @return TS_SUCCESS
+ * 	On success.
+ * @return TS_INDEX_ERROR
+ * 	If \p len is too small.
+ * @return TS_PARSE_ERROR
+ * 	If \p data is not a quantized spline of a supported version, or if
+ * 	\p size does not match to the header of \p data.
+ * @return TS_DIM_ZERO
+ * 	If the dimension is \c 0.
+ * @return TS_DEG_GE_NCTRLP
+ * 	If the degree is greater or equals to the number of control points.
+ * @return TS_NUM_KNOTS
+ * 	If the number of knots does not match to the number of control points
+ * 	plus the degree of the spline.
+ * @return TS_MALLOC
+ * 	If allocating memory failed.
+ */
+tsError TINYSPLINE_API
+ts_bspline_dequantize(const unsigned char *data,
+                      size_t size,
+                      tsReal *buffer,
+                      size_t len,
+                      tsBSplineView *view,
+                      tsStatus *status);
+/*! @} */
+
+
+
+/*! @name Evaluation Context
+ *
+ * ::ts_bspline_eval allocates a new ::tsDeBoorNet on every call. Applications
+ * that evaluate splines at a high rate (for example, once per mouse move and
+ * curve) may instead create a ::tsEvalContext once and reuse it for any
+ * number of evaluations. A context owns a net that is large enough for
+ * splines up to a certain degree and dimensionality. It also remembers the
+ * knot span of the last evaluation, so that coherent queries (knots that are
+ * close to each other) do not need to search the knot vector again.
+ *
+ * A context can be used with different splines and views. If a spline
+ * exceeds the capacity of a context, the net of the context is enlarged
+ * (which is the only case in which an evaluation allocates memory). A context
+ * must not be shared between threads. Instead, create one context per thread
+ * and share the (read-only) spline.
+ *
+ * @{
+ */
+/**
+ * Reusable workspace for repeated evaluations.
+ */
+typedef struct
+{
+	struct tsEvalContextImpl *pImpl; /**< The actual implementation. */
+} tsEvalContext;
+
+/**
+ * Creates a new context whose data points to NULL.
+ *
+ * @return
+ * 	A new context whose data points to NULL.
+ */
+tsEvalContext TINYSPLINE_API
+ts_eval_context_init(void);
+
+/**
+ * Creates a new context that is able to evaluate splines of degree <= \p
+ * max_degree and dimensionality <= \p max_dimension without allocating
+ * memory.
+ *
+ * @param[in] max_degree
+ * 	The maximum degree of the splines to be evaluated.
+ * @param[in] max_dimension
+ * 	The maximum dimensionality of the splines to be evaluated.
+ * @param[out] ctx
+ * 	The output context.
+ * @param[out] status
+ * 	The status of this function. May be NULL.
+ * @return TS_SUCCESS
+ * 	On success.
+ * @return TS_DIM_ZERO
+ * 	If \p max_dimension is 0.
+ * @return TS_MALLOC
+ * 	If allocating memory failed.
+ */
+tsError TINYSPLINE_API
+ts_eval_context_new(size_t max_degree,
+                    size_t max_dimension,
+                    tsEvalContext *ctx,
+                    tsStatus *status);
+
+/**
+ * Releases the data of \p ctx. After calling this function, the data of \p
+ * ctx points to NULL.
+ *
+ * @param[out] ctx
+ * 	The context to be released.
+ */
+void TINYSPLINE_API
+ts_eval_context_free(tsEvalContext *ctx);
+
+/**
+ * Evaluates \p spline at \p knot using the net of \p ctx and stores the
+ * result in \p point (which must be able to hold
+ * ts_bspline_dimension(\p spline) values). The entire net of the evaluation
+ * is available via ::ts_eval_context_net until the next evaluation. If \p ctx
+ * has been initialized with ::ts_eval_context_init only, its net is created on
+ * demand.
+ *
+ * @param[in, out] ctx
+ * 	The context to use.
+ * @param[in] spline
+ * 	The spline to evaluate.
+ * @param[in] knot
+ * 	The knot to evaluate \p spline at.
+ * @param[out] point
+ * 	Stores the result of the evaluation. May be NULL.
+ * @param[out] status
+ * 	The status of this function. May be NULL.
+ * @return TS_SUCCESS
+ * 	On success.
+ * @return TS_U_UNDEFINED
+ * 	If \p spline is not defined at \p knot.
+ * @return TS_MALLOC
+ * 	If enlarging the net of \p ctx failed.
+ */
+tsError TINYSPLINE_API
+ts_eval_context_eval(tsEvalContext *ctx,
+                     const tsBSpline *spline,
+                     tsReal knot,
+                     tsReal *point,
+                     tsStatus *status);
+
+/**
+ * See ::ts_eval_context_eval.
+ */
+tsError TINYSPLINE_API
+ts_eval_context_view_eval(tsEvalContext *ctx,
+                          const tsBSplineView *view,
+                          tsReal knot,
+                          tsReal *point,
+                          tsStatus *status);
+
+/**
+ * Returns the net of the last successful evaluation of \p ctx. The net is
+ * owned by \p ctx and must not be released. Its content is undefined if \p
+ * ctx has not been used for evaluation yet.
+ *
+ * @param[in] ctx
+ * 	The context whose net is returned.
+ * @return
+ * 	The net of \p ctx or NULL if the data of \p ctx points to NULL.
+ */
+const tsDeBoorNet TINYSPLINE_API *
+ts_eval_context_net(const tsEvalContext *ctx);
+/*! @} */
+
+
+
+/*! @name B-Spline Sets
+ *
+ * A ::tsBSplineSet stores a set of splines that have the same degree,
+ * dimensionality, and knot vector (for example, the result of
+ * ::ts_bspline_align). The knot vector is stored only once and the control
+ * points of all members are stored in structure-of-arrays layout
+ * (coordinate-major, member-minor). That is, component \c d of control
+ * point \c i of member \c m is located at:
+ *
+ *     control_points[(i * dimension + d) * num_splines + m]
+ *
+ * Since all members share the same knot vector, evaluating the set at a
+ * knot requires only one knot search and one set of basis functions. The
+ * points of all members are then computed with a sweep over contiguous
+ * memory, which compilers are able to vectorize. The points are returned in
+ * the same layout (component \c d of member \c m is stored at
+ * <tt>points[d * num_splines + m]</tt>).
+ *
+ * A set is not modified by ::ts_bsplineset_eval and, thus, can be evaluated
+ * from multiple threads concurrently.
+ *
+ * @{
+ */
+/**
+ * A set of splines with the same degree, dimensionality, and knot vector.
+ */
+typedef struct
+{
+	struct tsBSplineSetImpl *pImpl; /**< The actual implementation. */
+} tsBSplineSet;
+
+/**
+ * Creates a new set whose data points to NULL.
+ *
+ * @return
+ * 	A new set whose data points to NULL.
+ */
+tsBSplineSet TINYSPLINE_API
+ts_bsplineset_init(void);
+
+/**
+ * Creates a new set from the \p num splines \p splines. The knot vectors of
+ * the splines are compared with ::ts_knots_equal. The knots of the first
+ * spline are used for the set.
+ *
+ * @param[in] splines
+ * 	The members of the set.
+ * @param[in] num
+ * 	The number of splines.
+ * @param[out] set
+ * 	The output parameter.
+ * @param[out] status
+ * 	The status of this function. May be NULL.
+ * @return TS_SUCCESS
+ * 	On success.
+ * @return TS_NUM_POINTS
+ * 	If \p num is 0.
+ * @return TS_INCOMPATIBLE
+ * 	If the splines differ in degree, dimensionality, number of control
+ * 	points, or knots.
+ * @return TS_MALLOC
+ * 	If allocating memory failed.
+ */
+tsError TINYSPLINE_API
+ts_bsplineset_new(const tsBSpline *splines,
+                  size_t num,
+                  tsBSplineSet *set,
+                  tsStatus *status);
+
+/**
+ * Releases the data of \p set. Does nothing if the data of \p set points to
+ * NULL. Afterwards, the data of \p set points to NULL.
+ *
+ * @param[in, out] set
+ * 	The set to release.
+ */
+void TINYSPLINE_API
+ts_bsplineset_free(tsBSplineSet *set);
+
+/**
+ * Returns the number of splines in \p set.
+ *
+ * @param[in] set
+ * 	The set whose number of splines is read.
+ * @return
+ * 	The number of splines of \p set (0 if the data of \p set points
+ * 	to NULL).
+ */
+size_t TINYSPLINE_API
+ts_bsplineset_num_splines(const tsBSplineSet *set);
+
+/**
+ * Returns the degree of the splines in \p set.
+ *
+ * @param[in] set
+ * 	The set whose degree is read.
+ * @return
+ * 	The degree of the splines of \p set.
+ */
+size_t TINYSPLINE_API
+ts_bsplineset_degree(const tsBSplineSet *set);
+
+/**
+ * Returns the dimensionality of the splines in \p set.
+ *
+ * @param[in] set
+ * 	The set whose dimension is read.
+ * @return
+ * 	The dimensionality of the splines of \p set.
+ */
+size_t TINYSPLINE_API
+ts_bsplineset_dimension(const tsBSplineSet *set);
+
+/**
+ * Returns the number of control points of each spline in \p set.
+ *
+ * @param[in] set
+ * 	The set whose number of control points is read.
+ * @return
+ * 	The number of control points of each spline of \p set.
+ */
+size_t TINYSPLINE_API
+ts_bsplineset_num_control_points(const tsBSplineSet *set);
+
+/**
+ * Returns a pointer to the shared knot vector of \p set.
+ *
+ * @param[in] set
+ * 	The set whose knots are read.
+ * @return
+ * 	Pointer to the <tt>num_control_points + degree + 1</tt> knots of
+ * 	\p set.
+ */
+const tsReal TINYSPLINE_API *
+ts_bsplineset_knots_ptr(const tsBSplineSet *set);
+
+/**
+ * Returns a pointer to the control points of \p set (see the layout
+ * described above).
+ *
+ * @param[in] set
+ * 	The set whose control points are read.
+ * @return
+ * 	Pointer to the control points of \p set.
+ */
+const tsReal TINYSPLINE_API *
+ts_bsplineset_control_points_ptr(const tsBSplineSet *set);
+
+/**
+ * Evaluates all splines of \p set at \p knot and stores the resulting
+ * points in \p points, which must have space for
+ * <tt>dimension * num_splines</tt> values (see the layout described above).
+ * Does not allocate memory unless the degree of \p set is very high.
+ *
+ * @param[in] set
+ * 	The set to evaluate.
+ * @param[in] knot
+ * 	The knot to evaluate the splines at.
+ * @param[out] points
+ * 	Stores the points of all splines.
+ * @param[out] status
+ * 	The status of this function. May be NULL.
+ * @return TS_SUCCESS
+ * 	On success.
+ * @return TS_U_UNDEFINED
+ * 	If \p knot is not within the domain of \p set.
+ * @return TS_MALLOC
+ * 	If allocating memory failed.
+ */
+tsError TINYSPLINE_API
+ts_bsplineset_eval(const tsBSplineSet *set,
+                   tsReal knot,
+                   tsReal *points,
+                   tsStatus *status);
+
+/**
+ * Copies the spline at \p index of \p set into \p spline.
+ *
+ * @param[in] set
+ * 	The set to read from.
+ * @param[in] index
+ * 	The index of the spline.
+ * @param[out] spline
+ * 	The output parameter.
+ * @param[out] status
+ * 	The status of this function. May be NULL.
+ * @return TS_SUCCESS
+ * 	On success.
+ * @return TS_INDEX_ERROR
+ * 	If \p index is out of range.
+ * @return TS_MALLOC
+ * 	If allocating memory failed.
+ */
+tsError TINYSPLINE_API
+ts_bsplineset_spline_at(const tsBSplineSet *set,
+                        size_t index,
+                        tsBSpline *spline,
+                        tsStatus *status);
+/*! @} */
+
+
+
+/*! @name Morphisms
+ *
+ * A ::tsMorphism stores two splines, \c origin and \c target, that have
+ * been aligned (see ::ts_bspline_align) in advance. In contrast to
+ * ::ts_bspline_morph, which checks and, if necessary, aligns its input on
+ * every call, ::ts_morphism_eval merely interpolates linearly between the
+ * control points and knots of the aligned splines. Since the control points
+ * and knots of a spline are stored contiguously, this is a single loop over
+ * contiguous memory, which compilers are able to vectorize. The result is
+ * stored in a spline created with ::ts_morphism_new_spline. This way,
+ * animations can morph a spline once per frame without allocating memory
+ * or validating their input (if only a few points of the morphed spline are
+ * needed, see ::ts_morphism_eval_at and ::ts_morphism_eval_grid):
+ *
+ *     tsMorphism morphism = ts_morphism_init();
+ *     tsBSpline buffer = ts_bspline_init();
+ *     ts_morphism_new(&origin, &target, TS_POINT_EPSILON, &morphism, ...);
+ *     ts_morphism_new_spline(&morphism, &buffer, ...);
+ *     for (frame = 0; frame <= 60; frame++)
+ *         ts_morphism_eval(&morphism, frame / (tsReal) 60, &buffer);
+ *     ts_bspline_free(&buffer);
+ *     ts_morphism_free(&morphism);
+ *
+ * A morphism is not modified by ::ts_morphism_eval and, thus, can be
+ * evaluated from multiple threads concurrently (with different buffers).
+ *
+ * @{
+ */
+/**
+ * A pair of aligned splines that can be morphed into each other.
+ */
+typedef struct
+{
+	struct tsMorphismImpl *pImpl; /**< The actual implementation. */
+} tsMorphism;
+
+/**
+ * Creates a new morphism whose data points to NULL.
+ *
+ * @return
+ * 	A new morphism whose data points to NULL.
+ */
+tsMorphism TINYSPLINE_API
+ts_morphism_init(void);
+
+/**
+ * Aligns \p origin and \p target (if necessary) and stores the result in
+ * \p morphism. If \p origin and \p target differ in dimensionality, the
+ * smaller one is used.
+ *
+ * @param[in] origin
+ * 	Origin spline.
+ * @param[in] target
+ * 	Target spline.
+ * @param[in] epsilon
+ * 	Passed to ::ts_bspline_align if \p origin and \p target must be
+ * 	aligned. A viable default value is ::TS_POINT_EPSILON.
+ * @param[out] morphism
+ * 	The output parameter.
+ * @param[out] status
+ * 	The status of this function. May be NULL.
+ * @return TS_SUCCESS
+ * 	On success.
+ * @return TS_MALLOC
+ * 	If allocating memory failed.
+ */
+tsError TINYSPLINE_API
+ts_morphism_new(const tsBSpline *origin,
+                const tsBSpline *target,
+                tsReal epsilon,
+                tsMorphism *morphism,
+                tsStatus *status);
+
+/**
+ * Creates a deep copy of \p src and stores the copied data in \p dest. \p
+ * src and \p dest can be the same instance.
+ *
+ * @param[in] src
+ * 	The morphism to copy.
+ * @param[out] dest
+ * 	The output parameter.
+ * @param[out] status
+ * 	The status of this function. May be NULL.
+ * @return TS_SUCCESS
+ * 	On success.
+ * @return TS_MALLOC
+ * 	If allocating memory failed.
+ */
+tsError TINYSPLINE_API
+ts_morphism_copy(const tsMorphism *src,
+                 tsMorphism *dest,
+                 tsStatus *status);
+
+/**
+ * Releases the data of \p morphism. Does nothing if the data of \p morphism
+ * points to NULL. Afterwards, the data of \p morphism points to NULL.
+ *
+ * @param[in, out] morphism
+ * 	The morphism to release.
+ */
+void TINYSPLINE_API
+ts_morphism_free(tsMorphism *morphism);
+
+/**
+ * Returns the degree of the aligned splines of \p morphism.
+ *
+ * @param[in] morphism
+ * 	The morphism whose degree is read.
+ * @return
+ * 	The degree of the aligned splines of \p morphism.
+ */
+size_t TINYSPLINE_API
+ts_morphism_degree(const tsMorphism *morphism);
+
+/**
+ * Returns the dimensionality of the aligned splines of \p morphism.
+ *
+ * @param[in] morphism
+ * 	The morphism whose dimension is read.
+ * @return
+ * 	The dimensionality of the aligned splines of \p morphism.
+ */
+size_t TINYSPLINE_API
+ts_morphism_dimension(const tsMorphism *morphism);
+
+/**
+ * Returns the number of control points of the aligned splines of \p
+ * morphism.
+ *
+ * @param[in] morphism
+ * 	The morphism whose number of control points is read.
+ * @return
+ * 	The number of control points of the aligned splines of \p morphism.
+ */
+size_t TINYSPLINE_API
+ts_morphism_num_control_points(const tsMorphism *morphism);
+
+/**
+ * Creates a spline that can be passed to ::ts_morphism_eval, that is, a
+ * spline with the degree, dimensionality, and number of control points of
+ * \p morphism. The spline is set to the aligned origin.
+ *
+ * @param[in] morphism
+ * 	The morphism to create a spline for.
+ * @param[out] spline
+ * 	The output parameter.
+ * @param[out] status
+ * 	The status of this function. May be NULL.
+ * @return TS_SUCCESS
+ * 	On success.
+ * @return TS_MALLOC
+ * 	If allocating memory failed.
+ */
+tsError TINYSPLINE_API
+ts_morphism_new_spline(const tsMorphism *morphism,
+                       tsBSpline *spline,
+                       tsStatus *status);
+
+/**
+ * Interpolates between the aligned splines of \p morphism with respect to
+ * the time parameter \p t (domain: [0, 1]; clamped if necessary) and stores
+ * the result in \p spline. If \p t is 0, \p spline becomes the aligned
+ * origin. If \p t is 1, \p spline becomes the aligned target. This function
+ * neither allocates memory nor validates its input. Thus, \p spline must
+ * have the degree, dimensionality, and number of control points of \p
+ * morphism (for example, because it has been created with
+ * ::ts_morphism_new_spline); otherwise, the behavior is undefined.
+ *
+ * @param[in] morphism
+ * 	The morphism to evaluate.
+ * @param[in] t
+ * 	The time parameter.
+ * @param[out] spline
+ * 	Stores the result.
+ */
+void TINYSPLINE_API
+ts_morphism_eval(const tsMorphism *morphism,
+                 tsReal t,
+                 tsBSpline *spline);
+
+/**
+ * Evaluates the spline that ::ts_morphism_eval would create for \p t at \p
+ * knot without creating it. Only the <tt>2 * degree</tt> knots and <tt>degree
+ * + 1</tt> control points that affect \p knot are interpolated; the span of
+ * \p knot is found with the knot search of ::ts_bspline_eval, which is
+ * applied to the interpolated knot vector on the fly. That is, \p knot snaps
+ * to knots within ::TS_KNOT_EPSILON and, at knots whose multiplicity is equal
+ * to the order, the first point of the corresponding ::tsDeBoorNet is
+ * returned (see ::ts_deboornet_result). Hence, this function yields the same
+ * result as ::ts_morphism_eval followed by ::ts_bspline_eval (up to rounding
+ * errors), but is considerably faster if only a few points of the morphed
+ * spline are needed. Does not allocate memory unless the degree of \p
+ * morphism is very high.
+ *
+ * @param[in] morphism
+ * 	The morphism to evaluate.
+ * @param[in] t
+ * 	The time parameter (domain: [0, 1]; clamped if necessary).
+ * @param[in] knot
+ * 	The knot to evaluate the morphed spline at.
+ * @param[out] point
+ * 	Stores the resulting point. Must have space for
+ * 	::ts_morphism_dimension values.
+ * @param[out] status
+ * 	The status of this function. May be NULL.
+ * @return TS_SUCCESS
+ * 	On success.
+ * @return TS_U_UNDEFINED
+ * 	If \p knot is not within the domain of the morphed spline.
+ * @return TS_MALLOC
+ * 	If allocating memory failed.
+ */
+tsError TINYSPLINE_API
+ts_morphism_eval_at(const tsMorphism *morphism,
+                    tsReal t,
+                    tsReal knot,
+                    tsReal *point,
+                    tsStatus *status);
+
+/**
+ * Evaluates \p morphism (see ::ts_morphism_eval_at) at each pair of the \p
+ * num_ts time parameters \p ts and the \p num_knots knots \p knots. The
+ * point of the pair <tt>(ts[i], knots[j])</tt> is stored at
+ * <tt>points[(i * num_knots + j) * dimension]</tt>. Knots that are sorted
+ * (ascending) are evaluated faster, because the span of a knot serves as
+ * hint for the next knot.
+ *
+ * @param[in] morphism
+ * 	The morphism to evaluate.
+ * @param[in] ts
+ * 	The time parameters (domain: [0, 1]; clamped if necessary).
+ * @param[in] num_ts
+ * 	The number of time parameters.
+ * @param[in] knots
+ * 	The knots to evaluate the morphed splines at.
+ * @param[in] num_knots
+ * 	The number of knots.
+ * @param[out] points
+ * 	Stores the resulting points. Must have space for <tt>num_ts *
+ * 	num_knots * dimension</tt> values.
+ * @param[out] status
+ * 	The status of this function. May be NULL.
+ * @return TS_SUCCESS
+ * 	On success.
+ * @return TS_U_UNDEFINED
+ * 	If one of the knots is not within the domain of a morphed spline.
+ * @return TS_MALLOC
+ * 	If allocating memory failed.
+ */
+tsError TINYSPLINE_API
+ts_morphism_eval_grid(const tsMorphism *morphism,
+                      const tsReal *ts,
+                      size_t num_ts,
+                      const tsReal *knots,
+                      size_t num_knots,
+                      tsReal *points,
+                      tsStatus *status);
+/*! @} */
+
+
+
+/*! @name Spline Containers
+ *
+ * Applications that deal with a large number of splines may store them in a
+ * single container file instead of one file per spline. A container consists
+ * of the splines in binary format (see ::ts_bspline_to_binary) and an index
+ * table that is used to locate them. Containers are created (or extended)
+ * with a ::tsContainerWriter and read with a ::tsContainer.
+ *
+ * Opening a container maps the file into memory (if supported by the
+ * platform) rather than reading it. The splines of a container are then
+ * accessible as views (see ::ts_container_view) that point directly into the
+ * mapped file. That is, neither copying nor parsing is necessary to evaluate
+ * a spline of a container, and only the pages that are actually accessed are
+ * read from disk. If the platform does not support memory mapping, the file
+ * is read into memory at once.
+ *
+ * The layout of a container is as follows (all values are stored in little
+ * endian byte order):
+ *
+ *     Offset  Size  Description
+ *          0     4  Magic number "TSBC"
+ *          4     1  Format version (::TS_CONTAINER_VERSION)
+ *          5     1  Size of a real value in bytes (4 = float, 8 = double)
+ *          6     2  Reserved (0)
+ *          8     8  Number of splines (unsigned)
+ *         16     8  Offset of the index table (unsigned)
+ *         24     8  Reserved (0)
+ *         32     -  Binary splines, each padded to a multiple of 8 bytes
+ *          -   8*n  Index table: offset of each spline (unsigned)
+ *
+ * @{
+ */
+/**
+ * The magic number (first four bytes) of containers.
+ */
+#define TS_CONTAINER_MAGIC "TSBC"
+
+/**
+ * The current version of the container format.
+ */
+#define TS_CONTAINER_VERSION 1
+
+/**
+ * The size (in bytes) of the header of containers.
+ */
+#define TS_CONTAINER_HEADER_SIZE 32
+
+/**
+ * A read-only container that has been mapped into memory.
+ */
+typedef struct
+{
+	struct tsContainerImpl *pImpl; /**< The actual implementation. */
+} tsContainer;
+
+/**
+ * Writes splines to a container file.
+ */
+typedef struct
+{
+	struct tsContainerWriterImpl *pImpl; /**< The actual implementation. */
+} tsContainerWriter;
+
+/**
+ * Creates a new container whose data points to NULL.
+ *
+ * @return
+ * 	A new container whose data points to NULL.
+ */
+tsContainer TINYSPLINE_API
+ts_container_init(void);
+
+/**
+ * Opens (maps) the container file \p path. The header and the index table are
+ * validated, the splines are validated on access.
+ *
+ * @param[in] path
+ * 	Path of the container file.
+ * @param[out] container
+ * 	The output container.
+ * @param[out] status
+ * 	The status of this function. May be NULL.
+ * @return TS_SUCCESS
+ * 	On success.
+ * @return TS_IO_ERROR
+ * 	If \p path does not exist or could not be mapped.
+ * @return TS_PARSE_ERROR
+ * 	If \p path is not a container of a supported version or if its index
+ * 	table is corrupted.
+ * @return TS_MALLOC
+ * 	If allocating memory failed.
+ */
+tsError TINYSPLINE_API
+ts_container_open(const char *path,
+                  tsContainer *container,
+                  tsStatus *status);
+
+/**
+ * Unmaps \p container. After calling this function, the data of \p container
+ * points to NULL and all views obtained from \p container are invalid.
+ *
+ * @param[out] container
+ * 	The container to be closed.
+ */
+void TINYSPLINE_API
+ts_container_close(tsContainer *container);
+
+/**
+ * Returns the number of splines stored in \p container.
+ *
+ * @param[in] container
+ * 	The container whose number of splines is returned.
+ * @return
+ * 	The number of splines of \p container (0 if the data of \p container
+ * 	points to NULL).
+ */
+size_t TINYSPLINE_API
+ts_container_num_splines(const tsContainer *container);
+
+/**
+ * Stores a view of the spline at \p index of \p container in \p view. The
+ * view points directly into the memory of \p container and is valid until \p
+ * container is closed. This function does not copy any data, and runs in
+ * constant time. The header of the spline is validated, but its knots are not
+ * (cf. ::ts_bspline_view_init). That is, the caller is responsible for
+ * ensuring that the knot vector is non-decreasing and that no knot has a
+ * multiplicity greater than the order of the spline. Use
+ * ::ts_container_view_checked to validate the knots of the view, or
+ * ::ts_container_load to obtain a validated copy.
+ *
+ * Zero-copy access requires that the precision of \p container matches
+ * ::tsReal and that the host is little endian. Otherwise, this function
+ * fails with ::TS_PARSE_ERROR, but ::ts_container_load can still be used.
+ *
+ * @param[in] container
+ * 	The container to access.
+ * @param[in] index
+ * 	Index of the spline.
+ * @param[out] view
+ * 	The output view.
+ * @param[out] status
+ * 	The status of this function. May be NULL.
+ * @return TS_SUCCESS
+ * 	On success.
+ * @return TS_INDEX_ERROR
+ * 	If \p index is out of range.
+ * @return TS_PARSE_ERROR
+ * 	If the spline at \p index is corrupted or cannot be accessed without
+ * 	conversion.
+ * @return TS_DIM_ZERO
+ * 	If the dimension of the spline is \c 0.
+ * @return TS_DEG_GE_NCTRLP
+ * 	If the degree of the spline is greater or equals to its number of
+ * 	control points.
+ * @return TS_NUM_KNOTS
+ * 	If the number of knots of the spline does not match its number of
+ * 	control points plus its order.
+ */
+tsError TINYSPLINE_API
+ts_container_view(const tsContainer *container,
+                  size_t index,
+                  tsBSplineView *view,
+                  tsStatus *status);
+
+/**
+ * Same as ::ts_container_view, but additionally validates the knots of the
+ * view. Runs in linear time in the number of knots.
+ *
+ * @param[in] container
+ * 	The container to access.
+ * @param[in] index
+ * 	Index of the spline.
+ * @param[out] view
+ * 	The output view. Not modified if this function fails.
+ * @param[out] status
+ * 	The status of this function. May be NULL.
+ * @return TS_SUCCESS
+ * 	On success.
+ * @return TS_INDEX_ERROR
+ * 	If \p index is out of range.
+ * @return TS_PARSE_ERROR
+ * 	If the spline at \p index is corrupted or cannot be accessed without
+ * 	conversion.
+ * @return TS_DIM_ZERO
+ * 	If the dimension of the spline is \c 0.
+ * @return TS_DEG_GE_NCTRLP
+ * 	If the degree of the spline is greater or equals to its number of
+ * 	control points.
+ * @return TS_NUM_KNOTS
+ * 	If the number of knots of the spline does not match its number of
+ * 	control points plus its order.
+ * @return TS_KNOTS_DECR
+ * 	If the knot vector is decreasing.
+ * @return TS_MULTIPLICITY
+ * 	If there is a knot with multiplicity greater than order.
+ */
+tsError TINYSPLINE_API
+ts_container_view_checked(const tsContainer *container,
+                          size_t index,
+                          tsBSplineView *view,
+                          tsStatus *status);
+
+/**
+ * Copies the spline at \p index of \p container to \p spline (see
+ * ::ts_bspline_from_binary).
+ *
+ * @param[in] container
+ * 	The container to access.
+ * @param[in] index
+ * 	Index of the spline.
+ * @param[out] spline
+ * 	The output spline.
+ * @param[out] status
+ * 	The status of this function. May be NULL.
+ * @return TS_SUCCESS
+ * 	On success.
+ * @return TS_INDEX_ERROR
+ * 	If \p index is out of range.
+ * @return TS_PARSE_ERROR
+ * 	If the spline at \p index is corrupted.
+ * @return TS_KNOTS_DECR
+ * 	If the knot vector is decreasing.
+ * @return TS_MULTIPLICITY
+ * 	If there is a knot with multiplicity greater than order.
+ * @return TS_MALLOC
+ * 	If allocating memory failed.
+ */
+tsError TINYSPLINE_API
+ts_container_load(const tsContainer *container,
+                  size_t index,
+                  tsBSpline *spline,
+                  tsStatus *status);
+
+/**
+ * Creates a new writer whose data points to NULL.
+ *
+ * @return
+ * 	A new writer whose data points to NULL.
+ */
+tsContainerWriter TINYSPLINE_API
+ts_container_writer_init(void);
+
+/**
+ * Opens the container file \p path for writing. If \p append is true and \p
+ * path is an existing container, the splines written with \p writer are
+ * appended to the splines that are already stored in \p path. Otherwise, \p
+ * path is truncated (or created). The container is completed (i.e., the index
+ * table is written) when \p writer is closed with ::ts_container_writer_close.
+ * Note that appending overwrites the index table of \p path, that is, \p path
+ * is not a valid container until \p writer has been closed.
+ *
+ * @param[in] path
+ * 	Path of the container file.
+ * @param[in] append
+ * 	Whether to append to an existing container.
+ * @param[out] writer
+ * 	The output writer.
+ * @param[out] status
+ * 	The status of this function. May be NULL.
+ * @return TS_SUCCESS
+ * 	On success.
+ * @return TS_IO_ERROR
+ * 	If \p path could not be opened.
+ * @return TS_PARSE_ERROR
+ * 	If \p append is true and \p path is not a container of a supported
+ * 	version, or if its precision does not match ::tsReal.
+ * @return TS_MALLOC
+ * 	If allocating memory failed.
+ */
+tsError TINYSPLINE_API
+ts_container_writer_open(const char *path,
+                         int append,
+                         tsContainerWriter *writer,
+                         tsStatus *status);
+
+/**
+ * Appends \p spline to the container of \p writer. If writing \p spline
+ * fails, the partially written data is discarded, i.e., \p writer can still
+ * be used to append further splines.
+ *
+ * @param[in, out] writer
+ * 	The writer to use.
+ * @param[in] spline
+ * 	The spline to append.
+ * @param[out] status
+ * 	The status of this function. May be NULL.
+ * @return TS_SUCCESS
+ * 	On success.
+ * @return TS_IO_ERROR
+ * 	If an error occurred while writing \p spline or if \p writer has not
+ * 	been opened.
+ * @return TS_MALLOC
+ * 	If allocating memory failed.
+ */
+tsError TINYSPLINE_API
+ts_container_writer_append(tsContainerWriter *writer,
+                           const tsBSpline *spline,
+                           tsStatus *status);
+
+/**
+ * See ::ts_container_writer_append.
+ */
+tsError TINYSPLINE_API
+ts_container_writer_append_view(tsContainerWriter *writer,
+                                const tsBSplineView *view,
+                                tsStatus *status);
+
+/**
+ * Writes the index table of \p writer, closes the underlying file, and
+ * releases the data of \p writer. After calling this function, the data of \p
+ * writer points to NULL. The data is released even if an error occurs.
+ * Calling this function with a writer whose data points to NULL is a no-op.
+ *
+ * @param[in, out] writer
+ * 	The writer to be closed.
+ * @param[out] status
+ * 	The status of this function. May be NULL.
+ * @return TS_SUCCESS
+ * 	On success.
+ * @return TS_IO_ERROR
+ * 	If an error occurred while writing the index table.
+ */
+tsError TINYSPLINE_API
+ts_container_writer_close(tsContainerWriter *writer,
+                          tsStatus *status);
+/*! @} */
+
+
+
+/*! @name JSON Streams
+ *
+ * Functions and structs to read and write many splines from and to a single
+ * JSON file. Two layouts are supported: a JSON array of splines and
+ * newline-delimited JSON (one spline per line, also known as NDJSON or JSON
+ * Lines). Either way, each spline is an object as created by
+ * ::ts_bspline_to_json. Streams are processed incrementally, that is, memory
+ * consumption is bounded by the size of the largest spline rather than by the
+ * size of the file.
+ *
+ * Newline-delimited files can be split into byte ranges that are read
+ * independently of each other (see ::ts_json_stream_open_range), for example,
+ * to parse a large file with multiple threads.
+ *
+ * @{
+ */
+/**
+ * The layout of a JSON stream.
+ */
+typedef enum
+{
+	/** A JSON array of splines. */
+	TS_JSON_ARRAY = 0,
+
+	/** Newline-delimited JSON (one spline per line). */
+	TS_JSON_LINES = 1
+} tsJsonFormat;
+
+/**
+ * Reads splines from a JSON stream.
+ */
+typedef struct
+{
+	struct tsJsonStreamImpl *pImpl; /**< The actual implementation. */
+} tsJsonStream;
+
+/**
+ * Writes splines to a JSON stream.
+ */
+typedef struct
+{
+	struct tsJsonStreamWriterImpl *pImpl; /**< The actual implementation. */
+} tsJsonStreamWriter;
+
+/**
+ * Creates a new stream whose data points to NULL.
+ *
+ * @return
+ * 	A new stream whose data points to NULL.
+ */
+tsJsonStream TINYSPLINE_API
+ts_json_stream_init(void);
+
+/**
+ * Opens the JSON file \p path for reading. The layout (see ::tsJsonFormat) is
+ * determined by the content of the file: if its first non-whitespace
+ * character is \c [, the file is read as array, otherwise as sequence of
+ * objects (which may be separated by any kind of whitespace, not only
+ * newlines).
+ *
+ * @param[in] path
+ * 	Path of the JSON file.
+ * @param[out] stream
+ * 	The output stream.
+ * @param[out] status
+ * 	The status of this function. May be NULL.
+ * @return TS_SUCCESS
+ * 	On success.
+ * @return TS_IO_ERROR
+ * 	If \p path does not exist.
+ * @return TS_MALLOC
+ * 	If allocating memory failed.
+ */
+tsError TINYSPLINE_API
+ts_json_stream_open(const char *path,
+                    tsJsonStream *stream,
+                    tsStatus *status);
+
+/**
+ * Opens the byte range [\p begin, \p end) of the newline-delimited JSON file
+ * \p path for reading. The stream yields every spline whose line starts
+ * within the given range. That is, if a file is split into consecutive
+ * ranges, each spline is read exactly once, regardless of where exactly the
+ * ranges are split. Ranges do not need to be aligned to lines, but each spline
+ * must be on a single line (as written by ::ts_json_stream_writer_open with
+ * ::TS_JSON_LINES).
+ *
+ * @param[in] path
+ * 	Path of the newline-delimited JSON file.
+ * @param[in] begin
+ * 	Offset (in bytes) of the range, inclusive.
+ * @param[in] end
+ * 	Offset (in bytes) of the range, exclusive.
+ * @param[out] stream
+ * 	The output stream.
+ * @param[out] status
+ * 	The status of this function. May be NULL.
+ * @return TS_SUCCESS
+ * 	On success.
+ * @return TS_IO_ERROR
+ * 	If \p path does not exist or if \p begin cannot be seeked.
+ * @return TS_PARSE_ERROR
+ * 	If \p path is a JSON array.
+ * @return TS_MALLOC
+ * 	If allocating memory failed.
+ */
+tsError TINYSPLINE_API
+ts_json_stream_open_range(const char *path,
+                          size_t begin,
+                          size_t end,
+                          tsJsonStream *stream,
+                          tsStatus *status);
+
+/**
+ * Opens the null-terminated JSON string \p json for reading (see
+ * ::ts_json_stream_open). The stream does not copy \p json, that is, \p json
+ * must not be released before \p stream is closed.
+ *
+ * @param[in] json
+ * 	The JSON string to read.
+ * @param[out] stream
+ * 	The output stream.
+ * @param[out] status
+ * 	The status of this function. May be NULL.
+ * @return TS_SUCCESS
+ * 	On success.
+ * @return TS_MALLOC
+ * 	If allocating memory failed.
+ */
+tsError TINYSPLINE_API
+ts_json_stream_open_string(const char *json,
+                           tsJsonStream *stream,
+                           tsStatus *status);
+
+/**
+ * Reads the next spline of \p stream and stores the result in \p spline. If
+ * the end of \p stream has been reached, \p done is set to 1 and \p spline
+ * points to NULL. A stream cannot be continued after an error.
+ *
+ * @param[in, out] stream
+ * 	The stream to read from.
+ * @param[out] spline
+ * 	The output spline.
+ * @param[out] done
+ * 	1 if the end of \p stream has been reached, 0 otherwise.
+ * @param[out] status
+ * 	The status of this function. May be NULL.
+ * @return TS_SUCCESS
+ * 	On success.
+ * @return TS_IO_ERROR
+ * 	If an error occurred while reading or if \p stream has not been opened.
+ * @return TS_PARSE_ERROR
+ * 	If an error occurred while parsing the next spline (see
+ * 	::ts_bspline_parse_json for further error codes).
+ * @return TS_MALLOC
+ * 	If allocating memory failed.
+ */
+tsError TINYSPLINE_API
+ts_json_stream_next(tsJsonStream *stream,
+                    tsBSpline *spline,
+                    int *done,
+                    tsStatus *status);
+
+/**
+ * Returns the number of splines read from \p stream so far. Useful to locate
+ * the spline that caused an error.
+ *
+ * @param[in] stream
+ * 	The stream to query.
+ * @return
+ * 	The number of splines read from \p stream.
+ */
+size_t TINYSPLINE_API
+ts_json_stream_num_read(const tsJsonStream *stream);
+
+/**
+ * Closes \p stream and releases its data. After calling this function, the
+ * data of \p stream points to NULL.
+ *
+ * @param[out] stream
+ * 	The stream to be closed.
+ */
+void TINYSPLINE_API
+ts_json_stream_close(tsJsonStream *stream);
+
+/**
+ * Creates a new writer whose data points to NULL.
+ *
+ * @return
+ * 	A new writer whose data points to NULL.
+ */
+tsJsonStreamWriter TINYSPLINE_API
+ts_json_stream_writer_init(void);
+
+/**
+ * Opens (truncates or creates) the JSON file \p path for writing. Splines are
+ * written in the compact (single line) layout of ::ts_bspline_to_json. The
+ * file is complete when \p writer is closed with
+ * ::ts_json_stream_writer_close.
+ *
+ * @param[in] path
+ * 	Path of the JSON file.
+ * @param[in] format
+ * 	The layout of the file.
+ * @param[out] writer
+ * 	The output writer.
+ * @param[out] status
+ * 	The status of this function. May be NULL.
+ * @return TS_SUCCESS
+ * 	On success.
+ * @return TS_IO_ERROR
+ * 	If \p path could not be opened.
+ * @return TS_MALLOC
+ * 	If allocating memory failed.
+ */
+tsError TINYSPLINE_API
+ts_json_stream_writer_open(const char *path,
+                           tsJsonFormat format,
+                           tsJsonStreamWriter *writer,
+                           tsStatus *status);
+
+/**
+ * Appends \p spline to the file of \p writer.
+ *
+ * @param[in, out] writer
+ * 	The writer to use.
+ * @param[in] spline
+ * 	The spline to append.
+ * @param[out] status
+ * 	The status of this function. May be NULL.
+ * @return TS_SUCCESS
+ * 	On success.
+ * @return TS_IO_ERROR
+ * 	If an error occurred while writing \p spline or if \p writer has not
+ * 	been opened.
+ * @return TS_PARSE_ERROR
+ * 	If \p spline contains values that are not finite.
+ */
+tsError TINYSPLINE_API
+ts_json_stream_writer_append(tsJsonStreamWriter *writer,
+                             const tsBSpline *spline,
+                             tsStatus *status);
+
+/**
+ * See ::ts_json_stream_writer_append.
+ */
+tsError TINYSPLINE_API
+ts_json_stream_writer_append_view(tsJsonStreamWriter *writer,
+                                  const tsBSplineView *view,
+                                  tsStatus *status);
+
+/**
+ * Completes the file of \p writer (e.g., closes the array), closes the file,
+ * and releases the data of \p writer. After calling this function, the data
+ * of \p writer points to NULL. The data is released even if an error occurs.
+ * Calling this function with a writer whose data points to NULL is a no-op.
+ *
+ * @param[in, out] writer
+ * 	The writer to be closed.
+ * @param[out] status
+ * 	The status of this function. May be NULL.
+ * @return TS_SUCCESS
+ * 	On success.
+ * @return TS_IO_ERROR
+ * 	If an error occurred while completing the file.
+ */
+tsError TINYSPLINE_API
+ts_json_stream_writer_close(tsJsonStreamWriter *writer,
+                            tsStatus *status);
+
+/**
+ * Saves the \p num splines of \p splines to the JSON file \p path (see
+ * ::ts_json_stream_writer_open).
+ *
+ * @param[in] splines
+ * 	The splines to be saved.
+ * @param[in] num
+ * 	The number of splines.
+ * @param[in] path
+ * 	Path of the JSON file.
+ * @param[in] format
+ * 	The layout of the file.
+ * @param[out] status
+ * 	The status of this function. May be NULL.
+ * @return TS_SUCCESS
+ * 	On success.
+ * @return TS_IO_ERROR
+ * 	If an error occurred while saving \p splines.
+ * @return TS_PARSE_ERROR
+ * 	If a spline contains values that are not finite.
+ * @return TS_MALLOC
+ * 	If allocating memory failed.
+ */
+tsError TINYSPLINE_API
+ts_bspline_save_all(const tsBSpline *splines,
+                    size_t num,
+                    const char *path,
+                    tsJsonFormat format,
+                    tsStatus *status);
+
+/**
+ * Loads all splines of the JSON file \p path (see ::ts_json_stream_open).
+ * Each spline of \p splines must be released with ::ts_bspline_free, the array
+ * itself with \c free.
+ *
+ * @param[in] path
+ * 	Path of the JSON file.
+ * @param[out] splines
+ * 	The loaded splines (NULL if \p path contains no spline).
+ * @param[out] num
+ * 	The number of loaded splines.
+ * @param[out] status
+ * 	The status of this function. May be NULL.
+ * @return TS_SUCCESS
+ * 	On success.
+ * @return TS_IO_ERROR
+ * 	If \p path does not exist or could not be read.
+ * @return TS_PARSE_ERROR
+ * 	If an error occurred while parsing \p path (see
+ * 	::ts_bspline_parse_json for further error codes).
+ * @return TS_MALLOC
+ * 	If allocating memory failed.
+ */
+tsError TINYSPLINE_API
+ts_bspline_load_all(const char *path,
+                    tsBSpline **splines,
+                    size_t *num,
+                    tsStatus *status);
+/*! @} */
+
 
 
 /*! @name Vector Math
@@ -6,6 +6,16 @@
 #include <stdexcept>
 #include <cstdio>
 #include <sstream>
+#include <iomanip>
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <exception>
+#include <memory>
+#include <mutex>
+#include <system_error>
+#include <thread>
 
 /* Suppress some useless MSVC warnings. */
 #ifdef _MSC_VER
@@ -977,6 +987,26 @@ tinyspline::BSpline::load(std::string path)
 	return BSpline(data);
 }
 
+tinyspline::BSpline
+tinyspline::BSpline::fromBinary(const std::vector<unsigned char> &data)
+{
+	tsBSpline spline = ts_bspline_init();
+	tsStatus status;
+	if (ts_bspline_from_binary(data.data(), data.size(), &spline, &status))
+		throw std::runtime_error(status.message);
+	return BSpline(spline);
+}
+
+tinyspline::BSpline
+tinyspline::BSpline::loadBinary(std::string path)
+{
+	tsBSpline data = ts_bspline_init();
+	tsStatus status;
+	if (ts_bspline_load_binary(path.c_str(), &data, &status))
+		throw std::runtime_error(status.message);
+	return BSpline(data);
+}
+
 bool
 tinyspline::BSpline::knotsEqual(real x, real y)
 {
@@ -1143,6 +1173,69 @@ tinyspline::BSpline::sample(size_t num) const
 	return vec;
 }
 
+void
+tinyspline::BSpline::evalAllInto(const real *knots,
+                                 size_t numKnots,
+                                 real *points,
+                                 size_t lenPoints) const
+{
+	const size_t dim = dimension();
+	if (lenPoints < numKnots * dim) {
+		std::ostringstream oss;
+		oss << "Expected size: " << numKnots * dim
+		    << ", Actual size: " << lenPoints;
+		throw std::runtime_error(oss.str());
+	}
+	Evaluator evaluator(degree(), dim);
+	for (size_t i = 0; i < numKnots; i++) {
+		const real *result = evaluator.eval(*this, knots[i]);
+		std::memcpy(points + i * dim, result, dim * sizeof(real));
+	}
+}
+
+size_t
+tinyspline::BSpline::sampleInto(real *points, size_t lenPoints) const
+{
+	const size_t dim = dimension();
+	const size_t num = lenPoints / dim;
+	real min, max, knot;
+	ts_bspline_domain(&m_spline, &min, &max);
+	Evaluator evaluator(degree(), dim);
+	/* Same knots as ts_bspline_uniform_knot_seq, without allocating. */
+	for (size_t i = 0; i < num; i++) {
+		if (i == 0) knot = min;
+		else if (i == num - 1) knot = max;
+		else knot = (max - min) * ((real) i / (num - 1)) + min;
+		const real *result = evaluator.eval(*this, knot);
+		std::memcpy(points + i * dim, result, dim * sizeof(real));
+	}
+	return num;
+}
+
+tinyspline::std_real_vector_out
+tinyspline::BSpline::tessellate(real tolerance) const
+{
+	tinyspline::real *points = nullptr;
+	size_t capacity = 0, num = 0;
+	tsStatus status;
+	if (ts_bspline_tessellate(&m_spline,
+	                          tolerance,
+	                          &points,
+	                          &capacity,
+	                          &num,
+	                          nullptr,
+	                          nullptr,
+	                          &status)) {
+		std::free(points);
+		throw std::runtime_error(status.message);
+	}
+	real *first = points;
+	real *last = first + num * dimension();
+	std_real_vector_init(vec)(first, last);
+	std::free(points);
+	return vec;
+}
+
 tinyspline::DeBoorNet
 tinyspline::BSpline::bisect(real value,
                             real epsilon,
@@ -1298,6 +1391,54 @@ tinyspline::BSpline::save(std::string path) const
 		throw std::runtime_error(status.message);
 }
 
+std::vector<unsigned char>
+tinyspline::BSpline::toBinary() const
+{
+	unsigned char *data;
+	size_t size;
+	tsStatus status;
+	if (ts_bspline_to_binary(&m_spline, &data, &size, &status))
+		throw std::runtime_error(status.message);
+	std::vector<unsigned char> vec(data, data + size);
+	std::free(data);
+	return vec;
+}
+
+void
+tinyspline::BSpline::saveBinary(std::string path) const
+{
+	tsStatus status;
+	if (ts_bspline_save_binary(&m_spline, path.c_str(), &status))
+		throw std::runtime_error(status.message);
+}
+
+std::vector<unsigned char>
+tinyspline::BSpline::toQuantized(size_t bits,
+                                 tinyspline::real *maxError) const
+{
+	unsigned char *data;
+	size_t size;
+	tsStatus status;
+	if (ts_bspline_to_quantized(&m_spline, bits, &data, &size, maxError,
+	                            &status))
+		throw std::runtime_error(status.message);
+	std::vector<unsigned char> vec(data, data + size);
+	std::free(data);
+	return vec;
+}
+
+tinyspline::real
+tinyspline::BSpline::saveQuantized(std::string path,
+                                   size_t bits) const
+{
+	real maxError;
+	tsStatus status;
+	if (ts_bspline_save_quantized(&m_spline, bits, path.c_str(),
+	                              &maxError, &status))
+		throw std::runtime_error(status.message);
+	return maxError;
+}
+
 void
 tinyspline::BSpline::setControlPoints(
 	const std::vector<tinyspline::real> &ctrlp)
@@ -1437,6 +1578,38 @@ tinyspline::BSpline::elevateDegree(size_t amount,
 	return BSpline(data);
 }
 
+tinyspline::BSpline
+tinyspline::BSpline::elevateDegreeDirect(size_t amount) const
+{
+	tsBSpline data = ts_bspline_init();
+	tsStatus status;
+	if (ts_bspline_elevate_degree_direct(&m_spline, amount, &data,
+	                                     &status))
+		throw std::runtime_error(status.message);
+	return BSpline(data);
+}
+
+tinyspline::BSpline
+tinyspline::BSpline::reduceDegree(size_t amount,
+                                  real tolerance) const
+{
+	real error;
+	return reduceDegree(amount, tolerance, error);
+}
+
+tinyspline::BSpline
+tinyspline::BSpline::reduceDegree(size_t amount,
+                                  real tolerance,
+                                  real &error) const
+{
+	tsBSpline data = ts_bspline_init();
+	tsStatus status;
+	if (ts_bspline_reduce_degree(&m_spline, amount, tolerance, &data,
+	                             &error, &status))
+		throw std::runtime_error(status.message);
+	return BSpline(data);
+}
+
 tinyspline::BSpline
 tinyspline::BSpline::alignWith(const BSpline &other,
                                BSpline &otherAligned,
@@ -1481,188 +1654,1274 @@ std::string tinyspline::BSpline::toString() const
 
 
 
-/*! @name Morphism
+/*! @name BSplineView
  *
  * @{
  */
-tinyspline::Morphism::Morphism(const BSpline &origin,
-			       const BSpline &target,
-			       real epsilon)
-: m_origin(origin), m_target(target), m_epsilon(epsilon)
-{
-	m_originAligned = origin.alignWith(target, m_targetAligned, epsilon);
-	// Make buffer compatible by copying one of the aligned splines.
-	m_buffer = m_originAligned;
-}
-
-tinyspline::BSpline
-tinyspline::Morphism::eval(real t)
+tinyspline::BSplineView::BSplineView(const real *controlPoints,
+                                     size_t numControlPoints,
+                                     size_t dimension,
+                                     size_t degree,
+                                     const real *knots,
+                                     size_t controlPointStride,
+                                     size_t knotStride)
 {
 	tsStatus status;
-	if (t <= 0) return m_origin;
-	if (t >= 1) return m_target;
-	if (ts_bspline_morph(&m_originAligned.m_spline,
-			     &m_targetAligned.m_spline,
-			     t, m_epsilon,
-			     &m_buffer.m_spline, &status)) {
+	if (ts_bspline_view_init(numControlPoints,
+	                         dimension,
+	                         degree,
+	                         controlPoints,
+	                         controlPointStride,
+	                         knots,
+	                         knotStride,
+	                         &m_view,
+	                         &status))
 		throw std::runtime_error(status.message);
-	}
-	return m_buffer;
-}
-
-tinyspline::BSpline
-tinyspline::Morphism::origin() const
-{
-	return m_origin;
 }
 
-tinyspline::BSpline
-tinyspline::Morphism::target() const
+tinyspline::BSplineView::BSplineView(const BSpline &spline)
 {
-	return m_target;
+	ts_bspline_as_view(&spline.m_spline, &m_view);
 }
 
-tinyspline::real
-tinyspline::Morphism::epsilon() const
+tinyspline::DeBoorNet
+tinyspline::BSplineView::operator()(tinyspline::real knot) const
 {
-	return m_epsilon;
+	return eval(knot);
 }
 
-tinyspline::BSpline
-tinyspline::Morphism::operator()(real t)
+size_t
+tinyspline::BSplineView::degree() const
 {
-	return eval(t);
+	return m_view.degree;
 }
 
-std::string tinyspline::Morphism::toString() const
+size_t
+tinyspline::BSplineView::order() const
 {
-	std::ostringstream oss;
-	oss << "Morphism{"
-	    << "buffer: " << m_buffer.toString()
-	    << ", epsilon: " << epsilon()
-	    << "}";
-	return oss.str();
+	return m_view.degree + 1;
 }
-/*! @} */
-
-
-
-/*! @name ChordLenghts
- * @{
- */
-tinyspline::ChordLengths::ChordLengths()
-: m_spline(),
-  m_knots(nullptr),
-  m_lengths(nullptr),
-  m_size(0)
-{}
-
-tinyspline::ChordLengths::ChordLengths(const BSpline &spline,
-                                       real *knots,
-                                       real *lengths,
-                                       size_t size)
-: m_spline(spline),
-  m_knots(knots),
-  m_lengths(lengths),
-  m_size(size)
-{}
 
-tinyspline::ChordLengths::ChordLengths(const ChordLengths &other)
-: m_spline(other.m_spline),
-  m_knots(nullptr),
-  m_lengths(nullptr),
-  m_size(other.m_size)
+size_t
+tinyspline::BSplineView::dimension() const
 {
-	m_knots = new real[m_size];
-	std::copy(other.m_knots,
-	          other.m_knots + m_size,
-	          m_knots);
-	m_lengths = new real[m_size];
-	std::copy(other.m_lengths,
-	          other.m_lengths + m_size,
-	          m_lengths);
+	return m_view.dimension;
 }
 
-tinyspline::ChordLengths::ChordLengths(ChordLengths &&other)
-: m_spline(),
-  m_knots(nullptr),
-  m_lengths(nullptr),
-  m_size(0)
+size_t
+tinyspline::BSplineView::numControlPoints() const
 {
-	*this = std::move(other);
+	return m_view.num_control_points;
 }
 
-tinyspline::ChordLengths::~ChordLengths()
+tinyspline::DeBoorNet
+tinyspline::BSplineView::eval(real knot) const
 {
-	delete [] m_knots;
-	delete [] m_lengths;
-	m_size = 0;
+	tsDeBoorNet net = ts_deboornet_init();
+	tsStatus status;
+	if (ts_bspline_view_eval(&m_view, knot, &net, &status))
+		throw std::runtime_error(status.message);
+	return tinyspline::DeBoorNet(net);
 }
 
-tinyspline::ChordLengths &
-tinyspline::ChordLengths::operator=(const ChordLengths &other)
+tinyspline::std_real_vector_out
+tinyspline::BSplineView::evalAll(std_real_vector_in knots) const
 {
-	if (&other != this) {
-		real *knots = new real[other.m_size];
-		std::copy(other.m_knots,
-		          other.m_knots + other.m_size,
-		          knots);
-		real *lengths = new real[other.m_size];
-		std::copy(other.m_lengths,
-		          other.m_lengths + other.m_size,
-		          lengths);
-		delete [] m_knots;
-		delete [] m_lengths;
-		m_spline = other.m_spline;
-		m_knots = knots;
-		m_lengths = lengths;
-		m_size = other.m_size;
+	const size_t num_knots = std_real_vector_read(knots)size();
+	const real *knots_ptr = std_real_vector_read(knots)data();
+	tinyspline::real *points;
+	tsStatus status;
+	if (ts_bspline_view_eval_all(&m_view,
+	                             knots_ptr,
+	                             num_knots,
+	                             &points,
+	                             &status)) {
+		throw std::runtime_error(status.message);
 	}
-	return *this;
+	real *first = points;
+	real *last = first + num_knots * dimension();
+	std_real_vector_init(vec)(first, last);
+	std::free(points);
+	return vec;
 }
 
-tinyspline::ChordLengths &
-tinyspline::ChordLengths::operator=(ChordLengths &&other)
+tinyspline::std_real_vector_out
+tinyspline::BSplineView::sample(size_t num) const
 {
-	if (&other != this) {
-		delete [] m_knots;
-		delete [] m_lengths;
-		m_spline = other.m_spline;
-		m_knots = other.m_knots;
-		m_lengths = other.m_lengths;
-		m_size = other.m_size;
-		other.m_spline = BSpline();
-		other.m_knots = nullptr;
-		other.m_lengths = nullptr;
-		other.m_size = 0;
+	tinyspline::real *points;
+	size_t actualNum;
+	tsStatus status;
+	if (ts_bspline_view_sample(&m_view,
+	                           num,
+	                           &points,
+	                           &actualNum,
+	                           &status)) {
+		throw std::runtime_error(status.message);
 	}
-	return *this;
+	real *first = points;
+	real *last = first + actualNum * dimension();
+	std_real_vector_init(vec)(first, last);
+	std::free(points);
+	return vec;
 }
 
-tinyspline::BSpline
-tinyspline::ChordLengths::spline() const
+tinyspline::DeBoorNet
+tinyspline::BSplineView::bisect(real value,
+                                real epsilon,
+                                bool persnickety,
+                                size_t index,
+                                bool ascending,
+                                size_t maxIter) const
 {
-	return m_spline;
+	tsDeBoorNet net = ts_deboornet_init();
+	tsStatus status;
+	if (ts_bspline_view_bisect(&m_view,
+	                           value,
+	                           epsilon,
+	                           persnickety,
+	                           index,
+	                           ascending,
+	                           maxIter,
+	                           &net,
+	                           &status))
+		throw std::runtime_error(status.message);
+	return DeBoorNet(net);
 }
 
-std::vector<tinyspline::real>
-tinyspline::ChordLengths::knots() const
+tinyspline::Domain
+tinyspline::BSplineView::domain() const
 {
-	return std::vector<real>(m_knots,
-	                         m_knots + m_size);
+	real min, max;
+	ts_bspline_view_domain(&m_view, &min, &max);
+	return Domain(min, max);
 }
 
-std::vector<tinyspline::real>
-tinyspline::ChordLengths::lengths() const
+tinyspline::ChordLengths
+tinyspline::BSplineView::chordLengths(std_real_vector_in knots) const
 {
-	return std::vector<real>(m_lengths,
-	                         m_lengths + m_size);
+	tsStatus status;
+	size_t num = std_real_vector_read(knots)size();
+	std::unique_ptr<real[]> knotsArr(new real[num]);
+	std::unique_ptr<real[]> lengths(new real[num]);
+	std::copy(std_real_vector_read(knots)begin(),
+	          std_real_vector_read(knots)end(),
+	          knotsArr.get());
+	if (ts_bspline_view_chord_lengths(&m_view,
+	                                  knotsArr.get(),
+	                                  num,
+	                                  lengths.get(),
+	                                  &status))
+		throw std::runtime_error(status.message);
+	// Copy the spline before releasing the arrays to ChordLengths.
+	BSpline spline = toBSpline();
+	return ChordLengths(spline, knotsArr.release(), lengths.release(),
+	                    num);
 }
 
-std::vector<tinyspline::real>
-tinyspline::ChordLengths::values() const
+std::string
+tinyspline::BSplineView::toJson() const
 {
-	return lengths();
+	char *json;
+	tsStatus status;
+	if (ts_bspline_view_to_json(&m_view, &json, &status))
+		throw std::runtime_error(status.message);
+	std::string string(json);
+	std::free(json);
+	return string;
+}
+
+void
+tinyspline::BSplineView::save(std::string path) const
+{
+	tsStatus status;
+	if (ts_bspline_view_save(&m_view, path.c_str(), &status))
+		throw std::runtime_error(status.message);
+}
+
+std::vector<unsigned char>
+tinyspline::BSplineView::toBinary() const
+{
+	unsigned char *data;
+	size_t size;
+	tsStatus status;
+	if (ts_bspline_view_to_binary(&m_view, &data, &size, &status))
+		throw std::runtime_error(status.message);
+	std::vector<unsigned char> vec(data, data + size);
+	std::free(data);
+	return vec;
+}
+
+void
+tinyspline::BSplineView::saveBinary(std::string path) const
+{
+	tsStatus status;
+	if (ts_bspline_view_save_binary(&m_view, path.c_str(), &status))
+		throw std::runtime_error(status.message);
+}
+
+tinyspline::BSpline
+tinyspline::BSplineView::toBSpline() const
+{
+	tsBSpline data = ts_bspline_init();
+	tsStatus status;
+	if (ts_bspline_view_to_bspline(&m_view, &data, &status))
+		throw std::runtime_error(status.message);
+	return BSpline(data);
+}
+
+std::string tinyspline::BSplineView::toString() const
+{
+	Domain d = domain();
+	std::ostringstream oss;
+	oss << "BSplineView{"
+	    << "dimension: " << dimension()
+	    << ", degree: " << degree()
+	    << ", domain: [" << d.min() << ", " << d.max() << "]"
+	    << ", control points: " << numControlPoints()
+	    << ", knots: " << numControlPoints() + order()
+	    << "}";
+	return oss.str();
+}
+/*! @} */
+
+
+
+/*! @name Evaluator
+ *
+ * @{
+ */
+tinyspline::Evaluator::Evaluator(size_t maxDegree, size_t maxDimension)
+: m_ctx(ts_eval_context_init()),
+  m_maxDegree(maxDegree),
+  m_maxDimension(maxDimension)
+{
+	tsStatus status;
+	if (ts_eval_context_new(maxDegree, maxDimension, &m_ctx, &status))
+		throw std::runtime_error(status.message);
+}
+
+tinyspline::Evaluator::Evaluator(const Evaluator &other)
+: Evaluator(other.m_maxDegree, other.m_maxDimension)
+{}
+
+tinyspline::Evaluator::Evaluator(Evaluator &&other)
+: m_ctx(other.m_ctx),
+  m_maxDegree(other.m_maxDegree),
+  m_maxDimension(other.m_maxDimension)
+{
+	other.m_ctx = ts_eval_context_init();
+}
+
+tinyspline::Evaluator::~Evaluator()
+{
+	ts_eval_context_free(&m_ctx);
+}
+
+tinyspline::Evaluator &
+tinyspline::Evaluator::operator=(const Evaluator &other)
+{
+	if (&other != this) {
+		tsEvalContext ctx = ts_eval_context_init();
+		tsStatus status;
+		if (ts_eval_context_new(other.m_maxDegree,
+		                        other.m_maxDimension,
+		                        &ctx,
+		                        &status))
+			throw std::runtime_error(status.message);
+		ts_eval_context_free(&m_ctx);
+		m_ctx = ctx;
+		m_maxDegree = other.m_maxDegree;
+		m_maxDimension = other.m_maxDimension;
+	}
+	return *this;
+}
+
+tinyspline::Evaluator &
+tinyspline::Evaluator::operator=(Evaluator &&other)
+{
+	if (&other != this) {
+		ts_eval_context_free(&m_ctx);
+		m_ctx = other.m_ctx;
+		m_maxDegree = other.m_maxDegree;
+		m_maxDimension = other.m_maxDimension;
+		other.m_ctx = ts_eval_context_init();
+	}
+	return *this;
+}
+
+const tinyspline::real *
+tinyspline::Evaluator::eval(const BSpline &spline, real knot)
+{
+	tsStatus status;
+	if (ts_eval_context_eval(&m_ctx, &spline.m_spline, knot, NULL,
+	                         &status))
+		throw std::runtime_error(status.message);
+	return ts_deboornet_result_ptr(ts_eval_context_net(&m_ctx));
+}
+
+const tinyspline::real *
+tinyspline::Evaluator::eval(const BSplineView &view, real knot)
+{
+	tsStatus status;
+	if (ts_eval_context_view_eval(&m_ctx, &view.m_view, knot, NULL,
+	                              &status))
+		throw std::runtime_error(status.message);
+	return ts_deboornet_result_ptr(ts_eval_context_net(&m_ctx));
+}
+
+tinyspline::DeBoorNet
+tinyspline::Evaluator::net() const
+{
+	const tsDeBoorNet *src = ts_eval_context_net(&m_ctx);
+	tsDeBoorNet net = ts_deboornet_init();
+	tsStatus status;
+	if (!src)
+		throw std::runtime_error("evaluator has been moved");
+	if (ts_deboornet_copy(src, &net, &status))
+		throw std::runtime_error(status.message);
+	return tinyspline::DeBoorNet(net);
+}
+
+std::string
+tinyspline::Evaluator::toString() const
+{
+	std::ostringstream oss;
+	oss << "Evaluator{"
+	    << "maxDegree: " << m_maxDegree
+	    << ", maxDimension: " << m_maxDimension
+	    << "}";
+	return oss.str();
+}
+/*! @} */
+
+
+
+
+/*! @name Batch Processing
+ *
+ * @{
+ */
+#ifndef SWIG
+/* Number of chunks per thread. More chunks improve the load balance, but
+ * increase the synchronization overhead. */
+#define TS_BATCH_CHUNKS_PER_THREAD 8
+
+/* Estimates the cost of evaluating `spline' at `numEvals' knots. */
+static size_t
+batchCost(const tinyspline::BSpline &spline,
+          size_t numEvals)
+{
+	const size_t order = spline.order();
+	return numEvals * order * order * spline.dimension() +
+		spline.numControlPoints();
+}
+
+size_t
+tinyspline::BatchResult::size() const
+{
+	return m_offsets.empty() ? 0 : m_offsets.size() - 1;
+}
+
+const tinyspline::real *
+tinyspline::BatchResult::data(size_t index) const
+{
+	if (index >= size())
+		throw std::out_of_range("index out of range");
+	return m_values.data() + m_offsets[index];
+}
+
+size_t
+tinyspline::BatchResult::length(size_t index) const
+{
+	if (index >= size())
+		throw std::out_of_range("index out of range");
+	return m_offsets[index + 1] - m_offsets[index];
+}
+
+const std::vector<tinyspline::real> &
+tinyspline::BatchResult::values() const
+{
+	return m_values;
+}
+
+const std::vector<size_t> &
+tinyspline::BatchResult::offsets() const
+{
+	return m_offsets;
+}
+
+// The worker threads of a Batch. Worker `t' (starting at 1, the calling
+// thread is 0) sleeps until `generation' changes, runs `(*task)(t)', and
+// decrements `busy'.
+struct tinyspline::Batch::Pool {
+	std::mutex run; // Serializes the operations of a Batch.
+	std::mutex mutex;
+	std::condition_variable wake;
+	std::condition_variable done;
+	std::vector<std::thread> threads;
+	const std::function<void(size_t)> *task = nullptr;
+	size_t generation = 0;
+	size_t busy = 0;
+	bool started = false;
+	bool stop = false;
+
+	void work(size_t thread)
+	{
+		size_t seen = 0;
+		std::unique_lock<std::mutex> lock(mutex);
+		for (;;) {
+			wake.wait(lock, [&] {
+				return stop || generation != seen;
+			});
+			if (stop) return;
+			seen = generation;
+			const std::function<void(size_t)> *current = task;
+			lock.unlock();
+			(*current)(thread); // Does not throw.
+			lock.lock();
+			if (--busy == 0) done.notify_one();
+		}
+	}
+
+	// Starts up to `num' workers. No (more) threads may be available, in
+	// which case the calling thread does all the work.
+	void start(size_t num)
+	{
+		started = true;
+		for (size_t t = 1; t <= num; t++) {
+			try {
+				threads.emplace_back(&Pool::work, this, t);
+			} catch (const std::system_error &) {
+				break;
+			}
+		}
+	}
+
+	~Pool()
+	{
+		{
+			std::lock_guard<std::mutex> lock(mutex);
+			stop = true;
+		}
+		wake.notify_all();
+		for (std::thread &thread : threads)
+			thread.join();
+	}
+};
+
+tinyspline::Batch::Batch(size_t numThreads)
+: m_numThreads(numThreads), m_pool(new Pool)
+{
+	if (m_numThreads == 0)
+		m_numThreads = std::thread::hardware_concurrency();
+	if (m_numThreads == 0)
+		m_numThreads = 1;
+}
+
+tinyspline::Batch::Batch(const Batch &other)
+: m_numThreads(other.m_numThreads), m_pool(new Pool)
+{}
+
+tinyspline::Batch::~Batch()
+{
+	delete m_pool;
+}
+
+tinyspline::Batch &
+tinyspline::Batch::operator=(const Batch &other)
+{
+	if (&other != this && other.m_numThreads != m_numThreads) {
+		Pool *pool = new Pool;
+		delete m_pool;
+		m_pool = pool;
+		m_numThreads = other.m_numThreads;
+	}
+	return *this;
+}
+
+size_t
+tinyspline::Batch::numThreads() const
+{
+	return m_numThreads;
+}
+
+void
+tinyspline::Batch::run(const std::vector<size_t> &costs,
+                       const std::function<void(size_t, size_t)> &op) const
+{
+	const size_t num = costs.size();
+	if (num == 0) return;
+
+	// Split the splines into chunks of roughly equal cost. Chunk `c'
+	// consists of the splines [bounds[c], bounds[c + 1]).
+	size_t total = 0;
+	for (size_t cost : costs) total += cost;
+	const size_t target = std::max<size_t>(1, total /
+		(m_numThreads * TS_BATCH_CHUNKS_PER_THREAD));
+	std::vector<size_t> bounds(1, 0);
+	size_t sum = 0;
+	for (size_t i = 0; i < num; i++) {
+		sum += costs[i];
+		if (sum >= target) {
+			bounds.push_back(i + 1);
+			sum = 0;
+		}
+	}
+	if (bounds.back() != num) bounds.push_back(num);
+	const size_t numChunks = bounds.size() - 1;
+	const size_t numThreads = std::min(m_numThreads, numChunks);
+	if (numThreads <= 1) {
+		for (size_t i = 0; i < num; i++) op(0, i);
+		return;
+	}
+
+	// Each thread takes chunks from the front of its own queue and, once
+	// its queue is empty, steals chunks from the back of the others.
+	struct Queue {
+		std::mutex mutex;
+		std::deque<size_t> chunks;
+	};
+	std::vector<Queue> queues(numThreads);
+	for (size_t c = 0; c < numChunks; c++)
+		queues[c * numThreads / numChunks].chunks.push_back(c);
+	std::atomic<bool> failed(false);
+	std::exception_ptr error;
+	std::mutex errorMutex;
+	auto worker = [&](size_t thread) {
+		try {
+			for (;;) {
+				size_t chunk = 0;
+				bool found = false;
+				for (size_t k = 0; k < numThreads && !found; k++) {
+					Queue &queue = queues[(thread + k) %
+					                      numThreads];
+					std::lock_guard<std::mutex> lock(
+						queue.mutex);
+					if (queue.chunks.empty()) continue;
+					if (k == 0) {
+						chunk = queue.chunks.front();
+						queue.chunks.pop_front();
+					} else {
+						chunk = queue.chunks.back();
+						queue.chunks.pop_back();
+					}
+					found = true;
+				}
+				if (!found || failed) return;
+				for (size_t i = bounds[chunk];
+				     i < bounds[chunk + 1]; i++)
+					op(thread, i);
+			}
+		} catch (...) {
+			std::lock_guard<std::mutex> lock(errorMutex);
+			if (!error) error = std::current_exception();
+			failed = true;
+		}
+	};
+	// Workers beyond `numThreads' have no queue. The chunks of missing
+	// workers are stolen by the others.
+	const std::function<void(size_t)> task = [&](size_t thread) {
+		if (thread < numThreads) worker(thread);
+	};
+	Pool &pool = *m_pool;
+	std::lock_guard<std::mutex> run(pool.run);
+	if (!pool.started) pool.start(m_numThreads - 1);
+	{
+		std::lock_guard<std::mutex> lock(pool.mutex);
+		pool.task = &task;
+		pool.busy = pool.threads.size();
+		pool.generation++;
+	}
+	pool.wake.notify_all();
+	worker(0);
+	{
+		std::unique_lock<std::mutex> lock(pool.mutex);
+		pool.done.wait(lock, [&] { return pool.busy == 0; });
+		pool.task = nullptr;
+	}
+	if (error) std::rethrow_exception(error);
+}
+
+tinyspline::BatchResult
+tinyspline::Batch::sample(const std::vector<BSpline> &splines,
+                          size_t num) const
+{
+	if (num == 0) num = 100;
+	BatchResult result;
+	std::vector<size_t> costs(splines.size());
+	result.m_offsets.resize(splines.size() + 1, 0);
+	for (size_t i = 0; i < splines.size(); i++) {
+		costs[i] = batchCost(splines[i], num);
+		result.m_offsets[i + 1] = result.m_offsets[i] +
+			num * splines[i].dimension();
+	}
+	result.m_values.resize(result.m_offsets.back());
+	// One evaluator and knot buffer per thread.
+	std::vector<Evaluator> evaluators(m_numThreads);
+	std::vector<std::vector<real>> knots(m_numThreads,
+	                                     std::vector<real>(num));
+	run(costs, [&](size_t thread, size_t index) {
+		const BSpline &spline = splines[index];
+		real *out = result.m_values.data() + result.m_offsets[index];
+		tsEvalContext *ctx = &evaluators[thread].m_ctx;
+		real *seq = knots[thread].data();
+		tsStatus status;
+		ts_bspline_uniform_knot_seq(&spline.m_spline, num, seq);
+		for (size_t k = 0; k < num; k++) {
+			if (ts_eval_context_eval(ctx, &spline.m_spline, seq[k],
+			                         out, &status))
+				throw std::runtime_error(status.message);
+			out += spline.dimension();
+		}
+	});
+	return result;
+}
+
+tinyspline::BatchResult
+tinyspline::Batch::chordLengths(const std::vector<BSpline> &splines,
+                                size_t num) const
+{
+	BatchResult result;
+	std::vector<size_t> costs(splines.size());
+	result.m_offsets.resize(splines.size() + 1, 0);
+	for (size_t i = 0; i < splines.size(); i++) {
+		costs[i] = batchCost(splines[i], num);
+		result.m_offsets[i + 1] = result.m_offsets[i] + num;
+	}
+	result.m_values.resize(result.m_offsets.back());
+	std::vector<std::vector<real>> knots(m_numThreads,
+	                                     std::vector<real>(num));
+	run(costs, [&](size_t thread, size_t index) {
+		const BSpline &spline = splines[index];
+		real *seq = knots[thread].data();
+		tsStatus status;
+		ts_bspline_uniform_knot_seq(&spline.m_spline, num, seq);
+		if (ts_bspline_chord_lengths(&spline.m_spline, seq, num,
+		                             result.m_values.data() +
+		                             result.m_offsets[index],
+		                             &status))
+			throw std::runtime_error(status.message);
+	});
+	return result;
+}
+
+tinyspline::BatchResult
+tinyspline::Batch::map(const std::vector<BSpline> &splines,
+                       const LengthFunc &length,
+                       const Operation &op) const
+{
+	BatchResult result;
+	std::vector<size_t> costs(splines.size());
+	result.m_offsets.resize(splines.size() + 1, 0);
+	for (size_t i = 0; i < splines.size(); i++) {
+		size_t len = length(splines[i]);
+		costs[i] = batchCost(splines[i], len);
+		result.m_offsets[i + 1] = result.m_offsets[i] + len;
+	}
+	result.m_values.resize(result.m_offsets.back());
+	run(costs, [&](size_t, size_t index) {
+		op(splines[index],
+		   result.m_values.data() + result.m_offsets[index]);
+	});
+	return result;
+}
+
+std::string
+tinyspline::Batch::toString() const
+{
+	std::ostringstream oss;
+	oss << "Batch{"
+	    << "numThreads: " << m_numThreads
+	    << "}";
+	return oss.str();
+}
+#endif
+/*! @} */
+
+
+
+/*! @name Spline Containers
+ *
+ * @{
+ */
+tinyspline::Container::Container(std::string path)
+: m_container(ts_container_init())
+{
+	tsStatus status;
+	if (ts_container_open(path.c_str(), &m_container, &status))
+		throw std::runtime_error(status.message);
+}
+
+tinyspline::Container::Container(Container &&other)
+: m_container(other.m_container)
+{
+	other.m_container = ts_container_init();
+}
+
+tinyspline::Container::~Container()
+{
+	ts_container_close(&m_container);
+}
+
+tinyspline::Container &
+tinyspline::Container::operator=(Container &&other)
+{
+	if (&other != this) {
+		ts_container_close(&m_container);
+		m_container = other.m_container;
+		other.m_container = ts_container_init();
+	}
+	return *this;
+}
+
+size_t
+tinyspline::Container::numSplines() const
+{
+	return ts_container_num_splines(&m_container);
+}
+
+tinyspline::BSplineView
+tinyspline::Container::view(size_t index) const
+{
+	tsBSplineView view;
+	tsStatus status;
+	if (ts_container_view(&m_container, index, &view, &status))
+		throw std::runtime_error(status.message);
+	return BSplineView(view.control_points,
+	                   view.num_control_points,
+	                   view.dimension,
+	                   view.degree,
+	                   view.knots,
+	                   view.control_point_stride,
+	                   view.knot_stride);
+}
+
+tinyspline::BSplineView
+tinyspline::Container::checkedView(size_t index) const
+{
+	tsBSplineView view;
+	tsStatus status;
+	if (ts_container_view_checked(&m_container, index, &view, &status))
+		throw std::runtime_error(status.message);
+	return BSplineView(view.control_points,
+	                   view.num_control_points,
+	                   view.dimension,
+	                   view.degree,
+	                   view.knots,
+	                   view.control_point_stride,
+	                   view.knot_stride);
+}
+
+tinyspline::BSpline
+tinyspline::Container::load(size_t index) const
+{
+	tsBSpline data = ts_bspline_init();
+	tsStatus status;
+	if (ts_container_load(&m_container, index, &data, &status))
+		throw std::runtime_error(status.message);
+	return BSpline(data);
+}
+
+std::string
+tinyspline::Container::toString() const
+{
+	std::ostringstream oss;
+	oss << "Container{"
+	    << "splines: " << numSplines()
+	    << "}";
+	return oss.str();
+}
+
+tinyspline::ContainerWriter::ContainerWriter(std::string path, bool append)
+: m_writer(ts_container_writer_init())
+{
+	tsStatus status;
+	if (ts_container_writer_open(path.c_str(), append ? 1 : 0,
+	                             &m_writer, &status))
+		throw std::runtime_error(status.message);
+}
+
+tinyspline::ContainerWriter::ContainerWriter(ContainerWriter &&other)
+: m_writer(other.m_writer)
+{
+	other.m_writer = ts_container_writer_init();
+}
+
+tinyspline::ContainerWriter::~ContainerWriter()
+{
+	ts_container_writer_close(&m_writer, NULL);
+}
+
+tinyspline::ContainerWriter &
+tinyspline::ContainerWriter::operator=(ContainerWriter &&other)
+{
+	if (&other != this) {
+		ts_container_writer_close(&m_writer, NULL);
+		m_writer = other.m_writer;
+		other.m_writer = ts_container_writer_init();
+	}
+	return *this;
+}
+
+void
+tinyspline::ContainerWriter::append(const BSpline &spline)
+{
+	tsStatus status;
+	if (ts_container_writer_append(&m_writer, &spline.m_spline, &status))
+		throw std::runtime_error(status.message);
+}
+
+void
+tinyspline::ContainerWriter::append(const BSplineView &view)
+{
+	tsStatus status;
+	if (ts_container_writer_append_view(&m_writer, &view.m_view,
+	                                    &status))
+		throw std::runtime_error(status.message);
+}
+
+void
+tinyspline::ContainerWriter::close()
+{
+	tsStatus status;
+	if (ts_container_writer_close(&m_writer, &status))
+		throw std::runtime_error(status.message);
+}
+/*! @} */
+
+
+
+/*! @name JSON Streams
+ *
+ * @{
+ */
+tinyspline::JsonStream::JsonStream(std::string path)
+: m_stream(ts_json_stream_init())
+{
+	tsStatus status;
+	if (ts_json_stream_open(path.c_str(), &m_stream, &status))
+		throw std::runtime_error(status.message);
+}
+
+tinyspline::JsonStream::JsonStream(std::string path,
+                                   size_t begin,
+                                   size_t end)
+: m_stream(ts_json_stream_init())
+{
+	tsStatus status;
+	if (ts_json_stream_open_range(path.c_str(), begin, end,
+	                              &m_stream, &status))
+		throw std::runtime_error(status.message);
+}
+
+tinyspline::JsonStream::JsonStream(JsonStream &&other)
+: m_stream(other.m_stream)
+{
+	other.m_stream = ts_json_stream_init();
+}
+
+tinyspline::JsonStream::~JsonStream()
+{
+	ts_json_stream_close(&m_stream);
+}
+
+tinyspline::JsonStream &
+tinyspline::JsonStream::operator=(JsonStream &&other)
+{
+	if (&other != this) {
+		ts_json_stream_close(&m_stream);
+		m_stream = other.m_stream;
+		other.m_stream = ts_json_stream_init();
+	}
+	return *this;
+}
+
+bool
+tinyspline::JsonStream::next(BSpline &spline)
+{
+	tsBSpline data = ts_bspline_init();
+	tsStatus status;
+	int done;
+	if (ts_json_stream_next(&m_stream, &data, &done, &status))
+		throw std::runtime_error(status.message);
+	if (done)
+		return false;
+	spline = BSpline(data);
+	return true;
+}
+
+size_t
+tinyspline::JsonStream::numRead() const
+{
+	return ts_json_stream_num_read(&m_stream);
+}
+
+std::string
+tinyspline::JsonStream::toString() const
+{
+	std::ostringstream oss;
+	oss << "JsonStream{"
+	    << "read: " << numRead()
+	    << "}";
+	return oss.str();
+}
+
+tinyspline::JsonStreamWriter::JsonStreamWriter(std::string path, bool lines)
+: m_writer(ts_json_stream_writer_init())
+{
+	tsStatus status;
+	if (ts_json_stream_writer_open(path.c_str(),
+	                               lines ? TS_JSON_LINES : TS_JSON_ARRAY,
+	                               &m_writer, &status))
+		throw std::runtime_error(status.message);
+}
+
+tinyspline::JsonStreamWriter::JsonStreamWriter(JsonStreamWriter &&other)
+: m_writer(other.m_writer)
+{
+	other.m_writer = ts_json_stream_writer_init();
+}
+
+tinyspline::JsonStreamWriter::~JsonStreamWriter()
+{
+	ts_json_stream_writer_close(&m_writer, NULL);
+}
+
+tinyspline::JsonStreamWriter &
+tinyspline::JsonStreamWriter::operator=(JsonStreamWriter &&other)
+{
+	if (&other != this) {
+		ts_json_stream_writer_close(&m_writer, NULL);
+		m_writer = other.m_writer;
+		other.m_writer = ts_json_stream_writer_init();
+	}
+	return *this;
+}
+
+void
+tinyspline::JsonStreamWriter::append(const BSpline &spline)
+{
+	tsStatus status;
+	if (ts_json_stream_writer_append(&m_writer, &spline.m_spline,
+	                                 &status))
+		throw std::runtime_error(status.message);
+}
+
+void
+tinyspline::JsonStreamWriter::append(const BSplineView &view)
+{
+	tsStatus status;
+	if (ts_json_stream_writer_append_view(&m_writer, &view.m_view,
+	                                      &status))
+		throw std::runtime_error(status.message);
+}
+
+void
+tinyspline::JsonStreamWriter::close()
+{
+	tsStatus status;
+	if (ts_json_stream_writer_close(&m_writer, &status))
+		throw std::runtime_error(status.message);
+}
+/*! @} */
+
+
+
+/*! @name Morphism
+ *
+ * @{
+ */
+tinyspline::Morphism::Morphism(const BSpline &origin,
+			       const BSpline &target,
+			       real epsilon)
+: m_origin(origin), m_target(target), m_epsilon(epsilon),
+  m_morphism(ts_morphism_init())
+{
+	tsStatus status;
+	if (ts_morphism_new(&origin.m_spline, &target.m_spline, epsilon,
+	                    &m_morphism, &status))
+		throw std::runtime_error(status.message);
+}
+
+tinyspline::Morphism::Morphism(const Morphism &other)
+: m_origin(other.m_origin), m_target(other.m_target),
+  m_epsilon(other.m_epsilon), m_morphism(ts_morphism_init())
+{
+	tsStatus status;
+	if (ts_morphism_copy(&other.m_morphism, &m_morphism, &status))
+		throw std::runtime_error(status.message);
+}
+
+tinyspline::Morphism::Morphism(Morphism &&other)
+: m_origin(std::move(other.m_origin)),
+  m_target(std::move(other.m_target)),
+  m_epsilon(other.m_epsilon),
+  m_morphism(other.m_morphism)
+{
+	other.m_morphism = ts_morphism_init();
+}
+
+tinyspline::Morphism::~Morphism()
+{
+	ts_morphism_free(&m_morphism);
+}
+
+tinyspline::Morphism &
+tinyspline::Morphism::operator=(const Morphism &other)
+{
+	if (&other != this) {
+		tsMorphism data = ts_morphism_init();
+		tsStatus status;
+		if (ts_morphism_copy(&other.m_morphism, &data, &status))
+			throw std::runtime_error(status.message);
+		m_origin = other.m_origin;
+		m_target = other.m_target;
+		m_epsilon = other.m_epsilon;
+		ts_morphism_free(&m_morphism);
+		m_morphism = data;
+	}
+	return *this;
+}
+
+tinyspline::Morphism &
+tinyspline::Morphism::operator=(Morphism &&other)
+{
+	if (&other != this) {
+		m_origin = std::move(other.m_origin);
+		m_target = std::move(other.m_target);
+		m_epsilon = other.m_epsilon;
+		ts_morphism_free(&m_morphism);
+		m_morphism = other.m_morphism;
+		other.m_morphism = ts_morphism_init();
+	}
+	return *this;
+}
+
+tinyspline::BSpline
+tinyspline::Morphism::eval(real t) const
+{
+	if (!m_morphism.pImpl)
+		throw std::runtime_error("morphism has been moved");
+	if (t <= 0) return m_origin;
+	if (t >= 1) return m_target;
+	BSpline out;
+	eval(t, out);
+	return out;
+}
+
+void
+tinyspline::Morphism::eval(real t,
+                           BSpline &out) const
+{
+	if (!m_morphism.pImpl)
+		throw std::runtime_error("morphism has been moved");
+	// Reuse `out' if it has the shape of a previous result.
+	if (!out.m_spline.pImpl ||
+	    out.degree() != ts_morphism_degree(&m_morphism) ||
+	    out.dimension() != ts_morphism_dimension(&m_morphism) ||
+	    out.numControlPoints() !=
+	    ts_morphism_num_control_points(&m_morphism)) {
+		tsBSpline data = ts_bspline_init();
+		tsStatus status;
+		if (ts_morphism_new_spline(&m_morphism, &data, &status))
+			throw std::runtime_error(status.message);
+		out = BSpline(data);
+	}
+	// ts_morphism_eval only reads `m_morphism'. Hence, concurrent calls
+	// are safe as long as they do not share `out'.
+	ts_morphism_eval(&m_morphism, t, &out.m_spline);
+}
+
+tinyspline::std_real_vector_out
+tinyspline::Morphism::evalAt(real t, real knot) const
+{
+	if (!m_morphism.pImpl)
+		throw std::runtime_error("morphism has been moved");
+	std_real_vector_init(point)(ts_morphism_dimension(&m_morphism));
+	tsStatus status;
+	if (ts_morphism_eval_at(&m_morphism, t, knot,
+	                        std_real_vector_read(point)data(),
+	                        &status)) {
+		throw std::runtime_error(status.message);
+	}
+	return point;
+}
+
+tinyspline::std_real_vector_out
+tinyspline::Morphism::evalGrid(std_real_vector_in ts,
+                               std_real_vector_in knots) const
+{
+	if (!m_morphism.pImpl)
+		throw std::runtime_error("morphism has been moved");
+	const size_t numTs = std_real_vector_read(ts)size();
+	const size_t numKnots = std_real_vector_read(knots)size();
+	const size_t dim = ts_morphism_dimension(&m_morphism);
+	std_real_vector_init(points)(numTs * numKnots * dim);
+	tsStatus status;
+	if (ts_morphism_eval_grid(&m_morphism,
+	                          std_real_vector_read(ts)data(), numTs,
+	                          std_real_vector_read(knots)data(), numKnots,
+	                          std_real_vector_read(points)data(),
+	                          &status)) {
+		throw std::runtime_error(status.message);
+	}
+	return points;
+}
+
+tinyspline::BSpline
+tinyspline::Morphism::origin() const
+{
+	return m_origin;
+}
+
+tinyspline::BSpline
+tinyspline::Morphism::target() const
+{
+	return m_target;
+}
+
+tinyspline::real
+tinyspline::Morphism::epsilon() const
+{
+	return m_epsilon;
+}
+
+tinyspline::BSpline
+tinyspline::Morphism::operator()(real t) const
+{
+	return eval(t);
+}
+
+std::string tinyspline::Morphism::toString() const
+{
+	std::ostringstream oss;
+	oss << "Morphism{"
+	    << "origin: " << m_origin.toString()
+	    << ", target: " << m_target.toString()
+	    << ", epsilon: " << epsilon()
+	    << "}";
+	return oss.str();
+}
+/*! @} */
+
+
+
+/*! @name ChordLenghts
+ * @{
+ */
+tinyspline::ChordLengths::ChordLengths()
+: m_spline(),
+  m_knots(nullptr),
+  m_lengths(nullptr),
+  m_size(0)
+{}
+
+tinyspline::ChordLengths::ChordLengths(const BSpline &spline,
+                                       real *knots,
+                                       real *lengths,
+                                       size_t size)
+: m_spline(spline),
+  m_knots(knots),
+  m_lengths(lengths),
+  m_size(size)
+{}
+
+tinyspline::ChordLengths::ChordLengths(const ChordLengths &other)
+: m_spline(other.m_spline),
+  m_knots(nullptr),
+  m_lengths(nullptr),
+  m_size(other.m_size)
+{
+	m_knots = new real[m_size];
+	std::copy(other.m_knots,
+	          other.m_knots + m_size,
+	          m_knots);
+	m_lengths = new real[m_size];
+	std::copy(other.m_lengths,
+	          other.m_lengths + m_size,
+	          m_lengths);
+}
+
+tinyspline::ChordLengths::ChordLengths(ChordLengths &&other)
+: m_spline(),
+  m_knots(nullptr),
+  m_lengths(nullptr),
+  m_size(0)
+{
+	*this = std::move(other);
+}
+
+tinyspline::ChordLengths::~ChordLengths()
+{
+	delete [] m_knots;
+	delete [] m_lengths;
+	m_size = 0;
+}
+
+tinyspline::ChordLengths &
+tinyspline::ChordLengths::operator=(const ChordLengths &other)
+{
+	if (&other != this) {
+		real *knots = new real[other.m_size];
+		std::copy(other.m_knots,
+		          other.m_knots + other.m_size,
+		          knots);
+		real *lengths = new real[other.m_size];
+		std::copy(other.m_lengths,
+		          other.m_lengths + other.m_size,
+		          lengths);
+		delete [] m_knots;
+		delete [] m_lengths;
+		m_spline = other.m_spline;
+		m_knots = knots;
+		m_lengths = lengths;
+		m_size = other.m_size;
+	}
+	return *this;
+}
+
+tinyspline::ChordLengths &
+tinyspline::ChordLengths::operator=(ChordLengths &&other)
+{
+	if (&other != this) {
+		delete [] m_knots;
+		delete [] m_lengths;
+		m_spline = other.m_spline;
+		m_knots = other.m_knots;
+		m_lengths = other.m_lengths;
+		m_size = other.m_size;
+		other.m_spline = BSpline();
+		other.m_knots = nullptr;
+		other.m_lengths = nullptr;
+		other.m_size = 0;
+	}
+	return *this;
+}
+
+tinyspline::BSpline
+tinyspline::ChordLengths::spline() const
+{
+	return m_spline;
+}
+
+std::vector<tinyspline::real>
+tinyspline::ChordLengths::knots() const
+{
+	return std::vector<real>(m_knots,
+	                         m_knots + m_size);
+}
+
+std::vector<tinyspline::real>
+tinyspline::ChordLengths::lengths() const
+{
+	return std::vector<real>(m_lengths,
+	                         m_lengths + m_size);
+}
+
+std::vector<tinyspline::real>
+tinyspline::ChordLengths::values() const
+{
+	return lengths();
 }
 
 size_t
@@ -1739,6 +2998,52 @@ tinyspline::ChordLengths::toString() const
 }
 /*! @} */
 
+
+
+/*! @name Statistics
+ *
+ * @{
+ */
+bool
+tinyspline::Stats::enabled()
+{
+	return ts_stats_enabled() != 0;
+}
+
+void
+tinyspline::Stats::reset()
+{
+	ts_stats_reset();
+}
+
+std::string
+tinyspline::Stats::toString()
+{
+	if (!enabled())
+		return "Stats{enabled: false}";
+	std::vector<tsStats> stats(ts_stats_get(nullptr, 0));
+	stats.resize(ts_stats_get(stats.data(), stats.size()));
+	std::ostringstream oss;
+	oss << std::left << std::setw(40) << "function" << std::right
+	    << std::setw(10) << "calls"
+	    << std::setw(10) << "allocs"
+	    << std::setw(12) << "bytes"
+	    << std::setw(10) << "evals"
+	    << std::setw(10) << "searches"
+	    << std::setw(12) << "insertions" << "\n";
+	for (const tsStats &s : stats) {
+		oss << std::left << std::setw(40) << s.function << std::right
+		    << std::setw(10) << s.num_calls
+		    << std::setw(10) << s.num_allocs
+		    << std::setw(12) << s.num_bytes
+		    << std::setw(10) << s.num_evals
+		    << std::setw(10) << s.num_knot_searches
+		    << std::setw(12) << s.num_knot_insertions << "\n";
+	}
+	return oss.str();
+}
+/*! @} */
+
 #ifdef _MSC_VER
 #pragma warning(pop)
 #endif
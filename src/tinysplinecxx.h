@@ -5,6 +5,9 @@
 #include "tinyspline.h"
 #include <vector>
 #include <string>
+#ifndef SWIG
+#include <functional>
+#endif
 
 #ifndef TINYSPLINECXX_API
 #define TINYSPLINECXX_API TINYSPLINE_API
@@ -12,6 +15,39 @@
 
 
 
+/*! @name C++20 Spans
+ *
+ * If TINYSPLINECXX_SPAN is non-zero, the classes of this header provide
+ * additional overloads taking and returning std::span. Read-only spans refer
+ * to the internal data of an object and remain valid as long as the object is
+ * neither modified nor destroyed. Output spans are filled in place and, thus,
+ * allow to evaluate splines in loops without allocating a new std::vector for
+ * each result. The overloads are defined inline so that the library itself
+ * can be compiled with C++11. By default, TINYSPLINECXX_SPAN is enabled if
+ * the standard library provides std::span. Define TINYSPLINECXX_SPAN as 0 to
+ * disable the overloads.
+ *
+ * @{
+ */
+#if !defined(TINYSPLINECXX_SPAN) && !defined(SWIG) && defined(__has_include)
+#if __has_include(<version>)
+#include <version>
+#endif
+#endif
+#ifndef TINYSPLINECXX_SPAN
+#if defined(__cpp_lib_span) && __cpp_lib_span >= 202002L
+#define TINYSPLINECXX_SPAN 1
+#else
+#define TINYSPLINECXX_SPAN 0
+#endif
+#endif
+#if TINYSPLINECXX_SPAN
+#include <span>
+#endif
+/*! @} */
+
+
+
 /*! @name Emscripten Extensions
  *
  * Please see the following references for more details on how to use
@@ -25,6 +61,7 @@
 #ifdef TINYSPLINE_EMSCRIPTEN
 
 // Additional includes and namespaces.
+#include <algorithm>
 #include <stdexcept>
 #include <emscripten/bind.h>
 using namespace emscripten;
@@ -540,6 +577,21 @@ public:
 	*/
 	Vec4 resultVec4(size_t idx = 0) const;
 
+#if TINYSPLINECXX_SPAN
+	/* Read-only views of ::points and ::result. */
+	std::span<const real> pointsSpan() const
+	{
+		return { ts_deboornet_points_ptr(&m_net),
+		         ts_deboornet_len_points(&m_net) };
+	}
+
+	std::span<const real> resultSpan() const
+	{
+		return { ts_deboornet_result_ptr(&m_net),
+		         ts_deboornet_len_result(&m_net) };
+	}
+#endif
+
 	std::string toString() const;
 
 private:
@@ -549,6 +601,8 @@ private:
 	explicit DeBoorNet(tsDeBoorNet &data);
 
 	friend class BSpline;
+	friend class BSplineView;
+	friend class Evaluator;
 
 #ifdef TINYSPLINE_EMSCRIPTEN
 public:
@@ -599,6 +653,8 @@ public:
 	                                     real epsilon = TS_POINT_EPSILON);
 	static BSpline parseJson(std::string json);
 	static BSpline load(std::string path);
+	static BSpline fromBinary(const std::vector<unsigned char> &data);
+	static BSpline loadBinary(std::string path);
 
 	static bool knotsEqual(real x, real y);
 
@@ -623,6 +679,7 @@ public:
 	DeBoorNet eval(real knot) const;
 	std_real_vector_out evalAll(std_real_vector_in knots) const;
 	std_real_vector_out sample(size_t num = 0) const;
+	std_real_vector_out tessellate(real tolerance) const;
 	DeBoorNet bisect(real value,
 	                 real epsilon = (real) 0.0,
 	                 bool persnickety = false,
@@ -643,6 +700,11 @@ public:
 	/* Serialization */
 	std::string toJson() const;
 	void save(std::string path) const;
+	std::vector<unsigned char> toBinary() const;
+	void saveBinary(std::string path) const;
+	std::vector<unsigned char> toQuantized(size_t bits = 16,
+	                                       real *maxError = nullptr) const;
+	real saveQuantized(std::string path, size_t bits = 16) const;
 
 	/* Modifications */
 	void setControlPoints(const std::vector<real> &ctrlp);
@@ -661,6 +723,12 @@ public:
 	               real eps = TS_POINT_EPSILON) const;
 	BSpline elevateDegree(size_t amount,
 	                      real eps = TS_POINT_EPSILON) const;
+	BSpline elevateDegreeDirect(size_t amount) const;
+	BSpline reduceDegree(size_t amount,
+	                     real tolerance = TS_POINT_EPSILON) const;
+	BSpline reduceDegree(size_t amount,
+	                     real tolerance,
+	                     real &error) const;
 	BSpline alignWith(const BSpline &other,
 	                  BSpline &otherAligned,
 	                  real eps = TS_POINT_EPSILON) const;
@@ -670,14 +738,75 @@ public:
 	/* Debug */
 	std::string toString() const;
 
+#if TINYSPLINECXX_SPAN
+	/* Read-only views of ::controlPoints and ::knots. */
+	std::span<const real> controlPointsSpan() const
+	{
+		return { ts_bspline_control_points_ptr(&m_spline),
+		         ts_bspline_len_control_points(&m_spline) };
+	}
+
+	std::span<const real> knotsSpan() const
+	{
+		return { ts_bspline_knots_ptr(&m_spline),
+		         ts_bspline_num_knots(&m_spline) };
+	}
+
+	/**
+	 * Evaluates this spline at each knot of \p knots and stores the
+	 * results in \p points.
+	 *
+	 * @throws std::runtime_error
+	 * 	If \p points is smaller than \p knots.size() * ::dimension, or if
+	 * 	this spline is not defined at one of the knots.
+	 */
+	void evalAll(std::span<const real> knots,
+	             std::span<real> points) const
+	{
+		evalAllInto(knots.data(), knots.size(),
+		            points.data(), points.size());
+	}
+
+	/**
+	 * Samples \p points.size() / ::dimension points (see ::sample) and
+	 * stores them in \p points.
+	 *
+	 * @return
+	 * 	The number of sampled points.
+	 */
+	size_t sample(std::span<real> points) const
+	{ return sampleInto(points.data(), points.size()); }
+
+	/* Fills \p knots with ::uniformKnotSeq(\p knots.size()). */
+	void uniformKnotSeq(std::span<real> knots) const
+	{
+		ts_bspline_uniform_knot_seq(&m_spline, knots.size(),
+		                            knots.data());
+	}
+#endif
+
 private:
 	tsBSpline m_spline;
 
 	/* Constructors & Destructors */
 	explicit BSpline(tsBSpline &data);
 
+	/* Backends of the std::span overloads (see TINYSPLINECXX_SPAN). */
+	void evalAllInto(const real *knots,
+	                 size_t numKnots,
+	                 real *points,
+	                 size_t lenPoints) const;
+	size_t sampleInto(real *points, size_t lenPoints) const;
+
 	/* Needs to access ::spline. */
 	friend class Morphism;
+	friend class BSplineView;
+	friend class Evaluator;
+	friend class Container;
+	friend class ContainerWriter;
+	friend class JsonStream;
+	friend class JsonStreamWriter;
+	friend class Batch;
 
 #ifdef TINYSPLINE_EMSCRIPTEN
 public:
@@ -692,7 +821,344 @@ public:
 
 
 
+/*! @name BSplineView
+ *
+ * Wrapper class for ::tsBSplineView. The referenced memory must remain valid
+ * as long as an instance is in use.
+ *
+ * @{
+ */
+class TINYSPLINECXX_API BSplineView {
+public:
+	BSplineView(const real *controlPoints,
+	            size_t numControlPoints,
+	            size_t dimension,
+	            size_t degree,
+	            const real *knots,
+	            size_t controlPointStride = 0,
+	            size_t knotStride = 0);
+	explicit BSplineView(const BSpline &spline);
+
+	/* Operators */
+	DeBoorNet operator()(real knot) const;
+
+	/* Accessors */
+	size_t degree() const;
+	size_t order() const;
+	size_t dimension() const;
+	size_t numControlPoints() const;
+
+	/* Query */
+	DeBoorNet eval(real knot) const;
+	std_real_vector_out evalAll(std_real_vector_in knots) const;
+	std_real_vector_out sample(size_t num = 0) const;
+	DeBoorNet bisect(real value,
+	                 real epsilon = (real) 0.0,
+	                 bool persnickety = false,
+	                 size_t index = 0,
+	                 bool ascending = true,
+	                 size_t maxIter = 50) const;
+	Domain domain() const;
+	ChordLengths chordLengths(std_real_vector_in knots) const;
+
+	/* Serialization */
+	std::string toJson() const;
+	void save(std::string path) const;
+	std::vector<unsigned char> toBinary() const;
+	void saveBinary(std::string path) const;
+
+	/* Conversion */
+	BSpline toBSpline() const;
+
+	/* Debug */
+	std::string toString() const;
+
+private:
+	tsBSplineView m_view;
+
+	friend class Evaluator;
+	friend class ContainerWriter;
+	friend class JsonStreamWriter;
+};
+/*! @} */
+
+
+
+/*! @name Evaluation Context
+ *
+ * Wrapper class for ::tsEvalContext.
+ *
+ * @{
+ */
+class TINYSPLINECXX_API Evaluator {
+public:
+	explicit Evaluator(size_t maxDegree = 3, size_t maxDimension = 3);
+	Evaluator(const Evaluator &other);
+	Evaluator(Evaluator &&other);
+	virtual ~Evaluator();
+
+	Evaluator & operator=(const Evaluator &other);
+	Evaluator & operator=(Evaluator &&other);
+
+	/**
+	 * Evaluates \p spline at \p knot without allocating memory (unless
+	 * \p spline exceeds the capacity of this evaluator).
+	 *
+	 * @return
+	 * 	The result of the evaluation. The returned pointer is owned by
+	 * 	this evaluator and remains valid until the next evaluation.
+	 * @throws std::runtime_error
+	 * 	If \p spline is not defined at \p knot.
+	 */
+	const real *eval(const BSpline &spline, real knot);
+	const real *eval(const BSplineView &view, real knot);
+
+	/* Returns a copy of the net of the last evaluation. */
+	DeBoorNet net() const;
+
+	std::string toString() const;
+
+private:
+	tsEvalContext m_ctx;
+	size_t m_maxDegree, m_maxDimension;
+	friend class Batch;
+};
+/*! @} */
+
+
+
+/*! @name Batch Processing
+ *
+ * Applies an operation to many independent splines using a pool of threads.
+ * The worker threads of a Batch are started on first use and are kept alive
+ * (waiting for the next operation) until the Batch is destroyed. Thus,
+ * repeated operations do not pay for thread creation. The operations of a
+ * Batch are serialized, i.e., concurrent calls on the same Batch wait for
+ * each other, and an operation must not call its own Batch.
+ *
+ * The splines are grouped into chunks of roughly equal (estimated) cost and
+ * each thread processes the chunks of its own queue before stealing chunks
+ * from the queues of other threads. Thus, the load is balanced even if the
+ * sizes of the splines vary widely. The results of all splines are stored in
+ * one contiguous buffer (see BatchResult).
+ *
+ * The splines are only read (see the thread safety notes of ::tsBSpline) and
+ * must not be modified while a batch is running. Not available in the
+ * bindings.
+ *
+ * @{
+ */
+#ifndef SWIG
+/**
+ * The results of a batch. The values of spline \c i are stored in
+ * <tt>values()[offsets()[i], offsets()[i + 1])</tt>.
+ */
+class TINYSPLINECXX_API BatchResult {
+public:
+	/* Number of splines. */
+	size_t size() const;
+	const real *data(size_t index) const;
+	size_t length(size_t index) const;
+
+	const std::vector<real> &values() const;
+	/* size() + 1 elements. */
+	const std::vector<size_t> &offsets() const;
+
+private:
+	std::vector<real> m_values;
+	std::vector<size_t> m_offsets;
+	friend class Batch;
+};
+
+class TINYSPLINECXX_API Batch {
+public:
+	/**
+	 * Returns the number of values a spline produces.
+	 */
+	using LengthFunc = std::function<size_t(const BSpline &)>;
+
+	/**
+	 * Computes the values of a spline and stores them in the output
+	 * buffer, which has the length returned by LengthFunc. Must be
+	 * thread-safe.
+	 */
+	using Operation = std::function<void(const BSpline &, real *)>;
+
+	/**
+	 * Creates a batch processor with \p numThreads threads (including
+	 * the calling thread). If \p numThreads is 0, the number of hardware
+	 * threads is used.
+	 */
+	explicit Batch(size_t numThreads = 0);
+
+	/**
+	 * Copies the number of threads of \p other. The copy starts its own
+	 * worker threads.
+	 */
+	Batch(const Batch &other);
+	~Batch();
+
+	Batch & operator=(const Batch &other);
+
+	size_t numThreads() const;
+
+	/**
+	 * Samples each spline at \p num points (see BSpline::sample).
+	 */
+	BatchResult sample(const std::vector<BSpline> &splines,
+	                   size_t num = 100) const;
+
+	/**
+	 * Computes the chord lengths of each spline at \p num uniformly
+	 * distributed knots (see BSpline::chordLengths).
+	 */
+	BatchResult chordLengths(const std::vector<BSpline> &splines,
+	                         size_t num = 100) const;
+
+	/**
+	 * Applies \p op to each spline.
+	 *
+	 * @throws
+	 * 	The first exception thrown by \p op. The remaining splines
+	 * 	are skipped in this case.
+	 */
+	BatchResult map(const std::vector<BSpline> &splines,
+	                const LengthFunc &length,
+	                const Operation &op) const;
+
+	std::string toString() const;
+
+private:
+	/* The worker threads (see tinysplinecxx.cxx). */
+	struct Pool;
+
+	size_t m_numThreads;
+	Pool *m_pool;
+
+	/* Runs `op(thread, index)' for all splines with the given costs. */
+	void run(const std::vector<size_t> &costs,
+	         const std::function<void(size_t, size_t)> &op) const;
+};
+#endif
+/*! @} */
+
+
+
+/*! @name Spline Containers
+ *
+ * Wrapper classes for ::tsContainer and ::tsContainerWriter.
+ *
+ * @{
+ */
+class TINYSPLINECXX_API Container {
+public:
+	explicit Container(std::string path);
+	Container(const Container &other) = delete;
+	Container(Container &&other);
+	virtual ~Container();
+
+	Container & operator=(const Container &other) = delete;
+	Container & operator=(Container &&other);
+
+	size_t numSplines() const;
+
+	/**
+	 * Returns a view of the spline at \p index. The view points into the
+	 * memory of this container and must not outlive it.
+	 */
+	BSplineView view(size_t index) const;
+
+	/**
+	 * Same as #view, but additionally validates the knots of the view.
+	 */
+	BSplineView checkedView(size_t index) const;
+	BSpline load(size_t index) const;
+
+	std::string toString() const;
+
+private:
+	tsContainer m_container;
+};
+
+class TINYSPLINECXX_API ContainerWriter {
+public:
+	explicit ContainerWriter(std::string path, bool append = false);
+	ContainerWriter(const ContainerWriter &other) = delete;
+	ContainerWriter(ContainerWriter &&other);
+	/* Closes the writer, but ignores errors. Call close to detect them. */
+	virtual ~ContainerWriter();
+
+	ContainerWriter & operator=(const ContainerWriter &other) = delete;
+	ContainerWriter & operator=(ContainerWriter &&other);
+
+	void append(const BSpline &spline);
+	void append(const BSplineView &view);
+	void close();
+
+private:
+	tsContainerWriter m_writer;
+};
+/*! @} */
+
+
+
+/*! @name JSON Streams
+ *
+ * Wrapper classes for ::tsJsonStream and ::tsJsonStreamWriter.
+ *
+ * @{
+ */
+class TINYSPLINECXX_API JsonStream {
+public:
+	explicit JsonStream(std::string path);
+	/* Reads the byte range [begin, end) of a newline-delimited file. */
+	JsonStream(std::string path, size_t begin, size_t end);
+	JsonStream(const JsonStream &other) = delete;
+	JsonStream(JsonStream &&other);
+	virtual ~JsonStream();
+
+	JsonStream & operator=(const JsonStream &other) = delete;
+	JsonStream & operator=(JsonStream &&other);
+
+	/**
+	 * Reads the next spline into \p spline. Returns false (and leaves \p
+	 * spline unchanged) if the end of the stream has been reached.
+	 */
+	bool next(BSpline &spline);
+	size_t numRead() const;
+
+	std::string toString() const;
+
+private:
+	tsJsonStream m_stream;
+};
+
+class TINYSPLINECXX_API JsonStreamWriter {
+public:
+	explicit JsonStreamWriter(std::string path, bool lines = false);
+	JsonStreamWriter(const JsonStreamWriter &other) = delete;
+	JsonStreamWriter(JsonStreamWriter &&other);
+	/* Closes the writer, but ignores errors. Call close to detect them. */
+	virtual ~JsonStreamWriter();
+
+	JsonStreamWriter & operator=(const JsonStreamWriter &other) = delete;
+	JsonStreamWriter & operator=(JsonStreamWriter &&other);
+
+	void append(const BSpline &spline);
+	void append(const BSplineView &view);
+	void close();
+
+private:
+	tsJsonStreamWriter m_writer;
+};
+/*! @} */
+
+
+
 /*! @name Spline Morphing
+ *
+ * A morphism is immutable after construction. Thus, the same instance can
+ * be evaluated from multiple threads concurrently.
  *
  * @{
  */
@@ -701,20 +1167,59 @@ public:
 	Morphism(const BSpline &origin,
 		 const BSpline &target,
 		 real epsilon = TS_POINT_EPSILON);
+	Morphism(const Morphism &other);
+	Morphism(Morphism &&other);
+	virtual ~Morphism();
+
+	Morphism &operator=(const Morphism &other);
+	Morphism &operator=(Morphism &&other);
 
 	BSpline origin() const;
 	BSpline target() const;
 	real epsilon() const;
 
-	BSpline eval(real t);
-	BSpline operator()(real t);
+	/**
+	 * Returns the spline at \p t. If \p t <= 0, a copy of the origin is
+	 * returned; if \p t >= 1, a copy of the target is returned. Otherwise,
+	 * the result has the degree and number of control points of the
+	 * aligned splines.
+	 */
+	BSpline eval(real t) const;
+	/**
+	 * Stores the spline at \p t in \p out (see ::ts_morphism_eval). The
+	 * memory of \p out is reused if it is a result of a previous call, so
+	 * that calling this function in a loop does not allocate memory.
+	 *
+	 * Unlike the overload returning a spline, this function always
+	 * interpolates the aligned splines (\p t is clamped to [0, 1]). That
+	 * is, \p out has the same degree and number of control points for
+	 * every \p t, which may differ from those of the origin and target
+	 * even if \p t is 0 or 1.
+	 */
+	void eval(real t, BSpline &out) const;
+	/**
+	 * Same as the overload of \c eval returning a spline.
+	 */
+	BSpline operator()(real t) const;
+
+	/**
+	 * Evaluates the spline at \p t at \p knot without creating it (see
+	 * ::ts_morphism_eval_at).
+	 */
+	std_real_vector_out evalAt(real t, real knot) const;
+	/**
+	 * Evaluates the splines at \p ts at \p knots (see
+	 * ::ts_morphism_eval_grid). The point of <tt>(ts[i], knots[j])</tt>
+	 * is located at <tt>(i * knots.size() + j) * dimension</tt>.
+	 */
+	std_real_vector_out evalGrid(std_real_vector_in ts,
+	                             std_real_vector_in knots) const;
 
 	std::string toString() const;
 private:
 	BSpline m_origin, m_target;
 	real m_epsilon;
-	BSpline m_originAligned, m_targetAligned;
-	BSpline m_buffer;
+	tsMorphism m_morphism;
 };
 /*! @} */
 
@@ -754,9 +1259,93 @@ private:
 	             real *lengths,
 	             size_t size);
 	friend class BSpline;
+	friend class BSplineView;
+	friend class Evaluator;
 };
 /*! @} */
 
+
+
+/*! @name Statistics
+ *
+ * Wrapper for ::ts_stats_get and ::ts_stats_reset. The counters are only
+ * available if TinySpline has been built with TINYSPLINE_ENABLE_STATS.
+ *
+ * @{
+ */
+class TINYSPLINECXX_API Stats {
+public:
+	static bool enabled();
+	static void reset();
+
+	/* Table of the counters of the calling thread (one row per
+	 * function). */
+	static std::string toString();
+};
+/*! @} */
+
+
+
+#ifdef TINYSPLINE_EMSCRIPTEN
+/*! @name Typed Array Views (JavaScript)
+ *
+ * BSpline::sample and BSpline::evalAll copy their results into new JavaScript
+ * arrays. An EvalBuffer, in contrast, evaluates splines into memory that it
+ * owns and returns a typed array (Float64Array, or Float32Array with float
+ * precision) that refers to this memory. Reusing a buffer for all splines of
+ * a frame does not allocate any memory once the buffer has grown to its final
+ * size. A returned view is valid until the next call on the same buffer and
+ * must be copied (e.g., with slice()) to be kept. Growing the wasm memory
+ * detaches all views.
+ *
+ * @{
+ */
+class EvalBuffer {
+public:
+	EvalBuffer() : m_evaluator(), m_points(), m_knots() {}
+
+	val sample(const BSpline &spline, size_t num)
+	{
+		const Domain domain = spline.domain();
+		const real min = domain.min(), max = domain.max();
+		num = num == 0 ? 100 : num;
+		m_knots.resize(num);
+		/* Same knots as ts_bspline_sample. */
+		for (size_t i = 0; i < num; i++)
+			m_knots[i] = min + (max - min) * ((real) i / (num - 1));
+		m_knots[num - 1] = max;
+		m_knots[0] = min;
+		return eval(spline);
+	}
+
+	val evalAll(const BSpline &spline, const val &knots)
+	{
+		/* Bulk copy if knots is a typed array. */
+		m_knots = convertJSArrayToNumberVector<real>(knots);
+		return eval(spline);
+	}
+
+private:
+	Evaluator m_evaluator;
+	std::vector<real> m_points, m_knots;
+
+	val eval(const BSpline &spline)
+	{
+		const size_t dim = spline.dimension();
+		m_points.resize(m_knots.size() * dim);
+		for (size_t i = 0; i < m_knots.size(); i++) {
+			const real *result =
+				m_evaluator.eval(spline, m_knots[i]);
+			std::copy(result, result + dim,
+			          m_points.begin() + i * dim);
+		}
+		return val(typed_memory_view(m_points.size(),
+		                             m_points.data()));
+	}
+};
+/*! @} */
+#endif
+
 }
 
 
@@ -932,6 +1521,7 @@ EMSCRIPTEN_BINDINGS(tinyspline) {
 			select_overload<std_real_vector_out(size_t) const>
 			(&BSpline::sample1))
 	        .function("sample", &BSpline::sample)
+	        .function("tessellate", &BSpline::tessellate)
 	        .function("bisect", &BSpline::bisect)
 	        .function("isClosed", &BSpline::isClosed)
 
@@ -957,6 +1547,12 @@ EMSCRIPTEN_BINDINGS(tinyspline) {
 	        .function("toString", &BSpline::toString)
 	;
 
+	class_<EvalBuffer>("EvalBuffer")
+	        .constructor<>()
+	        .function("sample", &EvalBuffer::sample)
+	        .function("evalAll", &EvalBuffer::evalAll)
+	;
+
 	enum_<BSpline::Type>("BSplineType")
 	        .value("Opened", BSpline::Type::Opened)
 	        .value("Clamped", BSpline::Type::Clamped)
@@ -0,0 +1,254 @@
+#include <testutils.h>
+
+typedef struct
+{
+	size_t num_allocs;
+	size_t num_frees;
+	size_t bytes;
+} alloc_counter;
+
+void *counting_allocate(size_t size, void *user_data)
+{
+	alloc_counter *counter = (alloc_counter *) user_data;
+	counter->num_allocs++;
+	counter->bytes += size;
+	return malloc(size);
+}
+
+void counting_deallocate(void *ptr, size_t size, void *user_data)
+{
+	alloc_counter *counter = (alloc_counter *) user_data;
+	counter->num_frees++;
+	counter->bytes -= size;
+	free(ptr);
+}
+
+void *failing_reallocate(void *ptr, size_t old_size, size_t size,
+	void *user_data)
+{
+	(void) ptr;
+	(void) old_size;
+	(void) size;
+	(void) user_data;
+	return NULL;
+}
+
+void allocator_thread_allocator(CuTest *tc)
+{
+	___SETUP___
+	tsBSpline spline = ts_bspline_init();
+	tsBSpline elevated = ts_bspline_init();
+	tsDeBoorNet net = ts_deboornet_init();
+	alloc_counter counter = { 0, 0, 0 };
+	tsAllocator allocator;
+	const tsAllocator *prev = NULL;
+
+	allocator.allocate = counting_allocate;
+	allocator.reallocate = NULL;
+	allocator.deallocate = counting_deallocate;
+	allocator.user_data = &counter;
+
+	___GIVEN___
+	prev = ts_set_thread_allocator(&allocator);
+	CuAssertPtrEquals(tc, (void *) &allocator,
+		(void *) ts_active_allocator());
+	C(ts_bspline_new_with_control_points(
+		4, 2, 3, TS_CLAMPED, &spline, &status,
+		-1.75, -1.0,
+		-1.5,  -0.5,
+		-1.5,   0.0,
+		-1.25,  0.5))
+
+	___WHEN___
+	C(ts_bspline_eval(&spline, (tsReal) 0.5, &net, &status))
+	C(ts_bspline_elevate_degree(&spline, 2, POINT_EPSILON,
+		&elevated, &status))
+	ts_set_thread_allocator(prev);
+
+	___THEN___
+	CuAssertTrue(tc, counter.num_allocs >= 3);
+	assert_equal_shape(tc, &spline, &elevated);
+
+	___TEARDOWN___
+	ts_set_thread_allocator(prev);
+	/* Blocks are released with the allocator they were obtained from. */
+	ts_bspline_free(&spline);
+	ts_bspline_free(&elevated);
+	ts_deboornet_free(&net);
+	CuAssertTrue(tc, counter.num_allocs == counter.num_frees);
+	CuAssertTrue(tc, counter.bytes == 0);
+}
+
+void allocator_arena(CuTest *tc)
+{
+	___SETUP___
+	tsBSpline s1 = ts_bspline_init();
+	tsBSpline s2 = ts_bspline_init();
+	tsBSpline s1_al = ts_bspline_init();
+	tsBSpline s2_al = ts_bspline_init();
+	tsBSpline morph = ts_bspline_init();
+	double memory[4096];
+	tsArena arena;
+	const tsAllocator *prev = NULL;
+
+	ts_arena_init(&arena, memory, sizeof(memory));
+
+	___GIVEN___
+	prev = ts_set_thread_allocator(&arena.allocator);
+	C(ts_bspline_new_with_control_points(
+		4, 2, 3, TS_CLAMPED, &s1, &status,
+		0.0, 0.0,
+		1.0, 1.0,
+		2.0, 1.0,
+		3.0, 0.0))
+	C(ts_bspline_new_with_control_points(
+		3, 2, 1, TS_CLAMPED, &s2, &status,
+		0.0, 1.0,
+		1.5, 2.0,
+		3.0, 1.0))
+
+	___WHEN___
+	C(ts_bspline_align(&s1, &s2, POINT_EPSILON, &s1_al, &s2_al, &status))
+	C(ts_bspline_morph(&s1, &s2, (tsReal) 0.5, POINT_EPSILON,
+		&morph, &status))
+	ts_set_thread_allocator(prev);
+
+	___THEN___
+	CuAssertTrue(tc, arena.used > 0);
+	CuAssertTrue(tc, arena.peak >= arena.used);
+	CuAssertTrue(tc, arena.num_overflows == 0);
+	CuAssertIntEquals(tc, 3, (int) ts_bspline_degree(&s2_al));
+	CuAssertIntEquals(tc, (int) ts_bspline_num_control_points(&s1_al),
+		(int) ts_bspline_num_control_points(&s2_al));
+	CuAssertIntEquals(tc, (int) ts_bspline_num_control_points(&s1_al),
+		(int) ts_bspline_num_control_points(&morph));
+
+	___TEARDOWN___
+	ts_set_thread_allocator(prev);
+	ts_arena_reset(&arena);
+	CuAssertTrue(tc, arena.used == 0);
+	CuAssertTrue(tc, arena.peak == 0);
+}
+
+void allocator_arena_overflow(CuTest *tc)
+{
+	___SETUP___
+	tsBSpline spline = ts_bspline_init();
+	tsBSpline beziers = ts_bspline_init();
+	double memory[8];
+	tsArena arena;
+	const tsAllocator *prev = NULL;
+
+	ts_arena_init(&arena, memory, sizeof(memory));
+
+	___GIVEN___
+	prev = ts_set_thread_allocator(&arena.allocator);
+	C(ts_bspline_new(7, 3, 3, TS_OPENED, &spline, &status))
+
+	___WHEN___
+	C(ts_bspline_to_beziers(&spline, &beziers, &status))
+	ts_set_thread_allocator(prev);
+
+	___THEN___
+	CuAssertTrue(tc, arena.num_overflows > 0);
+	CuAssertTrue(tc, arena.used <= arena.size);
+	assert_equal_shape(tc, &spline, &beziers);
+
+	___TEARDOWN___
+	ts_set_thread_allocator(prev);
+	ts_bspline_free(&beziers);
+	ts_arena_reset(&arena);
+	spline = ts_bspline_init();
+	CuAssertTrue(tc, arena.overflows == NULL);
+	CuAssertTrue(tc, arena.num_overflows == 0);
+}
+
+void allocator_global_allocator(CuTest *tc)
+{
+	___SETUP___
+	tsBSpline spline = ts_bspline_init();
+	tsBSpline copy = ts_bspline_init();
+	alloc_counter counter = { 0, 0, 0 };
+	tsAllocator allocator;
+	const tsAllocator *prev = NULL;
+
+	allocator.allocate = counting_allocate;
+	allocator.reallocate = NULL;
+	allocator.deallocate = counting_deallocate;
+	allocator.user_data = &counter;
+
+	___GIVEN___
+	C(ts_bspline_new(4, 2, 3, TS_CLAMPED, &spline, &status))
+
+	___WHEN___
+	prev = ts_set_allocator(&allocator);
+	C(ts_bspline_copy(&spline, &copy, &status))
+	ts_set_allocator(prev);
+
+	___THEN___
+	CuAssertTrue(tc, counter.num_allocs == 1);
+	CuAssertTrue(tc, counter.num_frees == 0);
+
+	___TEARDOWN___
+	ts_set_allocator(prev);
+	ts_bspline_free(&spline);
+	ts_bspline_free(&copy);
+	CuAssertTrue(tc, counter.num_frees == 1);
+}
+
+void allocator_failing_reallocate(CuTest *tc)
+{
+	___SETUP___
+	tsBSpline spline = ts_bspline_init();
+	tsBSpline elevated = ts_bspline_init();
+	tsBSpline reduced = ts_bspline_init();
+	alloc_counter counter = { 0, 0, 0 };
+	tsAllocator allocator;
+	const tsAllocator *prev = NULL;
+	tsError err;
+
+	allocator.allocate = counting_allocate;
+	allocator.reallocate = failing_reallocate;
+	allocator.deallocate = counting_deallocate;
+	allocator.user_data = &counter;
+
+	___GIVEN___
+	C(ts_bspline_new_with_control_points(
+		4, 2, 3, TS_CLAMPED, &spline, &status,
+		-1.75, -1.0,
+		-1.5,  -0.5,
+		-1.5,   0.0,
+		-1.25,  0.5))
+	C(ts_bspline_elevate_degree(&spline, 1, POINT_EPSILON,
+		&elevated, &status))
+
+	___WHEN___
+	prev = ts_set_thread_allocator(&allocator);
+	err = ts_bspline_reduce_degree(&elevated, 1, POINT_EPSILON,
+		&reduced, NULL, NULL);
+	ts_set_thread_allocator(prev);
+
+	___THEN___
+	CuAssertIntEquals(tc, TS_MALLOC, err);
+	CuAssertPtrEquals(tc, NULL, reduced.pImpl);
+	CuAssertTrue(tc, counter.num_allocs > 0);
+	CuAssertTrue(tc, counter.num_allocs == counter.num_frees);
+	CuAssertTrue(tc, counter.bytes == 0);
+
+	___TEARDOWN___
+	ts_set_thread_allocator(prev);
+	ts_bspline_free(&spline);
+	ts_bspline_free(&elevated);
+	ts_bspline_free(&reduced);
+}
+
+CuSuite* get_allocator_suite()
+{
+	CuSuite* suite = CuSuiteNew();
+	SUITE_ADD_TEST(suite, allocator_thread_allocator);
+	SUITE_ADD_TEST(suite, allocator_arena);
+	SUITE_ADD_TEST(suite, allocator_arena_overflow);
+	SUITE_ADD_TEST(suite, allocator_global_allocator);
+	SUITE_ADD_TEST(suite, allocator_failing_reallocate);
+	return suite;
+}
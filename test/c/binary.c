@@ -0,0 +1,241 @@
+#include <testutils.h>
+
+tsError binary_new_spline(tsBSpline *spline, tsStatus *status)
+{
+	return ts_bspline_new_with_control_points(
+		6, 2, 5, TS_OPENED, spline, status,
+		 100.0,    0.0,
+		 200.0,  -10.7,
+		 500.5,   40.0,
+		-300.0, -260.0,
+		-50.1,   200.0,
+		-80.0,   130.24);
+}
+
+void binary_round_trip(CuTest *tc)
+{
+	___SETUP___
+	tsBSpline spline = ts_bspline_init();
+	tsBSpline parsed = ts_bspline_init();
+	unsigned char *data = NULL;
+	size_t size;
+
+	___GIVEN___
+	C(binary_new_spline(&spline, &status))
+
+	___WHEN___
+	C(ts_bspline_to_binary(&spline, &data, &size, &status))
+	C(ts_bspline_from_binary(data, size, &parsed, &status))
+
+	___THEN___
+	CuAssertIntEquals(tc, TS_BINARY_HEADER_SIZE +
+		(6 * 2 + 12) * sizeof(tsReal), (int) size);
+	CuAssertTrue(tc, memcmp(data, TS_BINARY_MAGIC, 4) == 0);
+	CuAssertIntEquals(tc, TS_BINARY_VERSION, data[4]);
+	CuAssertIntEquals(tc, (int) sizeof(tsReal), data[5]);
+	CuAssertIntEquals(tc, 5, data[8]);  /* degree */
+	CuAssertIntEquals(tc, 2, data[16]); /* dimension */
+	CuAssertIntEquals(tc, 6, data[24]); /* control points */
+	CuAssertIntEquals(tc, 12, data[32]); /* knots */
+	/* Values are stored bit-exact. */
+	CuAssertIntEquals(tc, (int) ts_bspline_degree(&spline),
+		(int) ts_bspline_degree(&parsed));
+	CuAssertTrue(tc, memcmp(ts_bspline_control_points_ptr(&spline),
+		ts_bspline_control_points_ptr(&parsed),
+		ts_bspline_sof_control_points(&spline)) == 0);
+	CuAssertTrue(tc, memcmp(ts_bspline_knots_ptr(&spline),
+		ts_bspline_knots_ptr(&parsed),
+		ts_bspline_sof_knots(&spline)) == 0);
+
+	___TEARDOWN___
+	ts_bspline_free(&spline);
+	ts_bspline_free(&parsed);
+	free(data);
+}
+
+void binary_save_load(CuTest *tc)
+{
+	___SETUP___
+	tsBSpline spline = ts_bspline_init();
+	tsBSpline loaded = ts_bspline_init();
+	tsBSplineView view;
+	tsReal interleaved[18];
+	unsigned char *expected = NULL, *actual = NULL;
+	size_t i, size_expected, size_actual;
+	const char *file = "binary_test_file.bin";
+
+	___GIVEN___
+	C(binary_new_spline(&spline, &status))
+	for (i = 0; i < 6; i++) {
+		interleaved[i * 3] = ts_bspline_control_points_ptr(
+			&spline)[i * 2];
+		interleaved[i * 3 + 1] = ts_bspline_control_points_ptr(
+			&spline)[i * 2 + 1];
+		interleaved[i * 3 + 2] = (tsReal) -1.0;
+	}
+	C(ts_bspline_view_init(6, 2, 5, interleaved, 3,
+		ts_bspline_knots_ptr(&spline), 1, &view, &status))
+
+	___WHEN___
+	C(ts_bspline_view_save_binary(&view, file, &status))
+	C(ts_bspline_load_binary(file, &loaded, &status))
+
+	___THEN___
+	C(ts_bspline_to_binary(&spline, &expected, &size_expected, &status))
+	C(ts_bspline_to_binary(&loaded, &actual, &size_actual, &status))
+	CuAssertIntEquals(tc, (int) size_expected, (int) size_actual);
+	CuAssertTrue(tc, memcmp(expected, actual, size_expected) == 0);
+
+	___TEARDOWN___
+	ts_bspline_free(&spline);
+	ts_bspline_free(&loaded);
+	free(expected);
+	free(actual);
+	remove(file);
+}
+
+void binary_float_to_real(CuTest *tc)
+{
+	___SETUP___
+	tsBSpline spline = ts_bspline_init();
+	unsigned char data[TS_BINARY_HEADER_SIZE + 6 * 4];
+	const float values[6] = { 1.f, 2.f, 0.f, 0.f, 1.f, 1.f };
+	unsigned char *bytes;
+	size_t i, j;
+	int le = 1;
+
+	___GIVEN___
+	/* Little endian float spline with 2 points of dimension 1. */
+	memset(data, 0, sizeof(data));
+	memcpy(data, TS_BINARY_MAGIC, 4);
+	data[4] = TS_BINARY_VERSION;
+	data[5] = 4;
+	data[8] = 1;  /* degree */
+	data[16] = 1; /* dimension */
+	data[24] = 2; /* control points */
+	data[32] = 4; /* knots */
+	le = *((unsigned char *) &le) == 1;
+	for (i = 0; i < 6; i++) {
+		bytes = (unsigned char *) (values + i);
+		for (j = 0; j < 4; j++) {
+			data[TS_BINARY_HEADER_SIZE + i * 4 + j] =
+				bytes[le ? j : 3 - j];
+		}
+	}
+
+	___WHEN___
+	C(ts_bspline_from_binary(data, sizeof(data), &spline, &status))
+
+	___THEN___
+	CuAssertDblEquals(tc, 1.0,
+		ts_bspline_control_points_ptr(&spline)[0], 0);
+	CuAssertDblEquals(tc, 2.0,
+		ts_bspline_control_points_ptr(&spline)[1], 0);
+	CuAssertDblEquals(tc, 1.0, ts_bspline_knots_ptr(&spline)[3], 0);
+
+	___TEARDOWN___
+	ts_bspline_free(&spline);
+}
+
+void binary_invalid_data(CuTest *tc)
+{
+	___SETUP___
+	tsBSpline spline = ts_bspline_init();
+	unsigned char *data = NULL;
+	size_t size;
+	tsReal *knots;
+
+	___GIVEN___
+	C(binary_new_spline(&spline, &status))
+	C(ts_bspline_to_binary(&spline, &data, &size, &status))
+	ts_bspline_free(&spline);
+
+	___WHEN___ ___THEN___
+	/* Truncated. */
+	CuAssertIntEquals(tc, TS_PARSE_ERROR,
+		ts_bspline_from_binary(data, size - 1, &spline, NULL));
+	CuAssertIntEquals(tc, TS_PARSE_ERROR,
+		ts_bspline_from_binary(data, 10, &spline, NULL));
+	CuAssertPtrEquals(tc, NULL, spline.pImpl);
+	/* Unsupported version. */
+	data[4] = TS_BINARY_VERSION + 1;
+	CuAssertIntEquals(tc, TS_PARSE_ERROR,
+		ts_bspline_from_binary(data, size, &spline, NULL));
+	data[4] = TS_BINARY_VERSION;
+	/* Decreasing knots. */
+	knots = (tsReal *) (data + TS_BINARY_HEADER_SIZE +
+		6 * 2 * sizeof(tsReal));
+	knots[3] = (tsReal) -1.0;
+	CuAssertIntEquals(tc, TS_KNOTS_DECR,
+		ts_bspline_from_binary(data, size, &spline, NULL));
+	/* Wrong magic number. */
+	data[0] = 'X';
+	CuAssertIntEquals(tc, TS_PARSE_ERROR,
+		ts_bspline_from_binary(data, size, &spline, NULL));
+	CuAssertPtrEquals(tc, NULL, spline.pImpl);
+	CuAssertIntEquals(tc, TS_IO_ERROR,
+		ts_bspline_load_binary("/does/not/exist", &spline, NULL));
+
+	___TEARDOWN___
+	ts_bspline_free(&spline);
+	free(data);
+}
+
+void binary_load_invalid_file(CuTest *tc)
+{
+	___SETUP___
+	tsBSpline spline = ts_bspline_init();
+	unsigned char *data = NULL;
+	size_t size;
+	const char *file = "binary_test_file.bin";
+	FILE *fp = NULL;
+
+	___GIVEN___
+	C(binary_new_spline(&spline, &status))
+	C(ts_bspline_to_binary(&spline, &data, &size, &status))
+	ts_bspline_free(&spline);
+
+	___WHEN___ ___THEN___
+	/* Truncated. */
+	fp = fopen(file, "wb");
+	CuAssertPtrNotNull(tc, fp);
+	fwrite(data, 1, size - 1, fp);
+	fclose(fp);
+	CuAssertIntEquals(tc, TS_PARSE_ERROR,
+		ts_bspline_load_binary(file, &spline, NULL));
+	CuAssertPtrEquals(tc, NULL, spline.pImpl);
+	/* Trailing data. */
+	fp = fopen(file, "wb");
+	CuAssertPtrNotNull(tc, fp);
+	fwrite(data, 1, size, fp);
+	fputc(0, fp);
+	fclose(fp);
+	CuAssertIntEquals(tc, TS_PARSE_ERROR,
+		ts_bspline_load_binary(file, &spline, NULL));
+	/* The header claims 2^40 control points. This must be rejected
+	 * before memory is allocated. */
+	data[24 + 5] = 1;
+	fp = fopen(file, "wb");
+	CuAssertPtrNotNull(tc, fp);
+	fwrite(data, 1, size, fp);
+	fclose(fp);
+	CuAssertIntEquals(tc, TS_PARSE_ERROR,
+		ts_bspline_load_binary(file, &spline, NULL));
+	CuAssertPtrEquals(tc, NULL, spline.pImpl);
+
+	___TEARDOWN___
+	ts_bspline_free(&spline);
+	free(data);
+	remove(file);
+}
+
+CuSuite* get_binary_suite()
+{
+	CuSuite* suite = CuSuiteNew();
+	SUITE_ADD_TEST(suite, binary_round_trip);
+	SUITE_ADD_TEST(suite, binary_save_load);
+	SUITE_ADD_TEST(suite, binary_float_to_real);
+	SUITE_ADD_TEST(suite, binary_invalid_data);
+	SUITE_ADD_TEST(suite, binary_load_invalid_file);
+	return suite;
+}
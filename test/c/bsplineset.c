@@ -0,0 +1,230 @@
+#include <testutils.h>
+
+#define BSPLINESET_NUM_SPLINES 7
+
+/* Fills the control points of `spline' with values that depend on `seed'. */
+void bsplineset_fill(tsBSpline *spline, size_t seed, tsStatus *status)
+{
+	tsReal *ctrlp = NULL;
+	size_t i, num = ts_bspline_len_control_points(spline);
+	if (ts_bspline_control_points(spline, &ctrlp, status))
+		return;
+	for (i = 0; i < num; i++)
+		ctrlp[i] = (tsReal) ((seed * 5 + i * 3) % 17) - 8;
+	ts_bspline_set_control_points(spline, ctrlp, status);
+	free(ctrlp);
+}
+
+void bsplineset_eval_matches_eval(CuTest *tc)
+{
+	___SETUP___
+	tsBSpline splines[BSPLINESET_NUM_SPLINES];
+	tsBSplineSet set = ts_bsplineset_init();
+	tsDeBoorNet net = ts_deboornet_init();
+	tsReal points[3 * BSPLINESET_NUM_SPLINES], min, max, u;
+	const tsReal *result;
+	size_t i, m, d, k, type;
+
+	for (m = 0; m < BSPLINESET_NUM_SPLINES; m++)
+		splines[m] = ts_bspline_init();
+
+	/* Clamped and opened splines with interior multiplicities. */
+	for (type = 0; type < 2; type++) {
+		___GIVEN___
+		for (m = 0; m < BSPLINESET_NUM_SPLINES; m++) {
+			ts_bspline_free(&splines[m]);
+			C(ts_bspline_new(9, 3, 3,
+				type == 0 ? TS_CLAMPED : TS_OPENED,
+				&splines[m], &status))
+			C(ts_bspline_insert_knot(&splines[m], (tsReal) 0.5,
+				2, &splines[m], &k, &status))
+			bsplineset_fill(&splines[m], m, &status);
+			C(status.code)
+		}
+		ts_bsplineset_free(&set);
+		C(ts_bsplineset_new(splines, BSPLINESET_NUM_SPLINES, &set,
+			&status))
+		ts_bspline_domain(&splines[0], &min, &max);
+
+		___WHEN___
+		for (i = 0; i <= 50; i++) {
+			u = min + (max - min) * ((tsReal) i / 50);
+			C(ts_bsplineset_eval(&set, u, points, &status))
+
+			___THEN___
+			for (m = 0; m < BSPLINESET_NUM_SPLINES; m++) {
+				C(ts_bspline_eval(&splines[m], u, &net,
+					&status))
+				result = ts_deboornet_result_ptr(&net);
+				for (d = 0; d < 3; d++) {
+					CuAssertDblEquals(tc, result[d],
+						points[d *
+						BSPLINESET_NUM_SPLINES + m],
+						POINT_EPSILON);
+				}
+				ts_deboornet_free(&net);
+			}
+		}
+	}
+
+	___TEARDOWN___
+	for (m = 0; m < BSPLINESET_NUM_SPLINES; m++)
+		ts_bspline_free(&splines[m]);
+	ts_bsplineset_free(&set);
+	ts_deboornet_free(&net);
+}
+
+void bsplineset_eval_at_joints(CuTest *tc)
+{
+	___SETUP___
+	tsBSpline splines[BSPLINESET_NUM_SPLINES];
+	tsBSplineSet set = ts_bsplineset_init();
+	tsDeBoorNet net = ts_deboornet_init();
+	tsReal points[2 * BSPLINESET_NUM_SPLINES], u;
+	const tsReal *knots, *result;
+	size_t i, m, d, deg;
+
+	for (m = 0; m < BSPLINESET_NUM_SPLINES; m++)
+		splines[m] = ts_bspline_init();
+
+	/* Knots with multiplicity order (including degree 0). */
+	for (deg = 0; deg < 4; deg++) {
+		___GIVEN___
+		for (m = 0; m < BSPLINESET_NUM_SPLINES; m++) {
+			ts_bspline_free(&splines[m]);
+			C(ts_bspline_new(4 * (deg + 1), 2, deg, TS_BEZIERS,
+				&splines[m], &status))
+			bsplineset_fill(&splines[m], m, &status);
+			C(status.code)
+		}
+		ts_bsplineset_free(&set);
+		C(ts_bsplineset_new(splines, BSPLINESET_NUM_SPLINES, &set,
+			&status))
+		knots = ts_bsplineset_knots_ptr(&set);
+
+		for (i = 0; i < ts_bspline_num_knots(&splines[0]); i++) {
+			___WHEN___
+			u = knots[i];
+			C(ts_bsplineset_eval(&set, u, points, &status))
+
+			___THEN___
+			for (m = 0; m < BSPLINESET_NUM_SPLINES; m++) {
+				C(ts_bspline_eval(&splines[m], u, &net,
+					&status))
+				result = ts_deboornet_result_ptr(&net);
+				for (d = 0; d < 2; d++) {
+					CuAssertDblEquals(tc, result[d],
+						points[d *
+						BSPLINESET_NUM_SPLINES + m],
+						0);
+				}
+				ts_deboornet_free(&net);
+			}
+		}
+	}
+
+	___TEARDOWN___
+	for (m = 0; m < BSPLINESET_NUM_SPLINES; m++)
+		ts_bspline_free(&splines[m]);
+	ts_bsplineset_free(&set);
+	ts_deboornet_free(&net);
+}
+
+void bsplineset_spline_at(CuTest *tc)
+{
+	___SETUP___
+	tsBSpline splines[3];
+	tsBSplineSet set = ts_bsplineset_init();
+	tsBSpline spline = ts_bspline_init();
+	size_t m;
+
+	for (m = 0; m < 3; m++)
+		splines[m] = ts_bspline_init();
+
+	___GIVEN___
+	for (m = 0; m < 3; m++) {
+		C(ts_bspline_new(5, 2, 2, TS_CLAMPED, &splines[m], &status))
+		bsplineset_fill(&splines[m], m, &status);
+		C(status.code)
+	}
+	CuAssertIntEquals(tc, 0, (int) ts_bsplineset_num_splines(&set));
+
+	___WHEN___
+	C(ts_bsplineset_new(splines, 3, &set, &status))
+
+	___THEN___
+	CuAssertIntEquals(tc, 3, (int) ts_bsplineset_num_splines(&set));
+	CuAssertIntEquals(tc, 2, (int) ts_bsplineset_degree(&set));
+	CuAssertIntEquals(tc, 2, (int) ts_bsplineset_dimension(&set));
+	CuAssertIntEquals(tc, 5,
+		(int) ts_bsplineset_num_control_points(&set));
+	/* Second coordinate of the first control point of the third
+	 * spline. */
+	CuAssertDblEquals(tc,
+		ts_bspline_control_points_ptr(&splines[2])[1],
+		ts_bsplineset_control_points_ptr(&set)[1 * 3 + 2], 0);
+	for (m = 0; m < 3; m++) {
+		C(ts_bsplineset_spline_at(&set, m, &spline, &status))
+		assert_equal_shape(tc, &splines[m], &spline);
+		ts_bspline_free(&spline);
+	}
+	CuAssertIntEquals(tc, TS_INDEX_ERROR,
+		ts_bsplineset_spline_at(&set, 3, &spline, NULL));
+
+	___TEARDOWN___
+	for (m = 0; m < 3; m++)
+		ts_bspline_free(&splines[m]);
+	ts_bsplineset_free(&set);
+	ts_bspline_free(&spline);
+}
+
+void bsplineset_errors(CuTest *tc)
+{
+	___SETUP___
+	tsBSpline splines[2];
+	tsBSplineSet set = ts_bsplineset_init();
+	tsReal points[4];
+	size_t k;
+
+	splines[0] = ts_bspline_init();
+	splines[1] = ts_bspline_init();
+
+	___GIVEN___
+	C(ts_bspline_new(4, 2, 2, TS_CLAMPED, &splines[0], &status))
+	C(ts_bspline_new(4, 2, 1, TS_CLAMPED, &splines[1], &status))
+
+	___WHEN___
+	/* Then. */
+	CuAssertIntEquals(tc, TS_NUM_POINTS,
+		ts_bsplineset_new(splines, 0, &set, NULL));
+	CuAssertIntEquals(tc, TS_INCOMPATIBLE,
+		ts_bsplineset_new(splines, 2, &set, &status));
+	CuAssertPtrEquals(tc, NULL, set.pImpl);
+
+	/* Same shape, different knots. */
+	ts_bspline_free(&splines[1]);
+	C(ts_bspline_new(3, 2, 2, TS_CLAMPED, &splines[1], &status))
+	C(ts_bspline_insert_knot(&splines[1], (tsReal) 0.3, 1, &splines[1],
+		&k, &status))
+	CuAssertIntEquals(tc, TS_INCOMPATIBLE,
+		ts_bsplineset_new(splines, 2, &set, NULL));
+
+	C(ts_bsplineset_new(splines, 1, &set, &status))
+	CuAssertIntEquals(tc, TS_U_UNDEFINED,
+		ts_bsplineset_eval(&set, (tsReal) 1.5, points, NULL));
+
+	___TEARDOWN___
+	ts_bspline_free(&splines[0]);
+	ts_bspline_free(&splines[1]);
+	ts_bsplineset_free(&set);
+}
+
+CuSuite* get_bsplineset_suite()
+{
+	CuSuite* suite = CuSuiteNew();
+	SUITE_ADD_TEST(suite, bsplineset_eval_matches_eval);
+	SUITE_ADD_TEST(suite, bsplineset_eval_at_joints);
+	SUITE_ADD_TEST(suite, bsplineset_spline_at);
+	SUITE_ADD_TEST(suite, bsplineset_errors);
+	return suite;
+}
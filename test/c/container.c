@@ -0,0 +1,285 @@
+#include <testutils.h>
+
+#define CONTAINER_FILE "container_test_file.tsbc"
+
+tsError container_new_spline(size_t i,
+                             tsBSpline *spline,
+                             tsStatus *status)
+{
+	tsReal *ctrlp = NULL;
+	size_t j, num, dim, deg;
+	tsError err;
+
+	num = 4 + i % 5;
+	dim = 1 + i % 3;
+	deg = 1 + i % 3;
+	TS_TRY(try, err, status)
+		TS_CALL(try, err, ts_bspline_new(num, dim, deg,
+			TS_CLAMPED, spline, status))
+		TS_CALL(try, err, ts_bspline_control_points(
+			spline, &ctrlp, status))
+		for (j = 0; j < num * dim; j++)
+			ctrlp[j] = (tsReal) (i * 100 + j);
+		TS_CALL(try, err, ts_bspline_set_control_points(
+			spline, ctrlp, status))
+	TS_FINALLY
+		free(ctrlp);
+	TS_END_TRY_RETURN(err)
+}
+
+tsError container_write(size_t from,
+                        size_t to,
+                        int append,
+                        tsStatus *status)
+{
+	tsContainerWriter writer = ts_container_writer_init();
+	tsBSpline spline = ts_bspline_init();
+	size_t i;
+	tsError err;
+
+	TS_TRY(try, err, status)
+		TS_CALL(try, err, ts_container_writer_open(
+			CONTAINER_FILE, append, &writer, status))
+		for (i = from; i < to; i++) {
+			TS_CALL(try, err, container_new_spline(
+				i, &spline, status))
+			TS_CALL(try, err, ts_container_writer_append(
+				&writer, &spline, status))
+			ts_bspline_free(&spline);
+		}
+		TS_CALL(try, err, ts_container_writer_close(
+			&writer, status))
+	TS_FINALLY
+		ts_bspline_free(&spline);
+		ts_container_writer_close(&writer, NULL);
+	TS_END_TRY_RETURN(err)
+}
+
+void assert_container_spline(CuTest *tc,
+                             const tsContainer *container,
+                             size_t i)
+{
+	___SETUP___
+	tsBSpline expected = ts_bspline_init();
+	tsBSpline loaded = ts_bspline_init();
+	tsBSplineView view;
+	tsDeBoorNet net_expected = ts_deboornet_init();
+	tsDeBoorNet net_actual = ts_deboornet_init();
+	tsReal min, max, u, dist;
+
+	___GIVEN___
+	C(container_new_spline(i, &expected, &status))
+
+	___WHEN___
+	C(ts_container_view(container, i, &view, &status))
+	C(ts_container_load(container, i, &loaded, &status))
+
+	___THEN___
+	assert_equal_shape(tc, &expected, &loaded);
+	CuAssertIntEquals(tc, (int) ts_bspline_degree(&expected),
+		(int) view.degree);
+	CuAssertIntEquals(tc, (int) ts_bspline_dimension(&expected),
+		(int) view.dimension);
+	CuAssertIntEquals(tc, (int) ts_bspline_num_control_points(&expected),
+		(int) view.num_control_points);
+	ts_bspline_domain(&expected, &min, &max);
+	u = min + (max - min) * (tsReal) 0.3;
+	C(ts_bspline_eval(&expected, u, &net_expected, &status))
+	C(ts_bspline_view_eval(&view, u, &net_actual, &status))
+	dist = ts_distance(ts_deboornet_result_ptr(&net_expected),
+	                   ts_deboornet_result_ptr(&net_actual),
+	                   ts_bspline_dimension(&expected));
+	CuAssertDblEquals(tc, 0, dist, POINT_EPSILON);
+
+	___TEARDOWN___
+	ts_bspline_free(&expected);
+	ts_bspline_free(&loaded);
+	ts_deboornet_free(&net_expected);
+	ts_deboornet_free(&net_actual);
+}
+
+void container_write_and_view(CuTest *tc)
+{
+	___SETUP___
+	tsContainer container = ts_container_init();
+	size_t i;
+
+	___GIVEN___
+	C(container_write(0, 100, 0, &status))
+
+	___WHEN___
+	C(ts_container_open(CONTAINER_FILE, &container, &status))
+
+	___THEN___
+	CuAssertIntEquals(tc, 100,
+		(int) ts_container_num_splines(&container));
+	for (i = 0; i < 100; i++)
+		assert_container_spline(tc, &container, i);
+	CuAssertIntEquals(tc, TS_INDEX_ERROR,
+		ts_container_view(&container, 100, NULL, NULL));
+
+	___TEARDOWN___
+	ts_container_close(&container);
+	CuAssertIntEquals(tc, 0, (int) ts_container_num_splines(&container));
+	remove(CONTAINER_FILE);
+}
+
+void container_append(CuTest *tc)
+{
+	___SETUP___
+	tsContainer container = ts_container_init();
+	size_t i;
+
+	___GIVEN___
+	C(container_write(0, 10, 0, &status))
+
+	___WHEN___
+	C(container_write(10, 25, 1, &status))
+	C(container_write(25, 26, 1, &status))
+
+	___THEN___
+	C(ts_container_open(CONTAINER_FILE, &container, &status))
+	CuAssertIntEquals(tc, 26,
+		(int) ts_container_num_splines(&container));
+	for (i = 0; i < 26; i++)
+		assert_container_spline(tc, &container, i);
+
+	___TEARDOWN___
+	ts_container_close(&container);
+	remove(CONTAINER_FILE);
+}
+
+void container_empty(CuTest *tc)
+{
+	___SETUP___
+	tsContainer container = ts_container_init();
+
+	___GIVEN___
+	C(container_write(0, 0, 1, &status))
+
+	___WHEN___
+	C(ts_container_open(CONTAINER_FILE, &container, &status))
+
+	___THEN___
+	CuAssertIntEquals(tc, 0, (int) ts_container_num_splines(&container));
+
+	___TEARDOWN___
+	ts_container_close(&container);
+	remove(CONTAINER_FILE);
+}
+
+void container_invalid(CuTest *tc)
+{
+	___SETUP___
+	tsContainer container = ts_container_init();
+	tsContainerWriter writer = ts_container_writer_init();
+	tsBSpline spline = ts_bspline_init();
+	FILE *file = NULL;
+
+	___GIVEN___
+	C(ts_bspline_new(7, 2, 3, TS_CLAMPED, &spline, &status))
+	C(ts_bspline_save_binary(&spline, CONTAINER_FILE, &status))
+
+	___WHEN___ ___THEN___
+	/* A binary spline is not a container. */
+	CuAssertIntEquals(tc, TS_PARSE_ERROR,
+		ts_container_open(CONTAINER_FILE, &container, NULL));
+	CuAssertPtrEquals(tc, NULL, container.pImpl);
+	CuAssertIntEquals(tc, TS_PARSE_ERROR,
+		ts_container_writer_open(CONTAINER_FILE, 1, &writer, NULL));
+	CuAssertPtrEquals(tc, NULL, writer.pImpl);
+	/* Truncated index table. */
+	C(container_write(0, 3, 0, &status))
+	file = fopen(CONTAINER_FILE, "r+b");
+	CuAssertPtrNotNull(tc, file);
+	fseek(file, 8, SEEK_SET);
+	fputc(200, file); /* number of splines */
+	fclose(file);
+	CuAssertIntEquals(tc, TS_PARSE_ERROR,
+		ts_container_open(CONTAINER_FILE, &container, NULL));
+	CuAssertIntEquals(tc, TS_IO_ERROR,
+		ts_container_open("/does/not/exist", &container, NULL));
+	ts_bspline_free(&spline);
+	CuAssertIntEquals(tc, TS_INDEX_ERROR,
+		ts_container_load(&container, 0, &spline, NULL));
+
+	___TEARDOWN___
+	ts_bspline_free(&spline);
+	ts_container_close(&container);
+	remove(CONTAINER_FILE);
+}
+
+void container_corrupted_view(CuTest *tc)
+{
+	___SETUP___
+	tsContainer container = ts_container_init();
+	tsBSplineView view;
+	tsReal knot = (tsReal) 5.0;
+	/* First (and only) spline: 4 control points, dimension 1, degree 1. */
+	const long spline = TS_CONTAINER_HEADER_SIZE;
+	FILE *file = NULL;
+
+	___GIVEN___
+	C(container_write(0, 1, 0, &status))
+	/* Decreasing knot vector. */
+	file = fopen(CONTAINER_FILE, "r+b");
+	CuAssertPtrNotNull(tc, file);
+	fseek(file, spline + TS_BINARY_HEADER_SIZE +
+	      (long) (6 * sizeof(tsReal)), SEEK_SET);
+	fwrite(&knot, sizeof(tsReal), 1, file);
+	fclose(file);
+
+	___WHEN___
+	C(ts_container_open(CONTAINER_FILE, &container, &status))
+
+	___THEN___
+	/* Knots are validated on request only. */
+	C(ts_container_view(&container, 0, &view, &status))
+	CuAssertIntEquals(tc, TS_KNOTS_DECR,
+		ts_container_view_checked(&container, 0, &view, NULL));
+	ts_container_close(&container);
+
+	___WHEN___
+	/* Number of knots does not match. */
+	file = fopen(CONTAINER_FILE, "r+b");
+	CuAssertPtrNotNull(tc, file);
+	fseek(file, spline + 32, SEEK_SET);
+	fputc(5, file);
+	fclose(file);
+	C(ts_container_open(CONTAINER_FILE, &container, &status))
+
+	___THEN___
+	CuAssertIntEquals(tc, TS_NUM_KNOTS,
+		ts_container_view(&container, 0, &view, NULL));
+	CuAssertIntEquals(tc, TS_NUM_KNOTS,
+		ts_container_view_checked(&container, 0, &view, NULL));
+	ts_container_close(&container);
+
+	___WHEN___
+	/* Degree >= number of control points. */
+	file = fopen(CONTAINER_FILE, "r+b");
+	CuAssertPtrNotNull(tc, file);
+	fseek(file, spline + 8, SEEK_SET);
+	fputc(4, file);
+	fclose(file);
+	C(ts_container_open(CONTAINER_FILE, &container, &status))
+
+	___THEN___
+	CuAssertIntEquals(tc, TS_DEG_GE_NCTRLP,
+		ts_container_view(&container, 0, &view, NULL));
+
+	___TEARDOWN___
+	ts_container_close(&container);
+	remove(CONTAINER_FILE);
+}
+
+CuSuite* get_container_suite()
+{
+	CuSuite* suite = CuSuiteNew();
+	SUITE_ADD_TEST(suite, container_write_and_view);
+	SUITE_ADD_TEST(suite, container_append);
+	SUITE_ADD_TEST(suite, container_empty);
+	SUITE_ADD_TEST(suite, container_invalid);
+	SUITE_ADD_TEST(suite, container_corrupted_view);
+	return suite;
+}
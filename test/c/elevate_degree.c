@@ -172,6 +172,77 @@ void elevate_degree_bspline(CuTest *tc)
 	ts_bspline_free(&elevated);
 }
 
+void elevate_degree_direct(CuTest *tc)
+{
+	___SETUP___
+	tsBSpline spline = ts_bspline_init();
+	tsBSpline expected = ts_bspline_init();
+	tsBSpline elevated = ts_bspline_init();
+	tsReal *ctrlp = NULL;
+	size_t deg, type, amount, i, k, num_distinct;
+
+	/* Both types, interior multiplicities (including discontinuities),
+	 * and degrees 0 to 4. */
+	for (deg = 0; deg < 5; deg++) {
+	for (type = 0; type < 2; type++) {
+		___GIVEN___
+		C(ts_bspline_new(deg + 6, 2, deg,
+			type == 0 ? TS_CLAMPED : TS_OPENED, &spline,
+			&status))
+		C(ts_bspline_control_points(&spline, &ctrlp, &status))
+		for (i = 0; i < ts_bspline_len_control_points(&spline); i++)
+			ctrlp[i] = (tsReal) ((i * 7) % 11) - 5;
+		C(ts_bspline_set_control_points(&spline, ctrlp, &status))
+		free(ctrlp);
+		ctrlp = NULL;
+		C(ts_bspline_insert_knot(&spline, (tsReal) 0.45, 1, &spline,
+			&k, &status))
+		C(ts_bspline_insert_knot(&spline, (tsReal) 0.55, deg + 1,
+			&spline, &k, &status))
+		/* Number of distinct interior knots after clamping. */
+		C(ts_bspline_to_beziers(&spline, &expected, &status))
+		num_distinct = ts_bspline_num_control_points(&expected) /
+			(deg + 1) - 1;
+		ts_bspline_free(&expected);
+
+		for (amount = 0; amount < 4; amount++) {
+			___WHEN___
+			C(ts_bspline_elevate_degree_direct(&spline, amount,
+				&elevated, &status))
+			C(ts_bspline_elevate_degree(&spline, amount,
+				POINT_EPSILON, &expected, &status))
+
+			___THEN___
+			CuAssertIntEquals(tc, (int) (deg + amount),
+				(int) ts_bspline_degree(&elevated));
+			CuAssertIntEquals(tc,
+				(int) (ts_bspline_num_control_points(&elevated)
+					+ ts_bspline_order(&elevated)),
+				(int) ts_bspline_num_knots(&elevated));
+			assert_equal_shape(tc, &expected, &elevated);
+			/* Minimal result (clamped splines only; opened
+			 * splines are clamped first). */
+			if (type == 0 && amount > 0 && deg > 0) {
+				CuAssertIntEquals(tc,
+					(int) (ts_bspline_num_control_points(
+					&spline) + amount * (num_distinct + 1)),
+					(int) ts_bspline_num_control_points(
+					&elevated));
+			}
+			ts_bspline_free(&elevated);
+			ts_bspline_free(&expected);
+		}
+		ts_bspline_free(&spline);
+	}
+	}
+
+	___TEARDOWN___
+	ts_bspline_free(&spline);
+	ts_bspline_free(&expected);
+	ts_bspline_free(&elevated);
+	free(ctrlp);
+}
+
 CuSuite* get_elevate_degree_suite()
 {
 	CuSuite* suite = CuSuiteNew();
@@ -179,5 +250,6 @@ CuSuite* get_elevate_degree_suite()
 	SUITE_ADD_TEST(suite, elevate_degree_line);
 	SUITE_ADD_TEST(suite, elevate_degree_bezier_curve);
 	SUITE_ADD_TEST(suite, elevate_degree_bspline);
+	SUITE_ADD_TEST(suite, elevate_degree_direct);
 	return suite;
 }
@@ -0,0 +1,120 @@
+#include <testutils.h>
+
+void eval_context_matches_eval(CuTest *tc)
+{
+	___SETUP___
+	tsBSpline spline = ts_bspline_init();
+	tsEvalContext ctx = ts_eval_context_init();
+	tsDeBoorNet net = ts_deboornet_init();
+	const tsDeBoorNet *cnet;
+	tsReal point[3], dist, min, max, u;
+	size_t i, j, k;
+
+	___GIVEN___
+	/* Opened knots with interior multiplicities. */
+	C(ts_bspline_new(9, 3, 3, TS_OPENED, &spline, &status))
+	C(ts_bspline_insert_knot(&spline, (tsReal) 0.5, 2, &spline, &k,
+		&status))
+	C(ts_eval_context_new(3, 3, &ctx, &status))
+	ts_bspline_domain(&spline, &min, &max);
+
+	___WHEN___
+	/* Forward, backward, and random access. */
+	for (j = 0; j < 3; j++) {
+		for (i = 0; i <= 100; i++) {
+			u = j == 0 ? (tsReal) i / 100 :
+			    j == 1 ? (tsReal) (100 - i) / 100 :
+			             (tsReal) ((i * 37) % 101) / 100;
+			u = min + (max - min) * u;
+			C(ts_bspline_eval(&spline, u, &net, &status))
+			C(ts_eval_context_eval(&ctx, &spline, u, point,
+				&status))
+
+			/* Then. */
+			cnet = ts_eval_context_net(&ctx);
+			CuAssertIntEquals(tc,
+				(int) ts_deboornet_index(&net),
+				(int) ts_deboornet_index(cnet));
+			CuAssertIntEquals(tc,
+				(int) ts_deboornet_multiplicity(&net),
+				(int) ts_deboornet_multiplicity(cnet));
+			CuAssertIntEquals(tc,
+				(int) ts_deboornet_num_result(&net),
+				(int) ts_deboornet_num_result(cnet));
+			dist = ts_distance(ts_deboornet_result_ptr(&net),
+			                   point, 3);
+			CuAssertDblEquals(tc, 0, dist, POINT_EPSILON);
+			ts_deboornet_free(&net);
+		}
+	}
+
+	___TEARDOWN___
+	ts_bspline_free(&spline);
+	ts_deboornet_free(&net);
+	ts_eval_context_free(&ctx);
+}
+
+void eval_context_grows_on_demand(CuTest *tc)
+{
+	___SETUP___
+	tsBSpline line = ts_bspline_init();
+	tsBSpline curve = ts_bspline_init();
+	tsEvalContext ctx = ts_eval_context_init();
+	tsDeBoorNet net = ts_deboornet_init();
+	tsReal point[4];
+
+	___GIVEN___
+	C(ts_bspline_new_with_control_points(
+		2, 2, 1, TS_CLAMPED, &line, &status,
+		0.0, 0.0,
+		2.0, 4.0))
+	C(ts_bspline_new(10, 4, 5, TS_CLAMPED, &curve, &status))
+	CuAssertPtrEquals(tc, NULL, (void *) ts_eval_context_net(&ctx));
+
+	___WHEN___
+	/* Created on demand. */
+	C(ts_eval_context_eval(&ctx, &line, (tsReal) 0.5, point, &status))
+
+	___THEN___
+	CuAssertDblEquals(tc, 1.0, point[0], POINT_EPSILON);
+	CuAssertDblEquals(tc, 2.0, point[1], POINT_EPSILON);
+	/* Enlarged. */
+	C(ts_eval_context_eval(&ctx, &curve, (tsReal) 0.3, point, &status))
+	C(ts_bspline_eval(&curve, (tsReal) 0.3, &net, &status))
+	CuAssertDblEquals(tc, 0, ts_distance(point,
+		ts_deboornet_result_ptr(&net), 4), POINT_EPSILON);
+	CuAssertIntEquals(tc, 4, (int) ts_deboornet_dimension(
+		ts_eval_context_net(&ctx)));
+	/* Smaller splines still work after enlarging. */
+	C(ts_eval_context_eval(&ctx, &line, (tsReal) 1.0, point, &status))
+	CuAssertDblEquals(tc, 2.0, point[0], POINT_EPSILON);
+	CuAssertDblEquals(tc, 4.0, point[1], POINT_EPSILON);
+	CuAssertIntEquals(tc, 2, (int) ts_deboornet_dimension(
+		ts_eval_context_net(&ctx)));
+	CuAssertIntEquals(tc, TS_U_UNDEFINED, ts_eval_context_eval(
+		&ctx, &line, (tsReal) 1.5, point, NULL));
+
+	___TEARDOWN___
+	ts_bspline_free(&line);
+	ts_bspline_free(&curve);
+	ts_deboornet_free(&net);
+	ts_eval_context_free(&ctx);
+	CuAssertPtrEquals(tc, NULL, (void *) ts_eval_context_net(&ctx));
+}
+
+void eval_context_dim_zero(CuTest *tc)
+{
+	tsEvalContext ctx = ts_eval_context_init();
+	CuAssertIntEquals(tc, TS_DIM_ZERO,
+		ts_eval_context_new(3, 0, &ctx, NULL));
+	CuAssertPtrEquals(tc, NULL, ctx.pImpl);
+}
+
+CuSuite* get_eval_context_suite()
+{
+	CuSuite* suite = CuSuiteNew();
+	SUITE_ADD_TEST(suite, eval_context_matches_eval);
+	SUITE_ADD_TEST(suite, eval_context_grows_on_demand);
+	SUITE_ADD_TEST(suite, eval_context_dim_zero);
+	return suite;
+}
@@ -0,0 +1,276 @@
+#include <testutils.h>
+
+#define JSON_STREAM_FILE "json_stream_test_file.json"
+
+tsError json_stream_new_spline(size_t i,
+                               tsBSpline *spline,
+                               tsStatus *status)
+{
+	tsReal *ctrlp = NULL;
+	size_t j, num, dim, deg;
+	tsError err;
+
+	num = 4 + i % 5;
+	dim = 1 + i % 3;
+	deg = 1 + i % 3;
+	TS_TRY(try, err, status)
+		TS_CALL(try, err, ts_bspline_new(num, dim, deg,
+			TS_CLAMPED, spline, status))
+		TS_CALL(try, err, ts_bspline_control_points(
+			spline, &ctrlp, status))
+		/* Not exactly representable in decimal. */
+		for (j = 0; j < num * dim; j++)
+			ctrlp[j] = (tsReal) (i * 100 + j) / (tsReal) 7.0;
+		TS_CALL(try, err, ts_bspline_set_control_points(
+			spline, ctrlp, status))
+	TS_FINALLY
+		free(ctrlp);
+	TS_END_TRY_RETURN(err)
+}
+
+void assert_json_stream_spline(CuTest *tc,
+                               tsBSpline *actual,
+                               size_t i)
+{
+	___SETUP___
+	tsBSpline expected = ts_bspline_init();
+	const tsReal *ctrlp_expected, *ctrlp_actual;
+	size_t j;
+
+	___GIVEN___
+	C(json_stream_new_spline(i, &expected, &status))
+
+	___THEN___
+	assert_equal_shape(tc, &expected, actual);
+	ctrlp_expected = ts_bspline_control_points_ptr(&expected);
+	ctrlp_actual = ts_bspline_control_points_ptr(actual);
+	for (j = 0; j < ts_bspline_len_control_points(&expected); j++) {
+		/* Exact round trip. */
+		CuAssertDblEquals(tc, ctrlp_expected[j], ctrlp_actual[j], 0);
+	}
+
+	___TEARDOWN___
+	ts_bspline_free(&expected);
+}
+
+tsError json_stream_write(size_t num,
+                          tsJsonFormat format,
+                          tsStatus *status)
+{
+	tsBSpline *splines = NULL;
+	size_t i, created = 0;
+	tsError err;
+
+	TS_TRY(try, err, status)
+		splines = (tsBSpline *) malloc(num * sizeof(tsBSpline));
+		if (!splines) {
+			TS_THROW_0(try, err, status, TS_MALLOC,
+				"out of memory")
+		}
+		for (; created < num; created++) {
+			TS_CALL(try, err, json_stream_new_spline(
+				created, splines + created, status))
+		}
+		TS_CALL(try, err, ts_bspline_save_all(splines, num,
+			JSON_STREAM_FILE, format, status))
+	TS_FINALLY
+		for (i = 0; i < created; i++)
+			ts_bspline_free(splines + i);
+		free(splines);
+	TS_END_TRY_RETURN(err)
+}
+
+void json_stream_save_load_all(CuTest *tc)
+{
+	___SETUP___
+	tsBSpline *splines = NULL;
+	size_t num = 0, i;
+	tsJsonFormat formats[2] = { TS_JSON_ARRAY, TS_JSON_LINES };
+	int f;
+
+	___GIVEN___
+	for (f = 0; f < 2; f++) {
+		C(json_stream_write(25, formats[f], &status))
+
+		___WHEN___
+		C(ts_bspline_load_all(JSON_STREAM_FILE, &splines, &num,
+			&status))
+
+		___THEN___
+		CuAssertIntEquals(tc, 25, (int) num);
+		for (i = 0; i < num; i++) {
+			assert_json_stream_spline(tc, splines + i, i);
+			ts_bspline_free(splines + i);
+		}
+		free(splines);
+		splines = NULL;
+		num = 0;
+	}
+
+	___TEARDOWN___
+	for (i = 0; i < num; i++)
+		ts_bspline_free(splines + i);
+	free(splines);
+	remove(JSON_STREAM_FILE);
+}
+
+void json_stream_ranges(CuTest *tc)
+{
+	___SETUP___
+	tsJsonStream stream = ts_json_stream_init();
+	tsBSpline spline = ts_bspline_init();
+	FILE *file = NULL;
+	size_t size, begin, end, num_ranges, r, read = 0;
+	int done;
+
+	___GIVEN___
+	C(json_stream_write(100, TS_JSON_LINES, &status))
+	file = fopen(JSON_STREAM_FILE, "rb");
+	CuAssertPtrNotNull(tc, file);
+	fseek(file, 0, SEEK_END);
+	size = (size_t) ftell(file);
+	fclose(file);
+
+	/* Ranges are not aligned to lines. */
+	for (num_ranges = 1; num_ranges <= 13; num_ranges += 3) {
+		read = 0;
+		for (r = 0; r < num_ranges; r++) {
+			begin = size * r / num_ranges;
+			end = size * (r + 1) / num_ranges;
+
+			___WHEN___
+			C(ts_json_stream_open_range(JSON_STREAM_FILE,
+				begin, end, &stream, &status))
+			for (;;) {
+				C(ts_json_stream_next(&stream, &spline, &done,
+					&status))
+				if (done) break;
+
+				___THEN___
+				/* Each spline is read exactly once and in
+				   order. */
+				assert_json_stream_spline(tc, &spline, read);
+				ts_bspline_free(&spline);
+				read++;
+			}
+			ts_json_stream_close(&stream);
+		}
+		CuAssertIntEquals(tc, 100, (int) read);
+	}
+
+	___TEARDOWN___
+	ts_bspline_free(&spline);
+	ts_json_stream_close(&stream);
+	remove(JSON_STREAM_FILE);
+}
+
+void json_stream_string(CuTest *tc)
+{
+	___SETUP___
+	tsJsonStream stream = ts_json_stream_init();
+	tsBSpline spline = ts_bspline_init();
+	const char *spline_json = "{\"degree\": 1, \"dimension\": 1, "
+		"\"control_points\": [0, 1], \"knots\": [0, 0, 1, 1]}";
+	char json[256];
+	const char *valid[4] = { "", "[]", " [ ] ", "{}\n{}\n{}" };
+	const size_t num_valid[4] = { 0, 0, 0, 3 };
+	size_t i, num;
+	int done;
+
+	___GIVEN___
+	for (i = 0; i < 4; i++) {
+		/* Substitute {} with a valid spline. */
+		json[0] = '\0';
+		for (num = 0; valid[i][num]; num++) {
+			if (valid[i][num] == '}') continue;
+			if (valid[i][num] == '{') strcat(json, spline_json);
+			else strncat(json, valid[i] + num, 1);
+		}
+
+		___WHEN___
+		C(ts_json_stream_open_string(json, &stream, &status))
+		for (num = 0;; num++) {
+			C(ts_json_stream_next(&stream, &spline, &done,
+				&status))
+			if (done) break;
+			ts_bspline_free(&spline);
+		}
+
+		___THEN___
+		CuAssertIntEquals(tc, (int) num_valid[i], (int) num);
+		CuAssertIntEquals(tc, (int) num_valid[i],
+			(int) ts_json_stream_num_read(&stream));
+		/* Subsequent calls do not fail. */
+		C(ts_json_stream_next(&stream, &spline, &done, &status))
+		CuAssertIntEquals(tc, 1, done);
+		CuAssertPtrEquals(tc, NULL, spline.pImpl);
+		ts_json_stream_close(&stream);
+	}
+
+	___TEARDOWN___
+	ts_bspline_free(&spline);
+	ts_json_stream_close(&stream);
+}
+
+void json_stream_invalid(CuTest *tc)
+{
+	___SETUP___
+	tsJsonStream stream = ts_json_stream_init();
+	tsBSpline spline = ts_bspline_init();
+	const char *spline_json = "{\"degree\": 1, \"dimension\": 1, "
+		"\"control_points\": [0, 1], \"knots\": [0, 0, 1, 1]}";
+	const char *invalid[6] = { "[{}", "[{},]", "[{}{}]", "[{}] {}",
+		"{} x", "[,{}]" };
+	char json[256];
+	size_t i, num;
+	int done = 0;
+	tsError err = TS_SUCCESS;
+
+	___GIVEN___
+	for (i = 0; i < 6; i++) {
+		json[0] = '\0';
+		for (num = 0; invalid[i][num]; num++) {
+			if (invalid[i][num] == '}') continue;
+			if (invalid[i][num] == '{') strcat(json, spline_json);
+			else strncat(json, invalid[i] + num, 1);
+		}
+		C(ts_json_stream_open_string(json, &stream, &status))
+
+		___WHEN___
+		do {
+			err = ts_json_stream_next(&stream, &spline, &done,
+				NULL);
+			ts_bspline_free(&spline);
+		} while (!err && !done);
+
+		___THEN___
+		CuAssertIntEquals(tc, TS_PARSE_ERROR, err);
+		CuAssertPtrEquals(tc, NULL, spline.pImpl);
+		ts_json_stream_close(&stream);
+	}
+
+	/* Ranges are not supported for arrays. */
+	C(json_stream_write(3, TS_JSON_ARRAY, &status))
+	CuAssertIntEquals(tc, TS_PARSE_ERROR, ts_json_stream_open_range(
+		JSON_STREAM_FILE, 0, 10, &stream, NULL));
+	CuAssertPtrEquals(tc, NULL, stream.pImpl);
+	CuAssertIntEquals(tc, TS_IO_ERROR, ts_json_stream_open(
+		"/does/not/exist", &stream, NULL));
+	CuAssertIntEquals(tc, TS_IO_ERROR, ts_json_stream_next(
+		&stream, &spline, &done, NULL));
+
+	___TEARDOWN___
+	ts_bspline_free(&spline);
+	ts_json_stream_close(&stream);
+	remove(JSON_STREAM_FILE);
+}
+
+CuSuite* get_json_stream_suite()
+{
+	CuSuite* suite = CuSuiteNew();
+	SUITE_ADD_TEST(suite, json_stream_save_load_all);
+	SUITE_ADD_TEST(suite, json_stream_ranges);
+	SUITE_ADD_TEST(suite, json_stream_string);
+	SUITE_ADD_TEST(suite, json_stream_invalid);
+	return suite;
+}
@@ -59,10 +59,238 @@ morph_line_to_line(CuTest *tc)
 	free(ctrlp);
 }
 
+void
+morph_morphism_matches_morph(CuTest *tc)
+{
+	___SETUP___
+	tsBSpline origin = ts_bspline_init();
+	tsBSpline target = ts_bspline_init();
+	tsBSpline morph = ts_bspline_init();
+	tsBSpline buffer = ts_bspline_init();
+	tsMorphism morphism = ts_morphism_init();
+	tsMorphism copy = ts_morphism_init();
+	const tsReal *expected, *actual;
+	const void *impl;
+	tsReal t;
+	size_t i, j, len;
+
+	___GIVEN___
+	C(ts_bspline_new_with_control_points(
+		3, 2, 1, TS_CLAMPED, &origin, &status,
+		0.0, 0.0,
+		1.0, 2.0,
+		3.0, 1.0))
+	C(ts_bspline_new_with_control_points(
+		5, 2, 3, TS_CLAMPED, &target, &status,
+		-1.0, 0.0,
+		0.0, 3.0,
+		2.0, 4.0,
+		4.0, 1.0,
+		5.0, -1.0))
+	C(ts_morphism_new(&origin, &target, POINT_EPSILON, &morphism,
+		&status))
+	C(ts_morphism_copy(&morphism, &copy, &status))
+	ts_morphism_free(&morphism);
+	C(ts_morphism_new_spline(&copy, &buffer, &status))
+	impl = buffer.pImpl;
+
+	/* Then. */
+	CuAssertIntEquals(tc, 3, (int) ts_morphism_degree(&copy));
+	CuAssertIntEquals(tc, 2, (int) ts_morphism_dimension(&copy));
+
+	for (i = 0; i <= 10; i++) {
+		___WHEN___
+		t = (tsReal) i / (tsReal) 10;
+		ts_morphism_eval(&copy, t, &buffer);
+		C(ts_bspline_morph(&origin, &target, t, POINT_EPSILON,
+			&morph, &status))
+
+		___THEN___
+		CuAssertPtrEquals(tc, (void *) impl, buffer.pImpl);
+		CuAssertIntEquals(tc,
+			(int) ts_bspline_num_control_points(&morph),
+			(int) ts_bspline_num_control_points(&buffer));
+		/* Control points and knots. */
+		len = ts_bspline_len_control_points(&morph) +
+			ts_bspline_num_knots(&morph);
+		expected = ts_bspline_control_points_ptr(&morph);
+		actual = ts_bspline_control_points_ptr(&buffer);
+		for (j = 0; j < len; j++) {
+			CuAssertDblEquals(tc, expected[j], actual[j],
+				POINT_EPSILON);
+		}
+	}
+
+	/* `t' is clamped. */
+	ts_morphism_eval(&copy, (tsReal) 2.0, &buffer);
+	assert_equal_shape(tc, &target, &buffer);
+	ts_morphism_eval(&copy, (tsReal) -1.0, &buffer);
+	assert_equal_shape(tc, &origin, &buffer);
+
+	___TEARDOWN___
+	ts_bspline_free(&origin);
+	ts_bspline_free(&target);
+	ts_bspline_free(&morph);
+	ts_bspline_free(&buffer);
+	ts_morphism_free(&morphism);
+	ts_morphism_free(&copy);
+}
+
+void
+morph_morphism_eval_grid(CuTest *tc)
+{
+	___SETUP___
+	tsBSpline origin = ts_bspline_init();
+	tsBSpline target = ts_bspline_init();
+	tsBSpline buffer = ts_bspline_init();
+	tsMorphism morphism = ts_morphism_init();
+	tsDeBoorNet net = ts_deboornet_init();
+	tsReal ts[5] = { -1.0, 0.0, 0.3, 0.7, 1.0 };
+	tsReal knots[7], points[5 * 7 * 3], point[3], min, max;
+	const tsReal *expected;
+	size_t i, j, k, d;
+
+	___GIVEN___
+	/* Interior multiplicities and different knots. */
+	C(ts_bspline_new(6, 3, 2, TS_OPENED, &origin, &status))
+	C(ts_bspline_insert_knot(&origin, (tsReal) 0.5, 2, &origin, &k,
+		&status))
+	C(ts_bspline_new(8, 3, 2, TS_CLAMPED, &target, &status))
+	C(ts_bspline_set_control_point_at(&target, 3, ts, &status))
+	C(ts_morphism_new(&origin, &target, POINT_EPSILON, &morphism,
+		&status))
+	C(ts_morphism_new_spline(&morphism, &buffer, &status))
+
+	for (i = 0; i < 5; i++) {
+		___WHEN___
+		/* Unsorted knots including both ends of the domain. */
+		ts_morphism_eval(&morphism, ts[i], &buffer);
+		ts_bspline_domain(&buffer, &min, &max);
+		for (j = 0; j < 7; j++) {
+			knots[j] = min + (max - min) *
+				(tsReal) ((j * 4) % 7) / (tsReal) 6;
+		}
+		C(ts_morphism_eval_grid(&morphism, ts + i, 1, knots, 7,
+			points + i * 7 * 3, &status))
+
+		___THEN___
+		for (j = 0; j < 7; j++) {
+			C(ts_bspline_eval(&buffer, knots[j], &net, &status))
+			expected = ts_deboornet_result_ptr(&net);
+			for (d = 0; d < 3; d++) {
+				CuAssertDblEquals(tc, expected[d],
+					points[(i * 7 + j) * 3 + d],
+					POINT_EPSILON);
+			}
+			ts_deboornet_free(&net);
+		}
+	}
+
+	/* The grid yields the same points as separate calls (knots that are
+	 * within the domain of all morphed splines). */
+	for (j = 0; j < 7; j++)
+		knots[j] = (tsReal) 0.3 + (tsReal) ((j * 4) % 7) / 20;
+	C(ts_morphism_eval_grid(&morphism, ts, 5, knots, 7, points, &status))
+	for (i = 0; i < 5; i++) {
+		for (j = 0; j < 7; j++) {
+			C(ts_morphism_eval_at(&morphism, ts[i], knots[j],
+				point, &status))
+			for (d = 0; d < 3; d++) {
+				CuAssertDblEquals(tc, point[d],
+					points[(i * 7 + j) * 3 + d], 0);
+			}
+		}
+	}
+	CuAssertIntEquals(tc, TS_U_UNDEFINED, ts_morphism_eval_at(
+		&morphism, ts[2], max + 1, point, NULL));
+
+	___TEARDOWN___
+	ts_bspline_free(&origin);
+	ts_bspline_free(&target);
+	ts_bspline_free(&buffer);
+	ts_morphism_free(&morphism);
+	ts_deboornet_free(&net);
+}
+
+void
+morph_morphism_eval_at_knots(CuTest *tc)
+{
+	___SETUP___
+	tsBSpline origin = ts_bspline_init();
+	tsBSpline target = ts_bspline_init();
+	tsBSpline buffer = ts_bspline_init();
+	tsMorphism morphism = ts_morphism_init();
+	tsDeBoorNet net = ts_deboornet_init();
+	tsReal ts[3] = { 0.0, 0.4, 1.0 };
+	tsReal *ctrlp = NULL, point[2], u, offset;
+	const tsReal *knots, *expected;
+	size_t deg, i, j, o, d;
+
+	/* Knots with multiplicity order (including degree 0) and knots that
+	 * are within TS_KNOT_EPSILON of `u'. */
+	for (deg = 0; deg < 4; deg++) {
+		___GIVEN___
+		C(ts_bspline_new(3 * (deg + 1), 2, deg, TS_BEZIERS, &origin,
+			&status))
+		C(ts_bspline_copy(&origin, &target, &status))
+		C(ts_bspline_control_points(&origin, &ctrlp, &status))
+		for (j = 0; j < ts_bspline_len_control_points(&origin); j++)
+			ctrlp[j] = (tsReal) ((j * 5) % 17) - 8;
+		C(ts_bspline_set_control_points(&origin, ctrlp, &status))
+		for (j = 0; j < ts_bspline_len_control_points(&origin); j++)
+			ctrlp[j] = (tsReal) ((j * 3) % 13) - 6;
+		C(ts_bspline_set_control_points(&target, ctrlp, &status))
+		free(ctrlp);
+		ctrlp = NULL;
+		C(ts_morphism_new(&origin, &target, POINT_EPSILON, &morphism,
+			&status))
+		C(ts_morphism_new_spline(&morphism, &buffer, &status))
+
+		for (i = 0; i < 3; i++) {
+			ts_morphism_eval(&morphism, ts[i], &buffer);
+			knots = ts_bspline_knots_ptr(&buffer);
+			for (j = 0; j < ts_bspline_num_knots(&buffer); j++) {
+			for (o = 0; o < 3; o++) {
+				___WHEN___
+				offset = (tsReal) TS_KNOT_EPSILON / 2;
+				u = knots[j] + (o == 0 ? 0 : o == 1 ? offset
+					: -offset);
+				C(ts_morphism_eval_at(&morphism, ts[i], u,
+					point, &status))
+
+				___THEN___
+				C(ts_bspline_eval(&buffer, u, &net, &status))
+				expected = ts_deboornet_result_ptr(&net);
+				for (d = 0; d < 2; d++) {
+					CuAssertDblEquals(tc, expected[d],
+						point[d], POINT_EPSILON);
+				}
+				ts_deboornet_free(&net);
+			}
+			}
+		}
+		ts_bspline_free(&origin);
+		ts_bspline_free(&target);
+		ts_bspline_free(&buffer);
+		ts_morphism_free(&morphism);
+	}
+
+	___TEARDOWN___
+	ts_bspline_free(&origin);
+	ts_bspline_free(&target);
+	ts_bspline_free(&buffer);
+	ts_morphism_free(&morphism);
+	ts_deboornet_free(&net);
+	free(ctrlp);
+}
+
 CuSuite *
 get_morph_suite()
 {
 	CuSuite* suite = CuSuiteNew();
 	SUITE_ADD_TEST(suite, morph_line_to_line);
+	SUITE_ADD_TEST(suite, morph_morphism_matches_morph);
+	SUITE_ADD_TEST(suite, morph_morphism_eval_grid);
+	SUITE_ADD_TEST(suite, morph_morphism_eval_at_knots);
 	return suite;
 }
@@ -99,6 +99,79 @@ void new_bspline_beziers_setup_failed(CuTest* tc)
 	___TEARDOWN___
 }
 
+void new_bspline_more_than_max_num_knots(CuTest* tc)
+{
+	___SETUP___
+	tsBSpline spline = ts_bspline_init();
+	tsBSpline copy = ts_bspline_init();
+	tsDeBoorNet net = ts_deboornet_init();
+	tsReal min, max;
+	size_t k;
+
+	___GIVEN___
+	C(ts_bspline_new(TS_MAX_NUM_KNOTS * 3, 2, 3, TS_CLAMPED,
+		&spline, &status))
+
+	___WHEN___
+	ts_bspline_domain(&spline, &min, &max);
+
+	___THEN___
+	CuAssertIntEquals(tc, TS_MAX_NUM_KNOTS * 3 + 4,
+		(int) ts_bspline_num_knots(&spline));
+	CuAssertDblEquals(tc, TS_DOMAIN_DEFAULT_MIN, min, 0);
+	/* ceil(2 * TS_KNOT_EPSILON * (num(knots) - 1)) default domains. */
+	CuAssertDblEquals(tc, TS_DOMAIN_DEFAULT_MIN + 7 *
+		(TS_DOMAIN_DEFAULT_MAX - TS_DOMAIN_DEFAULT_MIN), max,
+		TS_KNOT_EPSILON);
+	/* Distinct knots must not be considered equal. */
+	C(ts_bspline_set_knots(&spline,
+		ts_bspline_knots_ptr(&spline), &status))
+	C(ts_bspline_eval(&spline, max / 2, &net, &status))
+	CuAssertIntEquals(tc, 1, (int) ts_deboornet_num_result(&net));
+	C(ts_bspline_insert_knot(&spline, max / 3, 1, &copy, &k, &status))
+	CuAssertIntEquals(tc, TS_MAX_NUM_KNOTS * 3 + 5,
+		(int) ts_bspline_num_knots(&copy));
+
+	___TEARDOWN___
+	ts_bspline_free(&spline);
+	ts_bspline_free(&copy);
+	ts_deboornet_free(&net);
+}
+
+void new_bspline_large_knot_spacing(CuTest* tc)
+{
+	___SETUP___
+	tsBSpline spline = ts_bspline_init();
+	const tsReal *knots;
+	tsReal dist, min_dist;
+	size_t i;
+
+	___GIVEN___
+	/* Rounding errors near the end of the (enlarged) domain are in the
+	 * order of TS_KNOT_EPSILON with single precision. */
+	C(ts_bspline_new(1000000, 1, 3, TS_CLAMPED, &spline, &status))
+
+	___WHEN___
+	knots = ts_bspline_knots_ptr(&spline);
+	min_dist = knots[4] - knots[3];
+	for (i = 4; i < ts_bspline_num_knots(&spline) - 4; i++) {
+		dist = knots[i + 1] - knots[i];
+		if (dist < min_dist) min_dist = dist;
+	}
+
+	___THEN___
+	CuAssertTrue(tc, min_dist > (tsReal) TS_KNOT_EPSILON);
+	ts_bspline_free(&spline);
+	if (sizeof(tsReal) == sizeof(float)) {
+		/* Checked before allocating memory. */
+		CuAssertIntEquals(tc, TS_NUM_KNOTS, ts_bspline_new(10000000,
+			1, 3, TS_CLAMPED, &spline, NULL));
+	}
+
+	___TEARDOWN___
+	ts_bspline_free(&spline);
+}
+
 CuSuite* get_new_suite()
 {
 	CuSuite* suite = CuSuiteNew();
@@ -106,6 +179,8 @@ CuSuite* get_new_suite()
 	SUITE_ADD_TEST(suite, new_bspline_deg_greater_nctrlp);
 	SUITE_ADD_TEST(suite, new_bspline_deg_equals_nctrlp);
 	SUITE_ADD_TEST(suite, new_bspline_beziers_setup_failed);
+	SUITE_ADD_TEST(suite, new_bspline_more_than_max_num_knots);
+	SUITE_ADD_TEST(suite, new_bspline_large_knot_spacing);
 	return suite;
 }
 
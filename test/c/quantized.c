@@ -0,0 +1,234 @@
+#include <testutils.h>
+
+#define QUANTIZED_NUM_CTRLP 100
+
+static unsigned long quantized_lcg_state = 7;
+
+static tsReal quantized_next_random(void)
+{
+	quantized_lcg_state = quantized_lcg_state * 1103515245UL + 12345UL;
+	return (tsReal) ((quantized_lcg_state >> 8) & 0xFFFF) / (tsReal) 0xFFFF;
+}
+
+tsError quantized_new_spline(tsBSpline *spline, tsStatus *status)
+{
+	tsReal *ctrlp = NULL;
+	size_t i;
+	tsError err;
+
+	TS_TRY(try, err, status)
+		TS_CALL(try, err, ts_bspline_new(QUANTIZED_NUM_CTRLP, 3, 3,
+			TS_CLAMPED, spline, status))
+		TS_CALL(try, err, ts_bspline_control_points(
+			spline, &ctrlp, status))
+		/* Different range per dimension. */
+		for (i = 0; i < QUANTIZED_NUM_CTRLP; i++) {
+			ctrlp[i * 3]     = quantized_next_random() * 1000;
+			ctrlp[i * 3 + 1] = quantized_next_random() - 50;
+			ctrlp[i * 3 + 2] = quantized_next_random() / 100;
+		}
+		TS_CALL(try, err, ts_bspline_set_control_points(
+			spline, ctrlp, status))
+	TS_FINALLY
+		free(ctrlp);
+	TS_END_TRY_RETURN(err)
+}
+
+void quantized_round_trip(CuTest *tc)
+{
+	___SETUP___
+	tsBSpline spline = ts_bspline_init();
+	tsBSpline parsed = ts_bspline_init();
+	unsigned char *data = NULL;
+	size_t size, size_double, i;
+	const tsReal *expected, *actual;
+	tsReal max_error;
+
+	___GIVEN___
+	C(quantized_new_spline(&spline, &status))
+
+	___WHEN___
+	C(ts_bspline_to_quantized(&spline, 16, &data, &size, &max_error,
+		&status))
+	C(ts_bspline_from_binary(data, size, &parsed, &status))
+
+	___THEN___
+	CuAssertTrue(tc, memcmp(data, TS_QUANTIZED_MAGIC, 4) == 0);
+	CuAssertIntEquals(tc, TS_QUANTIZED_VERSION, data[4]);
+	CuAssertIntEquals(tc, 16, data[5]);
+	/* Binary format with double precision. */
+	size_double = TS_BINARY_HEADER_SIZE + 8 *
+		(ts_bspline_len_control_points(&spline) +
+		 ts_bspline_num_knots(&spline));
+	CuAssertTrue(tc, size * 3 < size_double);
+	CuAssertIntEquals(tc, 3, (int) ts_bspline_degree(&parsed));
+	CuAssertIntEquals(tc, 3, (int) ts_bspline_dimension(&parsed));
+	CuAssertIntEquals(tc, QUANTIZED_NUM_CTRLP,
+		(int) ts_bspline_num_control_points(&parsed));
+	/* Half a quantization step of the largest dimension. */
+	CuAssertTrue(tc, max_error > 0);
+	CuAssertTrue(tc, max_error <= (tsReal) (1000.0 / 65535 / 2 + 1e-4));
+	expected = ts_bspline_control_points_ptr(&spline);
+	actual = ts_bspline_control_points_ptr(&parsed);
+	for (i = 0; i < ts_bspline_len_control_points(&spline); i++) {
+		CuAssertDblEquals(tc, expected[i], actual[i], max_error);
+	}
+	expected = ts_bspline_knots_ptr(&spline);
+	actual = ts_bspline_knots_ptr(&parsed);
+	for (i = 0; i < ts_bspline_num_knots(&spline); i++)
+		CuAssertDblEquals(tc, expected[i], actual[i], max_error);
+	/* Domain is stored exactly. */
+	CuAssertDblEquals(tc, expected[0], actual[0], 0);
+	CuAssertDblEquals(tc, expected[i - 1], actual[i - 1], 0);
+
+	___TEARDOWN___
+	ts_bspline_free(&spline);
+	ts_bspline_free(&parsed);
+	free(data);
+}
+
+void quantized_dequantize_view(CuTest *tc)
+{
+	___SETUP___
+	tsBSpline spline = ts_bspline_init();
+	tsBSplineView view;
+	tsDeBoorNet expected = ts_deboornet_init();
+	tsDeBoorNet actual = ts_deboornet_init();
+	unsigned char *data = NULL;
+	tsReal *buffer = NULL, max_error, dist;
+	size_t size, len, i;
+
+	___GIVEN___
+	C(quantized_new_spline(&spline, &status))
+	C(ts_bspline_to_quantized(&spline, 32, &data, &size, &max_error,
+		&status))
+	C(ts_bspline_dequantized_len(data, size, &len, &status))
+	CuAssertIntEquals(tc, QUANTIZED_NUM_CTRLP * 3 +
+		QUANTIZED_NUM_CTRLP + 4, (int) len);
+	buffer = (tsReal *) malloc(len * sizeof(tsReal));
+	CuAssertPtrNotNull(tc, buffer);
+
+	___WHEN___
+	C(ts_bspline_dequantize(data, size, buffer, len, &view, &status))
+
+	___THEN___
+	CuAssertIntEquals(tc, QUANTIZED_NUM_CTRLP,
+		(int) view.num_control_points);
+	CuAssertIntEquals(tc, 3, (int) view.dimension);
+	CuAssertIntEquals(tc, 3, (int) view.degree);
+	for (i = 0; i <= 10; i++) {
+		C(ts_bspline_eval(&spline, (tsReal) i / 10, &expected,
+			&status))
+		C(ts_bspline_view_eval(&view, (tsReal) i / 10, &actual,
+			&status))
+		dist = ts_distance(ts_deboornet_result_ptr(&expected),
+		                   ts_deboornet_result_ptr(&actual), 3);
+		CuAssertDblEquals(tc, 0, dist, (tsReal) 0.01);
+		ts_deboornet_free(&expected);
+		ts_deboornet_free(&actual);
+	}
+	CuAssertIntEquals(tc, TS_INDEX_ERROR, ts_bspline_dequantize(
+		data, size, buffer, len - 1, &view, NULL));
+
+	___TEARDOWN___
+	ts_bspline_free(&spline);
+	ts_deboornet_free(&expected);
+	ts_deboornet_free(&actual);
+	free(data);
+	free(buffer);
+}
+
+void quantized_save_load(CuTest *tc)
+{
+	___SETUP___
+	tsBSpline spline = ts_bspline_init();
+	tsBSpline loaded = ts_bspline_init();
+	tsBSpline parsed = ts_bspline_init();
+	unsigned char *data = NULL;
+	size_t size, i;
+	tsReal max_error, max_error_file;
+	const char *file = "quantized_test_file.bin";
+
+	___GIVEN___
+	C(quantized_new_spline(&spline, &status))
+
+	___WHEN___
+	C(ts_bspline_save_quantized(&spline, 8, file, &max_error_file,
+		&status))
+	C(ts_bspline_load_binary(file, &loaded, &status))
+	C(ts_bspline_to_quantized(&spline, 8, &data, &size, &max_error,
+		&status))
+	C(ts_bspline_from_binary(data, size, &parsed, &status))
+
+	___THEN___
+	CuAssertDblEquals(tc, max_error, max_error_file, 0);
+	assert_equal_shape(tc, &loaded, &parsed);
+	for (i = 0; i < ts_bspline_len_control_points(&loaded); i++) {
+		CuAssertDblEquals(tc,
+			ts_bspline_control_points_ptr(&loaded)[i],
+			ts_bspline_control_points_ptr(&parsed)[i], 0);
+	}
+
+	___TEARDOWN___
+	ts_bspline_free(&spline);
+	ts_bspline_free(&loaded);
+	ts_bspline_free(&parsed);
+	free(data);
+	remove(file);
+}
+
+void quantized_invalid(CuTest *tc)
+{
+	___SETUP___
+	tsBSpline spline = ts_bspline_init();
+	tsBSpline parsed = ts_bspline_init();
+	tsReal knots[7] = { 0, 0, 0.5, 0.501, 0.502, 1, 1 };
+	unsigned char *data = NULL;
+	size_t size, len;
+
+	___GIVEN___
+	C(ts_bspline_new_with_control_points(5, 1, 1, TS_CLAMPED, &spline,
+		&status, 0.0, 1.0, 2.0, 3.0, 4.0))
+	C(ts_bspline_set_knots(&spline, knots, &status))
+
+	___WHEN___
+	/* Unsupported number of bits. */
+	CuAssertIntEquals(tc, TS_INDEX_ERROR, ts_bspline_to_quantized(
+		&spline, 12, &data, &size, NULL, NULL));
+	CuAssertPtrEquals(tc, NULL, data);
+	/* Three knots are mapped to the same integer. */
+	CuAssertIntEquals(tc, TS_MULTIPLICITY, ts_bspline_to_quantized(
+		&spline, 8, &data, &size, NULL, NULL));
+	CuAssertPtrEquals(tc, NULL, data);
+	C(ts_bspline_to_quantized(&spline, 16, &data, &size, NULL, &status))
+
+	___THEN___
+	/* Truncated and oversized data. */
+	CuAssertIntEquals(tc, TS_PARSE_ERROR, ts_bspline_from_binary(
+		data, size - 1, &parsed, NULL));
+	CuAssertPtrEquals(tc, NULL, parsed.pImpl);
+	CuAssertIntEquals(tc, TS_PARSE_ERROR, ts_bspline_from_binary(
+		data, TS_BINARY_HEADER_SIZE + 4, &parsed, NULL));
+	CuAssertIntEquals(tc, TS_PARSE_ERROR, ts_bspline_dequantized_len(
+		data, TS_BINARY_HEADER_SIZE + 4, &len, NULL));
+	data[5] = 24;
+	CuAssertIntEquals(tc, TS_PARSE_ERROR, ts_bspline_from_binary(
+		data, size, &parsed, NULL));
+	data[5] = 16;
+	C(ts_bspline_from_binary(data, size, &parsed, &status))
+
+	___TEARDOWN___
+	ts_bspline_free(&spline);
+	ts_bspline_free(&parsed);
+	free(data);
+}
+
+CuSuite* get_quantized_suite()
+{
+	CuSuite* suite = CuSuiteNew();
+	SUITE_ADD_TEST(suite, quantized_round_trip);
+	SUITE_ADD_TEST(suite, quantized_dequantize_view);
+	SUITE_ADD_TEST(suite, quantized_save_load);
+	SUITE_ADD_TEST(suite, quantized_invalid);
+	return suite;
+}
@@ -0,0 +1,202 @@
+#include <testutils.h>
+
+/* Creates a spline of degree `deg' with interior knots of different
+ * multiplicity. None of the knots can be removed. */
+void reduce_degree_spline(size_t deg, tsBSplineType type, tsBSpline *spline,
+	tsStatus *status)
+{
+	tsReal *ctrlp = NULL;
+	size_t i, k;
+	if (ts_bspline_new(deg + 6, 2, deg, type, spline, status))
+		return;
+	if (ts_bspline_insert_knot(spline, (tsReal) 0.45, 1, spline, &k,
+			status))
+		return;
+	if (ts_bspline_insert_knot(spline, (tsReal) 0.55, deg, spline, &k,
+			status))
+		return;
+	if (ts_bspline_control_points(spline, &ctrlp, status))
+		return;
+	for (i = 0; i < ts_bspline_len_control_points(spline); i++)
+		ctrlp[i] = (tsReal) ((i * 7) % 11) - 5;
+	ts_bspline_set_control_points(spline, ctrlp, status);
+	free(ctrlp);
+}
+
+void reduce_degree_undo_elevation(CuTest *tc)
+{
+	___SETUP___
+	tsBSpline spline = ts_bspline_init();
+	tsBSpline elevated = ts_bspline_init();
+	tsBSpline reduced = ts_bspline_init();
+	tsReal error;
+	size_t deg, type, amount, direct;
+
+	for (deg = 0; deg < 5; deg++) {
+	for (type = 0; type < 2; type++) {
+		___GIVEN___
+		reduce_degree_spline(deg, type == 0 ? TS_CLAMPED : TS_OPENED,
+			&spline, &status);
+		C(status.code)
+
+		for (amount = 1; amount < 4; amount++) {
+		for (direct = 0; direct < 2; direct++) {
+			if (direct) {
+				C(ts_bspline_elevate_degree_direct(&spline,
+					amount, &elevated, &status))
+			} else {
+				C(ts_bspline_elevate_degree(&spline, amount,
+					POINT_EPSILON, &elevated, &status))
+			}
+
+			___WHEN___
+			C(ts_bspline_reduce_degree(&elevated, amount,
+				POINT_EPSILON, &reduced, &error, &status))
+
+			___THEN___
+			CuAssertIntEquals(tc, (int) deg,
+				(int) ts_bspline_degree(&reduced));
+			CuAssertIntEquals(tc,
+				(int) (ts_bspline_num_control_points(&reduced)
+					+ ts_bspline_order(&reduced)),
+				(int) ts_bspline_num_knots(&reduced));
+			CuAssertTrue(tc, error <= POINT_EPSILON);
+			assert_equal_shape(tc, &spline, &reduced);
+			/* The knots inserted by the elevation have been
+			 * removed. */
+			if (type == 0 && deg > 0) {
+				CuAssertIntEquals(tc,
+					(int) ts_bspline_num_control_points(
+						&spline),
+					(int) ts_bspline_num_control_points(
+						&reduced));
+			}
+			ts_bspline_free(&elevated);
+			ts_bspline_free(&reduced);
+		}
+		}
+		ts_bspline_free(&spline);
+	}
+	}
+
+	___TEARDOWN___
+	ts_bspline_free(&spline);
+	ts_bspline_free(&elevated);
+	ts_bspline_free(&reduced);
+}
+
+void reduce_degree_error_bound(CuTest *tc)
+{
+	___SETUP___
+	tsBSpline spline = ts_bspline_init();
+	tsBSpline reduced = ts_bspline_init();
+	tsDeBoorNet net = ts_deboornet_init();
+	tsStatus stat;
+	tsReal tolerance, error, u, dist, max_dist, point[2];
+	size_t i, amount, num_ctrlp;
+
+	___GIVEN___
+	reduce_degree_spline(4, TS_CLAMPED, &spline, &status);
+	C(status.code)
+
+	for (amount = 1; amount < 4; amount++) {
+		num_ctrlp = 0;
+		for (tolerance = (tsReal) 100.0; tolerance > (tsReal) 0.01;
+				tolerance /= 4) {
+			___WHEN___
+			if (ts_bspline_reduce_degree(&spline, amount, tolerance,
+					&reduced, &error, &stat)) {
+				/* The error of the bezier segments alone
+				 * exceeds the tolerance. */
+				CuAssertIntEquals(tc, TS_NO_RESULT, stat.code);
+				CuAssertTrue(tc, error > tolerance);
+				break;
+			}
+
+			___THEN___
+			CuAssertIntEquals(tc, (int) (4 - amount),
+				(int) ts_bspline_degree(&reduced));
+			CuAssertTrue(tc, error <= tolerance);
+			/* A smaller tolerance permits less knot removals. */
+			CuAssertTrue(tc, num_ctrlp <=
+				ts_bspline_num_control_points(&reduced));
+			num_ctrlp = ts_bspline_num_control_points(&reduced);
+			max_dist = 0;
+			for (i = 0; i <= 100; i++) {
+				u = (tsReal) i / 100;
+				C(ts_bspline_eval(&spline, u, &net, &status))
+				memcpy(point, ts_deboornet_result_ptr(&net),
+					sizeof(point));
+				ts_deboornet_free(&net);
+				C(ts_bspline_eval(&reduced, u, &net, &status))
+				dist = ts_distance(point,
+					ts_deboornet_result_ptr(&net), 2);
+				ts_deboornet_free(&net);
+				if (dist > max_dist)
+					max_dist = dist;
+			}
+			CuAssertTrue(tc, max_dist <= error + POINT_EPSILON);
+			ts_bspline_free(&reduced);
+		}
+		/* The data cannot be approximated within 0.01. */
+		CuAssertTrue(tc, tolerance > (tsReal) 0.01);
+	}
+
+	___TEARDOWN___
+	ts_bspline_free(&spline);
+	ts_bspline_free(&reduced);
+	ts_deboornet_free(&net);
+}
+
+void reduce_degree_errors(CuTest *tc)
+{
+	___SETUP___
+	tsBSpline spline = ts_bspline_init();
+	tsBSpline reduced = ts_bspline_init();
+	tsBSpline copy = ts_bspline_init();
+	tsReal error = (tsReal) 1.0;
+	size_t k;
+
+	___GIVEN___
+	C(ts_bspline_new_with_control_points(
+		2, 3, 1, TS_CLAMPED, &spline, &status,
+		1.0, 2.0, 3.0,  /* P1 */
+		-2.0, 0.5, 4.0)) /* P2 */
+	C(ts_bspline_elevate_degree(&spline, 2, POINT_EPSILON, &spline,
+		&status))
+	C(ts_bspline_insert_knot(&spline, (tsReal) 0.3, 1, &spline, &k,
+		&status))
+	C(ts_bspline_insert_knot(&spline, (tsReal) 0.7, 2, &spline, &k,
+		&status))
+
+	___WHEN___
+	CuAssertIntEquals(tc, TS_NO_RESULT, ts_bspline_reduce_degree(
+		&spline, 4, (tsReal) 1.0, &reduced, NULL, &status));
+	C(ts_bspline_reduce_degree(&spline, 0, (tsReal) 0.0, &reduced,
+		&error, &status))
+	C(ts_bspline_copy(&spline, &copy, &status))
+	/* `spline' is a line. */
+	C(ts_bspline_reduce_degree(&copy, 2, POINT_EPSILON, &copy, NULL,
+		&status))
+
+	___THEN___
+	CuAssertDblEquals(tc, 0, error, 0);
+	assert_equal_shape(tc, &spline, &reduced);
+	CuAssertIntEquals(tc, 1, (int) ts_bspline_degree(&copy));
+	CuAssertIntEquals(tc, 2, (int) ts_bspline_num_control_points(&copy));
+	assert_equal_shape(tc, &spline, &copy);
+
+	___TEARDOWN___
+	ts_bspline_free(&spline);
+	ts_bspline_free(&reduced);
+	ts_bspline_free(&copy);
+}
+
+CuSuite* get_reduce_degree_suite()
+{
+	CuSuite* suite = CuSuiteNew();
+	SUITE_ADD_TEST(suite, reduce_degree_undo_elevation);
+	SUITE_ADD_TEST(suite, reduce_degree_error_bound);
+	SUITE_ADD_TEST(suite, reduce_degree_errors);
+	return suite;
+}
@@ -73,9 +73,213 @@ void save_load_load_equals_save(CuTest *tc)
 	remove(file);
 }
 
+void save_load_large_spline(CuTest *tc)
+{
+	___SETUP___
+	tsBSpline save = ts_bspline_init();
+	tsBSpline load = ts_bspline_init();
+	tsBSpline parsed = ts_bspline_init();
+	tsReal *ctrlp = NULL;
+	char *json = NULL;
+	char *file = "save_load_large_test_file.txt";
+	size_t i;
+
+	___GIVEN___
+	/* Spans multiple chunks of the streaming reader. */
+	C(ts_bspline_new(2000, 3, 3, TS_CLAMPED, &save, &status))
+	C(ts_bspline_control_points(&save, &ctrlp, &status))
+	for (i = 0; i < 2000 * 3; i++)
+		ctrlp[i] = (tsReal) (i * 0.1 - 300.0);
+	C(ts_bspline_set_control_points(&save, ctrlp, &status))
+
+	___WHEN___
+	C(ts_bspline_save(&save, file, &status))
+	C(ts_bspline_load(file, &load, &status))
+	C(ts_bspline_to_json(&save, &json, &status))
+	C(ts_bspline_parse_json(json, &parsed, &status))
+
+	___THEN___
+	assert_equal_shape(tc, &save, &load);
+	assert_equal_shape(tc, &save, &parsed);
+	CuAssertTrue(tc, memcmp(ts_bspline_control_points_ptr(&save),
+		ts_bspline_control_points_ptr(&load),
+		ts_bspline_sof_control_points(&save)) == 0);
+	CuAssertTrue(tc, memcmp(ts_bspline_knots_ptr(&save),
+		ts_bspline_knots_ptr(&parsed),
+		ts_bspline_sof_knots(&save)) == 0);
+
+	___TEARDOWN___
+	ts_bspline_free(&save);
+	ts_bspline_free(&load);
+	ts_bspline_free(&parsed);
+	free(ctrlp);
+	free(json);
+	remove(file);
+}
+
+void save_load_parse_json_schema(CuTest *tc)
+{
+	___SETUP___
+	tsBSpline spline = ts_bspline_init();
+	const char *json =
+		"{\"comment\": {\"a\": [1, -2.5e+3, \"x\\\"y\", null, true]},"
+		" \"knots\": [0, 0, 0.5, 1, 1],"
+		"\t\"control_points\":[1,2,-3E-1,4,5,6], \"dimension\": 2,"
+		"\r\n\"degree\": 1.0 } ";
+
+	___GIVEN___ ___WHEN___
+	C(ts_bspline_parse_json(json, &spline, &status))
+
+	___THEN___
+	CuAssertIntEquals(tc, 1, (int) ts_bspline_degree(&spline));
+	CuAssertIntEquals(tc, 2, (int) ts_bspline_dimension(&spline));
+	CuAssertIntEquals(tc, 3, (int) ts_bspline_num_control_points(&spline));
+	CuAssertDblEquals(tc, -0.3,
+		ts_bspline_control_points_ptr(&spline)[2], EPSILON);
+	CuAssertDblEquals(tc, 0.5, ts_bspline_knots_ptr(&spline)[2], EPSILON);
+
+	___TEARDOWN___
+	ts_bspline_free(&spline);
+}
+
+void save_load_parse_json_invalid(CuTest *tc)
+{
+	tsBSpline spline = ts_bspline_init();
+	const char *valid = "{\"degree\": 1, \"dimension\": 1, "
+		"\"control_points\": [0, 1], \"knots\": [0, 0, 1, 1]}";
+	const char *invalid[] = {
+		"",
+		"[]",
+		"{\"degree\": 1, \"dimension\": 1, "
+		"\"control_points\": [0, 1], \"knots\": [0, 0, 1, 1]} x",
+		"{\"degree\": 01, \"dimension\": 1, "
+		"\"control_points\": [0, 1], \"knots\": [0, 0, 1, 1]}",
+		"{\"degree\": 1, \"dimension\": 1, "
+		"\"control_points\": [0, 1.], \"knots\": [0, 0, 1, 1]}",
+		"{\"degree\": 1, \"dimension\": 1, "
+		"\"control_points\": [0, 1,], \"knots\": [0, 0, 1, 1]}",
+		"{\"degree\": 1, \"dimension\": 1, "
+		"\"control_points\": [0, \"1\"], \"knots\": [0, 0, 1, 1]}",
+		"{\"degree\": 1, \"dimension\": 1, "
+		"\"control_points\": [0, 1], \"knots\": [0, 0, 1, 1],"
+		"\"knots\": [0, 0, 1, 1]}",
+		"{\"degree\": 1, \"dimension\": 1, "
+		"\"control_points\": [0, 1]}",
+		"{\"degree\": 1, \"dimension\": 1, "
+		"\"control_points\": [0, 1], \"knots\": [0, 0, 1, 1]",
+		"{\"degree\": -1, \"dimension\": 1, "
+		"\"control_points\": [0, 1], \"knots\": [0, 0, 1, 1]}",
+		"{\"degree\": 1, \"dimension\": 2, "
+		"\"control_points\": [0, 1, 2], \"knots\": [0, 0, 1, 1]}"
+	};
+	size_t i;
+
+	CuAssertIntEquals(tc, TS_SUCCESS,
+		ts_bspline_parse_json(valid, &spline, NULL));
+	ts_bspline_free(&spline);
+	for (i = 0; i < sizeof(invalid) / sizeof(invalid[0]); i++) {
+		CuAssertIntEquals(tc, TS_PARSE_ERROR,
+			ts_bspline_parse_json(invalid[i], &spline, NULL));
+		CuAssertPtrEquals(tc, NULL, spline.pImpl);
+	}
+	CuAssertIntEquals(tc, TS_NUM_KNOTS, ts_bspline_parse_json(
+		"{\"degree\": 1, \"dimension\": 1, "
+		"\"control_points\": [0, 1], \"knots\": [0, 1, 1]}",
+		&spline, NULL));
+	CuAssertIntEquals(tc, TS_KNOTS_DECR, ts_bspline_parse_json(
+		"{\"degree\": 1, \"dimension\": 1, "
+		"\"control_points\": [0, 1], \"knots\": [0, 1, 0, 1]}",
+		&spline, NULL));
+	CuAssertIntEquals(tc, TS_IO_ERROR,
+		ts_bspline_load("/does/not/exist", &spline, NULL));
+}
+
+void save_load_shortest_numbers(CuTest *tc)
+{
+	___SETUP___
+	tsBSpline spline = ts_bspline_init();
+	tsBSpline parsed = ts_bspline_init();
+	tsReal ctrlp[6] = { (tsReal) 0.1, (tsReal) 100.7, (tsReal) 1e20,
+		(tsReal) -2.5e-7, (tsReal) 3.0, (tsReal) 1234.25 };
+	tsReal *expected = NULL, *actual = NULL;
+	char *json = NULL;
+	size_t i;
+
+	___GIVEN___
+	C(ts_bspline_new(6, 1, 1, TS_CLAMPED, &spline, &status))
+	C(ts_bspline_set_control_points(&spline, ctrlp, &status))
+
+	___WHEN___
+	C(ts_bspline_to_json(&spline, &json, &status))
+	C(ts_bspline_parse_json(json, &parsed, &status))
+
+	___THEN___
+	CuAssertPtrNotNull(tc, strstr(json, "0.1,"));
+	CuAssertPtrNotNull(tc, strstr(json, "100.7,"));
+	CuAssertPtrNotNull(tc, strstr(json, "1e+20,"));
+	CuAssertPtrNotNull(tc, strstr(json, "-2.5e-07,"));
+	CuAssertPtrNotNull(tc, strstr(json, "3,"));
+	CuAssertPtrNotNull(tc, strstr(json, "1234.25"));
+	CuAssertPtrNotNull(tc, strstr(json, "0.2,"));
+	C(ts_bspline_control_points(&spline, &expected, &status))
+	C(ts_bspline_control_points(&parsed, &actual, &status))
+	for (i = 0; i < 6; i++)
+		CuAssertDblEquals(tc, expected[i], actual[i], 0);
+	free(expected);
+	free(actual);
+	expected = actual = NULL;
+	C(ts_bspline_knots(&spline, &expected, &status))
+	C(ts_bspline_knots(&parsed, &actual, &status))
+	for (i = 0; i < 8; i++)
+		CuAssertDblEquals(tc, expected[i], actual[i], 0);
+
+	___TEARDOWN___
+	ts_bspline_free(&spline);
+	ts_bspline_free(&parsed);
+	free(expected);
+	free(actual);
+	free(json);
+}
+
+void save_load_parse_long_numbers(CuTest *tc)
+{
+	___SETUP___
+	tsBSpline spline = ts_bspline_init();
+	const char *json = "{\"degree\": 0, \"dimension\": 1, "
+		"\"control_points\": [0.44703488051891326904, "
+		"3.6267778215216334085e+31], \"knots\": [0, 0.5, 1]}";
+	/* The literals are rounded to tsReal directly. In float builds,
+	 * rounding them to double first yields the next larger floats. */
+#ifdef TINYSPLINE_FLOAT_PRECISION
+	tsReal expected[2] = { 0.44703488051891326904f,
+	                       3.6267778215216334085e+31f };
+#else
+	tsReal expected[2] = { 0.44703488051891326904,
+	                       3.6267778215216334085e+31 };
+#endif
+	tsReal *actual = NULL;
+
+	___GIVEN___ ___WHEN___
+	C(ts_bspline_parse_json(json, &spline, &status))
+
+	___THEN___
+	C(ts_bspline_control_points(&spline, &actual, &status))
+	CuAssertDblEquals(tc, expected[0], actual[0], 0);
+	CuAssertDblEquals(tc, expected[1], actual[1], 0);
+
+	___TEARDOWN___
+	ts_bspline_free(&spline);
+	free(actual);
+}
+
 CuSuite* get_save_load_suite()
 {
 	CuSuite* suite = CuSuiteNew();
 	SUITE_ADD_TEST(suite, save_load_load_equals_save);
+	SUITE_ADD_TEST(suite, save_load_large_spline);
+	SUITE_ADD_TEST(suite, save_load_parse_json_schema);
+	SUITE_ADD_TEST(suite, save_load_parse_json_invalid);
+	SUITE_ADD_TEST(suite, save_load_shortest_numbers);
+	SUITE_ADD_TEST(suite, save_load_parse_long_numbers);
 	return suite;
 }
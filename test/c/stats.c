@@ -0,0 +1,166 @@
+#include <testutils.h>
+
+#define STATS_MAX 16
+
+const tsStats *stats_find(const tsStats *stats,
+                          size_t num,
+                          const char *function)
+{
+	size_t i;
+	for (i = 0; i < num; i++) {
+		if (strcmp(stats[i].function, function) == 0)
+			return stats + i;
+	}
+	return NULL;
+}
+
+void stats_hot_loop(CuTest *tc)
+{
+	___SETUP___
+	tsBSpline spline = ts_bspline_init();
+	tsEvalContext ctx = ts_eval_context_init();
+	tsStats stats[STATS_MAX];
+	const tsStats *eval;
+	tsReal point[2];
+	size_t num, i;
+
+	___GIVEN___
+	C(ts_bspline_new(7, 2, 3, TS_CLAMPED, &spline, &status))
+	C(ts_eval_context_new(3, 2, &ctx, &status))
+	ts_stats_reset();
+
+	___WHEN___
+	for (i = 0; i < 100; i++) {
+		C(ts_eval_context_eval(&ctx, &spline, (tsReal) i / 100,
+			point, &status))
+	}
+	num = ts_stats_get(stats, STATS_MAX);
+
+	___THEN___
+	if (!ts_stats_enabled()) {
+		CuAssertIntEquals(tc, 0, (int) num);
+	} else {
+		CuAssertIntEquals(tc, 1, (int) num);
+		eval = stats_find(stats, num, "ts_eval_context_eval");
+		CuAssertPtrNotNull(tc, eval);
+		CuAssertIntEquals(tc, 100, (int) eval->num_calls);
+		CuAssertIntEquals(tc, 0, (int) eval->num_allocs);
+		CuAssertIntEquals(tc, 0, (int) eval->num_bytes);
+		CuAssertIntEquals(tc, 100, (int) eval->num_evals);
+		CuAssertIntEquals(tc, 100, (int) eval->num_knot_searches);
+	}
+
+	___TEARDOWN___
+	ts_bspline_free(&spline);
+	ts_eval_context_free(&ctx);
+}
+
+void stats_nested_calls(CuTest *tc)
+{
+	___SETUP___
+	tsBSpline spline = ts_bspline_init();
+	tsBSpline result = ts_bspline_init();
+	tsDeBoorNet net = ts_deboornet_init();
+	tsStats stats[STATS_MAX];
+	const tsStats *insert, *eval, *other;
+	size_t num, k;
+
+	___GIVEN___
+	C(ts_bspline_new(7, 2, 3, TS_CLAMPED, &spline, &status))
+	ts_stats_reset();
+
+	___WHEN___
+	C(ts_bspline_eval(&spline, (tsReal) 0.3, &net, &status))
+	C(ts_bspline_insert_knot(&spline, (tsReal) 0.3, 2, &result, &k,
+		&status))
+	ts_deboornet_free(&net);
+	num = ts_stats_get(stats, STATS_MAX);
+
+	___THEN___
+	if (!ts_stats_enabled()) {
+		CuAssertIntEquals(tc, 0, (int) num);
+	} else {
+		eval = stats_find(stats, num, "ts_bspline_eval");
+		CuAssertPtrNotNull(tc, eval);
+		CuAssertIntEquals(tc, 1, (int) eval->num_calls);
+		CuAssertTrue(tc, eval->num_allocs > 0);
+		CuAssertTrue(tc, eval->num_bytes > 0);
+		CuAssertIntEquals(tc, 1, (int) eval->num_evals);
+		/* ts_bspline_insert_knot calls ts_bspline_eval twice. */
+		insert = stats_find(stats, num, "ts_bspline_insert_knot");
+		CuAssertPtrNotNull(tc, insert);
+		CuAssertIntEquals(tc, 1, (int) insert->num_calls);
+		CuAssertIntEquals(tc, 2, (int) insert->num_evals);
+		CuAssertIntEquals(tc, 2, (int) insert->num_knot_insertions);
+		/* ts_deboornet_free is not instrumented and does not
+		 * allocate. */
+		other = stats_find(stats, num, "other");
+		CuAssertPtrEquals(tc, NULL, (void *) other);
+		/* The number of functions does not depend on `num'. */
+		CuAssertIntEquals(tc, (int) num, (int) ts_stats_get(stats, 1));
+		ts_stats_reset();
+		CuAssertIntEquals(tc, 0, (int) ts_stats_get(stats, STATS_MAX));
+	}
+
+	___TEARDOWN___
+	ts_bspline_free(&spline);
+	ts_bspline_free(&result);
+	ts_deboornet_free(&net);
+}
+
+void stats_views_and_files(CuTest *tc)
+{
+	___SETUP___
+	tsBSpline spline = ts_bspline_init();
+	tsBSpline load = ts_bspline_init();
+	tsBSplineView view;
+	tsDeBoorNet net = ts_deboornet_init();
+	tsStats stats[STATS_MAX];
+	const tsStats *eval, *save, *other;
+	char *file = "stats_test_file.json";
+	size_t num;
+
+	___GIVEN___
+	C(ts_bspline_new(7, 2, 3, TS_CLAMPED, &spline, &status))
+	ts_bspline_as_view(&spline, &view);
+	ts_stats_reset();
+
+	___WHEN___
+	C(ts_bspline_view_eval(&view, (tsReal) 0.3, &net, &status))
+	C(ts_bspline_save(&spline, file, &status))
+	C(ts_bspline_load(file, &load, &status))
+	num = ts_stats_get(stats, STATS_MAX);
+
+	___THEN___
+	if (!ts_stats_enabled()) {
+		CuAssertIntEquals(tc, 0, (int) num);
+	} else {
+		eval = stats_find(stats, num, "ts_bspline_view_eval");
+		CuAssertPtrNotNull(tc, eval);
+		CuAssertIntEquals(tc, 1, (int) eval->num_calls);
+		CuAssertIntEquals(tc, 1, (int) eval->num_evals);
+		CuAssertTrue(tc, eval->num_allocs > 0);
+		save = stats_find(stats, num, "ts_bspline_save");
+		CuAssertPtrNotNull(tc, save);
+		CuAssertIntEquals(tc, 1, (int) save->num_calls);
+		CuAssertPtrNotNull(tc, (void *) stats_find(stats, num,
+			"ts_bspline_load"));
+		other = stats_find(stats, num, "other");
+		CuAssertPtrEquals(tc, NULL, (void *) other);
+	}
+
+	___TEARDOWN___
+	remove(file);
+	ts_bspline_free(&spline);
+	ts_bspline_free(&load);
+	ts_deboornet_free(&net);
+}
+
+CuSuite* get_stats_suite()
+{
+	CuSuite* suite = CuSuiteNew();
+	SUITE_ADD_TEST(suite, stats_hot_loop);
+	SUITE_ADD_TEST(suite, stats_nested_calls);
+	SUITE_ADD_TEST(suite, stats_views_and_files);
+	return suite;
+}
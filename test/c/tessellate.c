@@ -0,0 +1,185 @@
+#include <testutils.h>
+#include <math.h>
+
+void *counting_grow(void *buffer, size_t size, void *user_data)
+{
+	(*((size_t *) user_data))++;
+	return realloc(buffer, size);
+}
+
+tsReal polyline_distance(const tsReal *point,
+                         const tsReal *polyline,
+                         size_t num,
+                         size_t dim)
+{
+	tsReal min = (tsReal) -1.0, len_sq, proj, t, d, dist;
+	size_t i, j;
+	for (i = 0; i + 1 < num; i++) {
+		len_sq = proj = (tsReal) 0.0;
+		for (j = 0; j < dim; j++) {
+			d = polyline[(i+1)*dim + j] - polyline[i*dim + j];
+			len_sq += d * d;
+			proj += (point[j] - polyline[i*dim + j]) * d;
+		}
+		t = len_sq > (tsReal) 0.0 ? proj / len_sq : (tsReal) 0.0;
+		t = t < (tsReal) 0.0 ? (tsReal) 0.0 : t;
+		t = t > (tsReal) 1.0 ? (tsReal) 1.0 : t;
+		dist = (tsReal) 0.0;
+		for (j = 0; j < dim; j++) {
+			d = point[j] - (polyline[i*dim + j] + t *
+				(polyline[(i+1)*dim + j] - polyline[i*dim + j]));
+			dist += d * d;
+		}
+		dist = (tsReal) sqrt(dist);
+		if (min < (tsReal) 0.0 || dist < min)
+			min = dist;
+	}
+	return min;
+}
+
+void tessellate_line(CuTest *tc)
+{
+	___SETUP___
+	tsBSpline spline = ts_bspline_init();
+	tsReal dist, *points = NULL;
+	size_t capacity = 0, num;
+
+	___GIVEN___
+	C(ts_bspline_new_with_control_points(
+		4, 2, 3, TS_CLAMPED, &spline, &status,
+		0.0, 0.0,
+		1.0, 1.0,
+		2.0, 2.0,
+		3.0, 3.0))
+
+	___WHEN___
+	C(ts_bspline_tessellate(&spline, (tsReal) 0.01, &points,
+		&capacity, &num, NULL, NULL, &status))
+
+	___THEN___
+	CuAssertIntEquals(tc, 2, (int) num);
+	CuAssertTrue(tc, capacity >= num);
+	dist = ts_distance_varargs(tc, 2, points, 0.0, 0.0);
+	CuAssertDblEquals(tc, 0, dist, POINT_EPSILON);
+	dist = ts_distance_varargs(tc, 2, points + 2, 3.0, 3.0);
+	CuAssertDblEquals(tc, 0, dist, POINT_EPSILON);
+
+	___TEARDOWN___
+	ts_bspline_free(&spline);
+	free(points);
+}
+
+void tessellate_max_deviation(CuTest *tc)
+{
+	___SETUP___
+	tsBSpline spline = ts_bspline_init();
+	tsReal tol, dist, *points = NULL, *samples = NULL;
+	size_t capacity = 0, num, num_samples, i;
+	const tsReal tols[3] = { (tsReal) 0.1, (tsReal) 0.01, (tsReal) 0.001 };
+	size_t t;
+
+	___GIVEN___
+	C(ts_bspline_new_with_control_points(
+		7, 2, 3, TS_CLAMPED, &spline, &status,
+		 0.0,  0.0,
+		 1.0,  3.0,
+		 2.0, -3.0,
+		 3.0,  0.0,
+		 4.0,  0.0,
+		 5.0,  0.0,
+		 6.0,  5.0))
+	C(ts_bspline_sample(&spline, 2000, &samples, &num_samples, &status))
+
+	___WHEN___
+	for (t = 0; t < 3; t++) {
+		tol = tols[t];
+		C(ts_bspline_tessellate(&spline, tol, &points,
+			&capacity, &num, NULL, NULL, &status))
+
+		/* Then. */
+		CuAssertTrue(tc, num > 2);
+		CuAssertTrue(tc, num < num_samples);
+		for (i = 0; i < num_samples; i++) {
+			dist = polyline_distance(samples + i*2, points,
+			                         num, 2);
+			CuAssertTrue(tc, dist <= tol + POINT_EPSILON);
+		}
+	}
+
+	___TEARDOWN___
+	ts_bspline_free(&spline);
+	free(points);
+	free(samples);
+}
+
+void tessellate_grow_callback(CuTest *tc)
+{
+	___SETUP___
+	tsBSpline spline = ts_bspline_init();
+	tsReal *points = NULL;
+	size_t capacity = 4, num, calls = 0;
+
+	___GIVEN___
+	C(ts_bspline_new_with_control_points(
+		4, 3, 3, TS_CLAMPED, &spline, &status,
+		0.0, 0.0, 0.0,
+		1.0, 4.0, 1.0,
+		2.0, -4.0, 2.0,
+		3.0, 0.0, 3.0))
+	points = (tsReal *) malloc(capacity * 3 * sizeof(tsReal));
+	CuAssertPtrNotNull(tc, points);
+
+	___WHEN___
+	C(ts_bspline_tessellate(&spline, (tsReal) 0.001, &points,
+		&capacity, &num, counting_grow, &calls, &status))
+
+	___THEN___
+	CuAssertTrue(tc, num > 4);
+	CuAssertTrue(tc, calls > 0);
+	CuAssertTrue(tc, capacity >= num);
+
+	___TEARDOWN___
+	ts_bspline_free(&spline);
+	free(points);
+}
+
+void tessellate_discontinuous(CuTest *tc)
+{
+	___SETUP___
+	tsBSpline spline = ts_bspline_init();
+	tsReal dist, *points = NULL;
+	size_t capacity = 0, num;
+
+	___GIVEN___
+	C(ts_bspline_new_with_control_points(
+		4, 2, 1, TS_BEZIERS, &spline, &status,
+		0.0, 0.0,
+		1.0, 0.0,
+		5.0, 5.0,
+		6.0, 5.0))
+
+	___WHEN___
+	C(ts_bspline_tessellate(&spline, (tsReal) 0.01, &points,
+		&capacity, &num, NULL, NULL, &status))
+
+	___THEN___
+	CuAssertIntEquals(tc, 4, (int) num);
+	dist = ts_distance_varargs(tc, 2, points + 2, 1.0, 0.0);
+	CuAssertDblEquals(tc, 0, dist, POINT_EPSILON);
+	dist = ts_distance_varargs(tc, 2, points + 4, 5.0, 5.0);
+	CuAssertDblEquals(tc, 0, dist, POINT_EPSILON);
+
+	___TEARDOWN___
+	ts_bspline_free(&spline);
+	free(points);
+}
+
+CuSuite* get_tessellate_suite()
+{
+	CuSuite* suite = CuSuiteNew();
+	SUITE_ADD_TEST(suite, tessellate_line);
+	SUITE_ADD_TEST(suite, tessellate_max_deviation);
+	SUITE_ADD_TEST(suite, tessellate_grow_callback);
+	SUITE_ADD_TEST(suite, tessellate_discontinuous);
+	return suite;
+}
@@ -14,6 +14,7 @@ CuSuite* get_derive_suite();
 CuSuite* get_bisect_suite();
 CuSuite* get_save_load_suite();
 CuSuite* get_elevate_degree_suite();
+CuSuite* get_reduce_degree_suite();
 CuSuite* get_align_suite();
 CuSuite* get_tension_suite();
 CuSuite* get_morph_suite();
@@ -22,6 +23,17 @@ CuSuite* get_vector_suite();
 CuSuite* get_chord_lengths_suite();
 CuSuite* get_copy_suite();
 CuSuite* get_sub_spline_suite();
+CuSuite* get_tessellate_suite();
+CuSuite* get_allocator_suite();
+CuSuite* get_view_suite();
+CuSuite* get_eval_context_suite();
+CuSuite* get_binary_suite();
+CuSuite* get_container_suite();
+CuSuite* get_json_stream_suite();
+CuSuite* get_quantized_suite();
+CuSuite* get_stats_suite();
+CuSuite* get_tracing_suite();
+CuSuite* get_bsplineset_suite();
 
 int main()
 {
@@ -43,6 +55,7 @@ int main()
 	CuSuiteAddSuite(suite, get_bisect_suite());
 	CuSuiteAddSuite(suite, get_save_load_suite());
 	CuSuiteAddSuite(suite, get_elevate_degree_suite());
+	CuSuiteAddSuite(suite, get_reduce_degree_suite());
 	CuSuiteAddSuite(suite, get_align_suite());
 	CuSuiteAddSuite(suite, get_tension_suite());
 	CuSuiteAddSuite(suite, get_morph_suite());
@@ -51,6 +64,17 @@ int main()
 	CuSuiteAddSuite(suite, get_chord_lengths_suite());
 	CuSuiteAddSuite(suite, get_copy_suite());
 	CuSuiteAddSuite(suite, get_sub_spline_suite());
+	CuSuiteAddSuite(suite, get_tessellate_suite());
+	CuSuiteAddSuite(suite, get_allocator_suite());
+	CuSuiteAddSuite(suite, get_view_suite());
+	CuSuiteAddSuite(suite, get_eval_context_suite());
+	CuSuiteAddSuite(suite, get_binary_suite());
+	CuSuiteAddSuite(suite, get_container_suite());
+	CuSuiteAddSuite(suite, get_json_stream_suite());
+	CuSuiteAddSuite(suite, get_quantized_suite());
+	CuSuiteAddSuite(suite, get_stats_suite());
+	CuSuiteAddSuite(suite, get_tracing_suite());
+	CuSuiteAddSuite(suite, get_bsplineset_suite());
 
 	CuSuiteRun(suite);
 	CuSuiteSummary(suite, output);
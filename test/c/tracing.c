@@ -0,0 +1,208 @@
+#include <testutils.h>
+
+#define TRACING_MAX 64
+
+typedef struct
+{
+	const char *names[TRACING_MAX];
+	char phases[TRACING_MAX];
+	size_t num;
+	/* Number of unmatched end events. */
+	size_t num_unmatched;
+	/* Names of the open begin events. */
+	const char *stack[TRACING_MAX];
+	size_t depth;
+} tracing_log;
+
+void tracing_record(const char *name, char phase, void *user_data)
+{
+	tracing_log *log = (tracing_log *) user_data;
+	if (log->num < TRACING_MAX) {
+		log->names[log->num] = name;
+		log->phases[log->num] = phase;
+		log->num++;
+	}
+	if (phase == 'B') {
+		if (log->depth < TRACING_MAX)
+			log->stack[log->depth++] = name;
+	} else if (log->depth == 0 ||
+	           strcmp(log->stack[log->depth - 1], name) != 0) {
+		log->num_unmatched++;
+	} else {
+		log->depth--;
+	}
+}
+
+void tracing_begin(const char *name, void *user_data)
+{
+	tracing_record(name, 'B', user_data);
+}
+
+void tracing_end(const char *name, void *user_data)
+{
+	tracing_record(name, 'E', user_data);
+}
+
+int tracing_contains(const tracing_log *log, const char *name)
+{
+	size_t i;
+	for (i = 0; i < log->num; i++) {
+		if (strcmp(log->names[i], name) == 0)
+			return 1;
+	}
+	return 0;
+}
+
+void tracing_nested_phases(CuTest *tc)
+{
+	___SETUP___
+	tsBSpline linear = ts_bspline_init();
+	tsBSpline cubic = ts_bspline_init();
+	tsBSpline s1 = ts_bspline_init();
+	tsBSpline s2 = ts_bspline_init();
+	tsTracer tracer;
+	tracing_log log;
+	const tsTracer *prev;
+
+	___GIVEN___
+	C(ts_bspline_new(5, 2, 1, TS_CLAMPED, &linear, &status))
+	C(ts_bspline_new(10, 2, 3, TS_CLAMPED, &cubic, &status))
+	memset(&log, 0, sizeof(log));
+	tracer.begin = tracing_begin;
+	tracer.end = tracing_end;
+	tracer.user_data = &log;
+
+	___WHEN___
+	prev = ts_set_tracer(&tracer);
+	C(ts_bspline_align(&linear, &cubic, TS_POINT_EPSILON, &s1, &s2,
+		&status))
+	ts_set_tracer(prev);
+
+	___THEN___
+	CuAssertPtrEquals(tc, NULL, (void *) prev);
+	if (!ts_tracing_enabled()) {
+		CuAssertIntEquals(tc, 0, (int) log.num);
+	} else {
+		CuAssertTrue(tc, log.num < TRACING_MAX);
+		CuAssertIntEquals(tc, 0, (int) log.num_unmatched);
+		CuAssertIntEquals(tc, 0, (int) log.depth);
+		CuAssertStrEquals(tc, "ts_bspline_align", log.names[0]);
+		CuAssertStrEquals(tc, "ts_bspline_align",
+			log.names[log.num - 1]);
+		/* Nested API functions and phases. */
+		CuAssertTrue(tc, tracing_contains(&log,
+			"ts_bspline_elevate_degree"));
+		CuAssertTrue(tc, tracing_contains(&log,
+			"ts_bspline_to_beziers"));
+		CuAssertTrue(tc, tracing_contains(&log,
+			"ts_bspline_elevate_degree/elevate"));
+		CuAssertTrue(tc, tracing_contains(&log,
+			"ts_bspline_align/insert_knots"));
+	}
+
+	___TEARDOWN___
+	ts_set_tracer(NULL);
+	ts_bspline_free(&linear);
+	ts_bspline_free(&cubic);
+	ts_bspline_free(&s1);
+	ts_bspline_free(&s2);
+}
+
+void tracing_balanced_on_error(CuTest *tc)
+{
+	___SETUP___
+	tsBSpline spline = ts_bspline_init();
+	tsReal points[8] = { 0, 0, 1, 1, 2, 0, 3, 1 };
+	tsTracer tracer;
+	tracing_log log;
+
+	___GIVEN___
+	memset(&log, 0, sizeof(log));
+	tracer.begin = tracing_begin;
+	tracer.end = tracing_end;
+	tracer.user_data = &log;
+	ts_set_tracer(&tracer);
+
+	___WHEN___
+	CuAssertIntEquals(tc, TS_NUM_POINTS,
+		ts_bspline_interpolate_cubic_natural(points, 0, 2, &spline,
+			NULL));
+	C(ts_bspline_interpolate_cubic_natural(points, 4, 2, &spline,
+		&status))
+	ts_set_tracer(NULL);
+	ts_bspline_free(&spline);
+	C(ts_bspline_interpolate_cubic_natural(points, 4, 2, &spline,
+		&status))
+
+	___THEN___
+	if (!ts_tracing_enabled()) {
+		CuAssertIntEquals(tc, 0, (int) log.num);
+	} else {
+		/* Failed call (2), successful call with two phases (6). */
+		CuAssertIntEquals(tc, 8, (int) log.num);
+		CuAssertIntEquals(tc, 0, (int) log.num_unmatched);
+		CuAssertIntEquals(tc, 0, (int) log.depth);
+		CuAssertTrue(tc, tracing_contains(&log,
+			"ts_bspline_interpolate_cubic_natural/build"));
+	}
+
+	___TEARDOWN___
+	ts_set_tracer(NULL);
+	ts_bspline_free(&spline);
+}
+
+void tracing_views_and_files(CuTest *tc)
+{
+	___SETUP___
+	tsBSpline spline = ts_bspline_init();
+	tsBSpline load = ts_bspline_init();
+	tsBSplineView view;
+	tsDeBoorNet net = ts_deboornet_init();
+	char *file = "tracing_test_file.json";
+	tsTracer tracer;
+	tracing_log log;
+
+	___GIVEN___
+	C(ts_bspline_new(7, 2, 3, TS_CLAMPED, &spline, &status))
+	ts_bspline_as_view(&spline, &view);
+	memset(&log, 0, sizeof(log));
+	tracer.begin = tracing_begin;
+	tracer.end = tracing_end;
+	tracer.user_data = &log;
+
+	___WHEN___
+	ts_set_tracer(&tracer);
+	C(ts_bspline_view_eval(&view, (tsReal) 0.3, &net, &status))
+	C(ts_bspline_save(&spline, file, &status))
+	C(ts_bspline_load(file, &load, &status))
+	ts_set_tracer(NULL);
+
+	___THEN___
+	if (!ts_tracing_enabled()) {
+		CuAssertIntEquals(tc, 0, (int) log.num);
+	} else {
+		/* One begin/end pair per call, nothing nested. */
+		CuAssertIntEquals(tc, 6, (int) log.num);
+		CuAssertIntEquals(tc, 0, (int) log.num_unmatched);
+		CuAssertIntEquals(tc, 0, (int) log.depth);
+		CuAssertStrEquals(tc, "ts_bspline_view_eval", log.names[0]);
+		CuAssertStrEquals(tc, "ts_bspline_save", log.names[2]);
+		CuAssertStrEquals(tc, "ts_bspline_load", log.names[4]);
+	}
+
+	___TEARDOWN___
+	ts_set_tracer(NULL);
+	remove(file);
+	ts_bspline_free(&spline);
+	ts_bspline_free(&load);
+	ts_deboornet_free(&net);
+}
+
+CuSuite* get_tracing_suite()
+{
+	CuSuite* suite = CuSuiteNew();
+	SUITE_ADD_TEST(suite, tracing_nested_phases);
+	SUITE_ADD_TEST(suite, tracing_balanced_on_error);
+	SUITE_ADD_TEST(suite, tracing_views_and_files);
+	return suite;
+}
@@ -0,0 +1,228 @@
+#include <testutils.h>
+
+/* Interleaved control points (x, y, id) and knots (knot, weight). */
+static const tsReal INTERLEAVED_CTRLP[15] = {
+	-1.75, -1.0,  100.0,
+	-1.5,  -0.5,  101.0,
+	-1.5,   0.0,  102.0,
+	-1.25,  0.5,  103.0,
+	-0.75,  0.75, 104.0
+};
+static const tsReal INTERLEAVED_KNOTS[18] = {
+	0.0, 9.0,
+	0.0, 9.0,
+	0.0, 9.0,
+	0.0, 9.0,
+	0.5, 9.0,
+	1.0, 9.0,
+	1.0, 9.0,
+	1.0, 9.0,
+	1.0, 9.0
+};
+
+tsError view_new_reference(tsBSpline *spline, tsStatus *status)
+{
+	return ts_bspline_new_with_control_points(
+		5, 2, 3, TS_CLAMPED, spline, status,
+		-1.75, -1.0,
+		-1.5,  -0.5,
+		-1.5,   0.0,
+		-1.25,  0.5,
+		-0.75,  0.75);
+}
+
+void view_eval(CuTest *tc)
+{
+	___SETUP___
+	tsBSpline spline = ts_bspline_init();
+	tsBSplineView view;
+	tsDeBoorNet expected = ts_deboornet_init();
+	tsDeBoorNet actual = ts_deboornet_init();
+	tsReal knots[7] = { 0.0, 0.1, 0.3, 0.5, 0.7, 0.9, 1.0 };
+	tsReal dist;
+	size_t i;
+
+	___GIVEN___
+	C(view_new_reference(&spline, &status))
+	C(ts_bspline_view_init(5, 2, 3,
+		INTERLEAVED_CTRLP, 3,
+		INTERLEAVED_KNOTS, 2,
+		&view, &status))
+
+	___WHEN___
+	for (i = 0; i < 7; i++) {
+		C(ts_bspline_eval(&spline, knots[i], &expected, &status))
+		C(ts_bspline_view_eval(&view, knots[i], &actual, &status))
+
+		/* Then. */
+		CuAssertIntEquals(tc,
+			(int) ts_deboornet_num_points(&expected),
+			(int) ts_deboornet_num_points(&actual));
+		dist = ts_distance(ts_deboornet_result_ptr(&expected),
+		                   ts_deboornet_result_ptr(&actual), 2);
+		CuAssertDblEquals(tc, 0, dist, POINT_EPSILON);
+		ts_deboornet_free(&expected);
+		ts_deboornet_free(&actual);
+	}
+
+	___TEARDOWN___
+	ts_bspline_free(&spline);
+	ts_deboornet_free(&expected);
+	ts_deboornet_free(&actual);
+}
+
+void view_sample_and_chord_lengths(CuTest *tc)
+{
+	___SETUP___
+	tsBSpline spline = ts_bspline_init();
+	tsBSplineView view;
+	tsReal *expected = NULL, *actual = NULL;
+	tsReal knots[50], len_expected[50], len_actual[50];
+	size_t num_expected, num_actual, i;
+
+	___GIVEN___
+	C(view_new_reference(&spline, &status))
+	C(ts_bspline_view_init(5, 2, 3,
+		INTERLEAVED_CTRLP, 3,
+		INTERLEAVED_KNOTS, 2,
+		&view, &status))
+	ts_bspline_uniform_knot_seq(&spline, 50, knots);
+
+	___WHEN___
+	C(ts_bspline_sample(&spline, 50, &expected, &num_expected, &status))
+	C(ts_bspline_view_sample(&view, 50, &actual, &num_actual, &status))
+	C(ts_bspline_chord_lengths(&spline, knots, 50, len_expected,
+		&status))
+	C(ts_bspline_view_chord_lengths(&view, knots, 50, len_actual,
+		&status))
+
+	___THEN___
+	CuAssertIntEquals(tc, (int) num_expected, (int) num_actual);
+	for (i = 0; i < num_expected * 2; i++)
+		CuAssertDblEquals(tc, expected[i], actual[i], POINT_EPSILON);
+	for (i = 0; i < 50; i++) {
+		CuAssertDblEquals(tc, len_expected[i], len_actual[i],
+			POINT_EPSILON);
+	}
+
+	___TEARDOWN___
+	ts_bspline_free(&spline);
+	free(expected);
+	free(actual);
+}
+
+void view_bisect(CuTest *tc)
+{
+	___SETUP___
+	tsBSplineView view;
+	tsDeBoorNet net = ts_deboornet_init();
+	const tsReal *result;
+
+	___GIVEN___
+	C(ts_bspline_view_init(5, 2, 3,
+		INTERLEAVED_CTRLP, 3,
+		INTERLEAVED_KNOTS, 2,
+		&view, &status))
+
+	___WHEN___
+	C(ts_bspline_view_bisect(&view, (tsReal) 0.25, POINT_EPSILON, 1, 1,
+		1, 50, &net, &status))
+
+	___THEN___
+	result = ts_deboornet_result_ptr(&net);
+	CuAssertDblEquals(tc, 0.25, result[1], POINT_EPSILON);
+
+	___TEARDOWN___
+	ts_deboornet_free(&net);
+}
+
+void view_to_json(CuTest *tc)
+{
+	___SETUP___
+	tsBSpline spline = ts_bspline_init();
+	tsBSpline parsed = ts_bspline_init();
+	tsBSplineView view;
+	char *expected = NULL, *actual = NULL;
+
+	___GIVEN___
+	C(view_new_reference(&spline, &status))
+	C(ts_bspline_view_init(5, 2, 3,
+		INTERLEAVED_CTRLP, 3,
+		INTERLEAVED_KNOTS, 2,
+		&view, &status))
+
+	___WHEN___
+	C(ts_bspline_to_json(&spline, &expected, &status))
+	C(ts_bspline_view_to_json(&view, &actual, &status))
+	C(ts_bspline_parse_json(actual, &parsed, &status))
+
+	___THEN___
+	CuAssertStrEquals(tc, expected, actual);
+	assert_equal_shape(tc, &spline, &parsed);
+
+	___TEARDOWN___
+	ts_bspline_free(&spline);
+	ts_bspline_free(&parsed);
+	free(expected);
+	free(actual);
+}
+
+void view_to_bspline(CuTest *tc)
+{
+	___SETUP___
+	tsBSpline spline = ts_bspline_init();
+	tsBSpline copy = ts_bspline_init();
+	tsBSplineView view;
+	tsReal knots[4] = { 0.0, 0.0, 1.0, 0.5 }; /* decreasing */
+	tsReal ctrlp[4] = { 0.0, 0.0, 1.0, 1.0 };
+
+	___GIVEN___
+	C(view_new_reference(&spline, &status))
+	C(ts_bspline_view_init(5, 2, 3,
+		INTERLEAVED_CTRLP, 3,
+		INTERLEAVED_KNOTS, 2,
+		&view, &status))
+
+	___WHEN___
+	C(ts_bspline_view_to_bspline(&view, &copy, &status))
+
+	___THEN___
+	assert_equal_shape(tc, &spline, &copy);
+	ts_bspline_free(&copy);
+	C(ts_bspline_view_init(2, 2, 1, ctrlp, 0, knots, 0, &view, &status))
+	CuAssertIntEquals(tc, TS_KNOTS_DECR,
+		ts_bspline_view_to_bspline(&view, &copy, NULL));
+	CuAssertPtrEquals(tc, NULL, copy.pImpl);
+
+	___TEARDOWN___
+	ts_bspline_free(&spline);
+	ts_bspline_free(&copy);
+}
+
+void view_init_errors(CuTest *tc)
+{
+	tsBSplineView view;
+	tsReal data[8] = { 0 };
+	CuAssertIntEquals(tc, TS_DIM_ZERO,
+		ts_bspline_view_init(2, 0, 1, data, 0, data, 0, &view, NULL));
+	CuAssertIntEquals(tc, TS_LCTRLP_DIM_MISMATCH,
+		ts_bspline_view_init(2, 2, 1, data, 1, data, 0, &view, NULL));
+	CuAssertIntEquals(tc, TS_DEG_GE_NCTRLP,
+		ts_bspline_view_init(2, 2, 2, data, 0, data, 0, &view, NULL));
+	CuAssertIntEquals(tc, TS_SUCCESS,
+		ts_bspline_view_init(2, 2, 1, data, 0, data, 0, &view, NULL));
+	CuAssertIntEquals(tc, 2, (int) view.control_point_stride);
+	CuAssertIntEquals(tc, 1, (int) view.knot_stride);
+}
+
+CuSuite* get_view_suite()
+{
+	CuSuite* suite = CuSuiteNew();
+	SUITE_ADD_TEST(suite, view_eval);
+	SUITE_ADD_TEST(suite, view_sample_and_chord_lengths);
+	SUITE_ADD_TEST(suite, view_bisect);
+	SUITE_ADD_TEST(suite, view_to_json);
+	SUITE_ADD_TEST(suite, view_to_bspline);
+	SUITE_ADD_TEST(suite, view_init_errors);
+	return suite;
+}
@@ -0,0 +1,170 @@
+#include <testutilscxx.h>
+
+#include <stdexcept>
+#include <thread>
+
+// Splines of very different size and dimensionality.
+static vector<BSpline>
+batch_splines(size_t num)
+{
+	vector<BSpline> splines;
+	for (size_t i = 0; i < num; i++) {
+		size_t numCtrlp = i % 10 == 0 ? 200 : 4 + i % 7;
+		BSpline spline(numCtrlp, 2 + i % 2, i % 4);
+		vector<real> ctrlp = spline.controlPoints();
+		for (size_t j = 0; j < ctrlp.size(); j++)
+			ctrlp[j] = (real) ((i + j * 3) % 11);
+		spline.setControlPoints(ctrlp);
+		splines.push_back(spline);
+	}
+	return splines;
+}
+
+void
+batch_sample(CuTest *tc)
+{
+	// Given
+	vector<BSpline> splines = batch_splines(100);
+	Batch batch(4);
+
+	// When
+	BatchResult result = batch.sample(splines, 30);
+
+	// Then
+	CuAssertIntEquals(tc, 4, (int) batch.numThreads());
+	CuAssertIntEquals(tc, 100, (int) result.size());
+	CuAssertIntEquals(tc, 101, (int) result.offsets().size());
+	CuAssertIntEquals(tc, (int) result.values().size(),
+	                  (int) result.offsets().back());
+	for (size_t i = 0; i < splines.size(); i++) {
+		vector<real> expected = splines[i].sample(30);
+		CuAssertIntEquals(tc, (int) expected.size(),
+		                  (int) result.length(i));
+		for (size_t j = 0; j < expected.size(); j++) {
+			CuAssertDblEquals(tc, expected[j], result.data(i)[j],
+			                  POINT_EPSILON);
+		}
+	}
+}
+
+void
+batch_chord_lengths(CuTest *tc)
+{
+	// Given
+	vector<BSpline> splines = batch_splines(50);
+	Batch batch(3);
+
+	// When
+	BatchResult result = batch.chordLengths(splines, 20);
+
+	// Then
+	CuAssertIntEquals(tc, 50, (int) result.size());
+	for (size_t i = 0; i < splines.size(); i++) {
+		vector<real> expected = splines[i].chordLengths(20).lengths();
+		CuAssertIntEquals(tc, 20, (int) result.length(i));
+		for (size_t j = 0; j < expected.size(); j++) {
+			CuAssertDblEquals(tc, expected[j], result.data(i)[j],
+			                  POINT_EPSILON);
+		}
+	}
+}
+
+void
+batch_map(CuTest *tc)
+{
+	// Given
+	vector<BSpline> splines = batch_splines(64);
+	Batch single(1), multi(8);
+	auto length = [](const BSpline &spline) {
+		return spline.numControlPoints();
+	};
+	auto op = [](const BSpline &spline, real *out) {
+		vector<real> ctrlp = spline.controlPoints();
+		for (size_t i = 0; i < spline.numControlPoints(); i++)
+			out[i] = ctrlp[i * spline.dimension()];
+	};
+
+	// When
+	BatchResult expected = single.map(splines, length, op);
+	BatchResult actual = multi.map(splines, length, op);
+
+	// Then
+	CuAssertIntEquals(tc, (int) expected.values().size(),
+	                  (int) actual.values().size());
+	for (size_t i = 0; i < expected.values().size(); i++) {
+		CuAssertDblEquals(tc, expected.values()[i],
+		                  actual.values()[i], 0);
+	}
+	CuAssertIntEquals(tc, 0, (int) multi.map({}, length, op).size());
+}
+
+void
+batch_exception(CuTest *tc)
+{
+	// Given
+	vector<BSpline> splines = batch_splines(100);
+	Batch batch(4);
+
+	// When
+	try {
+		batch.map(splines,
+		          [](const BSpline &) { return (size_t) 1; },
+		          [](const BSpline &spline, real *out) {
+			if (spline.numControlPoints() == 200)
+				throw std::runtime_error("large spline");
+			*out = 0;
+		});
+		CuFail(tc, "expected exception");
+	} catch (std::runtime_error &e) {
+		// Then
+		CuAssertStrEquals(tc, "large spline", e.what());
+	}
+	try {
+		BatchResult result = batch.sample(splines);
+		result.data(100);
+		CuFail(tc, "expected exception");
+	} catch (std::out_of_range &) {}
+}
+
+void
+batch_reuse(CuTest *tc)
+{
+	// Given
+	vector<BSpline> splines = batch_splines(40);
+	BatchResult expected = Batch(1).sample(splines, 10);
+	Batch batch(4);
+	Batch copy(batch);
+	vector<BatchResult> results(4);
+
+	// When
+	for (size_t i = 0; i < 20; i++)
+		results[0] = batch.sample(splines, 10);
+	results[1] = copy.sample(splines, 10);
+	// Concurrent calls on the same batch are serialized.
+	std::thread other([&] { results[2] = batch.sample(splines, 10); });
+	results[3] = batch.sample(splines, 10);
+	other.join();
+
+	// Then
+	CuAssertIntEquals(tc, 4, (int) copy.numThreads());
+	for (const BatchResult &result : results) {
+		CuAssertIntEquals(tc, (int) expected.values().size(),
+		                  (int) result.values().size());
+		for (size_t i = 0; i < expected.values().size(); i++) {
+			CuAssertDblEquals(tc, expected.values()[i],
+			                  result.values()[i], 0);
+		}
+	}
+}
+
+CuSuite *
+get_batch_suite()
+{
+	CuSuite* suite = CuSuiteNew();
+	SUITE_ADD_TEST(suite, batch_sample);
+	SUITE_ADD_TEST(suite, batch_chord_lengths);
+	SUITE_ADD_TEST(suite, batch_map);
+	SUITE_ADD_TEST(suite, batch_exception);
+	SUITE_ADD_TEST(suite, batch_reuse);
+	return suite;
+}
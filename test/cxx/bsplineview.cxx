@@ -0,0 +1,80 @@
+#include <testutilscxx.h>
+
+void
+bsplineview_eval_interleaved(CuTest *tc)
+{
+	// Given
+	BSpline spline(4, 2, 3);
+	spline.setControlPoints({
+		1.0, 1.0,
+		2.0, 4.0,
+		3.0, 2.0,
+		4.0, 3.0
+	});
+	vector<real> knots = spline.knots();
+	// x, y, weight (ignored)
+	vector<real> interleaved = {
+		1.0, 1.0, 7.0,
+		2.0, 4.0, 7.0,
+		3.0, 2.0, 7.0,
+		4.0, 3.0, 7.0
+	};
+
+	// When
+	BSplineView view(interleaved.data(), 4, 2, 3, knots.data(), 3);
+
+	// Then
+	CuAssertIntEquals(tc, 4, (int) view.numControlPoints());
+	CuAssertIntEquals(tc, 2, (int) view.dimension());
+	for (real u = 0; u <= 1; u += (real) 0.1) {
+		vector<real> expected = spline(u).result();
+		vector<real> actual = view(u).result();
+		CuAssertIntEquals(tc, 2, (int) actual.size());
+		CuAssertDblEquals(tc, expected[0], actual[0], POINT_EPSILON);
+		CuAssertDblEquals(tc, expected[1], actual[1], POINT_EPSILON);
+	}
+	assert_equal_shape(tc, spline, view.toBSpline());
+	CuAssertTrue(tc, spline.toJson() == view.toJson());
+	CuAssertTrue(tc, spline.toBinary() == view.toBinary());
+	assert_equal_shape(tc, spline, BSpline::fromBinary(view.toBinary()));
+}
+
+void
+bsplineview_of_bspline(CuTest *tc)
+{
+	// Given
+	BSpline spline(7, 3, 2);
+
+	// When
+	BSplineView view(spline);
+	vector<real> expected = spline.sample(30);
+	vector<real> actual = view.sample(30);
+
+	// Then
+	CuAssertIntEquals(tc, (int) expected.size(), (int) actual.size());
+	for (size_t i = 0; i < expected.size(); i++)
+		CuAssertDblEquals(tc, expected[i], actual[i], POINT_EPSILON);
+}
+
+void
+bsplineview_invalid(CuTest *tc)
+{
+	// Given
+	vector<real> data(8, (real) 0.0);
+
+	// When
+	try {
+		BSplineView view(data.data(), 2, 2, 1, data.data(), 1);
+		CuFail(tc, "expected exception");
+	} catch(std::exception &) {}
+}
+
+CuSuite *
+get_bsplineview_suite()
+{
+	CuSuite* suite = CuSuiteNew();
+	SUITE_ADD_TEST(suite, bsplineview_eval_interleaved);
+	SUITE_ADD_TEST(suite, bsplineview_of_bspline);
+	SUITE_ADD_TEST(suite, bsplineview_invalid);
+	return suite;
+}
@@ -0,0 +1,41 @@
+#include <testutilscxx.h>
+
+void
+container_round_trip(CuTest *tc)
+{
+	// Given
+	BSpline a(7, 3, 3);
+	BSpline b(4, 2, 1);
+	std::string path = "container_cxx_test_file.tsbc";
+	{
+		ContainerWriter writer(path);
+		writer.append(a);
+		writer.close();
+	}
+	{
+		ContainerWriter writer(path, true);
+		writer.append(BSplineView(b));
+	} // closed by destructor
+
+	// When
+	Container container(path);
+
+	// Then
+	CuAssertIntEquals(tc, 2, (int) container.numSplines());
+	assert_equal_shape(tc, a, container.load(0));
+	assert_equal_shape(tc, b, container.view(1).toBSpline());
+	CuAssertTrue(tc, a.toJson() == container.view(0).toJson());
+	try {
+		container.view(2);
+		CuFail(tc, "expected exception");
+	} catch(std::exception &) {}
+	remove(path.c_str());
+}
+
+CuSuite *
+get_container_suite()
+{
+	CuSuite* suite = CuSuiteNew();
+	SUITE_ADD_TEST(suite, container_round_trip);
+	return suite;
+}
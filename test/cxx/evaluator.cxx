@@ -0,0 +1,63 @@
+#include <testutilscxx.h>
+
+void
+evaluator_eval(CuTest *tc)
+{
+	// Given
+	BSpline spline(7, 3, 3);
+	Evaluator evaluator;
+
+	// When
+	for (real u = 0; u <= 1; u += (real) 0.05) {
+		const real *actual = evaluator.eval(spline, u);
+		vector<real> expected = spline.eval(u).result();
+
+		// Then
+		for (size_t i = 0; i < 3; i++)
+			CuAssertDblEquals(tc, expected[i], actual[i],
+			                  POINT_EPSILON);
+		CuAssertIntEquals(tc,
+		                  (int) spline.eval(u).index(),
+		                  (int) evaluator.net().index());
+	}
+}
+
+void
+evaluator_copy_and_move(CuTest *tc)
+{
+	// Given
+	BSpline spline(4, 2, 1);
+	spline.setControlPoints({
+		0.0, 0.0,
+		1.0, 1.0,
+		2.0, 0.0,
+		3.0, 1.0
+	});
+	Evaluator evaluator(1, 2);
+	evaluator.eval(spline, (real) 0.5);
+
+	// When
+	Evaluator copy(evaluator);
+	Evaluator moved(std::move(evaluator));
+
+	// Then
+	const real *result = copy.eval(spline, (real) 0.5);
+	CuAssertDblEquals(tc, 1.5, result[0], POINT_EPSILON);
+	CuAssertDblEquals(tc, 0.5, result[1], POINT_EPSILON);
+	result = moved.eval(BSplineView(spline), (real) 1.0);
+	CuAssertDblEquals(tc, 3.0, result[0], POINT_EPSILON);
+	CuAssertDblEquals(tc, 1.0, result[1], POINT_EPSILON);
+	try {
+		moved.eval(spline, (real) 2.0);
+		CuFail(tc, "expected exception");
+	} catch(std::exception &) {}
+}
+
+CuSuite *
+get_evaluator_suite()
+{
+	CuSuite* suite = CuSuiteNew();
+	SUITE_ADD_TEST(suite, evaluator_eval);
+	SUITE_ADD_TEST(suite, evaluator_copy_and_move);
+	return suite;
+}
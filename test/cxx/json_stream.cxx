@@ -0,0 +1,50 @@
+#include <testutilscxx.h>
+
+void
+json_stream_round_trip(CuTest *tc)
+{
+	// Given
+	BSpline a(7, 3, 3);
+	BSpline b(4, 2, 1);
+	std::string path = "json_stream_cxx_test_file.json";
+	for (int lines = 0; lines < 2; lines++) {
+		{
+			JsonStreamWriter writer(path, lines == 1);
+			writer.append(a);
+			writer.append(BSplineView(b));
+		} // closed by destructor
+
+		// When
+		JsonStream stream(path);
+		BSpline first, second, third;
+		bool has_first = stream.next(first);
+		bool has_second = stream.next(second);
+		bool has_third = stream.next(third);
+
+		// Then
+		CuAssertTrue(tc, has_first && has_second && !has_third);
+		CuAssertIntEquals(tc, 2, (int) stream.numRead());
+		assert_equal_shape(tc, a, first);
+		assert_equal_shape(tc, b, second);
+		CuAssertTrue(tc, a.toJson() == first.toJson());
+	}
+	try {
+		JsonStream stream(path, 0, 10);
+		CuAssertTrue(tc, stream.numRead() == 0);
+	} catch(std::exception &) {
+		CuFail(tc, "unexpected exception");
+	}
+	try {
+		JsonStream stream("/does/not/exist");
+		CuFail(tc, "expected exception");
+	} catch(std::exception &) {}
+	remove(path.c_str());
+}
+
+CuSuite *
+get_json_stream_suite()
+{
+	CuSuite* suite = CuSuiteNew();
+	SUITE_ADD_TEST(suite, json_stream_round_trip);
+	return suite;
+}
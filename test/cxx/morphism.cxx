@@ -0,0 +1,106 @@
+#include <testutilscxx.h>
+
+#include <stdexcept>
+
+void
+morphism_copy_and_move(CuTest *tc)
+{
+	// Given
+	BSpline origin(3, 2, 1);
+	origin.setControlPoints({ 0, 0, 1, 2, 3, 1 });
+	BSpline target(5, 2, 3);
+	Morphism morphism(origin, target);
+	BSpline out;
+
+	// When
+	Morphism copy(morphism);
+	Morphism moved(std::move(morphism));
+	copy = moved;
+	moved.eval((real) 0.5, out);
+	size_t numControlPoints = out.numControlPoints();
+	moved.eval((real) 0.75, out);
+
+	// Then
+	CuAssertIntEquals(tc, (int) numControlPoints,
+	                  (int) out.numControlPoints());
+	assert_equal_shape(tc, copy((real) 0.75), out);
+	assert_equal_shape(tc, origin, copy((real) 0));
+	assert_equal_shape(tc, target, copy((real) 1));
+	try {
+		morphism.eval((real) 0.5);
+		CuFail(tc, "expected exception");
+	} catch (std::runtime_error &) {}
+}
+
+void
+morphism_eval_grid(CuTest *tc)
+{
+	// Given
+	BSpline origin(4, 2, 1);
+	origin.setControlPoints({ 0, 0, 1, 0, 2, 0, 3, 0 });
+	BSpline target(6, 2, 3);
+	Morphism morphism(origin, target);
+
+	// When
+	vector<real> grid = morphism.evalGrid({ 0.25, 0.5 }, { 0, 0.4, 1 });
+
+	// Then
+	CuAssertIntEquals(tc, 2 * 3 * 2, (int) grid.size());
+	vector<real> point = morphism(0.5).eval(0.4).result();
+	vector<real> at = morphism.evalAt(0.5, 0.4);
+	for (size_t d = 0; d < 2; d++) {
+		CuAssertDblEquals(tc, point[d], grid[(1 * 3 + 1) * 2 + d],
+		                  POINT_EPSILON);
+		CuAssertDblEquals(tc, point[d], at[d], POINT_EPSILON);
+	}
+	try {
+		morphism.evalAt(0.5, 2);
+		CuFail(tc, "expected exception");
+	} catch (std::runtime_error &) {}
+}
+
+void
+morphism_eval_endpoints(CuTest *tc)
+{
+	// Given
+	BSpline origin(4, 2, 1);
+	origin.setControlPoints({ 0, 0, 1, 0, 2, 0, 3, 0 });
+	BSpline target(5, 2, 3);
+	Morphism morphism(origin, target);
+	BSpline out;
+
+	// When
+	BSpline first = morphism((real) 0);
+	BSpline last = morphism.eval((real) 1);
+	BSpline before = morphism((real) -1);
+	BSpline after = morphism((real) 2);
+	morphism.eval((real) 0, out);
+
+	// Then
+	CuAssertIntEquals(tc, 1, (int) first.degree());
+	CuAssertIntEquals(tc, 4, (int) first.numControlPoints());
+	CuAssertTrue(tc, first.controlPoints() == origin.controlPoints());
+	CuAssertTrue(tc, first.knots() == origin.knots());
+	CuAssertIntEquals(tc, 3, (int) last.degree());
+	CuAssertIntEquals(tc, 5, (int) last.numControlPoints());
+	CuAssertTrue(tc, last.controlPoints() == target.controlPoints());
+	CuAssertTrue(tc, last.knots() == target.knots());
+	CuAssertTrue(tc, before.controlPoints() == origin.controlPoints());
+	CuAssertTrue(tc, after.controlPoints() == target.controlPoints());
+	// The out parameter overload keeps the shape of the aligned splines.
+	BSpline mid = morphism((real) 0.5);
+	CuAssertIntEquals(tc, (int) mid.degree(), (int) out.degree());
+	CuAssertIntEquals(tc, (int) mid.numControlPoints(),
+	                  (int) out.numControlPoints());
+	assert_equal_shape(tc, origin, out);
+}
+
+CuSuite *
+get_morphism_suite()
+{
+	CuSuite* suite = CuSuiteNew();
+	SUITE_ADD_TEST(suite, morphism_copy_and_move);
+	SUITE_ADD_TEST(suite, morphism_eval_grid);
+	SUITE_ADD_TEST(suite, morphism_eval_endpoints);
+	return suite;
+}
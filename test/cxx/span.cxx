@@ -0,0 +1,72 @@
+#include <testutilscxx.h>
+#include <algorithm>
+
+#if TINYSPLINECXX_SPAN
+void
+span_read_only(CuTest *tc)
+{
+	// Given
+	BSpline spline(7, 2, 3);
+	DeBoorNet net = spline.eval((real) 0.5);
+
+	// When
+	std::span<const real> ctrlp = spline.controlPointsSpan();
+	std::span<const real> knots = spline.knotsSpan();
+	std::span<const real> points = net.pointsSpan();
+	std::span<const real> result = net.resultSpan();
+
+	// Then
+	CuAssertTrue(tc, ctrlp.size() == spline.controlPoints().size());
+	CuAssertTrue(tc, std::equal(ctrlp.begin(), ctrlp.end(),
+	                            spline.controlPoints().begin()));
+	CuAssertTrue(tc, knots.size() == spline.knots().size());
+	CuAssertTrue(tc, std::equal(knots.begin(), knots.end(),
+	                            spline.knots().begin()));
+	CuAssertTrue(tc, points.size() == net.points().size());
+	CuAssertTrue(tc, result.size() == net.result().size());
+	CuAssertDblEquals(tc, net.result()[0], result[0], 0);
+	CuAssertDblEquals(tc, net.result()[1], result[1], 0);
+}
+
+void
+span_output(CuTest *tc)
+{
+	// Given
+	BSpline spline(7, 3, 3);
+	real knots[5];
+	real points[3 * 5], samples[3 * 5 + 2];
+
+	// When
+	spline.uniformKnotSeq(knots);
+	spline.evalAll(knots, points);
+	size_t num = spline.sample(samples);
+
+	// Then
+	vector<real> expectedKnots = spline.uniformKnotSeq(5);
+	vector<real> expectedPoints = spline.sample(5);
+	CuAssertIntEquals(tc, 5, (int) num);
+	for (size_t i = 0; i < 5; i++)
+		CuAssertDblEquals(tc, expectedKnots[i], knots[i], 0);
+	for (size_t i = 0; i < 3 * 5; i++) {
+		CuAssertDblEquals(tc, expectedPoints[i], points[i],
+		                  POINT_EPSILON);
+		CuAssertDblEquals(tc, expectedPoints[i], samples[i],
+		                  POINT_EPSILON);
+	}
+	try {
+		spline.evalAll(knots, std::span<real>(points, 14));
+		CuFail(tc, "expected exception");
+	} catch(std::exception &) {}
+}
+#endif
+
+CuSuite *
+get_span_suite()
+{
+	CuSuite* suite = CuSuiteNew();
+#if TINYSPLINECXX_SPAN
+	SUITE_ADD_TEST(suite, span_read_only);
+	SUITE_ADD_TEST(suite, span_output);
+#endif
+	return suite;
+}
@@ -6,6 +6,14 @@ CuSuite* get_knots_suite();
 CuSuite* get_frames_suite();
 CuSuite* get_bspline_suite();
 CuSuite* get_deboornet_suite();
+CuSuite* get_bsplineview_suite();
+CuSuite* get_evaluator_suite();
+CuSuite* get_container_suite();
+CuSuite* get_json_stream_suite();
+CuSuite* get_span_suite();
+CuSuite* get_threads_suite();
+CuSuite* get_morphism_suite();
+CuSuite* get_batch_suite();
 
 int main()
 {
@@ -19,6 +27,14 @@ int main()
 	CuSuiteAddSuite(suite, get_frames_suite());
 	CuSuiteAddSuite(suite, get_bspline_suite());
 	CuSuiteAddSuite(suite, get_deboornet_suite());
+	CuSuiteAddSuite(suite, get_bsplineview_suite());
+	CuSuiteAddSuite(suite, get_evaluator_suite());
+	CuSuiteAddSuite(suite, get_container_suite());
+	CuSuiteAddSuite(suite, get_json_stream_suite());
+	CuSuiteAddSuite(suite, get_span_suite());
+	CuSuiteAddSuite(suite, get_threads_suite());
+	CuSuiteAddSuite(suite, get_morphism_suite());
+	CuSuiteAddSuite(suite, get_batch_suite());
 
 	CuSuiteRun(suite);
 	CuSuiteSummary(suite, output);
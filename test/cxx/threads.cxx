@@ -0,0 +1,119 @@
+#include <testutilscxx.h>
+
+#include <cmath>
+#ifndef __EMSCRIPTEN__
+#include <thread>
+#endif
+
+// Stress test for sharing an immutable spline (and morphism) between threads.
+// Run with -fsanitize=thread to detect data races.
+#define THREADS_NUM_THREADS 64
+#define THREADS_NUM_ROUNDS 20
+#define THREADS_NUM_KNOTS 16
+
+#ifndef __EMSCRIPTEN__
+// Evaluates `spline' and `morphism' with thread-local objects and counts the
+// results that differ from `points' and `morphed'.
+static int
+threads_worker(const BSpline &spline,
+               const Morphism &morphism,
+               const vector<vector<real>> &points,
+               const vector<vector<real>> &morphed,
+               size_t offset)
+{
+	Evaluator evaluator;
+	BSpline out;
+	int failures = 0;
+	for (size_t r = 0; r < THREADS_NUM_ROUNDS; r++) {
+		size_t k = (offset + r) % THREADS_NUM_KNOTS;
+		real u = (real) k / (THREADS_NUM_KNOTS - 1);
+		const real *result = evaluator.eval(spline, u);
+		vector<real> net = spline.eval(u).result();
+		morphism.eval(u, out);
+		vector<real> ctrlp = out.controlPoints();
+		for (size_t i = 0; i < points[k].size(); i++) {
+			if (std::fabs(result[i] - points[k][i]) > POINT_EPSILON)
+				failures++;
+			if (std::fabs(net[i] - points[k][i]) > POINT_EPSILON)
+				failures++;
+		}
+		for (size_t i = 0; i < morphed[k].size(); i++) {
+			if (std::fabs(ctrlp[i] - morphed[k][i]) > POINT_EPSILON)
+				failures++;
+		}
+	}
+	return failures;
+}
+#endif
+
+void
+threads_shared_spline(CuTest *tc)
+{
+#ifdef __EMSCRIPTEN__
+	(void) tc;
+#else
+	// Given
+	BSpline spline(50, 3, 3);
+	vector<real> ctrlp = spline.controlPoints();
+	for (size_t i = 0; i < ctrlp.size(); i++)
+		ctrlp[i] = (real) ((i * 7) % 13);
+	spline.setControlPoints(ctrlp);
+	const BSpline shared = spline;
+	const Morphism morphism(shared, BSpline(10, 3, 1));
+	vector<vector<real>> points, morphed;
+	for (size_t k = 0; k < THREADS_NUM_KNOTS; k++) {
+		real u = (real) k / (THREADS_NUM_KNOTS - 1);
+		points.push_back(shared.eval(u).result());
+		morphed.push_back(morphism.eval(u).controlPoints());
+	}
+	vector<int> failures(THREADS_NUM_THREADS, 0);
+	vector<std::thread> threads;
+
+	// When
+	for (size_t t = 0; t < THREADS_NUM_THREADS; t++) {
+		threads.emplace_back([&, t]() {
+			failures[t] = threads_worker(shared, morphism,
+			                             points, morphed, t);
+		});
+	}
+	for (std::thread &thread : threads)
+		thread.join();
+
+	// Then
+	for (size_t t = 0; t < THREADS_NUM_THREADS; t++)
+		CuAssertIntEquals(tc, 0, failures[t]);
+	assert_equal_shape(tc, spline, shared);
+#endif
+}
+
+void
+threads_morphism_eval(CuTest *tc)
+{
+	// Given
+	BSpline origin(4, 2, 1);
+	origin.setControlPoints({ 0, 0, 1, 0, 2, 0, 3, 0 });
+	BSpline target(5, 2, 3);
+	const Morphism morphism(origin, target);
+	BSpline out;
+
+	// When
+	morphism.eval((real) 0.5, out);
+
+	// Then
+	assert_equal_shape(tc, morphism.eval((real) 0.5), out);
+	morphism.eval((real) 0.0, out);
+	assert_equal_shape(tc, origin, out);
+	morphism.eval((real) 1.0, out);
+	assert_equal_shape(tc, target, out);
+	assert_equal_shape(tc, morphism((real) 0.25),
+	                   origin.morphTo(target)((real) 0.25));
+}
+
+CuSuite *
+get_threads_suite()
+{
+	CuSuite* suite = CuSuiteNew();
+	SUITE_ADD_TEST(suite, threads_shared_spline);
+	SUITE_ADD_TEST(suite, threads_morphism_eval);
+	return suite;
+}
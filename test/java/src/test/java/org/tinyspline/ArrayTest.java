@@ -0,0 +1,96 @@
+package org.tinyspline;
+
+import org.junit.jupiter.api.Test;
+
+import java.nio.ByteBuffer;
+import java.nio.ByteOrder;
+import java.nio.DoubleBuffer;
+import java.util.List;
+
+import static org.assertj.core.api.Assertions.assertThat;
+import static org.assertj.core.api.Assertions.assertThatThrownBy;
+import static org.assertj.core.data.Offset.offset;
+import static org.tinyspline.tinysplinejavaConstants.TS_POINT_EPSILON;
+
+public class ArrayTest {
+
+    private static DoubleBuffer directBuffer(int size) {
+        return ByteBuffer.allocateDirect(size * Double.BYTES)
+                .order(ByteOrder.nativeOrder())
+                .asDoubleBuffer();
+    }
+
+    private static BSpline newSpline() {
+        BSpline spline = new BSpline(4, 2);
+        spline.setControlPoints(new double[] {
+                120.0, 100.0, // P1
+                270.0, 40.0,  // P2
+                370.0, 490.0, // P3
+                590.0, 40.0   // P4
+        });
+        return spline;
+    }
+
+    @Test
+    public void testControlPointsArray() {
+        // Given
+        BSpline spline = newSpline();
+
+        // When
+        double[] ctrlp = spline.controlPointsArray();
+
+        // Then
+        assertThat(ctrlp).containsExactly(
+                spline.getControlPoints().stream()
+                        .mapToDouble(Double::doubleValue).toArray(),
+                offset(0.0));
+        assertThat(spline.knotsArray()).hasSize(8);
+    }
+
+    @Test
+    public void testEvalAllArray() {
+        // Given
+        BSpline spline = newSpline();
+        double[] knots = { 0.0, 0.25, 0.5, 1.0 };
+
+        // When
+        double[] points = spline.evalAll(knots);
+
+        // Then
+        List<Double> expected = spline.evalAll(List.of(0.0, 0.25, 0.5, 1.0));
+        assertThat(points).hasSize(expected.size());
+        for (int i = 0; i < points.length; i++) {
+            assertThat(points[i]).isEqualTo(expected.get(i),
+                    offset(TS_POINT_EPSILON));
+        }
+    }
+
+    @Test
+    public void testSampleDirectBuffer() {
+        // Given
+        BSpline spline = newSpline();
+        DoubleBuffer points = directBuffer(2 * 50);
+
+        // When
+        spline.sample(50, points);
+
+        // Then
+        double[] expected = spline.sampleArray(50);
+        for (int i = 0; i < expected.length; i++) {
+            assertThat(points.get(i)).isEqualTo(expected[i],
+                    offset(TS_POINT_EPSILON));
+        }
+    }
+
+    @Test
+    public void testInvalidBuffers() {
+        // Given
+        BSpline spline = newSpline();
+
+        // Then
+        assertThatThrownBy(() -> spline.sample(50, directBuffer(99)))
+                .isInstanceOf(IndexOutOfBoundsException.class);
+        assertThatThrownBy(() -> spline.sample(50, DoubleBuffer.allocate(100)))
+                .isInstanceOf(IllegalArgumentException.class);
+    }
+}
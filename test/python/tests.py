@@ -1,3 +1,4 @@
+import array
 import unittest
 from tinyspline import *
 
@@ -119,6 +120,53 @@ class TestInterpolation(unittest.TestCase):
 
 
 
+class TestBuffer(unittest.TestCase):
+
+    def testSampleIsList(self):
+        # Given
+        spline = BSpline(7, 2)
+
+        # When
+        points = spline.sample(10)
+
+        # Then
+        self.assertIsInstance(points, list)
+        self.assertEqual(20, len(points))
+
+    def testSampleBuffer(self):
+        # Given
+        spline = BSpline(7, 2)
+
+        # When
+        points = spline.sample_buffer(10)
+
+        # Then
+        view = memoryview(points)
+        self.assertEqual(20, len(view))
+        self.assertIn(view.format, ["d", "f"])
+        assertPts1dAlmostEqual(spline.sample(10), view, self)
+        assertPts1dAlmostEqual(spline.knots, spline.knots_buffer(), self)
+        assertPts1dAlmostEqual(spline.control_points,
+                               spline.control_points_buffer(), self)
+        assertPts1dAlmostEqual(spline.eval_all([0.5]),
+                               spline.eval_all_buffer([0.5]), self)
+
+    def testSetControlPointsFromBuffer(self):
+        # Given
+        spline = BSpline(3, 2, 1)
+        fmt = memoryview(spline.control_points_buffer()).format
+        ctrlp = array.array(fmt, [0, 1, 2, 3, 4, 5])
+
+        # When
+        spline.control_points = ctrlp
+
+        # Then
+        assertPts1dAlmostEqual(ctrlp, spline.control_points, self)
+        assertPts1dAlmostEqual([4, 5], spline.eval_all(
+            array.array(fmt, [1]))[0:2], self)
+
+
+
 class TestVec(unittest.TestCase):
 
     def testValuesVec2(self):